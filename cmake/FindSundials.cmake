@@ -30,6 +30,11 @@ else()
 		NAMES sundials_kinsol
 	)
 
+	# Only available if Sundials was built with KLU support
+	find_library(SUNDIALS_SUNLINSOLKLU_LIBRARY
+		NAMES sundials_sunlinsolklu
+	)
+
 	set(SUNDIALS_LIBRARIES
 		${SUNDIALS_ARKODE_LIBRARY}
 		${SUNDIALS_CVODE_LIBRARY}
@@ -39,8 +44,12 @@ else()
 		${SUNDIALS_KINSOL_LIBRARY}
 	)
 
+	if(SUNDIALS_SUNLINSOLKLU_LIBRARY)
+		list(APPEND SUNDIALS_LIBRARIES ${SUNDIALS_SUNLINSOLKLU_LIBRARY})
+	endif()
+
 	include(FindPackageHandleStandardArgs)
 	find_package_handle_standard_args(Sundials DEFAULT_MSG SUNDIALS_ARKODE_LIBRARY SUNDIALS_INCLUDE_DIR)
 
-	mark_as_advanced(SUNDIALS_INCLUDE_DIR SUNDIALS_LIBRARIES)
+	mark_as_advanced(SUNDIALS_INCLUDE_DIR SUNDIALS_LIBRARIES SUNDIALS_SUNLINSOLKLU_LIBRARY)
 endif()
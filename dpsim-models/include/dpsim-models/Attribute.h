@@ -173,6 +173,21 @@ public:
   }
 };
 
+/**
+ * Describes a derived attribute whose value is a part of its parent's value without any computation,
+ * e.g. a matrix coefficient or the real part of a complex number. Allows readers such as loggers to access
+ * the value directly in the parent's storage instead of running the attribute's update tasks.
+ */
+struct AttributeView {
+  /// The attribute this attribute was derived from, nullptr if this attribute is not a view
+  AttributeBase::Ptr parent;
+  /// Coefficient of a matrix parent, -1 if the view covers the whole value
+  Int row = -1;
+  Int column = -1;
+  /// 0 for the real and 1 for the imaginary part of a complex parent, -1 for the whole value
+  Int part = -1;
+};
+
 /**
  * Base class for all AttributeUpdateTasks. Enables storing tasks in an STL list independent of the dependency types.
  */
@@ -369,6 +384,21 @@ public:
     return derivedAttribute;
   }
 
+  /**
+   * Like `derive`, but additionally marks the new attribute as a view on a part of this attribute's value.
+   * The getter must only copy the part described by `row`, `column` and `part` (see `AttributeView`).
+   */
+  template <class U>
+  typename Attribute<U>::Ptr
+  deriveView(typename AttributeUpdateTask<U, T>::Actor getter,
+             typename AttributeUpdateTask<U, T>::Actor setter, Int row,
+             Int column, Int part) {
+    typename Attribute<U>::Ptr derivedAttribute = derive<U>(getter, setter);
+    std::static_pointer_cast<AttributeDynamic<U>>(derivedAttribute.getPtr())
+        ->setView(AttributeView{this->shared_from_this(), row, column, part});
+    return derivedAttribute;
+  }
+
   /**
    * Convenience method for deriving the real part of a complex attribute
    * @return a new attribute whose value will always equal the real part of `this`
@@ -390,7 +420,7 @@ public:
           currentValue.real(*dependent);
           dependency->set(currentValue);
         };
-    return derive<CPS::Real>(getter, setter);
+    return deriveView<CPS::Real>(getter, setter, -1, -1, 0);
   }
 
   /**
@@ -414,7 +444,7 @@ public:
           currentValue.imag(*dependent);
           dependency->set(currentValue);
         };
-    return derive<CPS::Real>(getter, setter);
+    return deriveView<CPS::Real>(getter, setter, -1, -1, 1);
   }
 
   /**
@@ -511,7 +541,8 @@ public:
           currentValue(row, column) = *dependent;
           dependency->set(currentValue);
         };
-    return derive<U>(getter, setter);
+    return deriveView<U>(getter, setter, static_cast<Int>(row),
+                         static_cast<Int>(column), -1);
   }
 };
 
@@ -556,10 +587,26 @@ protected:
   std::vector<typename AttributeUpdateTaskBase<T>::Ptr> updateTasksOnce;
   std::vector<typename AttributeUpdateTaskBase<T>::Ptr> updateTasksOnGet;
   std::vector<typename AttributeUpdateTaskBase<T>::Ptr> updateTasksOnSet;
+  AttributeView mView;
 
 public:
   AttributeDynamic(T initialValue = T()) : Attribute<T>(initialValue) {}
 
+  /**
+   * Marks this attribute as a view on a part of another attribute's value. Reset whenever the getter tasks change.
+   */
+  void setView(const AttributeView &view) { mView = view; }
+
+  /**
+   * @return the parent and position this attribute's value is taken from. `parent` is nullptr if this is no view.
+   */
+  const AttributeView &view() const { return mView; }
+
+  /**
+   * @return true if `get` runs update tasks, false if the value is always read from the internal storage
+   */
+  bool hasUpdateTasksOnGet() const { return !updateTasksOnGet.empty(); }
+
   /**
    * Allows for adding a new update task to this attribute.
    * @param kind The kind of update task
@@ -567,6 +614,8 @@ public:
    */
   void addTask(UpdateTaskKind kind,
                typename AttributeUpdateTaskBase<T>::Ptr task) {
+    if (kind != UpdateTaskKind::UPDATE_ON_SET)
+      mView = AttributeView();
     switch (kind) {
     case UpdateTaskKind::UPDATE_ONCE:
       updateTasksOnce.push_back(task);
@@ -589,6 +638,8 @@ public:
    * @param kind The kind of tasks to remove
    */
   void clearTasks(UpdateTaskKind kind) {
+    if (kind != UpdateTaskKind::UPDATE_ON_SET)
+      mView = AttributeView();
     switch (kind) {
     case UpdateTaskKind::UPDATE_ONCE:
       updateTasksOnce.clear();
@@ -608,6 +659,7 @@ public:
    * Remove all update tasks from this attribute, regardless of their kind.
    */
   void clearAllTasks() {
+    mView = AttributeView();
     updateTasksOnce.clear();
     updateTasksOnGet.clear();
     updateTasksOnSet.clear();
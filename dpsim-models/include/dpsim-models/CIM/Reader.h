@@ -10,6 +10,8 @@
 
 #include <list>
 #include <map>
+#include <memory>
+#include <vector>
 
 #include <dpsim-models/Components.h>
 #include <dpsim-models/Definitions.h>
@@ -58,6 +60,54 @@ class InvalidTopology {};
 
 class Reader {
 private:
+  // #### Extracted CIM data ####
+  /// Equipment classes that are mapped to components
+  enum class EquipmentType {
+    ACLineSegment,
+    PowerTransformer,
+    SynchronousMachine,
+    EnergyConsumer,
+    ExternalNetworkInjection,
+    EquivalentShunt
+  };
+  /// Parameters of a CIM equipment that are required to create a component.
+  /// The meaning of the parameters depends on the type, see the extract
+  /// functions.
+  struct EquipmentData {
+    EquipmentType type;
+    String mRID;
+    String name;
+    Real baseVoltage = 0;
+    std::vector<Real> params;
+  };
+  ///
+  struct TerminalData {
+    String mRID;
+    Int sequenceNumber = 1;
+    /// Empty if the terminal has no equipment
+    String equipment;
+  };
+  ///
+  struct NodeData {
+    String mRID;
+    String name;
+    std::vector<TerminalData> terminals;
+  };
+  /// Voltage of a topological node from an SvVoltage object
+  struct NodeVoltageData {
+    String node;
+    Real voltageAbs;
+    Real voltagePhase;
+  };
+  /// Power flow at a terminal from an SvPowerFlow object
+  struct TerminalPowerData {
+    String terminal;
+    Complex power;
+  };
+  /// Lookup tables of CIM objects, defined in the implementation to keep
+  /// CIM++ headers out of this file
+  struct ModelIndex;
+
   /// CIM logger
   Logger::Log mSLog;
   /// Log level of components
@@ -89,6 +139,26 @@ private:
   ///
   Bool mUseProtectionSwitches = false;
 
+  // #### Loading settings ####
+  /// Maps the equipment to components with multiple threads
+  Bool mParallelMapping = false;
+  /// Directory of the snapshots of extracted CIM data, empty if disabled
+  fs::path mSnapshotDirectory;
+  /// Files that are parsed
+  std::list<fs::path> mFilenames;
+
+  // #### Extracted CIM data ####
+  /// Only valid during the extraction
+  std::unique_ptr<ModelIndex> mIndex;
+  /// Topological nodes in the order of the CIM files
+  std::vector<NodeData> mNodeData;
+  /// Equipment in the order of the CIM files
+  std::vector<EquipmentData> mEquipmentData;
+  ///
+  std::vector<NodeVoltageData> mNodeVoltageData;
+  ///
+  std::vector<TerminalPowerData> mTerminalPowerData;
+
   // #### shunt component settings ####
   /// activates global shunt capacitor setting
   Bool mSetShuntCapacitor = false;
@@ -103,49 +173,84 @@ private:
   /// Resolves unit multipliers.
   static Real unitValue(Real value, CIMPP::UnitMultiplier mult);
   ///
-  void processSvVoltage(CIMPP::SvVoltage *volt);
+  void processNodeVoltage(const NodeVoltageData &volt);
   ///
-  void processSvPowerFlow(CIMPP::SvPowerFlow *flow);
+  void processTerminalPower(const TerminalPowerData &flow);
   ///
-  template <typename VarType>
-  void processTopologicalNode(CIMPP::TopologicalNode *topNode);
+  template <typename VarType> void processTopologicalNode(const NodeData &node);
   ///
   void addFiles(const fs::path &filename);
   /// Adds CIM files to list of files to be parsed.
   void addFiles(const std::list<fs::path> &filenames);
+  /// Parses the CIM files and extracts the data required for the components,
+  /// or restores the data from a snapshot of the same files.
+  void parseFiles();
   /// First, go through all topological nodes and collect them in a list.
   /// Since all nodes have references to the equipment connected to them (via Terminals), but not
   /// the other way around (which we need for instantiating the components), we collect that information here as well.
-  void parseFiles();
+  void createComponents();
   /// Returns list of components and nodes.
   SystemTopology systemTopology();
 
+  // #### Extraction Functions ####
+  /// Sorts the CIM objects by type in a single pass and extracts their data.
+  void extractModel();
+  ///
+  NodeData extractTopologicalNode(CIMPP::TopologicalNode *topNode);
+  /// Parameters: r, x, bch, gch
+  EquipmentData extractACLineSegment(CIMPP::ACLineSegment *line);
+  /// Parameters: rated power, rated voltages of both ends, voltage ratio,
+  /// resistance and reactance referred to the higher voltage side.
+  /// Returns false if the transformer is not supported.
+  Bool extractPowerTransformer(CIMPP::PowerTransformer *trans,
+                               EquipmentData &data);
+  /// Parameters: rated power, rated voltage, flag for dynamic data,
+  /// Rs, Ll, Ld, Lq, Ld_t, Lq_t, Ld_s, Lq_s, Td0_t, Tq0_t, Td0_s, Tq0_s, H,
+  /// flag for generating unit data, active power and voltage set-points
+  EquipmentData extractSynchronousMachine(CIMPP::SynchronousMachine *machine);
+  /// No parameters
+  EquipmentData extractEnergyConsumer(CIMPP::EnergyConsumer *consumer);
+  /// Parameters: voltage control mode (0 none, 1 set-point, 2 incomplete),
+  /// voltage set-point in per unit
+  EquipmentData
+  extractExternalNetworkInjection(CIMPP::ExternalNetworkInjection *extnet);
+  /// Parameters: g, b
+  EquipmentData extractEquivalentShunt(CIMPP::EquivalentShunt *shunt);
+
+  // #### Snapshot Functions ####
+  /// Path of the snapshot for the current set of files
+  fs::path snapshotPath();
+  /// Returns false if no valid snapshot exists
+  Bool readSnapshot(const fs::path &path);
+  ///
+  void writeSnapshot(const fs::path &path);
+
   // #### Mapping Functions ####
   /// Returns simulation node index which belongs to mRID.
   Matrix::Index mapTopologicalNode(String mrid);
-  /// Maps CIM components to CPowerSystem components.
-  TopologicalPowerComp::Ptr mapComponent(BaseClass *obj);
+  /// Maps extracted CIM data to CPowerSystem components.
+  TopologicalPowerComp::Ptr mapComponent(const EquipmentData &data);
   /// Returns an RX-Line.
   /// The voltage should be given in kV and the angle in degree.
   /// TODO: Introduce different models such as PI and wave model.
-  TopologicalPowerComp::Ptr mapACLineSegment(CIMPP::ACLineSegment *line);
+  TopologicalPowerComp::Ptr mapACLineSegment(const EquipmentData &line);
   /// Returns a transformer, either ideal or with RL elements to model losses.
-  TopologicalPowerComp::Ptr mapPowerTransformer(CIMPP::PowerTransformer *trans);
+  TopologicalPowerComp::Ptr mapPowerTransformer(const EquipmentData &trans);
   /// Returns an IdealVoltageSource with voltage setting according to load flow data
   /// at machine terminals. The voltage should be given in kV and the angle in degree.
   /// TODO: Introduce real synchronous generator models here.
   TopologicalPowerComp::Ptr
-  mapSynchronousMachine(CIMPP::SynchronousMachine *machine);
+  mapSynchronousMachine(const EquipmentData &machine);
   /// Returns an PQload with voltage setting according to load flow data.
   /// Currently the only option is to create an RL-load.
   /// The voltage should be given in kV and the angle in degree.
   /// TODO: Introduce real PQload model here.
-  TopologicalPowerComp::Ptr mapEnergyConsumer(CIMPP::EnergyConsumer *consumer);
+  TopologicalPowerComp::Ptr mapEnergyConsumer(const EquipmentData &consumer);
   /// Returns an external grid injection.
   TopologicalPowerComp::Ptr
-  mapExternalNetworkInjection(CIMPP::ExternalNetworkInjection *extnet);
+  mapExternalNetworkInjection(const EquipmentData &extnet);
   /// Returns a shunt
-  TopologicalPowerComp::Ptr mapEquivalentShunt(CIMPP::EquivalentShunt *shunt);
+  TopologicalPowerComp::Ptr mapEquivalentShunt(const EquipmentData &shunt);
 
   // #### Helper Functions ####
   /// Determine base voltage associated with object
@@ -185,6 +290,14 @@ public:
   void setShuntConductance(Real v);
   /// If set, some components like loads include protection switches
   void useProtectionSwitches(Bool value = true);
+
+  // #### loading settings ####
+  /// If set, the equipment is mapped to components by multiple threads
+  void useParallelMapping(Bool value = true);
+  /// If set, the data extracted from the CIM files is stored in the given
+  /// directory and restored from there when the same files are loaded again,
+  /// which skips parsing the files.
+  void useSnapshotCache(const fs::path &directory);
 };
 } // namespace CIM
 } // namespace CPS
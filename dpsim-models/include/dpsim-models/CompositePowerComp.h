@@ -23,6 +23,14 @@ private:
   MNAInterface::List mSubcomponentsAfterPostStep;
 
   std::vector<CPS::Attribute<Matrix>::Ptr> mRightVectorStamps;
+  /// Subcomponents that own the entries of mRightVectorStamps
+  MNAInterface::List mRightVectorSubcomponents;
+  /// Rows written by each entry of mRightVectorStamps
+  std::vector<std::vector<UInt>> mRightVectorStampRows;
+  /// Rows of this component's right vector that have to be reset every step
+  std::vector<UInt> mRightVectorRows;
+  /// True if the rows of all stamps are known and only they are summed up
+  Bool mSparseRightVectorStamps = false;
 
 public:
   using Type = VarType;
@@ -61,6 +61,10 @@ public:
                                          Int freqIdx) override;
   /// Stamps right side (source) vector
   void mnaCompApplyRightSideVectorStamp(Matrix &rightVector) override;
+  /// Only writes to the rows of its terminals
+  Bool mnaRightVectorRows(std::vector<UInt> &rows) override {
+    return mnaTerminalRightVectorRows(rows);
+  }
   void mnaCompApplyRightSideVectorStampHarm(Matrix &rightVector) override;
   /// Update interface voltage from MNA system result
   void mnaCompUpdateVoltage(const Matrix &leftVector) override;
@@ -89,6 +89,10 @@ public:
                    double resid[], std::vector<int> &off);
   ///Voltage Getter
   Complex daeInitialize();
+  /// Jacobian of the residual for DAE Solver
+  bool daeJacobian(double ttime, const double state[], const double dstate_dt[],
+                   double cj, JacobianEntries &jacobian,
+                   std::vector<int> &off);
 };
 } // namespace Ph1
 } // namespace DP
@@ -98,6 +98,10 @@ public:
                                          Int freqIdx) override;
   /// Stamps right side (source) vector
   void mnaCompApplyRightSideVectorStamp(Matrix &rightVector) override;
+  /// Only writes to the rows of its virtual node
+  Bool mnaRightVectorRows(std::vector<UInt> &rows) override {
+    return mnaTerminalRightVectorRows(rows);
+  }
   void mnaCompApplyRightSideVectorStampHarm(Matrix &rightVector) override;
   /// Returns current through the component
   void mnaCompUpdateCurrent(const Matrix &leftVector) override;
@@ -156,6 +160,10 @@ public:
                    double resid[], std::vector<int> &off) override;
   ///Voltage Getter
   Complex daeInitialize() override;
+  /// Jacobian of the residual for DAE Solver
+  bool daeJacobian(double ttime, const double state[], const double dstate_dt[],
+                   double cj, JacobianEntries &jacobian,
+                   std::vector<int> &off) override;
 };
 } // namespace Ph1
 } // namespace DP
@@ -47,6 +47,10 @@ public:
   void mnaCompApplySystemMatrixStamp(SparseMatrixRow &systemMatrix) override {}
   /// Stamps right side (source) vector
   void mnaCompApplyRightSideVectorStamp(Matrix &rightVector) override;
+  /// Only writes to the rows of its terminals
+  Bool mnaRightVectorRows(std::vector<UInt> &rows) override {
+    return mnaTerminalRightVectorRows(rows);
+  }
   ///
   void mnaCompUpdateVoltage(const Matrix &leftVector) override;
 
@@ -8,9 +8,28 @@
 
 #pragma once
 
-#define SPDLOG_ACTIVE_LEVEL SPDLOG_LEVEL_INFO
+#include <dpsim-models/Config.h>
+
+#define SPDLOG_ACTIVE_LEVEL DPSIM_LOG_LEVEL
 #include <spdlog/spdlog.h>
 
+// Check the level of the logger before evaluating the arguments, so that
+// matrices are only formatted when the message is written
+#undef SPDLOG_LOGGER_CALL
+#ifndef SPDLOG_NO_SOURCE_LOC
+#define SPDLOG_LOGGER_CALL(logger, level, ...)                                 \
+  ((logger)->should_log(level)                                                 \
+       ? (logger)->log(                                                        \
+             spdlog::source_loc{__FILE__, __LINE__, SPDLOG_FUNCTION}, level,   \
+             __VA_ARGS__)                                                      \
+       : (void)0)
+#else
+#define SPDLOG_LOGGER_CALL(logger, level, ...)                                 \
+  ((logger)->should_log(level)                                                 \
+       ? (logger)->log(spdlog::source_loc{}, level, __VA_ARGS__)               \
+       : (void)0)
+#endif
+
 #if defined(SPDLOG_VER_MAJOR) && SPDLOG_VER_MAJOR >= 1
 #include <spdlog/sinks/basic_file_sink.h>
 #else
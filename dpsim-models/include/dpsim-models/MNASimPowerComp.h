@@ -22,7 +22,7 @@ public:
   using List = std::vector<Ptr>;
 
   /// This component's contribution ("stamp") to the right-side vector.
-  /// TODO performance improvements from a sparse representation, at least during copying / summation?
+  /// Only the rows returned by mnaRightVectorRows() are read by the solver.
   Attribute<Matrix>::Ptr mRightVector;
 
   /// List of tasks that relate to using MNA for this component (usually pre-step and/or post-step)
@@ -71,6 +71,14 @@ public:
   void mnaApplyRightSideVectorStampHarm(Matrix &sourceVector) final;
   void mnaApplyRightSideVectorStampHarm(Matrix &sourceVector,
                                         Int freqIdx) final;
+  /// No rows if the right vector is empty, otherwise the rows are unknown
+  /// and the whole right vector is added. Components that only write to
+  /// their terminal and virtual node rows can override this with
+  /// mnaTerminalRightVectorRows().
+  Bool mnaRightVectorRows(std::vector<UInt> &rows) override;
+  /// Rows of the terminal nodes, the virtual nodes and the rows of all
+  /// subcomponents, none if the right vector is empty
+  Bool mnaTerminalRightVectorRows(std::vector<UInt> &rows);
 
   // MNA Interface methods that can be overridden by components
   virtual void mnaCompInitialize(Real omega, Real timeStep,
@@ -67,6 +67,10 @@ public:
                    double resid[], std::vector<int> &off) override;
   ///Voltage Getter
   Complex daeInitialize() override;
+  /// Jacobian of the residual for DAE Solver
+  bool daeJacobian(double ttime, const double state[], const double dstate_dt[],
+                   double cj, JacobianEntries &jacobian,
+                   std::vector<int> &off) override;
 
   void mnaCompPreStep(Real time, Int timeStepCount) override;
   void mnaCompPostStep(Real time, Int timeStepCount,
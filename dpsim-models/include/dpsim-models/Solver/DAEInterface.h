@@ -19,6 +19,8 @@ public:
 
   using ResFn = std::function<void(double, const double *, const double *,
                                    double *, std::vector<int> &)>;
+  /// Triplets (row, column, value) of a sparse Jacobian
+  using JacobianEntries = std::vector<Eigen::Triplet<Real>>;
 
   // #### DAE Section ####
   ///Residual Function for DAE Solver
@@ -27,5 +29,15 @@ public:
                            std::vector<int> &off) = 0;
   ///Voltage Getter for Components
   virtual Complex daeInitialize() = 0;
+  /// Appends the partial derivatives dF/dy + cj * dF/dy' of the residual
+  /// entries written by daeResidual, using the same offsets. Entries for the
+  /// same position are summed and the positions must not depend on the
+  /// state. Returns false if the component does not provide its Jacobian, so
+  /// that the solver approximates it by finite differences.
+  virtual bool daeJacobian(double ttime, const double state[],
+                           const double dstate_dt[], double cj,
+                           JacobianEntries &jacobian, std::vector<int> &off) {
+    return false;
+  }
 };
 } // namespace CPS
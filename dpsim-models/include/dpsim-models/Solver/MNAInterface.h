@@ -25,7 +25,8 @@ public:
   virtual void mnaInitialize(Real omega, Real timeStep) = 0;
   virtual void mnaInitialize(Real omega, Real timeStep,
                              Attribute<Matrix>::Ptr leftVector) = 0;
-  /// Stamps system matrix
+  /// Stamps system matrix. The matrix is compressed by the solver once all
+  /// components are stamped.
   virtual void mnaApplySystemMatrixStamp(SparseMatrixRow &systemMatrix) = 0;
   /// Stamps right side (source) vector
   virtual void mnaApplyRightSideVectorStamp(Matrix &rightVector) = 0;
@@ -66,5 +67,8 @@ public:
   virtual const Task::List &mnaTasks() const = 0;
   // Return right vector attribute
   virtual Attribute<Matrix>::Ptr getRightVector() const = 0;
+  /// Appends the rows of the right vector that the component writes to.
+  /// Returns false if they are unknown, then the whole vector is added.
+  virtual Bool mnaRightVectorRows(std::vector<UInt> &rows) { return false; }
 };
 } // namespace CPS
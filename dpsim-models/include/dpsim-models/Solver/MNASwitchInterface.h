@@ -23,12 +23,12 @@ public:
   // #### MNA section ####
   /// Check if switch is closed
   virtual Bool mnaIsClosed() = 0;
-  /// Stamps system matrix considering the defined switch position
+  /// Stamps system matrix considering the defined switch position.
+  /// The matrix is compressed by the solver once all stamps are applied.
   virtual void mnaApplySwitchSystemMatrixStamp(Bool closed,
                                                SparseMatrixRow &systemMatrix,
                                                Int freqIdx) final {
     this->mnaCompApplySwitchSystemMatrixStamp(closed, systemMatrix, freqIdx);
-    systemMatrix.makeCompressed();
   }
   virtual void mnaCompApplySwitchSystemMatrixStamp(
       Bool closed, SparseMatrixRow &systemMatrix, Int freqIdx) {}
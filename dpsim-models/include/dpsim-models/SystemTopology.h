@@ -147,6 +147,11 @@ public:
   /// Copy the whole topology the given number of times and add the resulting components and nodes to the topology.
   void multiply(Int numberCopies);
 
+  /// Returns a copy with new nodes and components of the same names, which
+  /// can be simulated independently of this topology. Only supports power
+  /// components which implement clone().
+  SystemTopology copy();
+
   /// @brief Remove system component
   /// @param name name of the component
   void removeComponent(const String &name);
@@ -168,5 +173,11 @@ public:
 
 private:
   template <typename VarType> void multiplyPowerComps(Int numberCopies);
+  /// Appends copies of the nodes and power components of type VarType, whose
+  /// names are extended by copySuffix
+  template <typename VarType>
+  void copyPowerComps(const String &copySuffix,
+                      typename SimNode<VarType>::List &newNodes,
+                      typename SimPowerComp<VarType>::List &newComponents);
 };
 } // namespace CPS
@@ -9,7 +9,13 @@
 #include <CIMExceptions.hpp>
 #include <CIMModel.hpp>
 #include <IEC61970.hpp>
+#include <algorithm>
+#include <fstream>
+#include <future>
+#include <iomanip>
 #include <memory>
+#include <thread>
+#include <unordered_map>
 
 #define READER_CPP
 #include <dpsim-models/CIM/Reader.h>
@@ -18,6 +24,101 @@ using namespace CPS;
 using namespace CPS::CIM;
 using CIMPP::UnitMultiplier;
 
+namespace {
+// Positions of the parameters in the extracted equipment data
+namespace LineParam {
+enum : UInt { R, X, Bch, Gch, Count };
+}
+namespace TransformerParam {
+enum : UInt {
+  RatedPower,
+  VoltageNode1,
+  VoltageNode2,
+  RatioAbs,
+  Resistance,
+  Reactance,
+  Count
+};
+}
+namespace MachineParam {
+enum : UInt {
+  RatedPower,
+  RatedVoltage,
+  HasDynamics,
+  Rs,
+  Ll,
+  Ld,
+  Lq,
+  Ld_t,
+  Lq_t,
+  Ld_s,
+  Lq_s,
+  Td0_t,
+  Tq0_t,
+  Td0_s,
+  Tq0_s,
+  H,
+  HasGeneratingUnit,
+  HasActivePowerSetPoint,
+  ActivePowerSetPoint,
+  HasVoltageSetPoint,
+  VoltageSetPoint,
+  HasMaximumReactivePower,
+  MaximumReactivePower,
+  Count
+};
+}
+namespace InjectionParam {
+enum : UInt { ControlMode, VoltageSetPoint, Count };
+}
+namespace ShuntParam {
+enum : UInt { G, B, Count };
+}
+
+// Increase when the layout of the extracted data changes
+const UInt SnapshotVersion = 1;
+const char SnapshotMagic[8] = {'D', 'P', 'S', 'I', 'M', 'C', 'I', 'M'};
+
+template <typename T> void writeValue(std::ostream &out, const T &value) {
+  out.write(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+void writeString(std::ostream &out, const String &value) {
+  writeValue<UInt>(out, static_cast<UInt>(value.size()));
+  out.write(value.data(), value.size());
+}
+
+template <typename T> T readValue(std::istream &in) {
+  T value{};
+  in.read(reinterpret_cast<char *>(&value), sizeof(T));
+  if (!in)
+    throw std::runtime_error("unexpected end of snapshot");
+  return value;
+}
+
+String readString(std::istream &in) {
+  String value(readValue<UInt>(in), '\0');
+  in.read(&value[0], value.size());
+  if (!in)
+    throw std::runtime_error("unexpected end of snapshot");
+  return value;
+}
+} // namespace
+
+struct Reader::ModelIndex {
+  /// Base voltages by equipment name from BaseVoltage objects
+  std::unordered_map<String, Real> baseVoltages;
+  /// Base voltages by equipment name from the connected topological nodes
+  std::unordered_map<String, Real> nodeBaseVoltages;
+  /// Last SvTapStep of each tap changer
+  std::unordered_map<CIMPP::TapChanger *, CIMPP::SvTapStep *> tapSteps;
+  /// First dynamic data object by the mRID of the synchronous machine
+  std::unordered_map<String, CIMPP::SynchronousMachineTimeConstantReactance *>
+      machineDynamics;
+  /// First generating unit by the mRID of its rotating machines
+  std::unordered_map<String, CIMPP::GeneratingUnit *> generatingUnits;
+};
+
 Reader::Reader(String name, Logger::Level logLevel,
                Logger::Level componentLogLevel) {
   mSLog = Logger::get(name + "_CIM", logLevel);
@@ -57,6 +158,13 @@ void Reader::useProtectionSwitches(Bool value) {
   mUseProtectionSwitches = value;
 }
 
+// #### loading settings ####
+void Reader::useParallelMapping(Bool value) { mParallelMapping = value; }
+
+void Reader::useSnapshotCache(const fs::path &directory) {
+  mSnapshotDirectory = directory;
+}
+
 Real Reader::unitValue(Real value, CIMPP::UnitMultiplier mult) {
   switch (mult) {
   case UnitMultiplier::p:
@@ -95,31 +203,29 @@ Real Reader::unitValue(Real value, CIMPP::UnitMultiplier mult) {
   return value;
 }
 
-TopologicalPowerComp::Ptr Reader::mapComponent(BaseClass *obj) {
-  if (CIMPP::ACLineSegment *line = dynamic_cast<CIMPP::ACLineSegment *>(obj))
-    return mapACLineSegment(line);
-  if (CIMPP::EnergyConsumer *consumer =
-          dynamic_cast<CIMPP::EnergyConsumer *>(obj))
-    return mapEnergyConsumer(consumer);
-  if (CIMPP::PowerTransformer *trans =
-          dynamic_cast<CIMPP::PowerTransformer *>(obj))
-    return mapPowerTransformer(trans);
-  if (CIMPP::SynchronousMachine *syncMachine =
-          dynamic_cast<CIMPP::SynchronousMachine *>(obj))
-    return mapSynchronousMachine(syncMachine);
-  if (CIMPP::ExternalNetworkInjection *extnet =
-          dynamic_cast<CIMPP::ExternalNetworkInjection *>(obj))
-    return mapExternalNetworkInjection(extnet);
-  if (CIMPP::EquivalentShunt *shunt =
-          dynamic_cast<CIMPP::EquivalentShunt *>(obj))
-    return mapEquivalentShunt(shunt);
+TopologicalPowerComp::Ptr Reader::mapComponent(const EquipmentData &data) {
+  switch (data.type) {
+  case EquipmentType::ACLineSegment:
+    return mapACLineSegment(data);
+  case EquipmentType::EnergyConsumer:
+    return mapEnergyConsumer(data);
+  case EquipmentType::PowerTransformer:
+    return mapPowerTransformer(data);
+  case EquipmentType::SynchronousMachine:
+    return mapSynchronousMachine(data);
+  case EquipmentType::ExternalNetworkInjection:
+    return mapExternalNetworkInjection(data);
+  case EquipmentType::EquivalentShunt:
+    return mapEquivalentShunt(data);
+  }
 
   return nullptr;
 }
 
 void Reader::addFiles(const fs::path &filename) {
+  mFilenames.push_back(filename);
   if (!mModel->addCIMFile(filename.string()))
-    SPDLOG_LOGGER_ERROR(mSLog, "Failed to read file {}", filename);
+    SPDLOG_LOGGER_ERROR(mSLog, "Failed to read file {}", filename.string());
 }
 
 void Reader::addFiles(const std::list<fs::path> &filenames) {
@@ -128,6 +234,17 @@ void Reader::addFiles(const std::list<fs::path> &filenames) {
 }
 
 void Reader::parseFiles() {
+  fs::path snapshot;
+  if (!mSnapshotDirectory.empty()) {
+    snapshot = snapshotPath();
+    if (readSnapshot(snapshot)) {
+      SPDLOG_LOGGER_INFO(mSLog, "Restored CIM data from snapshot {}",
+                         snapshot.string());
+      createComponents();
+      return;
+    }
+  }
+
   try {
     mModel->parseFiles();
   } catch (...) {
@@ -135,56 +252,63 @@ void Reader::parseFiles() {
     return;
   }
 
+  extractModel();
+  if (!snapshot.empty())
+    writeSnapshot(snapshot);
+  createComponents();
+}
+
+void Reader::createComponents() {
+  SPDLOG_LOGGER_INFO(mSLog, "#### Create components");
+  std::vector<TopologicalPowerComp::Ptr> components(mEquipmentData.size());
+  auto mapRange = [this, &components](std::size_t begin, std::size_t end) {
+    for (std::size_t i = begin; i < end; ++i)
+      components[i] = mapComponent(mEquipmentData[i]);
+  };
+
+  // Each component only depends on its own data, so the equipment can be
+  // split into contiguous ranges for the threads
+  std::size_t numThreads = 1;
+  if (mParallelMapping)
+    numThreads = std::max(1U, std::thread::hardware_concurrency());
+  if (numThreads == 1 || components.size() < 2 * numThreads) {
+    mapRange(0, components.size());
+  } else {
+    std::size_t rangeSize = (components.size() + numThreads - 1) / numThreads;
+    std::vector<std::future<void>> ranges;
+    for (std::size_t begin = 0; begin < components.size(); begin += rangeSize)
+      ranges.push_back(
+          std::async(std::launch::async, mapRange, begin,
+                     std::min(components.size(), begin + rangeSize)));
+    // Rethrows the exceptions of the mapping functions
+    for (auto &range : ranges)
+      range.get();
+  }
+
+  for (std::size_t i = 0; i < components.size(); ++i) {
+    if (components[i])
+      mPowerflowEquipment.insert(
+          std::make_pair(mEquipmentData[i].mRID, components[i]));
+  }
+
   SPDLOG_LOGGER_INFO(
       mSLog,
       "#### List of TopologicalNodes, associated Terminals and Equipment");
-  for (auto obj : mModel->Objects) {
-    if (CIMPP::TopologicalNode *topNode =
-            dynamic_cast<CIMPP::TopologicalNode *>(obj)) {
-      if (mDomain == Domain::EMT)
-        processTopologicalNode<Real>(topNode);
-      else
-        processTopologicalNode<Complex>(topNode);
-    }
+  for (auto &node : mNodeData) {
+    if (mDomain == Domain::EMT)
+      processTopologicalNode<Real>(node);
+    else
+      processTopologicalNode<Complex>(node);
   }
 
   // Collect voltage state variables associated to nodes that are used
   // for various components.
   SPDLOG_LOGGER_INFO(mSLog,
                      "#### List of Node voltages and Terminal power flow data");
-  for (auto obj : mModel->Objects) {
-    // Check if object is of class SvVoltage
-    if (CIMPP::SvVoltage *volt = dynamic_cast<CIMPP::SvVoltage *>(obj)) {
-      processSvVoltage(volt);
-    }
-    // Check if object is of class SvPowerFlow
-    else if (CIMPP::SvPowerFlow *flow =
-                 dynamic_cast<CIMPP::SvPowerFlow *>(obj)) {
-      processSvPowerFlow(flow);
-    }
-  }
-
-  SPDLOG_LOGGER_INFO(mSLog, "#### Create other components");
-  for (auto obj : mModel->Objects) {
-
-    // Check if object is not TopologicalNode, SvVoltage or SvPowerFlow
-    if (!dynamic_cast<CIMPP::TopologicalNode *>(obj) &&
-        !dynamic_cast<CIMPP::SvVoltage *>(obj) &&
-        !dynamic_cast<CIMPP::SvPowerFlow *>(obj)) {
-
-      if (CIMPP::IdentifiedObject *idObj =
-              dynamic_cast<CIMPP::IdentifiedObject *>(obj)) {
-
-        // Check if object is already in equipment list
-        if (mPowerflowEquipment.find(idObj->mRID) ==
-            mPowerflowEquipment.end()) {
-          TopologicalPowerComp::Ptr comp = mapComponent(obj);
-          if (comp)
-            mPowerflowEquipment.insert(std::make_pair(comp->uid(), comp));
-        }
-      }
-    }
-  }
+  for (auto &volt : mNodeVoltageData)
+    processNodeVoltage(volt);
+  for (auto &flow : mTerminalPowerData)
+    processTerminalPower(flow);
 
   SPDLOG_LOGGER_INFO(mSLog, "#### Check topology for unconnected components");
   for (auto pfe : mPowerflowEquipment) {
@@ -233,54 +357,563 @@ SystemTopology Reader::loadCIM(Real systemFrequency,
   return systemTopology();
 }
 
-void Reader::processSvVoltage(CIMPP::SvVoltage *volt) {
-  CIMPP::TopologicalNode *node = volt->TopologicalNode;
-  if (!node) {
+void Reader::extractModel() {
+  mIndex = std::make_unique<ModelIndex>();
+  mNodeData.clear();
+  mEquipmentData.clear();
+  mNodeVoltageData.clear();
+  mTerminalPowerData.clear();
+
+  // Sort the objects by type in a single pass, so that the extraction does
+  // not need to search the whole model for associated objects
+  std::vector<CIMPP::TopologicalNode *> topNodes;
+  std::vector<CIMPP::SvVoltage *> volts;
+  std::vector<CIMPP::SvPowerFlow *> flows;
+  std::vector<BaseClass *> equipment;
+  for (auto obj : mModel->Objects) {
+    if (auto topNode = dynamic_cast<CIMPP::TopologicalNode *>(obj)) {
+      topNodes.push_back(topNode);
+      if (!topNode->BaseVoltage)
+        continue;
+      Real baseVoltage =
+          unitValue(topNode->BaseVoltage->nominalVoltage.value,
+                    UnitMultiplier::k);
+      for (auto term : topNode->Terminal) {
+        if (term->ConductingEquipment)
+          mIndex->nodeBaseVoltages[term->ConductingEquipment->name] =
+              baseVoltage;
+      }
+    } else if (auto volt = dynamic_cast<CIMPP::SvVoltage *>(obj)) {
+      volts.push_back(volt);
+    } else if (auto flow = dynamic_cast<CIMPP::SvPowerFlow *>(obj)) {
+      flows.push_back(flow);
+    } else if (auto baseVolt = dynamic_cast<CIMPP::BaseVoltage *>(obj)) {
+      Real baseVoltage =
+          unitValue(baseVolt->nominalVoltage.value, UnitMultiplier::k);
+      for (auto comp : baseVolt->ConductingEquipment)
+        mIndex->baseVoltages[comp->name] = baseVoltage;
+    } else if (auto tapStep = dynamic_cast<CIMPP::SvTapStep *>(obj)) {
+      mIndex->tapSteps[tapStep->TapChanger] = tapStep;
+    } else if (auto genDyn = dynamic_cast<
+                   CIMPP::SynchronousMachineTimeConstantReactance *>(obj)) {
+      if (genDyn->SynchronousMachine)
+        mIndex->machineDynamics.emplace(genDyn->SynchronousMachine->mRID,
+                                        genDyn);
+    } else if (auto genUnit = dynamic_cast<CIMPP::GeneratingUnit *>(obj)) {
+      for (auto syncGen : genUnit->RotatingMachine)
+        mIndex->generatingUnits.emplace(syncGen->mRID, genUnit);
+    } else if (dynamic_cast<CIMPP::ACLineSegment *>(obj) ||
+               dynamic_cast<CIMPP::PowerTransformer *>(obj) ||
+               dynamic_cast<CIMPP::SynchronousMachine *>(obj) ||
+               dynamic_cast<CIMPP::EnergyConsumer *>(obj) ||
+               dynamic_cast<CIMPP::ExternalNetworkInjection *>(obj) ||
+               dynamic_cast<CIMPP::EquivalentShunt *>(obj)) {
+      equipment.push_back(obj);
+    }
+  }
+
+  SPDLOG_LOGGER_INFO(mSLog, "#### Extract CIM data");
+  for (auto topNode : topNodes)
+    mNodeData.push_back(extractTopologicalNode(topNode));
+
+  for (auto obj : equipment) {
+    if (auto line = dynamic_cast<CIMPP::ACLineSegment *>(obj)) {
+      mEquipmentData.push_back(extractACLineSegment(line));
+    } else if (auto trans = dynamic_cast<CIMPP::PowerTransformer *>(obj)) {
+      EquipmentData data;
+      if (extractPowerTransformer(trans, data))
+        mEquipmentData.push_back(data);
+    } else if (auto machine = dynamic_cast<CIMPP::SynchronousMachine *>(obj)) {
+      mEquipmentData.push_back(extractSynchronousMachine(machine));
+    } else if (auto consumer = dynamic_cast<CIMPP::EnergyConsumer *>(obj)) {
+      mEquipmentData.push_back(extractEnergyConsumer(consumer));
+    } else if (auto extnet =
+                   dynamic_cast<CIMPP::ExternalNetworkInjection *>(obj)) {
+      mEquipmentData.push_back(extractExternalNetworkInjection(extnet));
+    } else if (auto shunt = dynamic_cast<CIMPP::EquivalentShunt *>(obj)) {
+      mEquipmentData.push_back(extractEquivalentShunt(shunt));
+    }
+  }
+
+  for (auto volt : volts) {
+    CIMPP::TopologicalNode *node = volt->TopologicalNode;
+    if (!node) {
+      SPDLOG_LOGGER_WARN(
+          mSLog, "SvVoltage references missing Topological Node, ignoring");
+      continue;
+    }
+
+    try {
+      // Reading an uninitialized field throws, which must not depend on the
+      // log level
+      float angle = (float)volt->angle.value;
+      SPDLOG_LOGGER_INFO(mSLog, "    Angle={}", angle);
+    } catch (ReadingUninitializedField *e) {
+      volt->angle.value = 0;
+      std::cerr << "Uninitialized Angle for SVVoltage at " << node->name
+                << ".Setting default value of " << volt->angle.value
+                << std::endl;
+    }
+    mNodeVoltageData.push_back(
+        {node->mRID, unitValue(volt->v.value, UnitMultiplier::k),
+         volt->angle.value * PI / 180});
+  }
+
+  for (auto flow : flows) {
+    if (!flow->Terminal) {
+      SPDLOG_LOGGER_WARN(mSLog,
+                         "SvPowerFlow references missing Terminal, ignoring");
+      continue;
+    }
+    mTerminalPowerData.push_back(
+        {flow->Terminal->mRID,
+         Complex(unitValue(flow->p.value, UnitMultiplier::M),
+                 unitValue(flow->q.value, UnitMultiplier::M))});
+  }
+
+  mIndex.reset();
+}
+
+Reader::NodeData
+Reader::extractTopologicalNode(CIMPP::TopologicalNode *topNode) {
+  NodeData node;
+  node.mRID = topNode->mRID;
+  node.name = topNode->name;
+
+  for (auto term : topNode->Terminal) {
+    TerminalData terminal;
+    terminal.mRID = term->mRID;
+    if (term->sequenceNumber.initialized)
+      terminal.sequenceNumber = term->sequenceNumber;
+    if (term->ConductingEquipment)
+      terminal.equipment = term->ConductingEquipment->mRID;
+    node.terminals.push_back(terminal);
+  }
+
+  return node;
+}
+
+Reader::EquipmentData Reader::extractACLineSegment(CIMPP::ACLineSegment *line) {
+  EquipmentData data{EquipmentType::ACLineSegment, line->mRID, line->name};
+  data.baseVoltage = determineBaseVoltageAssociatedWithEquipment(line);
+  data.params.resize(LineParam::Count);
+  data.params[LineParam::R] = line->r.value;
+  data.params[LineParam::X] = line->x.value;
+  data.params[LineParam::Bch] = line->bch.value;
+  data.params[LineParam::Gch] = line->gch.value;
+  return data;
+}
+
+Bool Reader::extractPowerTransformer(CIMPP::PowerTransformer *trans,
+                                     EquipmentData &data) {
+  if (trans->PowerTransformerEnd.size() != 2) {
+    SPDLOG_LOGGER_WARN(
+        mSLog,
+        "PowerTransformer {} does not have exactly two windings, ignoring",
+        trans->name);
+    return false;
+  }
+  SPDLOG_LOGGER_INFO(mSLog, "Found PowerTransformer {}", trans->name);
+
+  // assign transformer ends
+  CIMPP::PowerTransformerEnd *end1 = nullptr, *end2 = nullptr;
+  for (auto end : trans->PowerTransformerEnd) {
+    if (end->Terminal->sequenceNumber == 1)
+      end1 = end;
+    else if (end->Terminal->sequenceNumber == 2)
+      end2 = end;
+    else
+      return false;
+  }
+  SPDLOG_LOGGER_INFO(mSLog, "    PowerTransformerEnd_1 {}", end1->name);
+  SPDLOG_LOGGER_INFO(mSLog, "    Srated={} Vrated={}",
+                     (float)end1->ratedS.value, (float)end1->ratedU.value);
+  try {
+    float r = (float)end1->r.value;
+    SPDLOG_LOGGER_INFO(mSLog, "       R={}", r);
+  } catch (ReadingUninitializedField *e1) {
+    end1->r.value = 1e-12;
+    SPDLOG_LOGGER_WARN(mSLog,
+                       "       Uninitialized value for PowerTrafoEnd1 setting "
+                       "default value of R={}",
+                       (float)end1->r.value);
+  }
+  try {
+    float x = (float)end1->x.value;
+    SPDLOG_LOGGER_INFO(mSLog, "       X={}", x);
+  } catch (ReadingUninitializedField *e1) {
+    end1->x.value = 1e-12;
+    SPDLOG_LOGGER_WARN(mSLog,
+                       "       Uninitialized value for PowerTrafoEnd1 setting "
+                       "default value of X={}",
+                       (float)end1->x.value);
+  }
+  SPDLOG_LOGGER_INFO(mSLog, "    PowerTransformerEnd_2 {}", end2->name);
+  SPDLOG_LOGGER_INFO(mSLog, "    Srated={} Vrated={}",
+                     (float)end2->ratedS.value, (float)end2->ratedU.value);
+  try {
+    float r = (float)end2->r.value;
+    SPDLOG_LOGGER_INFO(mSLog, "       R={}", r);
+  } catch (ReadingUninitializedField *e1) {
+    end2->r.value = 1e-12;
+    SPDLOG_LOGGER_WARN(mSLog,
+                       "       Uninitialized value for PowerTrafoEnd2 setting "
+                       "default value of R={}",
+                       (float)end2->r.value);
+  }
+  try {
+    float x = (float)end2->x.value;
+    SPDLOG_LOGGER_INFO(mSLog, "       X={}", x);
+  } catch (ReadingUninitializedField *e1) {
+    end2->x.value = 1e-12;
+    SPDLOG_LOGGER_WARN(mSLog,
+                       "       Uninitialized value for PowerTrafoEnd2 setting "
+                       "default value of X={}",
+                       (float)end2->x.value);
+  }
+
+  if (end1->ratedS.value != end2->ratedS.value) {
     SPDLOG_LOGGER_WARN(
-        mSLog, "SvVoltage references missing Topological Node, ignoring");
+        mSLog,
+        "    PowerTransformerEnds of {} come with distinct rated power values. "
+        "Using rated power of PowerTransformerEnd_1.",
+        trans->name);
+  }
+  Real ratedPower = unitValue(end1->ratedS.value, UnitMultiplier::M);
+  Real voltageNode1 = unitValue(end1->ratedU.value, UnitMultiplier::k);
+  Real voltageNode2 = unitValue(end2->ratedU.value, UnitMultiplier::k);
+
+  Real ratioAbsNominal = voltageNode1 / voltageNode2;
+  Real ratioAbs = ratioAbsNominal;
+
+  // use normalStep from RatioTapChanger
+  if (end1->RatioTapChanger) {
+    ratioAbs =
+        voltageNode1 / voltageNode2 *
+        (1 + (end1->RatioTapChanger->normalStep -
+              end1->RatioTapChanger->neutralStep) *
+                 end1->RatioTapChanger->stepVoltageIncrement.value / 100);
+  }
+
+  // if corresponding SvTapStep available, use instead tap position from there
+  if (end1->RatioTapChanger) {
+    auto search = mIndex->tapSteps.find(end1->RatioTapChanger);
+    if (search != mIndex->tapSteps.end()) {
+      auto tapStep = search->second;
+      ratioAbs =
+          voltageNode1 / voltageNode2 *
+          (1 + (tapStep->position - end1->RatioTapChanger->neutralStep) *
+                   end1->RatioTapChanger->stepVoltageIncrement.value / 100);
+    }
+  }
+
+  // Calculate resistance and reactance referred to higher voltage side
+  Real resistance = 0;
+  Real reactance = 0;
+  if (voltageNode1 >= voltageNode2 && abs(end1->x.value) > 1e-12) {
+    reactance = end1->x.value;
+    resistance = end1->r.value;
+  } else if (voltageNode1 >= voltageNode2 && abs(end2->x.value) > 1e-12) {
+    reactance = end2->x.value * std::pow(ratioAbsNominal, 2);
+    resistance = end2->r.value * std::pow(ratioAbsNominal, 2);
+  } else if (voltageNode2 > voltageNode1 && abs(end2->x.value) > 1e-12) {
+    reactance = end2->x.value;
+    resistance = end2->r.value;
+  } else if (voltageNode2 > voltageNode1 && abs(end1->x.value) > 1e-12) {
+    reactance = end1->x.value / std::pow(ratioAbsNominal, 2);
+    resistance = end1->r.value / std::pow(ratioAbsNominal, 2);
+  }
+
+  data = {EquipmentType::PowerTransformer, trans->mRID, trans->name};
+  data.params.resize(TransformerParam::Count);
+  data.params[TransformerParam::RatedPower] = ratedPower;
+  data.params[TransformerParam::VoltageNode1] = voltageNode1;
+  data.params[TransformerParam::VoltageNode2] = voltageNode2;
+  data.params[TransformerParam::RatioAbs] = ratioAbs;
+  data.params[TransformerParam::Resistance] = resistance;
+  data.params[TransformerParam::Reactance] = reactance;
+  return true;
+}
+
+Reader::EquipmentData
+Reader::extractSynchronousMachine(CIMPP::SynchronousMachine *machine) {
+  EquipmentData data{EquipmentType::SynchronousMachine, machine->mRID,
+                     machine->name};
+  auto &p = data.params;
+  p.resize(MachineParam::Count);
+
+  // Not every generator type requires all values, so missing values are
+  // only reported when the component is created
+  try {
+    p[MachineParam::RatedPower] =
+        unitValue(machine->ratedS.value, UnitMultiplier::M);
+    p[MachineParam::RatedVoltage] =
+        unitValue(machine->ratedU.value, UnitMultiplier::k);
+  } catch (ReadingUninitializedField *e) {
+    SPDLOG_LOGGER_WARN(mSLog, "Uninitialized rated values for {}",
+                       machine->name);
+  }
+
+  auto dynamics = mIndex->machineDynamics.find(machine->mRID);
+  if (dynamics != mIndex->machineDynamics.end()) {
+    auto genDyn = dynamics->second;
+    try {
+      p[MachineParam::Rs] = genDyn->statorResistance.value;
+      p[MachineParam::Ll] = genDyn->statorLeakageReactance.value;
+      p[MachineParam::Ld] = genDyn->xDirectSync.value;
+      p[MachineParam::Lq] = genDyn->xQuadSync.value;
+      p[MachineParam::Ld_t] = genDyn->xDirectTrans.value;
+      p[MachineParam::Lq_t] = genDyn->xQuadTrans.value;
+      p[MachineParam::Ld_s] = genDyn->xDirectSubtrans.value;
+      p[MachineParam::Lq_s] = genDyn->xQuadSubtrans.value;
+      p[MachineParam::Td0_t] = genDyn->tpdo.value;
+      p[MachineParam::Tq0_t] = genDyn->tpqo.value;
+      p[MachineParam::Td0_s] = genDyn->tppdo.value;
+      p[MachineParam::Tq0_s] = genDyn->tppqo.value;
+      p[MachineParam::H] = genDyn->inertia.value;
+      p[MachineParam::HasDynamics] = 1;
+    } catch (ReadingUninitializedField *e) {
+      SPDLOG_LOGGER_WARN(mSLog, "Incomplete dynamic data for {}, ignoring",
+                         machine->name);
+    }
+  }
+
+  auto unit = mIndex->generatingUnits.find(machine->mRID);
+  if (unit != mIndex->generatingUnits.end()) {
+    p[MachineParam::HasGeneratingUnit] = 1;
+    try {
+      p[MachineParam::ActivePowerSetPoint] =
+          unitValue(unit->second->initialP.value, UnitMultiplier::M);
+      p[MachineParam::HasActivePowerSetPoint] = 1;
+    } catch (ReadingUninitializedField *e) {
+    }
+    if (machine->RegulatingControl) {
+      p[MachineParam::VoltageSetPoint] =
+          unitValue(machine->RegulatingControl->targetValue.value,
+                    UnitMultiplier::k);
+      p[MachineParam::HasVoltageSetPoint] = 1;
+    }
+    try {
+      p[MachineParam::MaximumReactivePower] =
+          unitValue(machine->maxQ.value, UnitMultiplier::M);
+      p[MachineParam::HasMaximumReactivePower] = 1;
+    } catch (ReadingUninitializedField *e) {
+    }
+  }
+
+  return data;
+}
+
+Reader::EquipmentData
+Reader::extractEnergyConsumer(CIMPP::EnergyConsumer *consumer) {
+  return {EquipmentType::EnergyConsumer, consumer->mRID, consumer->name};
+}
+
+Reader::EquipmentData Reader::extractExternalNetworkInjection(
+    CIMPP::ExternalNetworkInjection *extnet) {
+  EquipmentData data{EquipmentType::ExternalNetworkInjection, extnet->mRID,
+                     extnet->name};
+  data.baseVoltage = determineBaseVoltageAssociatedWithEquipment(extnet);
+  data.params.resize(InjectionParam::Count);
+  try {
+    if (extnet->RegulatingControl) {
+      data.params[InjectionParam::VoltageSetPoint] =
+          extnet->RegulatingControl->targetValue;
+      data.params[InjectionParam::ControlMode] = 1;
+    }
+  } catch (ReadingUninitializedField *e) {
+    data.params[InjectionParam::ControlMode] = 2;
+  }
+  return data;
+}
+
+Reader::EquipmentData
+Reader::extractEquivalentShunt(CIMPP::EquivalentShunt *shunt) {
+  EquipmentData data{EquipmentType::EquivalentShunt, shunt->mRID, shunt->name};
+  data.baseVoltage = determineBaseVoltageAssociatedWithEquipment(shunt);
+  data.params.resize(ShuntParam::Count);
+  data.params[ShuntParam::G] = shunt->g.value;
+  data.params[ShuntParam::B] = shunt->b.value;
+  return data;
+}
+
+fs::path Reader::snapshotPath() {
+  // FNV-1a hash of the contents of all files
+  uint64_t hash = 14695981039346656037ULL;
+  for (auto &filename : mFilenames) {
+    std::ifstream file(filename, std::ios::binary);
+    char buffer[4096];
+    while (file.read(buffer, sizeof(buffer)) || file.gcount() > 0) {
+      for (std::streamsize i = 0; i < file.gcount(); ++i) {
+        hash ^= static_cast<unsigned char>(buffer[i]);
+        hash *= 1099511628211ULL;
+      }
+    }
+  }
+
+  std::stringstream name;
+  name << std::hex << std::setw(16) << std::setfill('0') << hash
+       << ".cimsnapshot";
+  return mSnapshotDirectory / name.str();
+}
+
+void Reader::writeSnapshot(const fs::path &path) {
+  fs::create_directories(path.parent_path());
+
+  // Write to a temporary file first to never leave a partial snapshot
+  fs::path tmpPath = path;
+  tmpPath += ".tmp";
+  std::ofstream out(tmpPath, std::ios::binary);
+  out.write(SnapshotMagic, sizeof(SnapshotMagic));
+  writeValue<UInt>(out, SnapshotVersion);
+
+  writeValue<UInt>(out, static_cast<UInt>(mNodeData.size()));
+  for (auto &node : mNodeData) {
+    writeString(out, node.mRID);
+    writeString(out, node.name);
+    writeValue<UInt>(out, static_cast<UInt>(node.terminals.size()));
+    for (auto &term : node.terminals) {
+      writeString(out, term.mRID);
+      writeValue<Int>(out, term.sequenceNumber);
+      writeString(out, term.equipment);
+    }
+  }
+
+  writeValue<UInt>(out, static_cast<UInt>(mEquipmentData.size()));
+  for (auto &data : mEquipmentData) {
+    writeValue<UInt>(out, static_cast<UInt>(data.type));
+    writeString(out, data.mRID);
+    writeString(out, data.name);
+    writeValue<Real>(out, data.baseVoltage);
+    writeValue<UInt>(out, static_cast<UInt>(data.params.size()));
+    for (auto param : data.params)
+      writeValue<Real>(out, param);
+  }
+
+  writeValue<UInt>(out, static_cast<UInt>(mNodeVoltageData.size()));
+  for (auto &volt : mNodeVoltageData) {
+    writeString(out, volt.node);
+    writeValue<Real>(out, volt.voltageAbs);
+    writeValue<Real>(out, volt.voltagePhase);
+  }
+
+  writeValue<UInt>(out, static_cast<UInt>(mTerminalPowerData.size()));
+  for (auto &flow : mTerminalPowerData) {
+    writeString(out, flow.terminal);
+    writeValue<Real>(out, flow.power.real());
+    writeValue<Real>(out, flow.power.imag());
+  }
+
+  out.close();
+  if (!out) {
+    SPDLOG_LOGGER_WARN(mSLog, "Failed to write snapshot {}", path.string());
+    fs::remove(tmpPath);
     return;
   }
-  auto search = mPowerflowNodes.find(node->mRID);
+  fs::rename(tmpPath, path);
+  SPDLOG_LOGGER_INFO(mSLog, "Stored CIM data in snapshot {}", path.string());
+}
+
+Bool Reader::readSnapshot(const fs::path &path) {
+  std::ifstream in(path, std::ios::binary);
+  if (!in)
+    return false;
+
+  std::vector<NodeData> nodes;
+  std::vector<EquipmentData> equipment;
+  std::vector<NodeVoltageData> volts;
+  std::vector<TerminalPowerData> flows;
+  try {
+    char magic[sizeof(SnapshotMagic)];
+    in.read(magic, sizeof(magic));
+    if (!in || !std::equal(magic, magic + sizeof(magic), SnapshotMagic) ||
+        readValue<UInt>(in) != SnapshotVersion)
+      return false;
+
+    nodes.resize(readValue<UInt>(in));
+    for (auto &node : nodes) {
+      node.mRID = readString(in);
+      node.name = readString(in);
+      node.terminals.resize(readValue<UInt>(in));
+      for (auto &term : node.terminals) {
+        term.mRID = readString(in);
+        term.sequenceNumber = readValue<Int>(in);
+        term.equipment = readString(in);
+      }
+    }
+
+    equipment.resize(readValue<UInt>(in));
+    for (auto &data : equipment) {
+      UInt type = readValue<UInt>(in);
+      if (type > static_cast<UInt>(EquipmentType::EquivalentShunt))
+        return false;
+      data.type = static_cast<EquipmentType>(type);
+      data.mRID = readString(in);
+      data.name = readString(in);
+      data.baseVoltage = readValue<Real>(in);
+      data.params.resize(readValue<UInt>(in));
+      for (auto &param : data.params)
+        param = readValue<Real>(in);
+    }
+
+    volts.resize(readValue<UInt>(in));
+    for (auto &volt : volts) {
+      volt.node = readString(in);
+      volt.voltageAbs = readValue<Real>(in);
+      volt.voltagePhase = readValue<Real>(in);
+    }
+
+    flows.resize(readValue<UInt>(in));
+    for (auto &flow : flows) {
+      flow.terminal = readString(in);
+      Real p = readValue<Real>(in);
+      flow.power = Complex(p, readValue<Real>(in));
+    }
+  } catch (std::exception &e) {
+    SPDLOG_LOGGER_WARN(mSLog, "Ignoring invalid snapshot {}: {}",
+                       path.string(), e.what());
+    return false;
+  }
+
+  mNodeData = std::move(nodes);
+  mEquipmentData = std::move(equipment);
+  mNodeVoltageData = std::move(volts);
+  mTerminalPowerData = std::move(flows);
+  return true;
+}
+
+void Reader::processNodeVoltage(const NodeVoltageData &volt) {
+  auto search = mPowerflowNodes.find(volt.node);
   if (search == mPowerflowNodes.end()) {
     SPDLOG_LOGGER_WARN(mSLog,
                        "SvVoltage references Topological Node {}"
                        " missing from mTopNodes, ignoring",
-                       node->mRID);
+                       volt.node);
     return;
   }
 
-  Real voltageAbs = Reader::unitValue(volt->v.value, UnitMultiplier::k);
+  auto &node = search->second;
+  node->setInitialVoltage(std::polar<Real>(volt.voltageAbs, volt.voltagePhase));
 
-  try {
-    SPDLOG_LOGGER_INFO(mSLog, "    Angle={}", (float)volt->angle.value);
-  } catch (ReadingUninitializedField *e) {
-    volt->angle.value = 0;
-    std::cerr << "Uninitialized Angle for SVVoltage at "
-              << volt->TopologicalNode->name << ".Setting default value of "
-              << volt->angle.value << std::endl;
-  }
-  Real voltagePhase = volt->angle.value * PI / 180;
-  mPowerflowNodes[node->mRID]->setInitialVoltage(
-      std::polar<Real>(voltageAbs, voltagePhase));
-
-  SPDLOG_LOGGER_INFO(
-      mSLog, "Node {} MatrixNodeIndex {}: {} V, {} deg",
-      mPowerflowNodes[node->mRID]->uid(),
-      mPowerflowNodes[node->mRID]->matrixNodeIndex(),
-      std::abs(mPowerflowNodes[node->mRID]->initialSingleVoltage()),
-      std::arg(mPowerflowNodes[node->mRID]->initialSingleVoltage()) * 180 / PI);
+  SPDLOG_LOGGER_INFO(mSLog, "Node {} MatrixNodeIndex {}: {} V, {} deg",
+                     node->uid(), node->matrixNodeIndex(),
+                     std::abs(node->initialSingleVoltage()),
+                     std::arg(node->initialSingleVoltage()) * 180 / PI);
 }
 
-void Reader::processSvPowerFlow(CIMPP::SvPowerFlow *flow) {
-  CIMPP::Terminal *term = flow->Terminal;
+void Reader::processTerminalPower(const TerminalPowerData &flow) {
+  auto search = mPowerflowTerminals.find(flow.terminal);
+  if (search == mPowerflowTerminals.end()) {
+    SPDLOG_LOGGER_WARN(mSLog, "SvPowerFlow references missing Terminal {}",
+                       flow.terminal);
+    return;
+  }
 
-  mPowerflowTerminals[term->mRID]->setPower(
-      Complex(Reader::unitValue(flow->p.value, UnitMultiplier::M),
-              Reader::unitValue(flow->q.value, UnitMultiplier::M)));
+  auto &term = search->second;
+  term->setPower(flow.power);
 
-  SPDLOG_LOGGER_WARN(mSLog, "Terminal {}: {} W + j {} Var", term->mRID,
-                     mPowerflowTerminals[term->mRID]->singleActivePower(),
-                     mPowerflowTerminals[term->mRID]->singleReactivePower());
+  SPDLOG_LOGGER_WARN(mSLog, "Terminal {}: {} W + j {} Var", flow.terminal,
+                     term->singleActivePower(), term->singleReactivePower());
 }
 
 SystemTopology Reader::systemTopology() {
@@ -326,19 +959,19 @@ Matrix::Index Reader::mapTopologicalNode(String mrid) {
 }
 
 TopologicalPowerComp::Ptr
-Reader::mapEnergyConsumer(CIMPP::EnergyConsumer *consumer) {
-  SPDLOG_LOGGER_INFO(mSLog, "    Found EnergyConsumer {}", consumer->name);
+Reader::mapEnergyConsumer(const EquipmentData &consumer) {
+  SPDLOG_LOGGER_INFO(mSLog, "    Found EnergyConsumer {}", consumer.name);
   if (mDomain == Domain::EMT) {
     if (mPhase == PhaseType::ABC) {
-      return std::make_shared<EMT::Ph3::RXLoad>(consumer->mRID, consumer->name,
+      return std::make_shared<EMT::Ph3::RXLoad>(consumer.mRID, consumer.name,
                                                 mComponentLogLevel);
     } else {
       SPDLOG_LOGGER_INFO(mSLog, "    RXLoad for EMT not implemented yet");
-      return std::make_shared<DP::Ph1::RXLoad>(consumer->mRID, consumer->name,
+      return std::make_shared<DP::Ph1::RXLoad>(consumer.mRID, consumer.name,
                                                mComponentLogLevel);
     }
   } else if (mDomain == Domain::SP) {
-    auto load = std::make_shared<SP::Ph1::Load>(consumer->mRID, consumer->name,
+    auto load = std::make_shared<SP::Ph1::Load>(consumer.mRID, consumer.name,
                                                 mComponentLogLevel);
 
     // P and Q values will be set according to SvPowerFlow data
@@ -349,34 +982,36 @@ Reader::mapEnergyConsumer(CIMPP::EnergyConsumer *consumer) {
   } else {
     if (mUseProtectionSwitches)
       return std::make_shared<DP::Ph1::RXLoadSwitch>(
-          consumer->mRID, consumer->name, mComponentLogLevel);
+          consumer.mRID, consumer.name, mComponentLogLevel);
     else
-      return std::make_shared<DP::Ph1::RXLoad>(consumer->mRID, consumer->name,
+      return std::make_shared<DP::Ph1::RXLoad>(consumer.mRID, consumer.name,
                                                mComponentLogLevel);
   }
 }
 
-TopologicalPowerComp::Ptr Reader::mapACLineSegment(CIMPP::ACLineSegment *line) {
+TopologicalPowerComp::Ptr
+Reader::mapACLineSegment(const EquipmentData &line) {
+  const auto &p = line.params;
   SPDLOG_LOGGER_INFO(mSLog,
                      "    Found ACLineSegment {} r={} x={} bch={} gch={}",
-                     line->name, (float)line->r.value, (float)line->x.value,
-                     (float)line->bch.value, (float)line->gch.value);
+                     line.name, (float)p[LineParam::R], (float)p[LineParam::X],
+                     (float)p[LineParam::Bch], (float)p[LineParam::Gch]);
 
-  Real resistance = line->r.value;
-  Real inductance = line->x.value / mOmega;
+  Real resistance = p[LineParam::R];
+  Real inductance = p[LineParam::X] / mOmega;
 
   // By default there is always a small conductance to ground to
   // avoid problems with floating nodes.
   Real capacitance = mShuntCapacitorValue;
   Real conductance = mShuntConductanceValue;
 
-  if (line->bch.value > 1e-9 && !mSetShuntCapacitor)
-    capacitance = Real(line->bch.value / mOmega);
+  if (p[LineParam::Bch] > 1e-9 && !mSetShuntCapacitor)
+    capacitance = Real(p[LineParam::Bch] / mOmega);
 
-  if (line->gch.value > 1e-9 && !mSetShuntConductance)
-    conductance = Real(line->gch.value);
+  if (p[LineParam::Gch] > 1e-9 && !mSetShuntConductance)
+    conductance = Real(p[LineParam::Gch]);
 
-  Real baseVoltage = determineBaseVoltageAssociatedWithEquipment(line);
+  Real baseVoltage = line.baseVoltage;
 
   if (mDomain == Domain::EMT) {
     if (mPhase == PhaseType::ABC) {
@@ -386,25 +1021,25 @@ TopologicalPowerComp::Ptr Reader::mapACLineSegment(CIMPP::ACLineSegment *line) {
       Matrix cond_3ph =
           CPS::Math::singlePhaseParameterToThreePhase(conductance);
 
-      auto cpsLine = std::make_shared<EMT::Ph3::PiLine>(line->mRID, line->name,
+      auto cpsLine = std::make_shared<EMT::Ph3::PiLine>(line.mRID, line.name,
                                                         mComponentLogLevel);
       cpsLine->setParameters(res_3ph, ind_3ph, cap_3ph, cond_3ph);
       return cpsLine;
     } else {
       SPDLOG_LOGGER_INFO(mSLog, "    PiLine for EMT not implemented yet");
-      auto cpsLine = std::make_shared<DP::Ph1::PiLine>(line->mRID, line->name,
+      auto cpsLine = std::make_shared<DP::Ph1::PiLine>(line.mRID, line.name,
                                                        mComponentLogLevel);
       cpsLine->setParameters(resistance, inductance, capacitance, conductance);
       return cpsLine;
     }
   } else if (mDomain == Domain::SP) {
-    auto cpsLine = std::make_shared<SP::Ph1::PiLine>(line->mRID, line->name,
+    auto cpsLine = std::make_shared<SP::Ph1::PiLine>(line.mRID, line.name,
                                                      mComponentLogLevel);
     cpsLine->setParameters(resistance, inductance, capacitance, conductance);
     cpsLine->setBaseVoltage(baseVoltage);
     return cpsLine;
   } else {
-    auto cpsLine = std::make_shared<DP::Ph1::PiLine>(line->mRID, line->name,
+    auto cpsLine = std::make_shared<DP::Ph1::PiLine>(line.mRID, line.name,
                                                      mComponentLogLevel);
     cpsLine->setParameters(resistance, inductance, capacitance, conductance);
     return cpsLine;
@@ -412,126 +1047,19 @@ TopologicalPowerComp::Ptr Reader::mapACLineSegment(CIMPP::ACLineSegment *line) {
 }
 
 TopologicalPowerComp::Ptr
-Reader::mapPowerTransformer(CIMPP::PowerTransformer *trans) {
-  if (trans->PowerTransformerEnd.size() != 2) {
-    SPDLOG_LOGGER_WARN(
-        mSLog,
-        "PowerTransformer {} does not have exactly two windings, ignoring",
-        trans->name);
-    return nullptr;
-  }
-  SPDLOG_LOGGER_INFO(mSLog, "Found PowerTransformer {}", trans->name);
-
-  // assign transformer ends
-  CIMPP::PowerTransformerEnd *end1 = nullptr, *end2 = nullptr;
-  for (auto end : trans->PowerTransformerEnd) {
-    if (end->Terminal->sequenceNumber == 1)
-      end1 = end;
-    else if (end->Terminal->sequenceNumber == 2)
-      end2 = end;
-    else
-      return nullptr;
-  }
-
-  // setting default values for non-set resistances and reactances
-  SPDLOG_LOGGER_INFO(mSLog, "    PowerTransformerEnd_1 {}", end1->name);
-  SPDLOG_LOGGER_INFO(mSLog, "    Srated={} Vrated={}",
-                     (float)end1->ratedS.value, (float)end1->ratedU.value);
-  try {
-    SPDLOG_LOGGER_INFO(mSLog, "       R={}", (float)end1->r.value);
-  } catch (ReadingUninitializedField *e1) {
-    end1->r.value = 1e-12;
-    SPDLOG_LOGGER_WARN(mSLog,
-                       "       Uninitialized value for PowerTrafoEnd1 setting "
-                       "default value of R={}",
-                       (float)end1->r.value);
-  }
-  try {
-    SPDLOG_LOGGER_INFO(mSLog, "       X={}", (float)end1->x.value);
-  } catch (ReadingUninitializedField *e1) {
-    end1->x.value = 1e-12;
-    SPDLOG_LOGGER_WARN(mSLog,
-                       "       Uninitialized value for PowerTrafoEnd1 setting "
-                       "default value of X={}",
-                       (float)end1->x.value);
-  }
-  SPDLOG_LOGGER_INFO(mSLog, "    PowerTransformerEnd_2 {}", end2->name);
-  SPDLOG_LOGGER_INFO(mSLog, "    Srated={} Vrated={}",
-                     (float)end2->ratedS.value, (float)end2->ratedU.value);
-  try {
-    SPDLOG_LOGGER_INFO(mSLog, "       R={}", (float)end2->r.value);
-  } catch (ReadingUninitializedField *e1) {
-    end2->r.value = 1e-12;
-    SPDLOG_LOGGER_WARN(mSLog,
-                       "       Uninitialized value for PowerTrafoEnd2 setting "
-                       "default value of R={}",
-                       (float)end2->r.value);
-  }
-  try {
-    SPDLOG_LOGGER_INFO(mSLog, "       X={}", (float)end2->x.value);
-  } catch (ReadingUninitializedField *e1) {
-    end2->x.value = 1e-12;
-    SPDLOG_LOGGER_WARN(mSLog,
-                       "       Uninitialized value for PowerTrafoEnd2 setting "
-                       "default value of X={}",
-                       (float)end2->x.value);
-  }
-
-  if (end1->ratedS.value != end2->ratedS.value) {
-    SPDLOG_LOGGER_WARN(
-        mSLog,
-        "    PowerTransformerEnds of {} come with distinct rated power values. "
-        "Using rated power of PowerTransformerEnd_1.",
-        trans->name);
-  }
-  Real ratedPower = unitValue(end1->ratedS.value, UnitMultiplier::M);
-  Real voltageNode1 = unitValue(end1->ratedU.value, UnitMultiplier::k);
-  Real voltageNode2 = unitValue(end2->ratedU.value, UnitMultiplier::k);
-
-  Real ratioAbsNominal = voltageNode1 / voltageNode2;
-  Real ratioAbs = ratioAbsNominal;
-
-  // use normalStep from RatioTapChanger
-  if (end1->RatioTapChanger) {
-    ratioAbs =
-        voltageNode1 / voltageNode2 *
-        (1 + (end1->RatioTapChanger->normalStep -
-              end1->RatioTapChanger->neutralStep) *
-                 end1->RatioTapChanger->stepVoltageIncrement.value / 100);
-  }
-
-  // if corresponding SvTapStep available, use instead tap position from there
-  if (end1->RatioTapChanger) {
-    for (auto obj : mModel->Objects) {
-      auto tapStep = dynamic_cast<CIMPP::SvTapStep *>(obj);
-      if (tapStep && tapStep->TapChanger == end1->RatioTapChanger) {
-        ratioAbs =
-            voltageNode1 / voltageNode2 *
-            (1 + (tapStep->position - end1->RatioTapChanger->neutralStep) *
-                     end1->RatioTapChanger->stepVoltageIncrement.value / 100);
-      }
-    }
-  }
+Reader::mapPowerTransformer(const EquipmentData &trans) {
+  const auto &p = trans.params;
+  Real ratedPower = p[TransformerParam::RatedPower];
+  Real voltageNode1 = p[TransformerParam::VoltageNode1];
+  Real voltageNode2 = p[TransformerParam::VoltageNode2];
+  Real ratioAbs = p[TransformerParam::RatioAbs];
 
   // TODO: To be extracted from cim class
   Real ratioPhase = 0;
 
-  // Calculate resistance and inductance referred to higher voltage side
-  Real resistance = 0;
-  Real inductance = 0;
-  if (voltageNode1 >= voltageNode2 && abs(end1->x.value) > 1e-12) {
-    inductance = end1->x.value / mOmega;
-    resistance = end1->r.value;
-  } else if (voltageNode1 >= voltageNode2 && abs(end2->x.value) > 1e-12) {
-    inductance = end2->x.value / mOmega * std::pow(ratioAbsNominal, 2);
-    resistance = end2->r.value * std::pow(ratioAbsNominal, 2);
-  } else if (voltageNode2 > voltageNode1 && abs(end2->x.value) > 1e-12) {
-    inductance = end2->x.value / mOmega;
-    resistance = end2->r.value;
-  } else if (voltageNode2 > voltageNode1 && abs(end1->x.value) > 1e-12) {
-    inductance = end1->x.value / mOmega / std::pow(ratioAbsNominal, 2);
-    resistance = end1->r.value / std::pow(ratioAbsNominal, 2);
-  }
+  // Resistance and inductance referred to higher voltage side
+  Real resistance = p[TransformerParam::Resistance];
+  Real inductance = p[TransformerParam::Reactance] / mOmega;
 
   if (mDomain == Domain::EMT) {
     if (mPhase == PhaseType::ABC) {
@@ -541,7 +1069,7 @@ Reader::mapPowerTransformer(CIMPP::PowerTransformer *trans) {
           CPS::Math::singlePhaseParameterToThreePhase(inductance);
       Bool withResistiveLosses = resistance > 0;
       auto transformer = std::make_shared<EMT::Ph3::Transformer>(
-          trans->mRID, trans->name, mComponentLogLevel, withResistiveLosses);
+          trans.mRID, trans.name, mComponentLogLevel, withResistiveLosses);
       transformer->setParameters(voltageNode1, voltageNode2, ratedPower,
                                  ratioAbs, ratioPhase, resistance_3ph,
                                  inductance_3ph);
@@ -552,7 +1080,7 @@ Reader::mapPowerTransformer(CIMPP::PowerTransformer *trans) {
     }
   } else if (mDomain == Domain::SP) {
     auto transformer = std::make_shared<SP::Ph1::Transformer>(
-        trans->mRID, trans->name, mComponentLogLevel);
+        trans.mRID, trans.name, mComponentLogLevel);
     transformer->setParameters(voltageNode1, voltageNode2, ratedPower, ratioAbs,
                                ratioPhase, resistance, inductance);
     Real baseVolt = voltageNode1 >= voltageNode2 ? voltageNode1 : voltageNode2;
@@ -561,7 +1089,7 @@ Reader::mapPowerTransformer(CIMPP::PowerTransformer *trans) {
   } else {
     Bool withResistiveLosses = resistance > 0;
     auto transformer = std::make_shared<DP::Ph1::Transformer>(
-        trans->mRID, trans->name, mComponentLogLevel, withResistiveLosses);
+        trans.mRID, trans.name, mComponentLogLevel, withResistiveLosses);
     transformer->setParameters(voltageNode1, voltageNode2, ratedPower, ratioAbs,
                                ratioPhase, resistance, inductance);
     return transformer;
@@ -569,8 +1097,8 @@ Reader::mapPowerTransformer(CIMPP::PowerTransformer *trans) {
 }
 
 TopologicalPowerComp::Ptr
-Reader::mapSynchronousMachine(CIMPP::SynchronousMachine *machine) {
-  SPDLOG_LOGGER_INFO(mSLog, "    Found  Synchronous machine {}", machine->name);
+Reader::mapSynchronousMachine(const EquipmentData &machine) {
+  SPDLOG_LOGGER_INFO(mSLog, "    Found  Synchronous machine {}", machine.name);
 
   if (mDomain == Domain::DP) {
     SPDLOG_LOGGER_INFO(mSLog, "    Create generator in DP domain.");
@@ -583,128 +1111,121 @@ Reader::mapSynchronousMachine(CIMPP::SynchronousMachine *machine) {
         mGeneratorType == GeneratorType::SG4OrderTPM ||
         mGeneratorType == GeneratorType::SG6OrderPCM) {
 
-      Real ratedPower = unitValue(machine->ratedS.value, UnitMultiplier::M);
-      Real ratedVoltage = unitValue(machine->ratedU.value, UnitMultiplier::k);
-
-      for (auto obj : mModel->Objects) {
-        // Check if object is not TopologicalNode, SvVoltage or SvPowerFlow
-        if (CIMPP::SynchronousMachineTimeConstantReactance *genDyn =
-                dynamic_cast<CIMPP::SynchronousMachineTimeConstantReactance *>(
-                    obj)) {
-          if (genDyn->SynchronousMachine->mRID == machine->mRID) {
-            // stator
-            Real Rs = genDyn->statorResistance.value;
-            Real Ll = genDyn->statorLeakageReactance.value;
-
-            // reactances
-            Real Ld = genDyn->xDirectSync.value;
-            Real Lq = genDyn->xQuadSync.value;
-            Real Ld_t = genDyn->xDirectTrans.value;
-            Real Lq_t = genDyn->xQuadTrans.value;
-            Real Ld_s = genDyn->xDirectSubtrans.value;
-            Real Lq_s = genDyn->xQuadSubtrans.value;
-
-            // time constants
-            Real Td0_t = genDyn->tpdo.value;
-            Real Tq0_t = genDyn->tpqo.value;
-            Real Td0_s = genDyn->tppdo.value;
-            Real Tq0_s = genDyn->tppqo.value;
-
-            // inertia
-            Real H = genDyn->inertia.value;
-
-            // not available in CIM -> set to 0, as actually no impact on machine equations
-            Int poleNum = 0;
-            Real nomFieldCurr = 0;
-
-            if (mGeneratorType == GeneratorType::TransientStability) {
-              SPDLOG_LOGGER_DEBUG(mSLog,
-                                  "    GeneratorType is TransientStability.");
-              auto gen = DP::Ph1::SynchronGeneratorTrStab::make(
-                  machine->mRID, machine->name, mComponentLogLevel);
-              gen->setStandardParametersPU(ratedPower, ratedVoltage, mFrequency,
-                                           Ld_t, H);
-              return gen;
-            } else if (mGeneratorType == GeneratorType::SG6aOrderVBR) {
-              SPDLOG_LOGGER_DEBUG(
-                  mSLog, "    GeneratorType is SynchronGenerator6aOrderVBR.");
-              auto gen = std::make_shared<DP::Ph1::SynchronGenerator6aOrderVBR>(
-                  machine->mRID, machine->name, mComponentLogLevel);
-              gen->setOperationalParametersPerUnit(
-                  ratedPower, ratedVoltage, mFrequency, H, Ld, Lq, Ll, Ld_t,
-                  Lq_t, Td0_t, Tq0_t, Ld_s, Lq_s, Td0_s, Tq0_s);
-              return gen;
-            } else if (mGeneratorType == GeneratorType::SG6bOrderVBR) {
-              SPDLOG_LOGGER_DEBUG(
-                  mSLog, "    GeneratorType is SynchronGenerator6bOrderVBR.");
-              auto gen = std::make_shared<DP::Ph1::SynchronGenerator6bOrderVBR>(
-                  machine->mRID, machine->name, mComponentLogLevel);
-              gen->setOperationalParametersPerUnit(
-                  ratedPower, ratedVoltage, mFrequency, H, Ld, Lq, Ll, Ld_t,
-                  Lq_t, Td0_t, Tq0_t, Ld_s, Lq_s, Td0_s, Tq0_s);
-              return gen;
-            } else if (mGeneratorType == GeneratorType::SG5OrderVBR) {
-              SPDLOG_LOGGER_DEBUG(
-                  mSLog, "    GeneratorType is SynchronGenerator5OrderVBR.");
-              auto gen = std::make_shared<DP::Ph1::SynchronGenerator5OrderVBR>(
-                  machine->mRID, machine->name, mComponentLogLevel);
-              gen->setOperationalParametersPerUnit(
-                  ratedPower, ratedVoltage, mFrequency, H, Ld, Lq, Ll, Ld_t,
-                  Lq_t, Td0_t, Tq0_t, Ld_s, Lq_s, Td0_s, Tq0_s, 0.0);
-              return gen;
-            } else if (mGeneratorType == GeneratorType::SG4OrderVBR) {
-              SPDLOG_LOGGER_DEBUG(
-                  mSLog, "    GeneratorType is SynchronGenerator4OrderVBR.");
-              auto gen = std::make_shared<DP::Ph1::SynchronGenerator4OrderVBR>(
-                  machine->mRID, machine->name, mComponentLogLevel);
-              gen->setOperationalParametersPerUnit(ratedPower, ratedVoltage,
-                                                   mFrequency, H, Ld, Lq, Ll,
-                                                   Ld_t, Lq_t, Td0_t, Tq0_t);
-              return gen;
-            } else if (mGeneratorType == GeneratorType::SG3OrderVBR) {
-              SPDLOG_LOGGER_DEBUG(
-                  mSLog, "    GeneratorType is SynchronGenerator3OrderVBR.");
-              auto gen = std::make_shared<DP::Ph1::SynchronGenerator3OrderVBR>(
-                  machine->mRID, machine->name, mComponentLogLevel);
-              gen->setOperationalParametersPerUnit(ratedPower, ratedVoltage,
-                                                   mFrequency, H, Ld, Lq, Ll,
-                                                   Ld_t, Td0_t);
-              return gen;
-            } else if (mGeneratorType == GeneratorType::SG4OrderPCM) {
-              SPDLOG_LOGGER_DEBUG(
-                  mSLog, "    GeneratorType is SynchronGenerator4OrderPCM.");
-              auto gen = std::make_shared<DP::Ph1::SynchronGenerator4OrderPCM>(
-                  machine->mRID, machine->name, mComponentLogLevel);
-              gen->setOperationalParametersPerUnit(ratedPower, ratedVoltage,
-                                                   mFrequency, H, Ld, Lq, Ll,
-                                                   Ld_t, Lq_t, Td0_t, Tq0_t);
-              return gen;
-            } else if (mGeneratorType == GeneratorType::SG4OrderTPM) {
-              SPDLOG_LOGGER_DEBUG(
-                  mSLog, "    GeneratorType is SynchronGenerator4OrderTPM.");
-              auto gen = std::make_shared<DP::Ph1::SynchronGenerator4OrderTPM>(
-                  machine->mRID, machine->name, mComponentLogLevel);
-              gen->setOperationalParametersPerUnit(ratedPower, ratedVoltage,
-                                                   mFrequency, H, Ld, Lq, Ll,
-                                                   Ld_t, Lq_t, Td0_t, Tq0_t);
-              return gen;
-            } else if (mGeneratorType == GeneratorType::SG6OrderPCM) {
-              SPDLOG_LOGGER_DEBUG(
-                  mSLog, "    GeneratorType is SynchronGenerator6OrderPCM.");
-              auto gen = std::make_shared<DP::Ph1::SynchronGenerator6OrderPCM>(
-                  machine->mRID, machine->name, mComponentLogLevel);
-              gen->setOperationalParametersPerUnit(
-                  ratedPower, ratedVoltage, mFrequency, H, Ld, Lq, Ll, Ld_t,
-                  Lq_t, Td0_t, Tq0_t, Ld_s, Lq_s, Td0_s, Tq0_s);
-              return gen;
-            }
-          }
+      const auto &p = machine.params;
+      Real ratedPower = p[MachineParam::RatedPower];
+      Real ratedVoltage = p[MachineParam::RatedVoltage];
+
+      if (p[MachineParam::HasDynamics] != 0) {
+        // stator
+        Real Rs = p[MachineParam::Rs];
+        Real Ll = p[MachineParam::Ll];
+
+        // reactances
+        Real Ld = p[MachineParam::Ld];
+        Real Lq = p[MachineParam::Lq];
+        Real Ld_t = p[MachineParam::Ld_t];
+        Real Lq_t = p[MachineParam::Lq_t];
+        Real Ld_s = p[MachineParam::Ld_s];
+        Real Lq_s = p[MachineParam::Lq_s];
+
+        // time constants
+        Real Td0_t = p[MachineParam::Td0_t];
+        Real Tq0_t = p[MachineParam::Tq0_t];
+        Real Td0_s = p[MachineParam::Td0_s];
+        Real Tq0_s = p[MachineParam::Tq0_s];
+
+        // inertia
+        Real H = p[MachineParam::H];
+
+        // not available in CIM -> set to 0, as actually no impact on machine equations
+        Int poleNum = 0;
+        Real nomFieldCurr = 0;
+
+        if (mGeneratorType == GeneratorType::TransientStability) {
+          SPDLOG_LOGGER_DEBUG(mSLog,
+                              "    GeneratorType is TransientStability.");
+          auto gen = DP::Ph1::SynchronGeneratorTrStab::make(
+              machine.mRID, machine.name, mComponentLogLevel);
+          gen->setStandardParametersPU(ratedPower, ratedVoltage, mFrequency,
+                                       Ld_t, H);
+          return gen;
+        } else if (mGeneratorType == GeneratorType::SG6aOrderVBR) {
+          SPDLOG_LOGGER_DEBUG(
+              mSLog, "    GeneratorType is SynchronGenerator6aOrderVBR.");
+          auto gen = std::make_shared<DP::Ph1::SynchronGenerator6aOrderVBR>(
+              machine.mRID, machine.name, mComponentLogLevel);
+          gen->setOperationalParametersPerUnit(
+              ratedPower, ratedVoltage, mFrequency, H, Ld, Lq, Ll, Ld_t, Lq_t,
+              Td0_t, Tq0_t, Ld_s, Lq_s, Td0_s, Tq0_s);
+          return gen;
+        } else if (mGeneratorType == GeneratorType::SG6bOrderVBR) {
+          SPDLOG_LOGGER_DEBUG(
+              mSLog, "    GeneratorType is SynchronGenerator6bOrderVBR.");
+          auto gen = std::make_shared<DP::Ph1::SynchronGenerator6bOrderVBR>(
+              machine.mRID, machine.name, mComponentLogLevel);
+          gen->setOperationalParametersPerUnit(
+              ratedPower, ratedVoltage, mFrequency, H, Ld, Lq, Ll, Ld_t, Lq_t,
+              Td0_t, Tq0_t, Ld_s, Lq_s, Td0_s, Tq0_s);
+          return gen;
+        } else if (mGeneratorType == GeneratorType::SG5OrderVBR) {
+          SPDLOG_LOGGER_DEBUG(
+              mSLog, "    GeneratorType is SynchronGenerator5OrderVBR.");
+          auto gen = std::make_shared<DP::Ph1::SynchronGenerator5OrderVBR>(
+              machine.mRID, machine.name, mComponentLogLevel);
+          gen->setOperationalParametersPerUnit(
+              ratedPower, ratedVoltage, mFrequency, H, Ld, Lq, Ll, Ld_t, Lq_t,
+              Td0_t, Tq0_t, Ld_s, Lq_s, Td0_s, Tq0_s, 0.0);
+          return gen;
+        } else if (mGeneratorType == GeneratorType::SG4OrderVBR) {
+          SPDLOG_LOGGER_DEBUG(
+              mSLog, "    GeneratorType is SynchronGenerator4OrderVBR.");
+          auto gen = std::make_shared<DP::Ph1::SynchronGenerator4OrderVBR>(
+              machine.mRID, machine.name, mComponentLogLevel);
+          gen->setOperationalParametersPerUnit(ratedPower, ratedVoltage,
+                                               mFrequency, H, Ld, Lq, Ll, Ld_t,
+                                               Lq_t, Td0_t, Tq0_t);
+          return gen;
+        } else if (mGeneratorType == GeneratorType::SG3OrderVBR) {
+          SPDLOG_LOGGER_DEBUG(
+              mSLog, "    GeneratorType is SynchronGenerator3OrderVBR.");
+          auto gen = std::make_shared<DP::Ph1::SynchronGenerator3OrderVBR>(
+              machine.mRID, machine.name, mComponentLogLevel);
+          gen->setOperationalParametersPerUnit(
+              ratedPower, ratedVoltage, mFrequency, H, Ld, Lq, Ll, Ld_t, Td0_t);
+          return gen;
+        } else if (mGeneratorType == GeneratorType::SG4OrderPCM) {
+          SPDLOG_LOGGER_DEBUG(
+              mSLog, "    GeneratorType is SynchronGenerator4OrderPCM.");
+          auto gen = std::make_shared<DP::Ph1::SynchronGenerator4OrderPCM>(
+              machine.mRID, machine.name, mComponentLogLevel);
+          gen->setOperationalParametersPerUnit(ratedPower, ratedVoltage,
+                                               mFrequency, H, Ld, Lq, Ll, Ld_t,
+                                               Lq_t, Td0_t, Tq0_t);
+          return gen;
+        } else if (mGeneratorType == GeneratorType::SG4OrderTPM) {
+          SPDLOG_LOGGER_DEBUG(
+              mSLog, "    GeneratorType is SynchronGenerator4OrderTPM.");
+          auto gen = std::make_shared<DP::Ph1::SynchronGenerator4OrderTPM>(
+              machine.mRID, machine.name, mComponentLogLevel);
+          gen->setOperationalParametersPerUnit(ratedPower, ratedVoltage,
+                                               mFrequency, H, Ld, Lq, Ll, Ld_t,
+                                               Lq_t, Td0_t, Tq0_t);
+          return gen;
+        } else if (mGeneratorType == GeneratorType::SG6OrderPCM) {
+          SPDLOG_LOGGER_DEBUG(
+              mSLog, "    GeneratorType is SynchronGenerator6OrderPCM.");
+          auto gen = std::make_shared<DP::Ph1::SynchronGenerator6OrderPCM>(
+              machine.mRID, machine.name, mComponentLogLevel);
+          gen->setOperationalParametersPerUnit(
+              ratedPower, ratedVoltage, mFrequency, H, Ld, Lq, Ll, Ld_t, Lq_t,
+              Td0_t, Tq0_t, Ld_s, Lq_s, Td0_s, Tq0_s);
+          return gen;
         }
       }
     } else if (mGeneratorType == GeneratorType::IdealVoltageSource) {
       SPDLOG_LOGGER_DEBUG(mSLog, "    GeneratorType is IdealVoltageSource.");
       return std::make_shared<DP::Ph1::SynchronGeneratorIdeal>(
-          machine->mRID, machine->name, mComponentLogLevel);
+          machine.mRID, machine.name, mComponentLogLevel);
     } else if (mGeneratorType == GeneratorType::None) {
       throw SystemError("GeneratorType is None. Specify!");
     } else {
@@ -719,159 +1240,137 @@ Reader::mapSynchronousMachine(CIMPP::SynchronousMachine *machine) {
         mGeneratorType == GeneratorType::SG4OrderVBR ||
         mGeneratorType == GeneratorType::SG3OrderVBR) {
 
-      Real ratedPower = unitValue(machine->ratedS.value, UnitMultiplier::M);
-      Real ratedVoltage = unitValue(machine->ratedU.value, UnitMultiplier::k);
-
-      for (auto obj : mModel->Objects) {
-        // Check if object is not TopologicalNode, SvVoltage or SvPowerFlow
-        if (CIMPP::SynchronousMachineTimeConstantReactance *genDyn =
-                dynamic_cast<CIMPP::SynchronousMachineTimeConstantReactance *>(
-                    obj)) {
-          if (genDyn->SynchronousMachine->mRID == machine->mRID) {
-            // stator
-            Real Rs = genDyn->statorResistance.value;
-            Real Ll = genDyn->statorLeakageReactance.value;
-
-            // reactances
-            Real Ld = genDyn->xDirectSync.value;
-            Real Lq = genDyn->xQuadSync.value;
-            Real Ld_t = genDyn->xDirectTrans.value;
-            Real Lq_t = genDyn->xQuadTrans.value;
-            Real Ld_s = genDyn->xDirectSubtrans.value;
-            Real Lq_s = genDyn->xQuadSubtrans.value;
-
-            // time constants
-            Real Td0_t = genDyn->tpdo.value;
-            Real Tq0_t = genDyn->tpqo.value;
-            Real Td0_s = genDyn->tppdo.value;
-            Real Tq0_s = genDyn->tppqo.value;
-
-            // inertia
-            Real H = genDyn->inertia.value;
-
-            // not available in CIM -> set to 0, as actually no impact on machine equations
-            Int poleNum = 0;
-            Real nomFieldCurr = 0;
-
-            if (mGeneratorType == GeneratorType::TransientStability) {
-              SPDLOG_LOGGER_DEBUG(mSLog,
-                                  "    GeneratorType is TransientStability.");
-              auto gen = SP::Ph1::SynchronGeneratorTrStab::make(
-                  machine->mRID, machine->name, mComponentLogLevel);
-              gen->setStandardParametersPU(ratedPower, ratedVoltage, mFrequency,
-                                           Ld_t, H);
-              return gen;
-            } else if (mGeneratorType == GeneratorType::SG6aOrderVBR) {
-              SPDLOG_LOGGER_DEBUG(
-                  mSLog, "    GeneratorType is SynchronGenerator6aOrderVBR.");
-              auto gen = std::make_shared<SP::Ph1::SynchronGenerator6aOrderVBR>(
-                  machine->mRID, machine->name, mComponentLogLevel);
-              gen->setOperationalParametersPerUnit(
-                  ratedPower, ratedVoltage, mFrequency, H, Ld, Lq, Ll, Ld_t,
-                  Lq_t, Td0_t, Tq0_t, Ld_s, Lq_s, Td0_s, Tq0_s);
-              return gen;
-            } else if (mGeneratorType == GeneratorType::SG6bOrderVBR) {
-              SPDLOG_LOGGER_DEBUG(
-                  mSLog, "    GeneratorType is SynchronGenerator6bOrderVBR.");
-              auto gen = std::make_shared<SP::Ph1::SynchronGenerator6bOrderVBR>(
-                  machine->mRID, machine->name, mComponentLogLevel);
-              gen->setOperationalParametersPerUnit(
-                  ratedPower, ratedVoltage, mFrequency, H, Ld, Lq, Ll, Ld_t,
-                  Lq_t, Td0_t, Tq0_t, Ld_s, Lq_s, Td0_s, Tq0_s);
-              return gen;
-            } else if (mGeneratorType == GeneratorType::SG5OrderVBR) {
-              SPDLOG_LOGGER_DEBUG(
-                  mSLog, "    GeneratorType is SynchronGenerator5OrderVBR.");
-              auto gen = std::make_shared<SP::Ph1::SynchronGenerator5OrderVBR>(
-                  machine->mRID, machine->name, mComponentLogLevel);
-              gen->setOperationalParametersPerUnit(
-                  ratedPower, ratedVoltage, mFrequency, H, Ld, Lq, Ll, Ld_t,
-                  Lq_t, Td0_t, Tq0_t, Ld_s, Lq_s, Td0_s, Tq0_s, 0.0);
-              return gen;
-            } else if (mGeneratorType == GeneratorType::SG4OrderVBR) {
-              SPDLOG_LOGGER_DEBUG(
-                  mSLog, "    GeneratorType is SynchronGenerator4OrderVBR.");
-              auto gen = std::make_shared<SP::Ph1::SynchronGenerator4OrderVBR>(
-                  machine->mRID, machine->name, mComponentLogLevel);
-              gen->setOperationalParametersPerUnit(ratedPower, ratedVoltage,
-                                                   mFrequency, H, Ld, Lq, Ll,
-                                                   Ld_t, Lq_t, Td0_t, Tq0_t);
-              return gen;
-            } else if (mGeneratorType == GeneratorType::SG3OrderVBR) {
-              SPDLOG_LOGGER_DEBUG(
-                  mSLog, "    GeneratorType is SynchronGenerator3OrderVBR.");
-              auto gen = std::make_shared<SP::Ph1::SynchronGenerator3OrderVBR>(
-                  machine->mRID, machine->name, mComponentLogLevel);
-              gen->setOperationalParametersPerUnit(ratedPower, ratedVoltage,
-                                                   mFrequency, H, Ld, Lq, Ll,
-                                                   Ld_t, Td0_t);
-              return gen;
-            }
-          }
+      const auto &p = machine.params;
+      Real ratedPower = p[MachineParam::RatedPower];
+      Real ratedVoltage = p[MachineParam::RatedVoltage];
+
+      if (p[MachineParam::HasDynamics] != 0) {
+        // stator
+        Real Rs = p[MachineParam::Rs];
+        Real Ll = p[MachineParam::Ll];
+
+        // reactances
+        Real Ld = p[MachineParam::Ld];
+        Real Lq = p[MachineParam::Lq];
+        Real Ld_t = p[MachineParam::Ld_t];
+        Real Lq_t = p[MachineParam::Lq_t];
+        Real Ld_s = p[MachineParam::Ld_s];
+        Real Lq_s = p[MachineParam::Lq_s];
+
+        // time constants
+        Real Td0_t = p[MachineParam::Td0_t];
+        Real Tq0_t = p[MachineParam::Tq0_t];
+        Real Td0_s = p[MachineParam::Td0_s];
+        Real Tq0_s = p[MachineParam::Tq0_s];
+
+        // inertia
+        Real H = p[MachineParam::H];
+
+        // not available in CIM -> set to 0, as actually no impact on machine equations
+        Int poleNum = 0;
+        Real nomFieldCurr = 0;
+
+        if (mGeneratorType == GeneratorType::TransientStability) {
+          SPDLOG_LOGGER_DEBUG(mSLog,
+                              "    GeneratorType is TransientStability.");
+          auto gen = SP::Ph1::SynchronGeneratorTrStab::make(
+              machine.mRID, machine.name, mComponentLogLevel);
+          gen->setStandardParametersPU(ratedPower, ratedVoltage, mFrequency,
+                                       Ld_t, H);
+          return gen;
+        } else if (mGeneratorType == GeneratorType::SG6aOrderVBR) {
+          SPDLOG_LOGGER_DEBUG(
+              mSLog, "    GeneratorType is SynchronGenerator6aOrderVBR.");
+          auto gen = std::make_shared<SP::Ph1::SynchronGenerator6aOrderVBR>(
+              machine.mRID, machine.name, mComponentLogLevel);
+          gen->setOperationalParametersPerUnit(
+              ratedPower, ratedVoltage, mFrequency, H, Ld, Lq, Ll, Ld_t, Lq_t,
+              Td0_t, Tq0_t, Ld_s, Lq_s, Td0_s, Tq0_s);
+          return gen;
+        } else if (mGeneratorType == GeneratorType::SG6bOrderVBR) {
+          SPDLOG_LOGGER_DEBUG(
+              mSLog, "    GeneratorType is SynchronGenerator6bOrderVBR.");
+          auto gen = std::make_shared<SP::Ph1::SynchronGenerator6bOrderVBR>(
+              machine.mRID, machine.name, mComponentLogLevel);
+          gen->setOperationalParametersPerUnit(
+              ratedPower, ratedVoltage, mFrequency, H, Ld, Lq, Ll, Ld_t, Lq_t,
+              Td0_t, Tq0_t, Ld_s, Lq_s, Td0_s, Tq0_s);
+          return gen;
+        } else if (mGeneratorType == GeneratorType::SG5OrderVBR) {
+          SPDLOG_LOGGER_DEBUG(
+              mSLog, "    GeneratorType is SynchronGenerator5OrderVBR.");
+          auto gen = std::make_shared<SP::Ph1::SynchronGenerator5OrderVBR>(
+              machine.mRID, machine.name, mComponentLogLevel);
+          gen->setOperationalParametersPerUnit(
+              ratedPower, ratedVoltage, mFrequency, H, Ld, Lq, Ll, Ld_t, Lq_t,
+              Td0_t, Tq0_t, Ld_s, Lq_s, Td0_s, Tq0_s, 0.0);
+          return gen;
+        } else if (mGeneratorType == GeneratorType::SG4OrderVBR) {
+          SPDLOG_LOGGER_DEBUG(
+              mSLog, "    GeneratorType is SynchronGenerator4OrderVBR.");
+          auto gen = std::make_shared<SP::Ph1::SynchronGenerator4OrderVBR>(
+              machine.mRID, machine.name, mComponentLogLevel);
+          gen->setOperationalParametersPerUnit(ratedPower, ratedVoltage,
+                                               mFrequency, H, Ld, Lq, Ll, Ld_t,
+                                               Lq_t, Td0_t, Tq0_t);
+          return gen;
+        } else if (mGeneratorType == GeneratorType::SG3OrderVBR) {
+          SPDLOG_LOGGER_DEBUG(
+              mSLog, "    GeneratorType is SynchronGenerator3OrderVBR.");
+          auto gen = std::make_shared<SP::Ph1::SynchronGenerator3OrderVBR>(
+              machine.mRID, machine.name, mComponentLogLevel);
+          gen->setOperationalParametersPerUnit(
+              ratedPower, ratedVoltage, mFrequency, H, Ld, Lq, Ll, Ld_t, Td0_t);
+          return gen;
         }
       }
     } else if (mGeneratorType == GeneratorType::PVNode) {
       SPDLOG_LOGGER_DEBUG(mSLog, "    GeneratorType is PVNode.");
-      for (auto obj : mModel->Objects) {
-        if (CIMPP::GeneratingUnit *genUnit =
-                dynamic_cast<CIMPP::GeneratingUnit *>(obj)) {
-          for (auto syncGen : genUnit->RotatingMachine) {
-            if (syncGen->mRID == machine->mRID) {
-              // Check whether relevant input data are set, otherwise set default values
-              Real setPointActivePower = 0;
-              Real setPointVoltage = 0;
-              Real maximumReactivePower = 1e12;
-              try {
-                setPointActivePower =
-                    unitValue(genUnit->initialP.value, UnitMultiplier::M);
-                SPDLOG_LOGGER_INFO(mSLog, "    setPointActivePower={}",
-                                   setPointActivePower);
-              } catch (ReadingUninitializedField *e) {
-                std::cerr
-                    << "Uninitalized setPointActivePower for GeneratingUnit "
-                    << machine->name << ". Using default value of "
+      const auto &p = machine.params;
+      if (p[MachineParam::HasGeneratingUnit] != 0) {
+        // Check whether relevant input data are set, otherwise set default values
+        Real setPointActivePower = 0;
+        Real setPointVoltage = 0;
+        Real maximumReactivePower = 1e12;
+        if (p[MachineParam::HasActivePowerSetPoint] != 0) {
+          setPointActivePower = p[MachineParam::ActivePowerSetPoint];
+          SPDLOG_LOGGER_INFO(mSLog, "    setPointActivePower={}",
+                             setPointActivePower);
+        } else {
+          std::cerr << "Uninitalized setPointActivePower for GeneratingUnit "
+                    << machine.name << ". Using default value of "
                     << setPointActivePower << std::endl;
-              }
-              if (machine->RegulatingControl) {
-                setPointVoltage =
-                    unitValue(machine->RegulatingControl->targetValue.value,
-                              UnitMultiplier::k);
-                SPDLOG_LOGGER_INFO(mSLog, "    setPointVoltage={}",
-                                   setPointVoltage);
-              } else {
-                std::cerr << "Uninitalized setPointVoltage for GeneratingUnit "
-                          << machine->name << ". Using default value of "
-                          << setPointVoltage << std::endl;
-              }
-              try {
-                maximumReactivePower =
-                    unitValue(machine->maxQ.value, UnitMultiplier::M);
-                SPDLOG_LOGGER_INFO(mSLog, "    maximumReactivePower={}",
-                                   maximumReactivePower);
-              } catch (ReadingUninitializedField *e) {
-                std::cerr
-                    << "Uninitalized maximumReactivePower for GeneratingUnit "
-                    << machine->name << ". Using default value of "
+        }
+        if (p[MachineParam::HasVoltageSetPoint] != 0) {
+          setPointVoltage = p[MachineParam::VoltageSetPoint];
+          SPDLOG_LOGGER_INFO(mSLog, "    setPointVoltage={}", setPointVoltage);
+        } else {
+          std::cerr << "Uninitalized setPointVoltage for GeneratingUnit "
+                    << machine.name << ". Using default value of "
+                    << setPointVoltage << std::endl;
+        }
+        if (p[MachineParam::HasMaximumReactivePower] != 0) {
+          maximumReactivePower = p[MachineParam::MaximumReactivePower];
+          SPDLOG_LOGGER_INFO(mSLog, "    maximumReactivePower={}",
+                             maximumReactivePower);
+        } else {
+          std::cerr << "Uninitalized maximumReactivePower for GeneratingUnit "
+                    << machine.name << ". Using default value of "
                     << maximumReactivePower << std::endl;
-              }
-
-              auto gen = std::make_shared<SP::Ph1::SynchronGenerator>(
-                  machine->mRID, machine->name, mComponentLogLevel);
-              gen->setParameters(
-                  unitValue(machine->ratedS.value, UnitMultiplier::M),
-                  unitValue(machine->ratedU.value, UnitMultiplier::k),
-                  setPointActivePower, setPointVoltage, PowerflowBusType::PV);
-              gen->setBaseVoltage(
-                  unitValue(machine->ratedU.value, UnitMultiplier::k));
-              return gen;
-            }
-          }
         }
+
+        auto gen = std::make_shared<SP::Ph1::SynchronGenerator>(
+            machine.mRID, machine.name, mComponentLogLevel);
+        gen->setParameters(p[MachineParam::RatedPower],
+                           p[MachineParam::RatedVoltage], setPointActivePower,
+                           setPointVoltage, PowerflowBusType::PV);
+        gen->setBaseVoltage(p[MachineParam::RatedVoltage]);
+        return gen;
       }
       SPDLOG_LOGGER_INFO(mSLog, "no corresponding initial power for {}",
-                         machine->name);
+                         machine.name);
       return std::make_shared<SP::Ph1::SynchronGenerator>(
-          machine->mRID, machine->name, mComponentLogLevel);
+          machine.mRID, machine.name, mComponentLogLevel);
     } else if (mGeneratorType == GeneratorType::None) {
       throw SystemError("GeneratorType is None. Specify!");
     } else {
@@ -886,119 +1385,109 @@ Reader::mapSynchronousMachine(CIMPP::SynchronousMachine *machine) {
         mGeneratorType == GeneratorType::SG6aOrderVBR ||
         mGeneratorType == GeneratorType::SG6bOrderVBR) {
 
-      Real ratedPower = unitValue(machine->ratedS.value, UnitMultiplier::M);
-      Real ratedVoltage = unitValue(machine->ratedU.value, UnitMultiplier::k);
-
-      for (auto obj : mModel->Objects) {
-        // Check if object is not TopologicalNode, SvVoltage or SvPowerFlow
-        if (CIMPP::SynchronousMachineTimeConstantReactance *genDyn =
-                dynamic_cast<CIMPP::SynchronousMachineTimeConstantReactance *>(
-                    obj)) {
-          if (genDyn->SynchronousMachine->mRID == machine->mRID) {
-
-            // stator
-            Real Rs = genDyn->statorResistance.value;
-            Real Ll = genDyn->statorLeakageReactance.value;
-
-            // reactances
-            Real Ld = genDyn->xDirectSync.value;
-            Real Lq = genDyn->xQuadSync.value;
-            Real Ld_t = genDyn->xDirectTrans.value;
-            Real Lq_t = genDyn->xQuadTrans.value;
-            Real Ld_s = genDyn->xDirectSubtrans.value;
-            Real Lq_s = genDyn->xQuadSubtrans.value;
-
-            // time constants
-            Real Td0_t = genDyn->tpdo.value;
-            Real Tq0_t = genDyn->tpqo.value;
-            Real Td0_s = genDyn->tppdo.value;
-            Real Tq0_s = genDyn->tppqo.value;
-
-            // inertia
-            Real H = genDyn->inertia.value;
-
-            // not available in CIM -> set to 0, as actually no impact on machine equations
-            Int poleNum = 0;
-            Real nomFieldCurr = 0;
-
-            if (mGeneratorType == GeneratorType::FullOrder) {
-              SPDLOG_LOGGER_DEBUG(mSLog, "    GeneratorType is FullOrder.");
-              auto gen = std::make_shared<EMT::Ph3::SynchronGeneratorDQTrapez>(
-                  machine->mRID, machine->name, mComponentLogLevel);
-              gen->setParametersOperationalPerUnit(
-                  ratedPower, ratedVoltage, mFrequency, poleNum, nomFieldCurr,
-                  Rs, Ld, Lq, Ld_t, Lq_t, Ld_s, Lq_s, Ll, Td0_t, Tq0_t, Td0_s,
-                  Tq0_s, H);
-              return gen;
-            } else if (mGeneratorType == GeneratorType::FullOrderVBR) {
-              SPDLOG_LOGGER_DEBUG(mSLog, "    GeneratorType is FullOrderVBR.");
-              auto gen = std::make_shared<EMT::Ph3::SynchronGeneratorVBR>(
-                  machine->mRID, machine->name, mComponentLogLevel);
-              gen->setBaseAndOperationalPerUnitParameters(
-                  ratedPower, ratedVoltage, mFrequency, poleNum, nomFieldCurr,
-                  Rs, Ld, Lq, Ld_t, Lq_t, Ld_s, Lq_s, Ll, Td0_t, Tq0_t, Td0_s,
-                  Tq0_s, H);
-              return gen;
-            } else if (mGeneratorType == GeneratorType::SG6aOrderVBR) {
-              SPDLOG_LOGGER_DEBUG(
-                  mSLog, "    GeneratorType is SynchronGenerator6aOrderVBR.");
-              auto gen =
-                  std::make_shared<EMT::Ph3::SynchronGenerator6aOrderVBR>(
-                      machine->mRID, machine->name, mComponentLogLevel);
-              gen->setOperationalParametersPerUnit(
-                  ratedPower, ratedVoltage, mFrequency, H, Ld, Lq, Ll, Ld_t,
-                  Lq_t, Td0_t, Tq0_t, Ld_s, Lq_s, Td0_s, Tq0_s);
-              return gen;
-            } else if (mGeneratorType == GeneratorType::SG6bOrderVBR) {
-              SPDLOG_LOGGER_DEBUG(
-                  mSLog, "    GeneratorType is SynchronGenerator6bOrderVBR.");
-              auto gen =
-                  std::make_shared<EMT::Ph3::SynchronGenerator6bOrderVBR>(
-                      machine->mRID, machine->name, mComponentLogLevel);
-              gen->setOperationalParametersPerUnit(
-                  ratedPower, ratedVoltage, mFrequency, H, Ld, Lq, Ll, Ld_t,
-                  Lq_t, Td0_t, Tq0_t, Ld_s, Lq_s, Td0_s, Tq0_s);
-              return gen;
-            } else if (mGeneratorType == GeneratorType::SG5OrderVBR) {
-              SPDLOG_LOGGER_DEBUG(
-                  mSLog, "    GeneratorType is SynchronGenerator5OrderVBR.");
-              auto gen = std::make_shared<EMT::Ph3::SynchronGenerator5OrderVBR>(
-                  machine->mRID, machine->name, mComponentLogLevel);
-              gen->setOperationalParametersPerUnit(
-                  ratedPower, ratedVoltage, mFrequency, H, Ld, Lq, Ll, Ld_t,
-                  Lq_t, Td0_t, Tq0_t, Ld_s, Lq_s, Td0_s, Tq0_s, 0.0);
-              return gen;
-            } else if (mGeneratorType == GeneratorType::SG4OrderVBR) {
-              SPDLOG_LOGGER_DEBUG(
-                  mSLog, "    GeneratorType is SynchronGenerator4OrderVBR.");
-              auto gen = std::make_shared<EMT::Ph3::SynchronGenerator4OrderVBR>(
-                  machine->mRID, machine->name, mComponentLogLevel);
-              gen->setOperationalParametersPerUnit(ratedPower, ratedVoltage,
-                                                   mFrequency, H, Ld, Lq, Ll,
-                                                   Ld_t, Lq_t, Td0_t, Tq0_t);
-              return gen;
-            } else if (mGeneratorType == GeneratorType::SG3OrderVBR) {
-              SPDLOG_LOGGER_DEBUG(
-                  mSLog, "    GeneratorType is SynchronGenerator3OrderVBR.");
-              auto gen = std::make_shared<EMT::Ph3::SynchronGenerator3OrderVBR>(
-                  machine->mRID, machine->name, mComponentLogLevel);
-              gen->setOperationalParametersPerUnit(ratedPower, ratedVoltage,
-                                                   mFrequency, H, Ld, Lq, Ll,
-                                                   Ld_t, Td0_t);
-              return gen;
-            }
-          }
+      const auto &p = machine.params;
+      Real ratedPower = p[MachineParam::RatedPower];
+      Real ratedVoltage = p[MachineParam::RatedVoltage];
+
+      if (p[MachineParam::HasDynamics] != 0) {
+        // stator
+        Real Rs = p[MachineParam::Rs];
+        Real Ll = p[MachineParam::Ll];
+
+        // reactances
+        Real Ld = p[MachineParam::Ld];
+        Real Lq = p[MachineParam::Lq];
+        Real Ld_t = p[MachineParam::Ld_t];
+        Real Lq_t = p[MachineParam::Lq_t];
+        Real Ld_s = p[MachineParam::Ld_s];
+        Real Lq_s = p[MachineParam::Lq_s];
+
+        // time constants
+        Real Td0_t = p[MachineParam::Td0_t];
+        Real Tq0_t = p[MachineParam::Tq0_t];
+        Real Td0_s = p[MachineParam::Td0_s];
+        Real Tq0_s = p[MachineParam::Tq0_s];
+
+        // inertia
+        Real H = p[MachineParam::H];
+
+        // not available in CIM -> set to 0, as actually no impact on machine equations
+        Int poleNum = 0;
+        Real nomFieldCurr = 0;
+
+        if (mGeneratorType == GeneratorType::FullOrder) {
+          SPDLOG_LOGGER_DEBUG(mSLog, "    GeneratorType is FullOrder.");
+          auto gen = std::make_shared<EMT::Ph3::SynchronGeneratorDQTrapez>(
+              machine.mRID, machine.name, mComponentLogLevel);
+          gen->setParametersOperationalPerUnit(
+              ratedPower, ratedVoltage, mFrequency, poleNum, nomFieldCurr, Rs,
+              Ld, Lq, Ld_t, Lq_t, Ld_s, Lq_s, Ll, Td0_t, Tq0_t, Td0_s, Tq0_s,
+              H);
+          return gen;
+        } else if (mGeneratorType == GeneratorType::FullOrderVBR) {
+          SPDLOG_LOGGER_DEBUG(mSLog, "    GeneratorType is FullOrderVBR.");
+          auto gen = std::make_shared<EMT::Ph3::SynchronGeneratorVBR>(
+              machine.mRID, machine.name, mComponentLogLevel);
+          gen->setBaseAndOperationalPerUnitParameters(
+              ratedPower, ratedVoltage, mFrequency, poleNum, nomFieldCurr, Rs,
+              Ld, Lq, Ld_t, Lq_t, Ld_s, Lq_s, Ll, Td0_t, Tq0_t, Td0_s, Tq0_s,
+              H);
+          return gen;
+        } else if (mGeneratorType == GeneratorType::SG6aOrderVBR) {
+          SPDLOG_LOGGER_DEBUG(
+              mSLog, "    GeneratorType is SynchronGenerator6aOrderVBR.");
+          auto gen = std::make_shared<EMT::Ph3::SynchronGenerator6aOrderVBR>(
+              machine.mRID, machine.name, mComponentLogLevel);
+          gen->setOperationalParametersPerUnit(
+              ratedPower, ratedVoltage, mFrequency, H, Ld, Lq, Ll, Ld_t, Lq_t,
+              Td0_t, Tq0_t, Ld_s, Lq_s, Td0_s, Tq0_s);
+          return gen;
+        } else if (mGeneratorType == GeneratorType::SG6bOrderVBR) {
+          SPDLOG_LOGGER_DEBUG(
+              mSLog, "    GeneratorType is SynchronGenerator6bOrderVBR.");
+          auto gen = std::make_shared<EMT::Ph3::SynchronGenerator6bOrderVBR>(
+              machine.mRID, machine.name, mComponentLogLevel);
+          gen->setOperationalParametersPerUnit(
+              ratedPower, ratedVoltage, mFrequency, H, Ld, Lq, Ll, Ld_t, Lq_t,
+              Td0_t, Tq0_t, Ld_s, Lq_s, Td0_s, Tq0_s);
+          return gen;
+        } else if (mGeneratorType == GeneratorType::SG5OrderVBR) {
+          SPDLOG_LOGGER_DEBUG(
+              mSLog, "    GeneratorType is SynchronGenerator5OrderVBR.");
+          auto gen = std::make_shared<EMT::Ph3::SynchronGenerator5OrderVBR>(
+              machine.mRID, machine.name, mComponentLogLevel);
+          gen->setOperationalParametersPerUnit(
+              ratedPower, ratedVoltage, mFrequency, H, Ld, Lq, Ll, Ld_t, Lq_t,
+              Td0_t, Tq0_t, Ld_s, Lq_s, Td0_s, Tq0_s, 0.0);
+          return gen;
+        } else if (mGeneratorType == GeneratorType::SG4OrderVBR) {
+          SPDLOG_LOGGER_DEBUG(
+              mSLog, "    GeneratorType is SynchronGenerator4OrderVBR.");
+          auto gen = std::make_shared<EMT::Ph3::SynchronGenerator4OrderVBR>(
+              machine.mRID, machine.name, mComponentLogLevel);
+          gen->setOperationalParametersPerUnit(ratedPower, ratedVoltage,
+                                               mFrequency, H, Ld, Lq, Ll, Ld_t,
+                                               Lq_t, Td0_t, Tq0_t);
+          return gen;
+        } else if (mGeneratorType == GeneratorType::SG3OrderVBR) {
+          SPDLOG_LOGGER_DEBUG(
+              mSLog, "    GeneratorType is SynchronGenerator3OrderVBR.");
+          auto gen = std::make_shared<EMT::Ph3::SynchronGenerator3OrderVBR>(
+              machine.mRID, machine.name, mComponentLogLevel);
+          gen->setOperationalParametersPerUnit(
+              ratedPower, ratedVoltage, mFrequency, H, Ld, Lq, Ll, Ld_t, Td0_t);
+          return gen;
         }
       }
     } else if (mGeneratorType == GeneratorType::IdealVoltageSource) {
       SPDLOG_LOGGER_DEBUG(mSLog, "    GeneratorType is IdealVoltageSource.");
       return std::make_shared<EMT::Ph3::SynchronGeneratorIdeal>(
-          machine->mRID, machine->name, mComponentLogLevel,
+          machine.mRID, machine.name, mComponentLogLevel,
           GeneratorType::IdealVoltageSource);
     } else if (mGeneratorType == GeneratorType::IdealCurrentSource) {
       SPDLOG_LOGGER_DEBUG(mSLog, "    GeneratorType is IdealCurrentSource.");
       return std::make_shared<EMT::Ph3::SynchronGeneratorIdeal>(
-          machine->mRID, machine->name, mComponentLogLevel,
+          machine.mRID, machine.name, mComponentLogLevel,
           GeneratorType::IdealCurrentSource);
     } else if (mGeneratorType == GeneratorType::None) {
       throw SystemError("GeneratorType is None. Specify!");
@@ -1010,16 +1499,16 @@ Reader::mapSynchronousMachine(CIMPP::SynchronousMachine *machine) {
 }
 
 TopologicalPowerComp::Ptr
-Reader::mapExternalNetworkInjection(CIMPP::ExternalNetworkInjection *extnet) {
+Reader::mapExternalNetworkInjection(const EquipmentData &extnet) {
   SPDLOG_LOGGER_INFO(mSLog, "Found External Network Injection {}",
-                     extnet->name);
+                     extnet.name);
 
-  Real baseVoltage = determineBaseVoltageAssociatedWithEquipment(extnet);
+  Real baseVoltage = extnet.baseVoltage;
 
   if (mDomain == Domain::EMT) {
     if (mPhase == PhaseType::ABC) {
       return std::make_shared<EMT::Ph3::NetworkInjection>(
-          extnet->mRID, extnet->name, mComponentLogLevel);
+          extnet.mRID, extnet.name, mComponentLogLevel);
     } else {
       throw SystemError(
           "Mapping of ExternalNetworkInjection for EMT::Ph1 not existent!");
@@ -1028,25 +1517,24 @@ Reader::mapExternalNetworkInjection(CIMPP::ExternalNetworkInjection *extnet) {
   } else if (mDomain == Domain::SP) {
     if (mPhase == PhaseType::Single) {
       auto cpsextnet = std::make_shared<SP::Ph1::NetworkInjection>(
-          extnet->mRID, extnet->name, mComponentLogLevel);
+          extnet.mRID, extnet.name, mComponentLogLevel);
       cpsextnet->modifyPowerFlowBusType(
           PowerflowBusType::
               VD); // for powerflow solver set as VD component as default
       cpsextnet->setBaseVoltage(baseVoltage);
 
-      try {
-        if (extnet->RegulatingControl) {
-          SPDLOG_LOGGER_INFO(mSLog, "       Voltage set-point={}",
-                             (float)extnet->RegulatingControl->targetValue);
-          cpsextnet->setParameters(
-              extnet->RegulatingControl->targetValue *
-              baseVoltage); // assumes that value is specified in CIM data in per unit
-        } else {
-          SPDLOG_LOGGER_INFO(
-              mSLog, "       No voltage set-point defined. Using 1 per unit.");
-          cpsextnet->setParameters(1. * baseVoltage);
-        }
-      } catch (ReadingUninitializedField *e) {
+      const auto &p = extnet.params;
+      if (p[InjectionParam::ControlMode] == 1) {
+        SPDLOG_LOGGER_INFO(mSLog, "       Voltage set-point={}",
+                           (float)p[InjectionParam::VoltageSetPoint]);
+        cpsextnet->setParameters(
+            p[InjectionParam::VoltageSetPoint] *
+            baseVoltage); // assumes that value is specified in CIM data in per unit
+      } else if (p[InjectionParam::ControlMode] == 0) {
+        SPDLOG_LOGGER_INFO(
+            mSLog, "       No voltage set-point defined. Using 1 per unit.");
+        cpsextnet->setParameters(1. * baseVoltage);
+      } else {
         std::cerr << "Ignore incomplete RegulatingControl" << std::endl;
       }
 
@@ -1059,7 +1547,7 @@ Reader::mapExternalNetworkInjection(CIMPP::ExternalNetworkInjection *extnet) {
   } else {
     if (mPhase == PhaseType::Single) {
       return std::make_shared<DP::Ph1::NetworkInjection>(
-          extnet->mRID, extnet->name, mComponentLogLevel);
+          extnet.mRID, extnet.name, mComponentLogLevel);
     } else {
       throw SystemError(
           "Mapping of ExternalNetworkInjection for DP::Ph3 not existent!");
@@ -1069,130 +1557,85 @@ Reader::mapExternalNetworkInjection(CIMPP::ExternalNetworkInjection *extnet) {
 }
 
 TopologicalPowerComp::Ptr
-Reader::mapEquivalentShunt(CIMPP::EquivalentShunt *shunt) {
-  SPDLOG_LOGGER_INFO(mSLog, "Found shunt {}", shunt->name);
-
-  Real baseVoltage = determineBaseVoltageAssociatedWithEquipment(shunt);
+Reader::mapEquivalentShunt(const EquipmentData &shunt) {
+  SPDLOG_LOGGER_INFO(mSLog, "Found shunt {}", shunt.name);
 
-  auto cpsShunt = std::make_shared<SP::Ph1::Shunt>(shunt->mRID, shunt->name,
+  auto cpsShunt = std::make_shared<SP::Ph1::Shunt>(shunt.mRID, shunt.name,
                                                    mComponentLogLevel);
-  cpsShunt->setParameters(shunt->g.value, shunt->b.value);
-  cpsShunt->setBaseVoltage(baseVoltage);
+  cpsShunt->setParameters(shunt.params[ShuntParam::G],
+                          shunt.params[ShuntParam::B]);
+  cpsShunt->setBaseVoltage(shunt.baseVoltage);
   return cpsShunt;
 }
 
 Real Reader::determineBaseVoltageAssociatedWithEquipment(
     CIMPP::ConductingEquipment *equipment) {
-  Real baseVoltage = 0;
-
   // first look for baseVolt object to determine baseVoltage
-  for (auto obj : mModel->Objects) {
-    if (CIMPP::BaseVoltage *baseVolt =
-            dynamic_cast<CIMPP::BaseVoltage *>(obj)) {
-      for (auto comp : baseVolt->ConductingEquipment) {
-        if (comp->name == equipment->name) {
-          baseVoltage =
-              unitValue(baseVolt->nominalVoltage.value, UnitMultiplier::k);
-        }
-      }
-    }
-  }
+  auto search = mIndex->baseVoltages.find(equipment->name);
+  if (search != mIndex->baseVoltages.end() && search->second != 0)
+    return search->second;
+
   // as second option take baseVoltage of topologicalNode where equipment is connected to
-  if (baseVoltage == 0) {
-    for (auto obj : mModel->Objects) {
-      if (CIMPP::TopologicalNode *topNode =
-              dynamic_cast<CIMPP::TopologicalNode *>(obj)) {
-        for (auto term : topNode->Terminal) {
-          if (term->ConductingEquipment->name == equipment->name) {
-            baseVoltage = unitValue(topNode->BaseVoltage->nominalVoltage.value,
-                                    UnitMultiplier::k);
-          }
-        }
-      }
-    }
-  }
+  search = mIndex->nodeBaseVoltages.find(equipment->name);
+  if (search != mIndex->nodeBaseVoltages.end())
+    return search->second;
 
-  return baseVoltage;
+  return 0;
 }
 
 template <typename VarType>
-void Reader::processTopologicalNode(CIMPP::TopologicalNode *topNode) {
+void Reader::processTopologicalNode(const NodeData &node) {
   // Add this node to global node list and assign simulation node incrementally.
   int matrixNodeIndex = Int(mPowerflowNodes.size());
-  mPowerflowNodes[topNode->mRID] = SimNode<VarType>::make(
-      topNode->mRID, topNode->name, matrixNodeIndex, mPhase);
+  auto simNode =
+      SimNode<VarType>::make(node.mRID, node.name, matrixNodeIndex, mPhase);
+  mPowerflowNodes[node.mRID] = simNode;
 
   if (mPhase == PhaseType::ABC) {
-    SPDLOG_LOGGER_INFO(
-        mSLog, "TopologicalNode {} phase A as simulation node {} ",
-        topNode->mRID,
-        mPowerflowNodes[topNode->mRID]->matrixNodeIndex(PhaseType::A));
-    SPDLOG_LOGGER_INFO(
-        mSLog, "TopologicalNode {} phase B as simulation node {}",
-        topNode->mRID,
-        mPowerflowNodes[topNode->mRID]->matrixNodeIndex(PhaseType::B));
-    SPDLOG_LOGGER_INFO(
-        mSLog, "TopologicalNode {} phase C as simulation node {}",
-        topNode->mRID,
-        mPowerflowNodes[topNode->mRID]->matrixNodeIndex(PhaseType::C));
+    SPDLOG_LOGGER_INFO(mSLog,
+                       "TopologicalNode {} phase A as simulation node {} ",
+                       node.mRID, simNode->matrixNodeIndex(PhaseType::A));
+    SPDLOG_LOGGER_INFO(mSLog,
+                       "TopologicalNode {} phase B as simulation node {}",
+                       node.mRID, simNode->matrixNodeIndex(PhaseType::B));
+    SPDLOG_LOGGER_INFO(mSLog,
+                       "TopologicalNode {} phase C as simulation node {}",
+                       node.mRID, simNode->matrixNodeIndex(PhaseType::C));
   } else
     SPDLOG_LOGGER_INFO(mSLog,
                        "TopologicalNode id: {}, name: {} as simulation node {}",
-                       topNode->mRID, topNode->name,
-                       mPowerflowNodes[topNode->mRID]->matrixNodeIndex());
+                       node.mRID, node.name, simNode->matrixNodeIndex());
 
-  for (auto term : topNode->Terminal) {
+  for (auto &term : node.terminals) {
     // Insert Terminal if it does not exist in the map and add reference to node.
-    // This could be optimized because the Terminal is searched twice.
-    auto cpsTerm = SimTerminal<VarType>::make(term->mRID);
-    mPowerflowTerminals.insert(std::make_pair(term->mRID, cpsTerm));
-    cpsTerm->setNode(std::dynamic_pointer_cast<SimNode<VarType>>(
-        mPowerflowNodes[topNode->mRID]));
-
-    if (!term->sequenceNumber.initialized)
-      term->sequenceNumber = 1;
+    auto cpsTerm = SimTerminal<VarType>::make(term.mRID);
+    mPowerflowTerminals.insert(std::make_pair(term.mRID, cpsTerm));
+    cpsTerm->setNode(simNode);
 
-    SPDLOG_LOGGER_INFO(mSLog, "    Terminal {}, sequenceNumber {}", term->mRID,
-                       (int)term->sequenceNumber);
+    SPDLOG_LOGGER_INFO(mSLog, "    Terminal {}, sequenceNumber {}", term.mRID,
+                       term.sequenceNumber);
 
-    // Try to process Equipment connected to Terminal.
-    CIMPP::ConductingEquipment *equipment = term->ConductingEquipment;
-    if (!equipment) {
+    // The equipment has been mapped to components before
+    if (term.equipment.empty()) {
       SPDLOG_LOGGER_WARN(mSLog, "Terminal {} has no Equipment, ignoring!",
-                         term->mRID);
-    } else {
-      // Insert Equipment if it does not exist in the map and add reference to Terminal.
-      // This could be optimized because the Equipment is searched twice.
-      if (mPowerflowEquipment.find(equipment->mRID) ==
-          mPowerflowEquipment.end()) {
-        TopologicalPowerComp::Ptr comp = mapComponent(equipment);
-        if (comp) {
-          mPowerflowEquipment.insert(std::make_pair(equipment->mRID, comp));
-        } else {
-          SPDLOG_LOGGER_WARN(mSLog, "Could not map equipment {}",
-                             equipment->mRID);
-          continue;
-        }
-      }
+                         term.mRID);
+      continue;
+    }
+    auto search = mPowerflowEquipment.find(term.equipment);
+    if (search == mPowerflowEquipment.end()) {
+      SPDLOG_LOGGER_WARN(mSLog, "Could not map equipment {}", term.equipment);
+      continue;
+    }
 
-      auto pfEquipment = mPowerflowEquipment.at(equipment->mRID);
-      if (pfEquipment == nullptr) {
-        SPDLOG_LOGGER_ERROR(mSLog, "Equipment {} is null in equipment list",
-                            equipment->mRID);
-        throw SystemError("Equipment is null in equipment list.");
-      }
-      std::dynamic_pointer_cast<SimPowerComp<VarType>>(pfEquipment)
-          ->setTerminalAt(std::dynamic_pointer_cast<SimTerminal<VarType>>(
-                              mPowerflowTerminals[term->mRID]),
-                          term->sequenceNumber - 1);
+    std::dynamic_pointer_cast<SimPowerComp<VarType>>(search->second)
+        ->setTerminalAt(std::dynamic_pointer_cast<SimTerminal<VarType>>(
+                            mPowerflowTerminals[term.mRID]),
+                        term.sequenceNumber - 1);
 
-      SPDLOG_LOGGER_INFO(mSLog, "        Added Terminal {} to Equipment {}",
-                         term->mRID, equipment->mRID);
-    }
+    SPDLOG_LOGGER_INFO(mSLog, "        Added Terminal {} to Equipment {}",
+                       term.mRID, term.equipment);
   }
 }
 
-template void
-Reader::processTopologicalNode<Real>(CIMPP::TopologicalNode *topNode);
-template void
-Reader::processTopologicalNode<Complex>(CIMPP::TopologicalNode *topNode);
+template void Reader::processTopologicalNode<Real>(const NodeData &node);
+template void Reader::processTopologicalNode<Complex>(const NodeData &node);
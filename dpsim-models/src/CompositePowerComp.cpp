@@ -16,6 +16,7 @@ void CompositePowerComp<VarType>::addMNASubComponent(
 
     if (contributeToRightVector) {
       this->mRightVectorStamps.push_back(mnasubcomp->mRightVector);
+      this->mRightVectorSubcomponents.push_back(mnasubcomp);
     }
 
     switch (preStepOrder) {
@@ -57,6 +58,19 @@ void CompositePowerComp<VarType>::mnaCompInitialize(
   **this->mRightVector = Matrix::Zero(leftVector->get().rows(), 1);
 
   mnaParentInitialize(omega, timeStep, leftVector);
+
+  // Sum up only the rows the subcomponents write to, if all of them are known
+  mRightVectorRows.clear();
+  mRightVectorStampRows.assign(mRightVectorStamps.size(), {});
+  mSparseRightVectorStamps = this->mnaRightVectorRows(mRightVectorRows);
+  for (UInt i = 0; mSparseRightVectorStamps && i < mRightVectorStamps.size();
+       ++i) {
+    if ((**mRightVectorStamps[i]).size() == 0)
+      continue;
+    mSparseRightVectorStamps =
+        mRightVectorSubcomponents[i]->mnaRightVectorRows(
+            mRightVectorStampRows[i]);
+  }
 }
 
 template <typename VarType>
@@ -71,10 +85,20 @@ void CompositePowerComp<VarType>::mnaCompApplySystemMatrixStamp(
 template <typename VarType>
 void CompositePowerComp<VarType>::mnaCompApplyRightSideVectorStamp(
     Matrix &rightVector) {
-  rightVector.setZero();
-  for (auto stamp : mRightVectorStamps) {
-    if ((**stamp).size() != 0) {
-      rightVector += **stamp;
+  if (mSparseRightVectorStamps) {
+    for (UInt row : mRightVectorRows)
+      rightVector(row, 0) = 0;
+    for (UInt i = 0; i < mRightVectorStamps.size(); ++i) {
+      const Matrix &stamp = **mRightVectorStamps[i];
+      for (UInt row : mRightVectorStampRows[i])
+        rightVector(row, 0) += stamp(row, 0);
+    }
+  } else {
+    rightVector.setZero();
+    for (auto stamp : mRightVectorStamps) {
+      if ((**stamp).size() != 0) {
+        rightVector += **stamp;
+      }
     }
   }
   mnaParentApplyRightSideVectorStamp(rightVector);
@@ -186,6 +186,21 @@ void DP::Ph1::NetworkInjection::daeResidual(double ttime, const double state[],
   off[1] += 1;
 }
 
+bool DP::Ph1::NetworkInjection::daeJacobian(double ttime, const double state[],
+                                            const double dstate_dt[], double cj,
+                                            JacobianEntries &jacobian,
+                                            std::vector<int> &off) {
+  int Pos1 = matrixNodeIndex(0);
+  int Pos2 = matrixNodeIndex(1);
+  int c_offset = off[0] + off[1]; // current offset for component
+  // The injected current does not depend on the state
+  jacobian.emplace_back(c_offset, Pos2, 1.0);
+  jacobian.emplace_back(c_offset, Pos1, -1.0);
+  jacobian.emplace_back(c_offset, c_offset, -1.0);
+  off[1] += 1;
+  return true;
+}
+
 Complex DP::Ph1::NetworkInjection::daeInitialize() {
   (**mIntfVoltage)(0, 0) = (**mSubVoltageSource->mIntfVoltage)(0, 0);
   return (**mSubVoltageSource->mIntfVoltage)(0, 0);
@@ -188,4 +188,22 @@ void DP::Ph1::Resistor::daeResidual(double ttime, const double state[],
   off[1] += 1;
 }
 
+bool DP::Ph1::Resistor::daeJacobian(double ttime, const double state[],
+                                    const double dstate_dt[], double cj,
+                                    JacobianEntries &jacobian,
+                                    std::vector<int> &off) {
+  int Pos1 = matrixNodeIndex(0);
+  int Pos2 = matrixNodeIndex(1);
+  int c_offset = off[0] + off[1]; // Current offset for component
+  int n_offset_1 = c_offset + Pos1 + 1;
+  int n_offset_2 = c_offset + Pos2 + 1;
+  jacobian.emplace_back(c_offset, Pos2, 1.0);
+  jacobian.emplace_back(c_offset, Pos1, -1.0);
+  jacobian.emplace_back(c_offset, c_offset, -1.0);
+  jacobian.emplace_back(n_offset_1, c_offset, 1.0 / **mResistance);
+  jacobian.emplace_back(n_offset_2, c_offset, 1.0 / **mResistance);
+  off[1] += 1;
+  return true;
+}
+
 Complex DP::Ph1::Resistor::daeInitialize() { return (**mIntfVoltage)(0, 0); }
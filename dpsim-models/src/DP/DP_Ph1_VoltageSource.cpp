@@ -313,6 +313,21 @@ void DP::Ph1::VoltageSource::daeResidual(double ttime, const double state[],
   off[1] += 1;
 }
 
+bool DP::Ph1::VoltageSource::daeJacobian(double ttime, const double state[],
+                                         const double dstate_dt[], double cj,
+                                         JacobianEntries &jacobian,
+                                         std::vector<int> &off) {
+  int Pos1 = matrixNodeIndex(0);
+  int Pos2 = matrixNodeIndex(1);
+  int c_offset = off[0] + off[1]; // current offset for component
+  // The injected current does not depend on the state
+  jacobian.emplace_back(c_offset, Pos2, 1.0);
+  jacobian.emplace_back(c_offset, Pos1, -1.0);
+  jacobian.emplace_back(c_offset, c_offset, -1.0);
+  off[1] += 1;
+  return true;
+}
+
 Complex DP::Ph1::VoltageSource::daeInitialize() {
   (**mIntfVoltage)(0, 0) = mSrcSig->getSignal();
   return mSrcSig->getSignal();
@@ -175,3 +175,11 @@ Complex DP::Ph3::VoltageSource::daeInitialize() {
   (**mIntfVoltage)(0, 0) = **mVoltageRef;
   return **mVoltageRef;
 }
+
+bool DP::Ph3::VoltageSource::daeJacobian(double ttime, const double state[],
+                                         const double dstate_dt[], double cj,
+                                         JacobianEntries &jacobian,
+                                         std::vector<int> &off) {
+  // The source does not contribute to the residual
+  return true;
+}
@@ -120,7 +120,6 @@ void EMT::Ph3::Inductor::mnaCompApplyRightSideVectorStamp(Matrix &rightVector) {
   SPDLOG_LOGGER_DEBUG(
       mSLog, "\nEquivalent Current (mnaCompApplyRightSideVectorStamp): {:s}",
       Logger::matrixToString(mEquivCurrent));
-  mSLog->flush();
 }
 
 void EMT::Ph3::Inductor::mnaCompAddPreStepDependencies(
@@ -183,5 +182,4 @@ void EMT::Ph3::Inductor::mnaCompUpdateCurrent(const Matrix &leftVector) {
   **mIntfCurrent = mEquivCond * **mIntfVoltage + mEquivCurrent;
   SPDLOG_LOGGER_DEBUG(mSLog, "\nUpdate Current: {:s}",
                       Logger::matrixToString(**mIntfCurrent));
-  mSLog->flush();
 }
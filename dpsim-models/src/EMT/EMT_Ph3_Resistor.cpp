@@ -120,7 +120,6 @@ void EMT::Ph3::Resistor::mnaCompUpdateVoltage(const Matrix &leftVector) {
   }
   SPDLOG_LOGGER_DEBUG(mSLog, "\nVoltage: {:s}",
                       Logger::matrixToString(**mIntfVoltage));
-  mSLog->flush();
 }
 
 void EMT::Ph3::Resistor::mnaCompUpdateCurrent(const Matrix &leftVector) {
@@ -129,5 +128,4 @@ void EMT::Ph3::Resistor::mnaCompUpdateCurrent(const Matrix &leftVector) {
   **mIntfCurrent = resistanceInv * **mIntfVoltage;
   SPDLOG_LOGGER_DEBUG(mSLog, "\nCurrent: {:s}",
                       Logger::matrixToString(**mIntfCurrent));
-  mSLog->flush();
 }
@@ -274,7 +274,6 @@ void EMT::Ph3::SSN::Full_Serial_RLC::mnaCompApplyRightSideVectorStamp(
   SPDLOG_LOGGER_DEBUG(
       mSLog, "\nHistory current term (mnaCompApplyRightSideVectorStamp): {:s}",
       Logger::matrixToString(mYHistory));
-  mSLog->flush();
 }
 
 void EMT::Ph3::SSN::Full_Serial_RLC::mnaCompAddPreStepDependencies(
@@ -335,7 +334,6 @@ void EMT::Ph3::SSN::Full_Serial_RLC::mnaCompUpdateVoltage(
   }
   SPDLOG_LOGGER_DEBUG(mSLog, "\nUpdate Voltage: {:s}",
                       Logger::matrixToString(**mIntfVoltage));
-  mSLog->flush();
 }
 
 void EMT::Ph3::SSN::Full_Serial_RLC::mnaCompUpdateCurrent(
@@ -344,7 +342,6 @@ void EMT::Ph3::SSN::Full_Serial_RLC::mnaCompUpdateCurrent(
 
   SPDLOG_LOGGER_DEBUG(mSLog, "\nUpdate Current: {:s}",
                       Logger::matrixToString(**mIntfCurrent));
-  mSLog->flush();
 }
 
 void EMT::Ph3::SSN::Full_Serial_RLC::setParameters(Matrix resistance,
@@ -126,7 +126,6 @@ void EMT::Ph3::SSN::Inductor::mnaCompApplyRightSideVectorStamp(
   SPDLOG_LOGGER_DEBUG(
       mSLog, "\nHistory current term (mnaCompApplyRightSideVectorStamp): {:s}",
       Logger::matrixToString(mHistoricCurrent));
-  mSLog->flush();
 }
 
 void EMT::Ph3::SSN::Inductor::mnaCompAddPreStepDependencies(
@@ -189,5 +188,4 @@ void EMT::Ph3::SSN::Inductor::mnaCompUpdateCurrent(const Matrix &leftVector) {
   **mIntfCurrent = mHistoricCurrent + mDufourWKN * **mIntfVoltage;
   SPDLOG_LOGGER_DEBUG(mSLog, "\nUpdate Current: {:s}",
                       Logger::matrixToString(**mIntfCurrent));
-  mSLog->flush();
 }
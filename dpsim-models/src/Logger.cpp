@@ -8,6 +8,7 @@
 
 #include <iomanip>
 #include <memory>
+#include <mutex>
 
 #include <spdlog/sinks/null_sink.h>
 #include <spdlog/sinks/stdout_color_sinks.h>
@@ -40,12 +41,26 @@ String Logger::matrixCompToString(const MatrixComp &mat) {
   return ss.str();
 }
 
+// Sparse matrices are listed by their nonzero entries, a dense copy of a large
+// system matrix would not fit into memory
 String Logger::sparseMatrixToString(const SparseMatrix &mat) {
-  return matrixToString(Matrix(mat));
+  std::stringstream ss;
+  ss << std::scientific << "\n";
+  for (Int outer = 0; outer < mat.outerSize(); ++outer) {
+    for (SparseMatrix::InnerIterator it(mat, outer); it; ++it)
+      ss << "(" << it.row() << ", " << it.col() << ") " << it.value() << "\n";
+  }
+  return ss.str();
 }
 
 String Logger::sparseMatrixCompToString(const SparseMatrixComp &mat) {
-  return matrixCompToString(MatrixComp(mat));
+  std::stringstream ss;
+  ss << std::scientific << "\n";
+  for (Int outer = 0; outer < mat.outerSize(); ++outer) {
+    for (SparseMatrixComp::InnerIterator it(mat, outer); it; ++it)
+      ss << "(" << it.row() << ", " << it.col() << ") " << it.value() << "\n";
+  }
+  return ss.str();
 }
 
 String Logger::phasorMatrixToString(const MatrixComp &mat) {
@@ -138,6 +153,10 @@ String Logger::getCSVLineFromData(Real time, const MatrixComp &data) {
 
 Logger::Log Logger::get(const std::string &name, Level filelevel,
                         Level clilevel) {
+  // Components can be created by multiple threads, e.g. by the CIM reader
+  static std::mutex mutex;
+  std::lock_guard<std::mutex> lock(mutex);
+
   Logger::Log logger = spdlog::get(name);
 
   if (!logger) {
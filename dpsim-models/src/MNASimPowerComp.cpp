@@ -1,5 +1,7 @@
 // SPDX-License-Identifier: Apache-2.0
 
+#include <algorithm>
+
 #include <dpsim-models/MNASimPowerComp.h>
 
 using namespace CPS;
@@ -49,7 +51,6 @@ template <typename VarType>
 void MNASimPowerComp<VarType>::mnaApplySystemMatrixStamp(
     SparseMatrixRow &systemMatrix) {
   this->mnaCompApplySystemMatrixStamp(systemMatrix);
-  systemMatrix.makeCompressed();
 };
 
 template <typename VarType>
@@ -117,6 +118,63 @@ void MNASimPowerComp<VarType>::mnaApplyRightSideVectorStampHarm(
   this->mnaCompApplyRightSideVectorStampHarm(sourceVector, freqIdx);
 };
 
+template <typename VarType>
+Bool MNASimPowerComp<VarType>::mnaRightVectorRows(std::vector<UInt> &rows) {
+  // Components without right vector do not write to any row
+  return (**mRightVector).size() == 0;
+}
+
+template <typename VarType>
+Bool MNASimPowerComp<VarType>::mnaTerminalRightVectorRows(
+    std::vector<UInt> &rows) {
+  const Matrix &rightVector = **mRightVector;
+  // Components without right vector do not write to any row
+  if (rightVector.size() == 0)
+    return true;
+  // Harmonic stamps have one column per frequency
+  if (rightVector.cols() != 1)
+    return false;
+
+  // Complex values are stored in one block per frequency, each holding the
+  // real parts followed by the imaginary parts
+  UInt numBlocks = 1;
+  UInt harmonicOffset = static_cast<UInt>(rightVector.rows());
+  UInt complexOffset = 0;
+  if (std::is_same<VarType, Complex>::value) {
+    numBlocks = std::max<UInt>(this->mNumFreqs, 1);
+    harmonicOffset = static_cast<UInt>(rightVector.rows()) / numBlocks;
+    complexOffset = harmonicOffset / 2;
+  }
+
+  auto addNode = [&](const typename SimNode<VarType>::Ptr &node) {
+    if (!node || node->isGround())
+      return;
+    for (UInt index : node->matrixNodeIndices()) {
+      for (UInt block = 0; block < numBlocks; ++block) {
+        rows.push_back(index + block * harmonicOffset);
+        if (complexOffset > 0)
+          rows.push_back(index + block * harmonicOffset + complexOffset);
+      }
+    }
+  };
+  for (auto &terminal : this->mTerminals)
+    addNode(terminal->node());
+  for (auto &node : this->mVirtualNodes)
+    addNode(node);
+
+  for (auto &subComp : this->mSubComponents) {
+    auto mnaSubComp = std::dynamic_pointer_cast<MNAInterface>(subComp);
+    if (!mnaSubComp || !mnaSubComp->mnaRightVectorRows(rows))
+      return false;
+  }
+
+  // Subcomponents share nodes with their parent, every row must only be
+  // summed up once
+  std::sort(rows.begin(), rows.end());
+  rows.erase(std::unique(rows.begin(), rows.end()), rows.end());
+  return true;
+}
+
 template <typename VarType>
 void MNASimPowerComp<VarType>::mnaCompInitialize(
     Real omega, Real timeStep, Attribute<Matrix>::Ptr leftVector) {
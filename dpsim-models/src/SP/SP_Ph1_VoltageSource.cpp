@@ -212,3 +212,11 @@ Complex SP::Ph1::VoltageSource::daeInitialize() {
   (**mIntfVoltage)(0, 0) = mSrcSig->getSignal();
   return mSrcSig->getSignal();
 }
+
+bool SP::Ph1::VoltageSource::daeJacobian(double ttime, const double state[],
+                                         const double dstate_dt[], double cj,
+                                         JacobianEntries &jacobian,
+                                         std::vector<int> &off) {
+  // The source does not contribute to the residual
+  return true;
+}
@@ -177,3 +177,11 @@ Complex SP::Ph3::VoltageSource::daeInitialize() {
   (**mIntfVoltage)(0, 0) = **mVoltageRef;
   return **mVoltageRef;
 }
+
+bool SP::Ph3::VoltageSource::daeJacobian(double ttime, const double state[],
+                                         const double dstate_dt[], double cj,
+                                         JacobianEntries &jacobian,
+                                         std::vector<int> &off) {
+  // The source does not contribute to the residual
+  return true;
+}
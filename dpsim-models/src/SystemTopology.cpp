@@ -171,59 +171,64 @@ std::map<String, String, std::less<>> SystemTopology::listIdObjects() const {
 }
 
 template <typename VarType>
-void SystemTopology::multiplyPowerComps(Int numberCopies) {
-  typename SimNode<VarType>::List newNodes;
-  typename SimPowerComp<VarType>::List newComponents;
+void SystemTopology::copyPowerComps(
+    const String &copySuffix, typename SimNode<VarType>::List &newNodes,
+    typename SimPowerComp<VarType>::List &newComponents) {
+  std::unordered_map<typename SimNode<VarType>::Ptr,
+                     typename SimNode<VarType>::Ptr>
+      nodeMap;
 
-  for (int copy = 0; copy < numberCopies; copy++) {
-    std::unordered_map<typename SimNode<VarType>::Ptr,
-                       typename SimNode<VarType>::Ptr>
-        nodeMap;
-    String copySuffix = "_" + std::to_string(copy + 2);
-
-    // copy nodes
-    typename SimNode<VarType>::Ptr nodePtr;
-    for (size_t nNode = 0; nNode < mNodes.size(); nNode++) {
-      auto nodePtr = this->node<SimNode<VarType>>(static_cast<UInt>(nNode));
-      if (!nodePtr)
-        continue;
+  // copy nodes
+  for (size_t nNode = 0; nNode < mNodes.size(); nNode++) {
+    auto nodePtr = this->node<SimNode<VarType>>(static_cast<UInt>(nNode));
+    if (!nodePtr)
+      continue;
 
-      // GND is not copied
-      if (nodePtr->isGround()) {
-        nodeMap[nodePtr] = nodePtr;
-      } else {
-        auto nodeCpy = SimNode<VarType>::make(nodePtr->name() + copySuffix,
-                                              nodePtr->phaseType());
-        nodeCpy->setInitialVoltage(nodePtr->initialVoltage());
-        nodeMap[nodePtr] = nodeCpy;
-        newNodes.push_back(nodeCpy);
-      }
+    // GND is not copied
+    if (nodePtr->isGround()) {
+      nodeMap[nodePtr] = nodePtr;
+    } else {
+      auto nodeCpy = SimNode<VarType>::make(nodePtr->name() + copySuffix,
+                                            nodePtr->phaseType());
+      nodeCpy->setInitialVoltage(nodePtr->initialVoltage());
+      nodeMap[nodePtr] = nodeCpy;
+      newNodes.push_back(nodeCpy);
     }
+  }
 
-    // copy components
-    for (auto genComp : mComponents) {
-      auto comp = std::dynamic_pointer_cast<SimPowerComp<VarType>>(genComp);
-      if (!comp)
-        continue;
-      auto copy = comp->clone(comp->name() + copySuffix);
-      if (!copy)
-        throw SystemError("copy() not implemented for " + comp->name());
-
-      // map the nodes to their new copies, creating new terminals
-      typename SimNode<VarType>::List nodeCopies;
-      for (UInt nNode = 0; nNode < comp->terminalNumber(); nNode++) {
-        nodeCopies.push_back(nodeMap[comp->node(nNode)]);
-      }
-      copy->connect(nodeCopies);
+  // copy components
+  for (auto genComp : mComponents) {
+    auto comp = std::dynamic_pointer_cast<SimPowerComp<VarType>>(genComp);
+    if (!comp)
+      continue;
+    auto copy = comp->clone(comp->name() + copySuffix);
+    if (!copy)
+      throw SystemError("copy() not implemented for " + comp->name());
+
+    // map the nodes to their new copies, creating new terminals
+    typename SimNode<VarType>::List nodeCopies;
+    for (UInt nNode = 0; nNode < comp->terminalNumber(); nNode++) {
+      nodeCopies.push_back(nodeMap[comp->node(nNode)]);
+    }
+    copy->connect(nodeCopies);
 
-      // update the terminal powers for powerflow initialization
-      for (UInt nTerminal = 0; nTerminal < comp->terminalNumber();
-           nTerminal++) {
-        copy->terminal(nTerminal)->setPower(comp->terminal(nTerminal)->power());
-      }
-      newComponents.push_back(copy);
+    // update the terminal powers for powerflow initialization
+    for (UInt nTerminal = 0; nTerminal < comp->terminalNumber(); nTerminal++) {
+      copy->terminal(nTerminal)->setPower(comp->terminal(nTerminal)->power());
     }
+    newComponents.push_back(copy);
   }
+}
+
+template <typename VarType>
+void SystemTopology::multiplyPowerComps(Int numberCopies) {
+  typename SimNode<VarType>::List newNodes;
+  typename SimPowerComp<VarType>::List newComponents;
+
+  for (int copy = 0; copy < numberCopies; copy++)
+    copyPowerComps<VarType>("_" + std::to_string(copy + 2), newNodes,
+                            newComponents);
+
   for (auto node : newNodes)
     addNode(node);
   for (auto comp : newComponents)
@@ -236,6 +241,34 @@ void SystemTopology::multiply(Int numCopies) {
   multiplyPowerComps<Complex>(numCopies);
 }
 
+SystemTopology SystemTopology::copy() {
+  for (auto comp : mComponents) {
+    if (!std::dynamic_pointer_cast<SimPowerComp<Real>>(comp) &&
+        !std::dynamic_pointer_cast<SimPowerComp<Complex>>(comp))
+      throw SystemError("copy() not implemented for " + comp->name());
+  }
+
+  SimNode<Real>::List realNodes;
+  SimPowerComp<Real>::List realComponents;
+  SimNode<Complex>::List complexNodes;
+  SimPowerComp<Complex>::List complexComponents;
+  copyPowerComps<Real>("", realNodes, realComponents);
+  copyPowerComps<Complex>("", complexNodes, complexComponents);
+
+  SystemTopology topology(mSystemFrequency);
+  topology.mFrequencies = mFrequencies;
+  for (auto node : realNodes)
+    topology.addNode(node);
+  for (auto node : complexNodes)
+    topology.addNode(node);
+  for (auto comp : realComponents)
+    topology.addComponent(comp);
+  for (auto comp : complexComponents)
+    topology.addComponent(comp);
+  topology.componentsAtNodeList();
+  return topology;
+}
+
 /// DEPRECATED: Unused
 void SystemTopology::reset() {
   // for (auto c : mComponents) {
@@ -0,0 +1,70 @@
+/* Measures the time needed to pack, send, receive and unpack samples with
+ * InterfaceVillasQueueless over a VILLASnode loopback node.
+ *
+ * Usage: QueuelessBenchmark [signals] [steps]
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <chrono>
+#include <string>
+
+#include <DPsim.h>
+#include <dpsim-villas/InterfaceVillasQueueless.h>
+#include <dpsim/TimingStatistics.h>
+
+using namespace DPsim;
+
+int main(int argc, char *argv[]) {
+  UInt signalCount = argc > 1 ? std::stoul(argv[1]) : 200;
+  UInt steps = argc > 2 ? std::stoul(argv[2]) : 100000;
+
+  std::string loopbackConfig = R"STRING({
+      "type": "loopback",
+      "queuelen": 1024
+    })STRING";
+
+  auto intf = std::make_shared<InterfaceVillasQueueless>(
+      loopbackConfig, "QueuelessBenchmark", spdlog::level::off);
+
+  // The first signal carries the sequence number, the others are looped back
+  // from the exported to the imported attributes
+  auto seqOut = CPS::AttributeStatic<Int>::make(0);
+  auto seqIn = CPS::AttributeStatic<Int>::make(0);
+  intf->addExport(seqOut);
+  intf->addImport(seqIn, true, true);
+
+  std::vector<CPS::Attribute<Real>::Ptr> exports;
+  std::vector<CPS::Attribute<Real>::Ptr> imports;
+  for (UInt i = 1; i < signalCount; i++) {
+    exports.push_back(CPS::AttributeStatic<Real>::make(i));
+    imports.push_back(CPS::AttributeStatic<Real>::make(0));
+    intf->addExport(exports.back());
+    intf->addImport(imports.back(), true, true);
+  }
+
+  intf->open();
+
+  TimingStatistics stepTimes;
+  for (UInt step = 0; step < steps; step++) {
+    **seqOut = step;
+    for (auto &attr : exports)
+      **attr += 1;
+
+    auto start = std::chrono::steady_clock::now();
+    intf->syncExports();
+    intf->syncImports();
+    std::chrono::duration<double> duration =
+        std::chrono::steady_clock::now() - start;
+    stepTimes.update(duration.count());
+  }
+
+  intf->close();
+
+  auto log = CPS::Logger::get("QueuelessBenchmark");
+  log->info("Signals: {}, steps: {}", signalCount, steps);
+  log->info("Read errors: {}, write errors: {}", **intf->mReadErrors,
+            **intf->mWriteErrors);
+  stepTimes.logSummary(log, "Round trip");
+  return 0;
+}
@@ -54,6 +54,18 @@ public:
 
   virtual void printVillasSignals() const;
 
+  /// Stamp exported samples with the wall clock time (enabled by default)
+  void setTimestampExports(Bool timestampExports) {
+    mTimestampExports = timestampExports;
+  }
+
+  /// Number of failed reads, the imported attributes keep their values
+  const CPS::Attribute<Int>::Ptr mReadErrors;
+  /// Number of samples which could not be written
+  const CPS::Attribute<Int>::Ptr mWriteErrors;
+  /// Number of received samples with an unexpected sequence number
+  const CPS::Attribute<Int>::Ptr mOverruns;
+
   virtual ~InterfaceVillasQueueless() {
     if (mOpened) {
       try {
@@ -73,9 +85,40 @@ protected:
   virtual Int readFromVillas();
   void createNode();
   void createSignals();
+  void createPlans();
   Int mSequenceToDpsim;
   Int mSequenceFromDpsim;
 
+  /// Attribute of a fixed type and its position in a sample
+  template <typename T> struct SignalMapping {
+    std::shared_ptr<CPS::Attribute<T>> attr;
+    size_t index;
+  };
+
+  /// Typed signal tables which are resolved once in open()
+  struct SignalPlan {
+    std::vector<SignalMapping<Real>> real;
+    std::vector<SignalMapping<Int>> integer;
+    std::vector<SignalMapping<Bool>> boolean;
+    std::vector<SignalMapping<Complex>> complex;
+    size_t length = 0;
+
+    void clear();
+    /// Throws if the type of the attribute cannot be sent over VILLASnode
+    void add(CPS::AttributeBase::Ptr attr, size_t index);
+  };
+
+  SignalPlan mImportPlan;
+  SignalPlan mExportPlan;
+  /// True if the first import is an integer carrying the sequence number
+  Bool mImportSequence = false;
+  Bool mTimestampExports = true;
+  /// Samples reused for every read and, if the node did not keep it, write
+  node::Sample *mReadSample = nullptr;
+  node::Sample *mWriteSample = nullptr;
+
+  node::Sample *allocateWriteSample();
+
 public:
   class PreStep : public CPS::Task {
   public:
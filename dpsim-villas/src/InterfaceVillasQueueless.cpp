@@ -4,6 +4,7 @@
  */
 
 #include <dpsim-villas/InterfaceVillasQueueless.h>
+#include <algorithm>
 #include <dpsim-villas/InterfaceWorkerVillas.h>
 #include <memory>
 #include <spdlog/spdlog.h>
@@ -22,8 +23,12 @@ namespace DPsim {
 InterfaceVillasQueueless::InterfaceVillasQueueless(
     const String &nodeConfig, const String &name,
     spdlog::level::level_enum logLevel)
-    : Interface(name, logLevel), mNodeConfig(nodeConfig), mNode(nullptr),
-      mSamplePool(), mSequenceToDpsim(0), mSequenceFromDpsim(0) {}
+    : Interface(name, logLevel),
+      mReadErrors(AttributeStatic<Int>::make(0)),
+      mWriteErrors(AttributeStatic<Int>::make(0)),
+      mOverruns(AttributeStatic<Int>::make(0)), mNodeConfig(nodeConfig),
+      mNode(nullptr), mSamplePool(), mSequenceToDpsim(0),
+      mSequenceFromDpsim(0) {}
 
 void InterfaceVillasQueueless::createNode() {
   if (villas::node::memory::init(100) != 0) {
@@ -65,8 +70,11 @@ void InterfaceVillasQueueless::createNode() {
     std::exit(1);
   }
   struct villas::node::memory::Type *pool_mt = &villas::node::memory::heap;
+  size_t sampleLength = std::max<size_t>(
+      {64, mImportAttrsDpsim.size(), mExportAttrsDpsim.size()});
   ret = node::pool_init(&mSamplePool, 16,
-                        sizeof(node::Sample) + SAMPLE_DATA_LENGTH(64), pool_mt);
+                        sizeof(node::Sample) + SAMPLE_DATA_LENGTH(sampleLength),
+                        pool_mt);
   if (ret < 0) {
     SPDLOG_LOGGER_ERROR(mLog,
                         "Error: InterfaceVillas failed to init sample pool. "
@@ -137,7 +145,64 @@ void InterfaceVillasQueueless::createSignals() {
   }
 }
 
+void InterfaceVillasQueueless::SignalPlan::clear() {
+  real.clear();
+  integer.clear();
+  boolean.clear();
+  complex.clear();
+  length = 0;
+}
+
+void InterfaceVillasQueueless::SignalPlan::add(AttributeBase::Ptr attr,
+                                               size_t index) {
+  auto &type = attr->getType();
+  if (type == typeid(Real)) {
+    real.push_back(
+        {std::dynamic_pointer_cast<Attribute<Real>>(attr.getPtr()), index});
+  } else if (type == typeid(Int)) {
+    integer.push_back(
+        {std::dynamic_pointer_cast<Attribute<Int>>(attr.getPtr()), index});
+  } else if (type == typeid(Bool)) {
+    boolean.push_back(
+        {std::dynamic_pointer_cast<Attribute<Bool>>(attr.getPtr()), index});
+  } else if (type == typeid(Complex)) {
+    complex.push_back(
+        {std::dynamic_pointer_cast<Attribute<Complex>>(attr.getPtr()), index});
+  } else {
+    throw RuntimeError("Unsupported attribute type!");
+  }
+  length = std::max(length, index + 1);
+}
+
+void InterfaceVillasQueueless::createPlans() {
+  mImportPlan.clear();
+  for (size_t i = 0; i < mImportAttrsDpsim.size(); i++)
+    mImportPlan.add(std::get<0>(mImportAttrsDpsim[i]), i);
+  mImportSequence =
+      !mImportAttrsDpsim.empty() &&
+      std::get<0>(mImportAttrsDpsim[0])->getType() == typeid(Int);
+
+  mExportPlan.clear();
+  for (size_t i = 0; i < mExportAttrsDpsim.size(); i++)
+    mExportPlan.add(std::get<0>(mExportAttrsDpsim[i]), i);
+}
+
+node::Sample *InterfaceVillasQueueless::allocateWriteSample() {
+  node::Sample *sample = node::sample_alloc(&mSamplePool);
+  if (sample == nullptr)
+    return nullptr;
+
+  sample->signals = mNode->getOutputSignals(false);
+  sample->length = mExportPlan.length;
+  sample->flags |= (int)villas::node::SampleFlags::HAS_SEQUENCE;
+  sample->flags |= (int)villas::node::SampleFlags::HAS_DATA;
+  if (mTimestampExports)
+    sample->flags |= (int)villas::node::SampleFlags::HAS_TS_ORIGIN;
+  return sample;
+}
+
 void InterfaceVillasQueueless::open() {
+  createPlans();
   createNode();
   createSignals();
 
@@ -153,9 +218,25 @@ void InterfaceVillasQueueless::open() {
     close();
     std::exit(1);
   }
+
+  if (mImportPlan.length > 0)
+    mReadSample = node::sample_alloc(&mSamplePool);
+  if (mExportPlan.length > 0)
+    mWriteSample = allocateWriteSample();
+  if ((mImportPlan.length > 0 && mReadSample == nullptr) ||
+      (mExportPlan.length > 0 && mWriteSample == nullptr)) {
+    SPDLOG_LOGGER_ERROR(mLog, "Fatal error: InterfaceVillas could not "
+                              "allocate samples from its pool");
+    close();
+    std::exit(1);
+  }
+
   mOpened = true;
   mSequenceFromDpsim = 0;
   mSequenceToDpsim = 0;
+  **mReadErrors = 0;
+  **mWriteErrors = 0;
+  **mOverruns = 0;
 }
 
 void InterfaceVillasQueueless::close() {
@@ -169,6 +250,14 @@ void InterfaceVillasQueueless::close() {
     std::exit(1);
   }
   mOpened = false;
+  if (mReadSample) {
+    node::sample_decref(mReadSample);
+    mReadSample = nullptr;
+  }
+  if (mWriteSample) {
+    node::sample_decref(mWriteSample);
+    mWriteSample = nullptr;
+  }
   ret = node::pool_destroy(&mSamplePool);
   if (ret < 0) {
     SPDLOG_LOGGER_ERROR(mLog,
@@ -198,86 +287,60 @@ CPS::Task::List InterfaceVillasQueueless::getTasks() {
 
 void InterfaceVillasQueueless::PreStep::execute(Real time, Int timeStepCount) {
   auto seqnum = mIntf.readFromVillas();
-  static size_t overrunCounter = 0;
-  if (seqnum != mIntf.mSequenceToDpsim + 1) {
-    overrunCounter++;
-  }
-  if (overrunCounter > 10000) {
-    SPDLOG_LOGGER_WARN(mIntf.mLog, "{} Overrun(s) detected!", overrunCounter);
-    overrunCounter = 0;
+  if (seqnum != mIntf.mSequenceToDpsim &&
+      seqnum != mIntf.mSequenceToDpsim + 1) {
+    Int &overruns = **mIntf.mOverruns;
+    if (++overruns % 10000 == 0) {
+      SPDLOG_LOGGER_WARN(mIntf.mLog, "{} Overrun(s) detected!", overruns);
+    }
   }
   mIntf.mSequenceToDpsim = seqnum;
 }
 
 Int InterfaceVillasQueueless::readFromVillas() {
-  node::Sample *sample = nullptr;
-  Int seqnum = 0;
-  int ret = 0;
-  if (mImportAttrsDpsim.size() == 0) {
+  if (mImportPlan.length == 0) {
     return 0;
   }
-  try {
-    sample = node::sample_alloc(&mSamplePool);
-    ret = 0;
-    while (ret == 0) {
-      ret = mNode->read(&sample, 1);
-      if (ret < 0) {
-        SPDLOG_LOGGER_ERROR(mLog,
-                            "Fatal error: failed to read sample from "
-                            "InterfaceVillas. Read returned code {}",
-                            ret);
-        close();
-        std::exit(1);
-      } else if (ret == 0) {
-        SPDLOG_LOGGER_WARN(mLog,
-                           "InterfaceVillas read returned 0. Retrying...");
-      }
-    }
 
-    if (sample->length != mImportAttrsDpsim.size()) {
-      SPDLOG_LOGGER_ERROR(mLog,
-                          "Error: Received Sample length ({}) does not match "
-                          "configured attributes length ({})",
-                          sample->length, mImportAttrsDpsim.size());
-      throw RuntimeError(
-          "Received Sample length does not match configured attributes length");
-    }
-
-    for (size_t i = 0; i < mImportAttrsDpsim.size(); i++) {
-      auto attr = std::get<0>(mImportAttrsDpsim[i]);
-      if (attr->getType() == typeid(Real)) {
-        auto attrReal =
-            std::dynamic_pointer_cast<Attribute<Real>>(attr.getPtr());
-        attrReal->set(sample->data[i].f);
-      } else if (attr->getType() == typeid(Int)) {
-        auto attrInt = std::dynamic_pointer_cast<Attribute<Int>>(attr.getPtr());
-        attrInt->set(sample->data[i].i);
-        if (i == 0) {
-          seqnum = sample->data[i].i;
-        }
-      } else if (attr->getType() == typeid(Bool)) {
-        auto attrBool =
-            std::dynamic_pointer_cast<Attribute<Bool>>(attr.getPtr());
-        attrBool->set(sample->data[i].b);
-      } else if (attr->getType() == typeid(Complex)) {
-        auto attrComplex =
-            std::dynamic_pointer_cast<Attribute<Complex>>(attr.getPtr());
-        attrComplex->set(
-            Complex(sample->data[i].z.real(), sample->data[i].z.imag()));
-      } else {
-        SPDLOG_LOGGER_ERROR(mLog, "Error: Unsupported attribute type!");
-        throw RuntimeError("Unsupported attribute type!");
-      }
+  int ret = 0;
+  while (ret == 0) {
+    ret = mNode->read(&mReadSample, 1);
+    if (ret == 0) {
+      SPDLOG_LOGGER_WARN(mLog, "InterfaceVillas read returned 0. Retrying...");
     }
+  }
+  if (ret < 0) {
+    // Keep the previous values and let the simulation continue
+    ++**mReadErrors;
+    SPDLOG_LOGGER_ERROR(mLog,
+                        "Error: failed to read sample from InterfaceVillas. "
+                        "Read returned code {}",
+                        ret);
+    return mSequenceToDpsim;
+  }
 
-    sample_decref(sample);
-  } catch (const std::exception &) {
-    if (sample)
-      sample_decref(sample);
+  const node::Sample *sample = mReadSample;
+  if (sample->length != mImportPlan.length) {
+    SPDLOG_LOGGER_ERROR(mLog,
+                        "Error: Received Sample length ({}) does not match "
+                        "configured attributes length ({})",
+                        sample->length, mImportPlan.length);
+    throw RuntimeError(
+        "Received Sample length does not match configured attributes length");
+  }
 
-    throw;
+  for (auto &signal : mImportPlan.real)
+    signal.attr->set(sample->data[signal.index].f);
+  for (auto &signal : mImportPlan.integer)
+    signal.attr->set(sample->data[signal.index].i);
+  for (auto &signal : mImportPlan.boolean)
+    signal.attr->set(sample->data[signal.index].b);
+  for (auto &signal : mImportPlan.complex) {
+    auto &value = sample->data[signal.index].z;
+    signal.attr->set(Complex(value.real(), value.imag()));
   }
-  return seqnum;
+
+  return mImportSequence ? sample->data[0].i : 0;
 }
 
 void InterfaceVillasQueueless::PostStep::execute(Real time, Int timeStepCount) {
@@ -285,72 +348,51 @@ void InterfaceVillasQueueless::PostStep::execute(Real time, Int timeStepCount) {
 }
 
 void InterfaceVillasQueueless::writeToVillas() {
-  if (mExportAttrsDpsim.size() == 0) {
+  if (mExportPlan.length == 0) {
     return;
   }
-  node::Sample *sample = nullptr;
-  Int ret = 0;
-  try {
-    sample = node::sample_alloc(&mSamplePool);
-    if (sample == nullptr) {
+
+  // Nodes which queue samples keep a reference, so the sample can only be
+  // reused once they have released it
+  if (mWriteSample == nullptr || mWriteSample->refcnt > 1) {
+    if (mWriteSample)
+      node::sample_decref(mWriteSample);
+    mWriteSample = allocateWriteSample();
+    if (mWriteSample == nullptr) {
+      ++**mWriteErrors;
       SPDLOG_LOGGER_ERROR(mLog, "InterfaceVillas could not allocate a new "
                                 "sample! Not sending any data!");
       return;
     }
+  }
 
-    sample->signals = mNode->getOutputSignals(false);
-
-    for (size_t i = 0; i < mExportAttrsDpsim.size(); i++) {
-      auto attr = std::get<0>(mExportAttrsDpsim[i]);
-      if (attr->getType() == typeid(Real)) {
-        auto attrReal =
-            std::dynamic_pointer_cast<Attribute<Real>>(attr.getPtr());
-        sample->data[i].f = attrReal->get();
-      } else if (attr->getType() == typeid(Int)) {
-        auto attrInt = std::dynamic_pointer_cast<Attribute<Int>>(attr.getPtr());
-        sample->data[i].i = attrInt->get();
-      } else if (attr->getType() == typeid(Bool)) {
-        auto attrBool =
-            std::dynamic_pointer_cast<Attribute<Bool>>(attr.getPtr());
-        sample->data[i].b = attrBool->get();
-      } else if (attr->getType() == typeid(Complex)) {
-        auto attrComplex =
-            std::dynamic_pointer_cast<Attribute<Complex>>(attr.getPtr());
-        sample->data[i].z = std::complex<float>(attrComplex->get().real(),
-                                                attrComplex->get().imag());
-      } else {
-        SPDLOG_LOGGER_ERROR(mLog, "Error: Unsupported attribute type!");
-        throw RuntimeError("Unsupported attribute type!");
-      }
-    }
+  node::Sample *sample = mWriteSample;
+  for (auto &signal : mExportPlan.real)
+    sample->data[signal.index].f = signal.attr->get();
+  for (auto &signal : mExportPlan.integer)
+    sample->data[signal.index].i = signal.attr->get();
+  for (auto &signal : mExportPlan.boolean)
+    sample->data[signal.index].b = signal.attr->get();
+  for (auto &signal : mExportPlan.complex) {
+    const Complex &value = signal.attr->get();
+    sample->data[signal.index].z =
+        std::complex<float>(value.real(), value.imag());
+  }
 
-    sample->length = mExportAttrsDpsim.size();
-    sample->sequence = mSequenceFromDpsim++;
-    sample->flags |= (int)villas::node::SampleFlags::HAS_SEQUENCE;
-    sample->flags |= (int)villas::node::SampleFlags::HAS_DATA;
+  sample->sequence = mSequenceFromDpsim++;
+  if (mTimestampExports)
     clock_gettime(CLOCK_REALTIME, &sample->ts.origin);
-    sample->flags |= (int)villas::node::SampleFlags::HAS_TS_ORIGIN;
 
-    do {
-      ret = mNode->write(&sample, 1);
-    } while (ret == 0);
-    if (ret < 0)
-      SPDLOG_LOGGER_ERROR(mLog,
-                          "Failed to write samples to InterfaceVillas. Write "
-                          "returned code {}",
-                          ret);
-
-    sample_decref(sample);
-  } catch (const std::exception &) {
-    sample_decref(sample);
-
-    if (ret < 0)
-      SPDLOG_LOGGER_ERROR(
-          mLog,
-          "Failed to write samples to InterfaceVillas. Write returned code {}",
-          ret);
-
-    // Don't throw here, because we managed to send something
+  Int ret = 0;
+  do {
+    ret = mNode->write(&sample, 1);
+  } while (ret == 0);
+  if (ret < 0) {
+    ++**mWriteErrors;
+    SPDLOG_LOGGER_ERROR(mLog,
+                        "Failed to write samples to InterfaceVillas. Write "
+                        "returned code {}",
+                        ret);
   }
 }
 
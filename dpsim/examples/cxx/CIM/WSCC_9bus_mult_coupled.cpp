@@ -6,6 +6,7 @@
  * file, You can obtain one at https://mozilla.org/MPL/2.0/.
  *********************************************************************************/
 
+#include <chrono>
 #include <fstream>
 #include <iostream>
 #include <list>
@@ -106,6 +107,65 @@ void simulateCoupled(std::list<fs::path> filenames, CommandLineArgs &args,
   sim.logStepTimes(simName + "_step_times");
 }
 
+// Compares the step times with the right side vector stamps summed up at
+// the components' rows only and with full vector additions
+void benchmarkRightVector(std::list<fs::path> filenames, CommandLineArgs &args,
+                          Int copies, Bool sparse) {
+  String simName = "WSCC_9bus_coupled_rhs_" + std::to_string(copies) + "_" +
+                   (sparse ? "sparse" : "dense");
+  Logger::setLogDir("logs/" + simName);
+
+  CIM::Reader reader(simName, Logger::Level::off, Logger::Level::off);
+  SystemTopology sys =
+      reader.loadCIM(60, filenames, Domain::DP, PhaseType::Single,
+                     CPS::GeneratorType::IdealVoltageSource);
+
+  if (copies > 0)
+    multiply_connected(sys, copies, 12.5, 0.16, 1e-6);
+
+  Simulation sim(simName, Logger::Level::off);
+  sim.setSystem(sys);
+  sim.setTimeStep(args.timeStep);
+  sim.setFinalTime(args.duration);
+  sim.setDomain(Domain::DP);
+  sim.doSparseRightVector(sparse);
+  sim.run();
+
+  std::cout << copies << "\t" << (sparse ? "sparse" : "dense") << "\t"
+            << sim.stepTimes().mean() * 1e6 << "\t"
+            << sim.stepTimes().percentile(0.99) * 1e6 << std::endl;
+}
+
+// Measures the time to load the system and to initialize the simulation,
+// which includes the assembly and factorization of the system matrix
+void benchmarkStartup(std::list<fs::path> filenames, Int copies,
+                      Logger::Level logLevel) {
+  String simName = "WSCC_9bus_coupled_startup_" + std::to_string(copies);
+  Logger::setLogDir("logs/" + simName);
+
+  auto start = std::chrono::steady_clock::now();
+  CIM::Reader reader(simName, logLevel, Logger::Level::off);
+  SystemTopology sys =
+      reader.loadCIM(60, filenames, Domain::DP, PhaseType::Single,
+                     CPS::GeneratorType::IdealVoltageSource);
+  if (copies > 0)
+    multiply_connected(sys, copies, 12.5, 0.16, 1e-6);
+  auto loaded = std::chrono::steady_clock::now();
+
+  Simulation sim(simName, logLevel);
+  sim.setSystem(sys);
+  sim.setDomain(Domain::DP);
+  sim.initialize();
+  auto initialized = std::chrono::steady_clock::now();
+
+  std::chrono::duration<Real> loadTime = loaded - start;
+  std::chrono::duration<Real> initTime = initialized - loaded;
+  std::cout << copies << "\t" << sys.mNodes.size() << "\t"
+            << spdlog::level::to_string_view(logLevel).data() << "\t"
+            << loadTime.count() * 1e3 << "\t" << initTime.count() * 1e3
+            << std::endl;
+}
+
 int main(int argc, char *argv[]) {
   CommandLineArgs args(argc, argv);
   args.timeStep = 0.0001;
@@ -135,6 +195,26 @@ int main(int argc, char *argv[]) {
   if (args.options.find("seq") != args.options.end())
     numSeq = args.getOptionInt("seq");
 
+  // Run with increasing numbers of copies up to the given number
+  if (args.options.find("startup_benchmark") != args.options.end()) {
+    std::cout << "copies\tnodes\tlog\tload [ms]\tinitialize [ms]"
+              << std::endl;
+    // Messages below the log level must not cost any formatting
+    for (Int copies = 0; copies <= numCopies; copies++) {
+      benchmarkStartup(filenames, copies, Logger::Level::off);
+      benchmarkStartup(filenames, copies, Logger::Level::info);
+    }
+    return 0;
+  }
+  if (args.options.find("rhs_benchmark") != args.options.end()) {
+    std::cout << "copies\trhs\tmean [us]\tp99 [us]" << std::endl;
+    for (Int copies = 0; copies <= numCopies; copies++) {
+      benchmarkRightVector(filenames, args, copies, false);
+      benchmarkRightVector(filenames, args, copies, true);
+    }
+    return 0;
+  }
+
   std::cout << "Simulate with " << numCopies << " copies, " << numThreads
             << " threads, sequence number " << numSeq << std::endl;
 
@@ -105,6 +105,11 @@ void simulateDiakoptics(std::list<fs::path> filenames, Int copies, Int threads,
 
   sim.run();
   sim.logStepTimes(simName + "_step_times");
+
+  auto &stepTimes = sim.stepTimes();
+  std::cout << copies << "\t" << threads << "\t" << splits << "\t"
+            << stepTimes.mean() * 1e6 << "\t"
+            << stepTimes.percentile(0.99) * 1e6 << std::endl;
 }
 
 int main(int argc, char *argv[]) {
@@ -138,6 +143,14 @@ int main(int argc, char *argv[]) {
   if (args.options.find("splits") != args.options.end())
     numSplits = args.getOptionInt("splits");
 
+  // Scaling benchmark: step times for all numbers of splits
+  if (args.options.find("scaling") != args.options.end()) {
+    std::cout << "copies\tthreads\tsplits\tmean [us]\tp99 [us]" << std::endl;
+    for (Int splits = 1; splits <= numCopies + 1; splits++)
+      simulateDiakoptics(filenames, numCopies, numThreads, splits, numSeq);
+    return 0;
+  }
+
   std::cout << "Simulate with " << numCopies << " copies, " << numThreads
             << " threads, " << numSplits << " splits, sequence number "
             << numSeq << std::endl;
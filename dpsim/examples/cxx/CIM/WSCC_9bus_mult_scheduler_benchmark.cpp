@@ -0,0 +1,132 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <iostream>
+#include <list>
+
+#include <DPsim.h>
+#include <dpsim/SequentialScheduler.h>
+#include <dpsim/ThreadLevelScheduler.h>
+#include <dpsim/ThreadListScheduler.h>
+#include <dpsim/WorkStealingScheduler.h>
+
+using namespace DPsim;
+using namespace CPS;
+
+// Compares the step times of the task schedulers on replicated WSCC 9-bus
+// systems that are connected by decoupling lines, so every copy is solved
+// as a separate subnet.
+//
+// Options:
+//   copies:    number of additional copies of the system (default 0..8)
+//   threads:   number of threads of the parallel schedulers (default 4)
+//   scheduler: only run one of sequential, openmp, level, list, stealing
+
+void multiply_decoupled(SystemTopology &sys, int copies, Real resistance,
+                        Real inductance, Real capacitance) {
+
+  sys.multiply(copies);
+  std::vector<String> nodes = {"BUS5", "BUS8", "BUS6"};
+
+  for (auto orig_node : nodes) {
+    std::vector<String> nodeNames{orig_node};
+    for (int i = 2; i <= copies + 1; i++) {
+      nodeNames.push_back(orig_node + "_" + std::to_string(i));
+    }
+    nodeNames.push_back(orig_node);
+    int nlines = copies == 1 ? 1 : copies + 1;
+
+    for (int i = 0; i < nlines; i++) {
+      auto line = Signal::DecouplingLine::make(
+          "dline_" + orig_node + "_" + std::to_string(i),
+          sys.node<DP::SimNode>(nodeNames[i]),
+          sys.node<DP::SimNode>(nodeNames[i + 1]), resistance, inductance,
+          capacitance, Logger::Level::off);
+      sys.addComponent(line);
+      sys.addComponents(line->getLineComponents());
+    }
+  }
+}
+
+std::shared_ptr<Scheduler> makeScheduler(const String &name, Int threads) {
+  if (name == "sequential")
+    return std::make_shared<SequentialScheduler>();
+#ifdef WITH_OPENMP
+  if (name == "openmp")
+    return std::make_shared<OpenMPLevelScheduler>(threads);
+#endif
+  if (name == "level")
+    return std::make_shared<ThreadLevelScheduler>(threads);
+  if (name == "list")
+    return std::make_shared<ThreadListScheduler>(threads);
+  if (name == "stealing")
+    return std::make_shared<WorkStealingScheduler>(threads);
+  return nullptr;
+}
+
+void benchmark(const std::list<fs::path> &filenames, Int copies,
+               const String &schedulerName, Int threads) {
+  auto scheduler = makeScheduler(schedulerName, threads);
+  if (!scheduler)
+    return;
+
+  String simName = "WSCC_9bus_scheduler_" + schedulerName + "_" +
+                   std::to_string(copies) + "_" + std::to_string(threads);
+  Logger::setLogDir("logs/" + simName);
+
+  CIM::Reader reader(simName, Logger::Level::off, Logger::Level::off);
+  SystemTopology sys =
+      reader.loadCIM(60, filenames, Domain::DP, PhaseType::Single,
+                     CPS::GeneratorType::IdealVoltageSource);
+
+  if (copies > 0)
+    multiply_decoupled(sys, copies, 12.5, 0.16, 1e-6);
+
+  Simulation sim(simName, Logger::Level::off);
+  sim.setSystem(sys);
+  sim.setTimeStep(0.0001);
+  sim.setFinalTime(0.2);
+  sim.setDomain(Domain::DP);
+  sim.setScheduler(scheduler);
+  sim.run();
+
+  auto &stepTimes = sim.stepTimes();
+  std::cout << schedulerName << "\t" << copies << "\t" << threads << "\t"
+            << stepTimes.mean() * 1e6 << "\t"
+            << stepTimes.percentile(0.99) * 1e6 << "\t"
+            << stepTimes.max() * 1e6 << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+  CommandLineArgs args(argc, argv);
+
+  std::list<fs::path> filenames;
+  filenames = DPsim::Utils::findFiles(
+      {"WSCC-09_RX_DI.xml", "WSCC-09_RX_EQ.xml", "WSCC-09_RX_SV.xml",
+       "WSCC-09_RX_TP.xml"},
+      "build/_deps/cim-data-src/WSCC-09/WSCC-09_RX", "CIMPATH");
+
+  std::vector<Int> copies = {0, 1, 2, 4, 8};
+  std::vector<String> schedulers = {"sequential", "openmp", "level", "list",
+                                    "stealing"};
+  Int threads = 4;
+
+  if (args.options.find("copies") != args.options.end())
+    copies = {args.getOptionInt("copies")};
+  if (args.options.find("threads") != args.options.end())
+    threads = args.getOptionInt("threads");
+  if (args.options.find("scheduler") != args.options.end())
+    schedulers = {args.getOptionString("scheduler")};
+
+  std::cout << "scheduler\tcopies\tthreads\tmean [us]\tp99 [us]\tmax [us]"
+            << std::endl;
+  for (Int numCopies : copies) {
+    for (auto &scheduler : schedulers)
+      benchmark(filenames, numCopies, scheduler, threads);
+  }
+}
@@ -0,0 +1,69 @@
+/* Copyright 2017-2024 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <DPsim.h>
+
+using namespace DPsim;
+using namespace CPS::DP;
+using namespace CPS::DP::Ph1;
+
+/*
+ * Sweeps the resistance of an RL circuit in an ensemble of simulations, e.g.
+ * DP_Ensemble_RL -o members=64 -o threads=8
+ */
+
+int main(int argc, char *argv[]) {
+  CommandLineArgs args(argc, argv);
+
+  UInt members = 16;
+  UInt threads = 0;
+  if (args.options.find("members") != args.options.end())
+    members = args.getOptionInt("members");
+  if (args.options.find("threads") != args.options.end())
+    threads = args.getOptionInt("threads");
+
+  String simName = "DP_Ensemble_RL";
+  Logger::setLogDir("logs/" + simName);
+
+  // Nodes
+  auto n1 = SimNode::make("n1");
+  auto n2 = SimNode::make("n2");
+
+  // Components
+  auto vs = VoltageSource::make("vs");
+  vs->setParameters(Complex(10, 0));
+  auto r1 = Resistor::make("r_1");
+  r1->setParameters(5);
+  auto l1 = Inductor::make("l_1");
+  l1->setParameters(0.02);
+
+  // Connections
+  vs->connect(SimNode::List{SimNode::GND, n1});
+  r1->connect(SimNode::List{n1, n2});
+  l1->connect(SimNode::List{n2, SimNode::GND});
+
+  auto sys = SystemTopology(50, SystemNodeList{n1, n2},
+                            SystemComponentList{vs, r1, l1});
+
+  EnsembleSimulation ensemble(simName, sys, Logger::Level::off);
+  ensemble.setTimeStep(0.0001);
+  ensemble.setFinalTime(0.1);
+  ensemble.setThreads(threads);
+  ensemble.logAttribute("i", "l_1", "i_intf");
+  for (UInt member = 0; member < members; member++) {
+    ensemble.addMember({"r" + std::to_string(member),
+                        {{"r_1", "R", 1. + member * 0.5}}});
+  }
+  ensemble.run();
+  ensemble.writeCSV("logs/" + simName + "/" + simName + ".csv");
+
+  UInt failed = 0;
+  for (auto &error : ensemble.errors())
+    failed += error.empty() ? 0 : 1;
+  return failed > 0 ? 1 : 0;
+}
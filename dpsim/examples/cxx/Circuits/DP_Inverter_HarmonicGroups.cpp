@@ -0,0 +1,128 @@
+/* Copyright 2017-2024 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <DPsim.h>
+
+using namespace DPsim;
+using namespace CPS::DP;
+using namespace CPS::DP::Ph1;
+
+/*
+ * Checks the frequency-parallel solution of harmonics against the solution
+ * of all frequencies in one system. In the resistive network all frequencies
+ * have the same system matrix and are solved together in one group, in the
+ * grid with inductors and capacitors each frequency is solved on its own.
+ * Returns 1 if the node voltages differ.
+ */
+
+SystemTopology buildSystem(Bool resistive, SimNode::List &nodes) {
+  Matrix frequencies(9, 1);
+  frequencies << 50, 19850, 19950, 20050, 20150, 39750, 39950, 40050, 40250;
+
+  Logger::Level level = Logger::Level::off;
+
+  // Nodes
+  auto n1 = SimNode::make("n1");
+  auto n2 = SimNode::make("n2");
+  auto n3 = SimNode::make("n3");
+  nodes = SimNode::List{n1, n2, n3};
+
+  // Components
+  auto inv = Inverter::make("inv", level);
+  inv->setParameters(std::vector<CPS::Int>{2, 2, 2, 2, 4, 4, 4, 4},
+                     std::vector<CPS::Int>{-3, -1, 1, 3, -5, -1, 1, 5}, 360,
+                     0.87, 0);
+  auto r1 = Resistor::make("r1", level);
+  r1->setParameters(0.1);
+  inv->connect({n1});
+  r1->connect({n1, n2});
+
+  if (resistive) {
+    auto r2 = Resistor::make("r2", level);
+    r2->setParameters(10);
+    auto r3 = Resistor::make("r3", level);
+    r3->setParameters(5);
+    auto r4 = Resistor::make("r4", level);
+    r4->setParameters(20);
+    r2->connect({n2, SimNode::GND});
+    r3->connect({n2, n3});
+    r4->connect({n3, SimNode::GND});
+
+    return SystemTopology(50, frequencies, SystemNodeList{n1, n2, n3},
+                          SystemComponentList{inv, r1, r2, r3, r4});
+  }
+
+  auto l1 = Inductor::make("l1", level);
+  l1->setParameters(600e-6);
+  auto c1 = Capacitor::make("c1", level);
+  c1->setParameters(10e-6);
+  auto r2 = Resistor::make("r2", level);
+  r2->setParameters(0.101);
+  l1->connect({n2, n3});
+  c1->connect({SimNode::GND, n3});
+  r2->connect({n3, SimNode::GND});
+
+  return SystemTopology(50, frequencies, SystemNodeList{n1, n2, n3},
+                        SystemComponentList{inv, r1, l1, c1, r2});
+}
+
+Bool compare(const String &simName, Bool resistive) {
+  Logger::setLogDir("logs/" + simName);
+
+  SimNode::List nodesSeq, nodesPar;
+  Simulation simSeq(simName + "_Sequential", Logger::Level::off);
+  simSeq.setSystem(buildSystem(resistive, nodesSeq));
+  Simulation simPar(simName + "_Parallel", Logger::Level::off);
+  simPar.setSystem(buildSystem(resistive, nodesPar));
+  simPar.doFrequencyParallelization(true);
+
+  for (auto sim : {&simSeq, &simPar}) {
+    sim->setTimeStep(0.000001);
+    sim->setFinalTime(0.002);
+    sim->start();
+  }
+
+  Real maxError = 0;
+  Bool finite = true;
+  while (simSeq.time() < simSeq.finalTime()) {
+    simSeq.step();
+    simPar.step();
+    for (UInt node = 0; node < nodesSeq.size(); ++node) {
+      const MatrixComp &vSeq = **nodesSeq[node]->mVoltage;
+      const MatrixComp &vPar = **nodesPar[node]->mVoltage;
+      Real error = (vSeq - vPar).cwiseAbs().maxCoeff() /
+                   std::max(1.0, vSeq.cwiseAbs().maxCoeff());
+      finite &= std::isfinite(error);
+      maxError = std::max(maxError, error);
+    }
+  }
+  simSeq.stop();
+  simPar.stop();
+
+  std::cout << simName << ": maximum relative error " << maxError
+            << std::endl;
+  return finite && maxError < 1e-6;
+}
+
+int main(int argc, char *argv[]) {
+  Bool failed = false;
+
+  if (!compare("DP_Inverter_HarmonicGroups_Resistive", true)) {
+    std::cerr << "Grouped harmonics differ from the sequential solution"
+              << std::endl;
+    failed = true;
+  }
+
+  if (!compare("DP_Inverter_HarmonicGroups_Grid", false)) {
+    std::cerr << "Separate harmonics differ from the sequential solution"
+              << std::endl;
+    failed = true;
+  }
+
+  return failed ? 1 : 0;
+}
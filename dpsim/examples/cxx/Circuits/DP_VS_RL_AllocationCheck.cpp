@@ -0,0 +1,105 @@
+/* Copyright 2017-2024 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <DPsim.h>
+#include <dpsim/AllocationCounter.h>
+#include <dpsim/ThreadLevelScheduler.h>
+
+using namespace DPsim;
+using namespace CPS::DP;
+using namespace CPS::DP::Ph1;
+
+/*
+ * Checks the allocation check of the simulation steps. A simulation with a
+ * thread scheduler and an asynchronous data logger must not report
+ * allocations, while an event that allocates must be detected.
+ * Returns 1 if the check fails.
+ */
+
+/// Event that allocates heap memory when it is executed
+class AllocatingEvent : public Event {
+public:
+  AllocatingEvent(Real time) : Event(time) {}
+
+  void execute() override {
+    mData = std::make_unique<std::vector<Real>>(1024);
+  }
+
+private:
+  std::unique_ptr<std::vector<Real>> mData;
+};
+
+Bool simulate(const String &simName, Bool allocate) {
+  Logger::setLogDir("logs/" + simName);
+
+  // Nodes
+  auto n1 = SimNode::make("n1");
+  auto n2 = SimNode::make("n2");
+
+  // Components
+  auto vs = VoltageSource::make("vs");
+  vs->setParameters(Complex(10, 0));
+  auto r1 = Resistor::make("r_1");
+  r1->setParameters(5);
+  auto l1 = Inductor::make("l_1");
+  l1->setParameters(0.02);
+
+  // Connections
+  vs->connect(SimNode::List{SimNode::GND, n1});
+  r1->connect(SimNode::List{n1, n2});
+  l1->connect(SimNode::List{n2, SimNode::GND});
+
+  auto sys = SystemTopology(50, SystemNodeList{n1, n2},
+                            SystemComponentList{vs, r1, l1});
+
+  // The writer thread of the logger allocates, which must not be counted
+  auto logger = DataLogger::make(simName);
+  logger->setAsyncBuffer(1024);
+  logger->logAttribute("v1", n1->attribute("v"));
+  logger->logAttribute("v2", n2->attribute("v"));
+
+  Simulation sim(simName, Logger::Level::off);
+  sim.setSystem(sys);
+  sim.setTimeStep(0.0001);
+  sim.setFinalTime(0.1);
+  sim.setScheduler(std::make_shared<ThreadLevelScheduler>(2));
+  sim.addLogger(logger);
+  sim.doAllocationCheck(true);
+  if (allocate)
+    sim.addEvent(std::make_shared<AllocatingEvent>(0.05));
+
+  sim.start();
+  try {
+    while (sim.time() < sim.finalTime())
+      sim.step();
+  } catch (const CPS::SystemError &e) {
+    std::cout << simName << ": " << e.descr() << std::endl;
+    sim.stop();
+    return false;
+  }
+  sim.stop();
+  return true;
+}
+
+int main(int argc, char *argv[]) {
+  Bool failed = false;
+
+  if (!simulate("DP_VS_RL_AllocationCheck", false)) {
+    std::cerr << "Allocations reported for an allocation-free simulation"
+              << std::endl;
+    failed = true;
+  }
+
+  if (AllocationCounter::isSupported() &&
+      simulate("DP_VS_RL_AllocationCheck_Event", true)) {
+    std::cerr << "Allocation of an event was not detected" << std::endl;
+    failed = true;
+  }
+
+  return failed ? 1 : 0;
+}
@@ -0,0 +1,104 @@
+/* Copyright 2017-2024 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <limits>
+
+#include <DPsim.h>
+
+using namespace DPsim;
+using namespace CPS::DP;
+using namespace CPS::DP::Ph1;
+
+/*
+ * Checks the restamping of variable elements when the system matrix is
+ * recomputed. The variable conductance starts at zero, so the values it
+ * writes to are zero during initialization. Returns 1 if the node voltages
+ * differ from the analytical solution.
+ */
+
+/// Resistor whose resistance can be changed during the simulation. It does
+/// not declare its system matrix entries.
+class VariableResistor : public Resistor,
+                         public CPS::MNAVariableCompInterface {
+public:
+  VariableResistor(String name) : Resistor(name, name) {}
+
+  Bool hasParameterChanged() override {
+    if (**mResistance == mStampedResistance)
+      return false;
+    mStampedResistance = **mResistance;
+    return true;
+  }
+
+private:
+  Real mStampedResistance = std::numeric_limits<Real>::infinity();
+};
+
+int main(int argc, char *argv[]) {
+  String simName = "DP_VariableConductance_Restamp";
+  Logger::setLogDir("logs/" + simName);
+
+  // Nodes
+  auto n1 = SimNode::make("n1");
+  auto n2 = SimNode::make("n2");
+  auto n3 = SimNode::make("n3");
+
+  // Components
+  auto vs = VoltageSource::make("vs");
+  vs->setParameters(Complex(10, 0));
+  auto r1 = Resistor::make("r_1");
+  r1->setParameters(1);
+  auto r2 = Resistor::make("r_2");
+  r2->setParameters(1);
+  auto r3 = Resistor::make("r_3");
+  r3->setParameters(1);
+  auto rVar = std::make_shared<VariableResistor>("r_var");
+  rVar->setParameters(std::numeric_limits<Real>::infinity());
+
+  // Connections
+  vs->connect(SimNode::List{SimNode::GND, n1});
+  r1->connect(SimNode::List{n1, n2});
+  r2->connect(SimNode::List{n2, SimNode::GND});
+  rVar->connect(SimNode::List{n2, n3});
+  r3->connect(SimNode::List{n3, SimNode::GND});
+
+  auto sys = SystemTopology(50, SystemNodeList{n1, n2, n3},
+                            SystemComponentList{vs, r1, r2, r3, rVar});
+
+  Simulation sim(simName, Logger::Level::off);
+  sim.setSystem(sys);
+  sim.setTimeStep(0.0001);
+  sim.setFinalTime(0.1);
+  sim.doSystemMatrixRecomputation(true);
+  sim.start();
+
+  // Resistance of the variable resistor and expected voltages of n2 and n3
+  std::vector<std::tuple<Real, Real, Real>> cases = {
+      {std::numeric_limits<Real>::infinity(), 5, 0},
+      {1, 4, 2},
+      {std::numeric_limits<Real>::infinity(), 5, 0},
+      {0.5, 3.75, 2.5}};
+
+  Bool failed = false;
+  for (auto &c : cases) {
+    **rVar->mResistance = std::get<0>(c);
+    sim.runFor(10);
+    Complex v2 = n2->singleVoltage();
+    Complex v3 = n3->singleVoltage();
+    if (std::abs(v2 - std::get<1>(c)) > 1e-9 ||
+        std::abs(v3 - std::get<2>(c)) > 1e-9) {
+      std::cerr << "R = " << std::get<0>(c) << ": v2 = " << v2
+                << ", v3 = " << v3 << ", expected " << std::get<1>(c) << ", "
+                << std::get<2>(c) << std::endl;
+      failed = true;
+    }
+  }
+  sim.stop();
+
+  return failed ? 1 : 0;
+}
@@ -0,0 +1,123 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <chrono>
+
+#include <DPsim.h>
+#include <dpsim/InterfaceQueued.h>
+#include <dpsim/InterfaceWorker.h>
+#include <dpsim/TimingStatistics.h>
+
+using namespace DPsim;
+
+/*
+ * Compares the export of one packet per attribute with batched frames in
+ * InterfaceQueued. A stub worker discards the values and measures the time
+ * from the export of a step until it reaches the worker, e.g.
+ * InterfaceQueued_Benchmark -o signals=200 -o steps=100000
+ */
+
+using Clock = std::chrono::steady_clock;
+
+class StubWorker : public InterfaceWorker {
+public:
+  explicit StubWorker(const std::vector<Clock::time_point> &pushTimes)
+      : mPushTimes(pushTimes) {}
+
+  void readValuesFromEnv(
+      std::vector<InterfaceQueued::AttributePacket> &updatedAttrs) override {}
+
+  void writeValuesToEnv(
+      std::vector<InterfaceQueued::AttributePacket> &updatedAttrs) override {
+    for (const auto &packet : updatedAttrs) {
+      // The first export carries the step number
+      if (packet.attributeId == 0)
+        received(std::dynamic_pointer_cast<CPS::Attribute<Int>>(
+                     packet.value.getPtr())
+                     ->get());
+    }
+    updatedAttrs.clear();
+  }
+
+  void writeFrameToEnv(const InterfaceQueued::AttributeFrame &frame) override {
+    received(static_cast<Int>(frame.values[(*frame.slots)[0].offset]));
+  }
+
+  void open() override {}
+  void close() override {}
+
+  TimingStatistics mLatency;
+  std::atomic<UInt> mReceived{0};
+
+private:
+  void received(Int step) {
+    mLatency.update(
+        std::chrono::duration<double>(Clock::now() - mPushTimes[step])
+            .count());
+    mReceived++;
+  }
+
+  const std::vector<Clock::time_point> &mPushTimes;
+};
+
+void benchmark(Bool batched, UInt signals, UInt steps,
+               CPS::Logger::Log log) {
+  std::vector<Clock::time_point> pushTimes(steps);
+  auto worker = std::make_shared<StubWorker>(pushTimes);
+  auto intf = std::make_shared<InterfaceQueued>(worker, "Benchmark");
+  intf->setBatchedExports(batched);
+
+  auto step = CPS::AttributeStatic<Int>::make(0);
+  intf->addExport(step);
+  std::vector<CPS::Attribute<Real>::Ptr> values;
+  for (UInt i = 1; i < signals; i++) {
+    values.push_back(CPS::AttributeStatic<Real>::make(i));
+    intf->addExport(values.back());
+  }
+
+  intf->open();
+
+  TimingStatistics pushStats;
+  auto start = Clock::now();
+  for (UInt i = 0; i < steps; i++) {
+    **step = i;
+    for (auto &value : values)
+      **value += 1;
+
+    pushTimes[i] = Clock::now();
+    intf->pushDpsimAttrsToQueue();
+    pushStats.update(
+        std::chrono::duration<double>(Clock::now() - pushTimes[i]).count());
+  }
+  intf->close();
+  std::chrono::duration<double> duration = Clock::now() - start;
+
+  String mode = batched ? "Frames" : "Packets";
+  log->info("{}: {} of {} steps delivered, {:.0f} steps/s", mode,
+            worker->mReceived.load(), steps,
+            worker->mReceived.load() / duration.count());
+  pushStats.logSummary(log, mode + " export");
+  worker->mLatency.logSummary(log, mode + " latency");
+}
+
+int main(int argc, char *argv[]) {
+  CommandLineArgs args(argc, argv);
+
+  UInt signals = 200;
+  UInt steps = 100000;
+  if (args.options.find("signals") != args.options.end())
+    signals = args.getOptionInt("signals");
+  if (args.options.find("steps") != args.options.end())
+    steps = args.getOptionInt("steps");
+
+  auto log = CPS::Logger::get("InterfaceQueued_Benchmark");
+  log->info("Signals: {}, steps: {}", signals, steps);
+  benchmark(false, signals, steps, log);
+  benchmark(true, signals, steps, log);
+  return 0;
+}
@@ -0,0 +1,152 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <DPsim.h>
+
+#ifdef WITH_CIM
+#include <dpsim-models/CIM/Reader.h>
+#endif
+
+using namespace DPsim;
+using namespace CPS;
+
+/*
+ * Compares the dense and the sparse Jacobian assembly of the powerflow solver.
+ * Without CIM files, a synthetic meshed grid with the given number of buses is
+ * used, e.g. PF_SparseJacobian_Benchmark -o buses=10000
+ * With CIM files as positional arguments, the CIM grid is used instead.
+ */
+
+SystemTopology syntheticGrid(UInt numBuses) {
+  Real Vnom = 110e3;
+  SystemNodeList nodes;
+  SystemComponentList comps;
+
+  for (UInt i = 0; i < numBuses; ++i)
+    nodes.push_back(
+        SimNode<Complex>::make("n" + std::to_string(i), PhaseType::Single));
+
+  auto extnet = SP::Ph1::NetworkInjection::make("Slack");
+  extnet->setParameters(Vnom);
+  extnet->setBaseVoltage(Vnom);
+  extnet->modifyPowerFlowBusType(PowerflowBusType::VD);
+  extnet->connect({nodes[0]});
+  comps.push_back(extnet);
+
+  // Ring with additional chords to obtain a meshed grid
+  UInt chord = std::max<UInt>(2, (UInt)std::sqrt(numBuses));
+  auto addLine = [&](UInt from, UInt to) {
+    auto line = SP::Ph1::PiLine::make("line_" + std::to_string(from) + "_" +
+                                      std::to_string(to));
+    line->setParameters(0.5, 0.005, 1e-8);
+    line->setBaseVoltage(Vnom);
+    line->connect({nodes[from], nodes[to]});
+    comps.push_back(line);
+  };
+  for (UInt i = 0; i < numBuses; ++i) {
+    addLine(i, (i + 1) % numBuses);
+    if (i + chord < numBuses && i % chord == 0)
+      addLine(i, i + chord);
+  }
+
+  for (UInt i = 1; i < numBuses; ++i) {
+    if (i % 10 == 0) {
+      auto gen = SP::Ph1::SynchronGenerator::make("gen" + std::to_string(i));
+      gen->setParameters(100e6, Vnom, 2e6, Vnom, PowerflowBusType::PV);
+      gen->setBaseVoltage(Vnom);
+      gen->connect({nodes[i]});
+      comps.push_back(gen);
+    } else {
+      auto load = SP::Ph1::Load::make("load" + std::to_string(i));
+      load->setParameters(150e3, 50e3, Vnom);
+      load->modifyPowerFlowBusType(PowerflowBusType::PQ);
+      load->connect({nodes[i]});
+      comps.push_back(load);
+    }
+  }
+
+  return SystemTopology(50, nodes, comps);
+}
+
+Real runPowerflow(const SystemTopology &system, Bool sparse,
+                  DirectLinearSolverImpl impl, MatrixComp &voltages) {
+  String simName =
+      String("PF_SparseJacobian_Benchmark_") + (sparse ? "sparse" : "dense");
+  Logger::setLogDir("logs/" + simName);
+
+  Simulation sim(simName, Logger::Level::off);
+  sim.setSystem(system);
+  sim.setTimeStep(1);
+  sim.setFinalTime(1);
+  sim.setDomain(Domain::SP);
+  sim.setSolverType(Solver::Type::NRP);
+  sim.setSolverAndComponentBehaviour(Solver::Behaviour::Simulation);
+  sim.doInitFromNodesAndTerminals(false);
+  sim.doSparsePowerflowJacobian(sparse);
+  sim.setDirectLinearSolverImplementation(impl);
+
+  auto start = std::chrono::steady_clock::now();
+  sim.run();
+  auto end = std::chrono::steady_clock::now();
+
+  voltages = MatrixComp(system.mNodes.size(), 1);
+  for (UInt i = 0; i < system.mNodes.size(); ++i)
+    voltages(i, 0) =
+        std::dynamic_pointer_cast<SimNode<Complex>>(system.mNodes[i])
+            ->singleVoltage();
+
+  return std::chrono::duration<Real>(end - start).count();
+}
+
+int main(int argc, char *argv[]) {
+  CommandLineArgs args(argc, argv);
+
+  UInt numBuses = 1000;
+  if (args.options.find("buses") != args.options.end())
+    numBuses = args.getOptionInt("buses");
+
+  SystemTopology system;
+  String gridName;
+#ifdef WITH_CIM
+  if (!args.positional.empty()) {
+    CIM::Reader reader("PF_SparseJacobian_Benchmark", Logger::Level::off,
+                       Logger::Level::off);
+    system = reader.loadCIM(args.sysFreq, args.positionalPaths(), Domain::SP);
+    gridName = "CIM grid";
+  }
+#endif
+  if (gridName.empty()) {
+    system = syntheticGrid(numBuses);
+    gridName = "synthetic grid";
+  }
+
+  // The dense assembly is quadratic in the number of buses,
+  // so it can be skipped for large grids
+  Bool skipDense = args.options.find("skip-dense") != args.options.end();
+
+  DirectLinearSolverImpl impl = args.directImpl;
+#ifndef WITH_KLU
+  if (impl == DirectLinearSolverImpl::KLU)
+    impl = DirectLinearSolverImpl::SparseLU;
+#endif
+
+  std::cout << "Powerflow of " << gridName << " with "
+            << system.mNodes.size() << " buses" << std::endl;
+
+  MatrixComp vSparse, vDense;
+  Real timeSparse = runPowerflow(system, true, impl, vSparse);
+  std::cout << "Sparse Jacobian: " << timeSparse << " s" << std::endl;
+
+  if (!skipDense) {
+    Real timeDense = runPowerflow(system, false, impl, vDense);
+    std::cout << "Dense Jacobian: " << timeDense << " s" << std::endl;
+    std::cout << "Speedup: " << timeDense / timeSparse << std::endl;
+    std::cout << "Max. voltage deviation: "
+              << (vSparse - vDense).cwiseAbs().maxCoeff() << " V" << std::endl;
+  }
+}
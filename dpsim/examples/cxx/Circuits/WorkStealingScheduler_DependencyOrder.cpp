@@ -0,0 +1,113 @@
+/* Copyright 2017-2024 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <atomic>
+#include <cmath>
+#include <iostream>
+#include <random>
+
+#include <DPsim.h>
+#include <dpsim/WorkStealingScheduler.h>
+
+using namespace DPsim;
+
+/*
+ * Checks that the work-stealing scheduler executes every task once per step
+ * and only after all tasks it depends on. The tasks form a random graph and
+ * take different times, so that threads steal from each other.
+ * Returns 1 if the order is violated.
+ */
+
+static std::atomic<bool> sOrderViolated(false);
+
+/// Task that checks that its predecessors finished in the current step
+class OrderTask : public CPS::Task {
+public:
+  typedef std::shared_ptr<OrderTask> Ptr;
+
+  OrderTask(String name, const std::vector<Ptr> &predecessors, UInt work)
+      : Task(name), mPredecessors(predecessors), mWork(work),
+        mResult(CPS::AttributeStatic<Int>::make(0)) {
+    for (auto &pred : predecessors)
+      mAttributeDependencies.push_back(pred->mResult);
+    mModifiedAttributes.push_back(mResult);
+    // Keeps every task in the schedule
+    mModifiedAttributes.push_back(Scheduler::external);
+  }
+
+  void execute(Real time, Int timeStepCount) override {
+    for (auto &pred : mPredecessors) {
+      if (pred->mLastStep.load(std::memory_order_acquire) != timeStepCount)
+        sOrderViolated = true;
+    }
+    if (mLastStep.load(std::memory_order_relaxed) != timeStepCount - 1)
+      sOrderViolated = true;
+
+    volatile Real sum = 0;
+    for (UInt i = 0; i < mWork; ++i)
+      sum = sum + std::sqrt(static_cast<Real>(i));
+
+    mLastStep.store(timeStepCount, std::memory_order_release);
+  }
+
+  std::vector<Ptr> mPredecessors;
+  UInt mWork;
+  const CPS::Attribute<Int>::Ptr mResult;
+  std::atomic<Int> mLastStep{-1};
+};
+
+int main(int argc, char *argv[]) {
+  const UInt numTasks = 64;
+  const Int numSteps = 500;
+
+  std::mt19937 gen(42);
+  std::vector<OrderTask::Ptr> orderTasks;
+  for (UInt i = 0; i < numTasks; ++i) {
+    std::vector<OrderTask::Ptr> predecessors;
+    if (i > 0) {
+      std::uniform_int_distribution<UInt> pred(0, i - 1);
+      UInt numPredecessors = std::uniform_int_distribution<UInt>(0, 3)(gen);
+      for (UInt p = 0; p < numPredecessors; ++p)
+        predecessors.push_back(orderTasks[pred(gen)]);
+    }
+    UInt work = std::uniform_int_distribution<UInt>(10, 5000)(gen);
+    orderTasks.push_back(std::make_shared<OrderTask>(
+        "task" + std::to_string(i), predecessors, work));
+  }
+
+  Bool failed = false;
+  for (Int threads : {1, 2, 4, 8}) {
+    for (auto &task : orderTasks)
+      task->mLastStep = -1;
+    sOrderViolated = false;
+
+    CPS::Task::List tasks(orderTasks.begin(), orderTasks.end());
+    Scheduler::Edges inEdges, outEdges;
+    auto scheduler = std::make_shared<WorkStealingScheduler>(threads);
+    scheduler->resolveDeps(tasks, inEdges, outEdges);
+    scheduler->createSchedule(tasks, inEdges, outEdges);
+
+    Bool missing = false;
+    for (Int step = 0; step < numSteps; ++step) {
+      scheduler->step(step * 0.001, step);
+      for (auto &task : orderTasks)
+        missing |= task->mLastStep.load() != step;
+    }
+    scheduler->stop();
+
+    if (sOrderViolated || missing) {
+      std::cerr << threads << " threads: "
+                << (sOrderViolated ? "dependency order violated"
+                                   : "task not executed")
+                << std::endl;
+      failed = true;
+    }
+  }
+
+  return failed ? 1 : 0;
+}
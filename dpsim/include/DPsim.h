@@ -7,6 +7,8 @@
  *********************************************************************************/
 
 #include <dpsim/Config.h>
+#include <dpsim/EnsembleSimulation.h>
+#include <dpsim/MemoryDataLogger.h>
 #include <dpsim/Simulation.h>
 #include <dpsim/Utils.h>
 
@@ -25,6 +27,14 @@
 #include <dpsim/OpenMPLevelScheduler.h>
 #endif
 
+#ifdef WITH_HDF5
+#include <dpsim/HDF5DataLogger.h>
+#endif
+
+#ifdef WITH_KLU
+#include <dpsim/KLUFactorizationCache.h>
+#endif
+
 namespace DPsim {
 // #### CPS for users ####
 using SystemTopology = CPS::SystemTopology;
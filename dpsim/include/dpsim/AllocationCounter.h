@@ -0,0 +1,52 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+
+#include <dpsim/Config.h>
+
+namespace DPsim {
+
+/// Counts heap allocations between start() and stop() of the threads that
+/// enabled counting with countThisThread(), i.e. the thread stepping the
+/// simulation and the scheduler worker threads. Allocations of other threads,
+/// e.g. of loggers and interfaces, are ignored. Allocations are only counted
+/// if DPsim is built with WITH_ALLOCATION_CHECK, which replaces malloc,
+/// calloc, realloc, posix_memalign and aligned_alloc of the process.
+class AllocationCounter {
+public:
+  /// True if the build supports counting allocations
+  static bool isSupported();
+  /// Enables or disables counting the allocations of the calling thread
+  static void countThisThread(bool value);
+  /// True if the allocations of the calling thread are counted
+  static bool countsThisThread();
+  /// Resets the counter and starts counting
+  static void start();
+  /// Stops counting and returns the number of allocations since start()
+  static std::size_t stop();
+
+  /// Enables or disables counting for the calling thread and restores the
+  /// previous setting when the scope is left, also by an exception
+  class ThreadScope {
+  public:
+    explicit ThreadScope(bool value) : mPrevious(countsThisThread()) {
+      countThisThread(value);
+    }
+    ~ThreadScope() { countThisThread(mPrevious); }
+    ThreadScope(const ThreadScope &) = delete;
+    ThreadScope &operator=(const ThreadScope &) = delete;
+
+  private:
+    bool mPrevious;
+  };
+};
+
+} // namespace DPsim
@@ -0,0 +1,97 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <thread>
+#include <vector>
+
+#include <dpsim/Definitions.h>
+
+namespace DPsim {
+
+/// Bounded single-producer single-consumer ring buffer of data rows that is
+/// drained by a background thread.
+///
+/// The simulation thread fills rows with acquireRow() and commitRow() without
+/// locking, allocating or doing any I/O. The writer thread wakes up
+/// periodically, hands all committed rows to the write function in one batch
+/// and then releases them. Memory usage is fixed to `rows * columns` values.
+class AsyncLogBuffer {
+public:
+  /// Behaviour of acquireRow() when all rows are in use
+  enum class OverflowPolicy {
+    /// Discard the new row
+    Drop,
+    /// Wait for the writer thread to release a row
+    Block,
+    /// Discard the new row and report the number of lost rows on stop()
+    Count
+  };
+
+  /// Called on the writer thread for every committed row
+  using WriteFunction = std::function<void(const Real *row, UInt columns)>;
+  /// Called on the writer thread after a batch of rows has been written
+  using FlushFunction = std::function<void()>;
+
+  AsyncLogBuffer(UInt rows, UInt columns, OverflowPolicy policy,
+                 WriteFunction write, FlushFunction flush = nullptr,
+                 std::chrono::microseconds drainInterval =
+                     std::chrono::milliseconds(10));
+  ~AsyncLogBuffer();
+
+  AsyncLogBuffer(const AsyncLogBuffer &) = delete;
+  AsyncLogBuffer &operator=(const AsyncLogBuffer &) = delete;
+
+  /// Starts the writer thread
+  void start();
+  /// Writes all committed rows and joins the writer thread
+  void stop();
+
+  /// Returns storage for the next row or nullptr if the row is dropped
+  Real *acquireRow();
+  /// Publishes the row returned by the last successful acquireRow()
+  void commitRow();
+
+  /// Number of rows that were dropped because the buffer was full
+  UInt overruns() const { return mOverruns.load(std::memory_order_relaxed); }
+  /// Number of rows handed to the write function
+  UInt written() const { return mWritten.load(std::memory_order_relaxed); }
+  UInt rows() const { return mRows; }
+  UInt columns() const { return mColumns; }
+  OverflowPolicy policy() const { return mPolicy; }
+
+private:
+  void run();
+  /// Writes all committed rows, returns false if there were none
+  bool drain();
+
+  const UInt mRows;
+  const UInt mColumns;
+  const OverflowPolicy mPolicy;
+  WriteFunction mWrite;
+  FlushFunction mFlush;
+  std::chrono::microseconds mDrainInterval;
+
+  std::vector<Real> mData;
+  std::thread mThread;
+  std::atomic<bool> mRunning{false};
+
+  /// Position of the next row to be committed, only written by the producer
+  alignas(64) std::atomic<uint64_t> mHead{0};
+  /// Position of the next row to be written, only written by the consumer
+  alignas(64) std::atomic<uint64_t> mTail{0};
+  alignas(64) std::atomic<UInt> mOverruns{0};
+  std::atomic<UInt> mWritten{0};
+};
+
+} // namespace DPsim
@@ -0,0 +1,95 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <vector>
+
+#include <dpsim-models/Attribute.h>
+#include <dpsim/Definitions.h>
+
+namespace DPsim {
+
+/// Reads the values of a fixed list of attributes into a flat array of Reals.
+///
+/// The attributes are resolved once when they are added: static attributes,
+/// dynamic attributes that only reference a static attribute, and views
+/// created by `deriveCoeff`, `deriveReal` and `deriveImag` are mapped to an
+/// offset into the storage of the underlying `Real`, `Int`, `Complex`,
+/// `Matrix` or `MatrixComp` value. Consecutive values with a constant stride
+/// in the same storage are merged into one run, so gather() is a flat copy
+/// loop without virtual calls or update tasks. Attributes that cannot be
+/// resolved are read through `Attribute::get()`.
+///
+/// Matrices are accessed via their `data()` pointer on every gather(), so
+/// assigning a new matrix of the same size to an attribute is allowed.
+/// Resizing a matrix or changing attribute references after adding them
+/// invalidates the plan.
+class AttributeExportPlan {
+public:
+  /// Appends the value of `attr` and returns the number of values added:
+  /// one for `Real` and `Int`, two (real and imaginary part) for `Complex`
+  /// and zero for all other types.
+  UInt add(CPS::AttributeBase::Ptr attr);
+  /// Removes all attributes
+  void clear();
+
+  /// Number of values written by gather()
+  UInt size() const { return static_cast<UInt>(mIntegerValues.size()); }
+  /// True if the value at `index` was converted from `Int`
+  Bool isInteger(UInt index) const { return mIntegerValues[index]; }
+  /// Number of values that are read through `Attribute::get()`
+  UInt unresolved() const { return mUnresolved; }
+
+  /// Copies the current values to `values`, which must hold size() elements
+  void gather(Real *values) const;
+
+private:
+  enum class Storage {
+    Real,
+    Int,
+    Matrix,
+    MatrixComp,
+    AttributeReal,
+    AttributeInt,
+    AttributeComplex
+  };
+
+  /// Position of a value inside the storage of an attribute
+  struct Location {
+    Storage storage;
+    const void *object;
+    size_t offset;
+    /// Type of the value at this location
+    const std::type_info *type;
+  };
+
+  /// `count` values starting at `offset` with distance `stride`
+  struct Run {
+    Storage storage;
+    const void *object;
+    size_t offset;
+    size_t stride;
+    UInt count;
+  };
+
+  Bool locate(const CPS::AttributeBase::Ptr &attr, Location &location);
+  void append(Storage storage, const void *object, size_t offset);
+
+  std::vector<Run> mRuns;
+  std::vector<Bool> mIntegerValues;
+  UInt mUnresolved = 0;
+  /// Keeps the resolved storage alive
+  std::vector<std::shared_ptr<const void>> mStorage;
+  /// Unresolved attributes, indexed by the offset of their run
+  std::vector<CPS::Attribute<Real>::Ptr> mRealAttributes;
+  std::vector<CPS::Attribute<Int>::Ptr> mIntAttributes;
+  std::vector<CPS::Attribute<Complex>::Ptr> mComplexAttributes;
+};
+
+} // namespace DPsim
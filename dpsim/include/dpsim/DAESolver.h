@@ -23,6 +23,11 @@
 #include <nvector/nvector_serial.h>
 #include <sundials/sundials_types.h>
 #include <sunlinsol/sunlinsol_dense.h>
+#include <sunmatrix/sunmatrix_dense.h>
+#ifdef WITH_SUNDIALS_KLU
+#include <sunlinsol/sunlinsol_klu.h>
+#include <sunmatrix/sunmatrix_sparse.h>
+#endif
 
 namespace DPsim {
 
@@ -39,6 +44,8 @@ protected:
   Int mNEQ;
   /// Components of the Problem
   CPS::IdentifiedObject::List mComponents;
+  /// DAE interfaces of mComponents, evaluated in this order
+  std::vector<CPS::DAEInterface *> mDAEComponents;
   /// Nodes of the Problem
   CPS::SimNode<Complex>::List mNodes;
 
@@ -64,7 +71,22 @@ protected:
   SUNLinearSolver LS = NULL;
   long int interalSteps = 0;
   long int resEval = 0;
-  std::vector<CPS::DAEInterface::ResFn> mResidualFunctions;
+
+  // Sparse Jacobian
+  /// True if all components provide their Jacobian, otherwise it is
+  /// approximated by finite differences
+  Bool mAnalyticJacobian = true;
+  /// Column pointers of the compressed sparse column pattern
+  std::vector<sunindextype> mJacobianColumns;
+  /// Row indices of the compressed sparse column pattern
+  std::vector<sunindextype> mJacobianRows;
+  /// Values of the Jacobian in the order of the pattern
+  std::vector<Real> mJacobianValues;
+  /// Entries collected from the components
+  CPS::DAEInterface::JacobianEntries mJacobianEntries;
+  /// Groups of columns without common rows, which are approximated by a
+  /// single residual evaluation
+  std::vector<std::vector<Int>> mColumnGroups;
 
   /// Residual Function of entire System
   static int residualFunctionWrapper(realtype ttime, N_Vector state,
@@ -72,6 +94,32 @@ protected:
                                      void *user_data);
   int residualFunction(realtype ttime, N_Vector state, N_Vector dstate_dt,
                        N_Vector resid);
+  /// Evaluates the residual of all nodes and components into resid
+  void evaluateResidual(realtype ttime, const double state[],
+                        const double dstate_dt[], double resid[]);
+
+  /// Jacobian dF/dy + cj * dF/dy' of entire System
+  static int jacobianFunctionWrapper(realtype ttime, realtype cj,
+                                     N_Vector state, N_Vector dstate_dt,
+                                     N_Vector resid, SUNMatrix jacobian,
+                                     void *user_data, N_Vector tmp1,
+                                     N_Vector tmp2, N_Vector tmp3);
+  int jacobianFunction(realtype ttime, realtype cj, N_Vector state,
+                       N_Vector dstate_dt, N_Vector resid, SUNMatrix jacobian,
+                       N_Vector tmp1, N_Vector tmp2, N_Vector tmp3);
+  /// Collects the Jacobian entries of all nodes and components, returns
+  /// false if a component does not provide its entries
+  Bool collectJacobianEntries(realtype ttime, const double state[],
+                              const double dstate_dt[], realtype cj);
+  /// Finite difference approximation of the Jacobian in mJacobianValues
+  void approximateJacobian(realtype ttime, realtype cj, N_Vector state,
+                           N_Vector dstate_dt, N_Vector resid, N_Vector tmp1,
+                           N_Vector tmp2, N_Vector tmp3);
+  /// Determines the pattern of the Jacobian from the components or, if not
+  /// available, by perturbing each variable once
+  void createJacobianPattern();
+  /// Position of an entry in the pattern or -1
+  sunindextype patternPosition(sunindextype row, sunindextype column) const;
 
 public:
   /// Create solve object with given parameters
@@ -17,6 +17,7 @@
 #include <dpsim-models/PtrFactory.h>
 #include <dpsim-models/SimNode.h>
 #include <dpsim-models/Task.h>
+#include <dpsim/AsyncLogBuffer.h>
 #include <dpsim/DataLoggerInterface.h>
 #include <dpsim/Definitions.h>
 #include <dpsim/Scheduler.h>
@@ -33,6 +34,19 @@ protected:
   UInt mDownsampling;
   fs::path mFilename;
 
+  /// Rows of the asynchronous buffer, zero writes synchronously
+  UInt mAsyncRows = 0;
+  AsyncLogBuffer::OverflowPolicy mAsyncPolicy =
+      AsyncLogBuffer::OverflowPolicy::Count;
+  std::unique_ptr<AsyncLogBuffer> mAsyncBuffer;
+  AttributeExportPlan mExportPlan;
+  /// Time and attribute values of the current row
+  std::vector<Real> mRow;
+
+  void compileExportPlan();
+  void startAsync();
+  void writeRow(const Real *row, UInt columns);
+
   virtual void logDataLine(Real time, Real data);
   virtual void logDataLine(Real time, const Matrix &data);
   virtual void logDataLine(Real time, const MatrixComp &data);
@@ -42,11 +56,25 @@ public:
 
   DataLogger(Bool enabled = true);
   DataLogger(String name, Bool enabled = true, UInt downsampling = 1);
-  virtual ~DataLogger(){};
+  virtual ~DataLogger() {
+    // The writer thread uses the members below
+    if (mAsyncBuffer)
+      mAsyncBuffer->stop();
+  };
 
   virtual void start() override;
   virtual void stop() override;
 
+  /// Copy attribute values into a ring buffer of `rows` rows in log() and
+  /// write them to the file from a background thread. Must be called before
+  /// start().
+  void setAsyncBuffer(UInt rows, AsyncLogBuffer::OverflowPolicy policy =
+                                     AsyncLogBuffer::OverflowPolicy::Count);
+  /// Number of rows lost because the asynchronous buffer was full
+  UInt asyncOverruns() const {
+    return mAsyncBuffer ? mAsyncBuffer->overruns() : 0;
+  }
+
   virtual void setColumnNames(std::vector<String> names);
   void logPhasorNodeValues(Real time, const Matrix &data, Int freqNum = 1);
   void logEMTNodeValues(Real time, const Matrix &data);
@@ -12,6 +12,7 @@
 #include <dpsim-models/PtrFactory.h>
 #include <dpsim-models/SimNode.h>
 #include <dpsim-models/Task.h>
+#include <dpsim/AttributeExportPlan.h>
 #include <dpsim/Definitions.h>
 #include <dpsim/Scheduler.h>
 #include <iomanip>
@@ -22,6 +23,17 @@ class DataLoggerInterface {
 protected:
   std::map<String, CPS::AttributeBase::Ptr> mAttributes;
 
+  // Resolves the logged attributes into `plan`, one value per attribute in the order of mAttributes
+  void compileExportPlan(AttributeExportPlan &plan) {
+    plan.clear();
+    for (auto &it : mAttributes) {
+      if (plan.add(it.second) != 1)
+        throw std::runtime_error(
+            "DataLoggerInterface: Unsupported attribute type for attribute " +
+            it.first);
+    }
+  }
+
 public:
   typedef std::shared_ptr<DataLoggerInterface> Ptr;
   typedef std::vector<DataLoggerInterface::Ptr> List;
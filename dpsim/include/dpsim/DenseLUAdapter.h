@@ -48,5 +48,11 @@ public:
 
   /// solution function for a right hand side
   Matrix solve(Matrix &rightSideVector) override;
+
+  /// solution function for a right hand side without allocating memory
+  void solve(const Matrix &rightSideVector, Matrix &leftSideVector) override;
+
+  /// estimated memory held by the factorization in bytes
+  std::size_t memoryUsage() override;
 };
 } // namespace DPsim
@@ -12,6 +12,7 @@
 #include <dpsim-models/SimSignalComp.h>
 #include <dpsim-models/Solver/MNAInterface.h>
 #include <dpsim/DataLogger.h>
+#include <dpsim/DirectLinearSolver.h>
 #include <dpsim/Solver.h>
 
 #include <unordered_map>
@@ -35,8 +36,23 @@ private:
     UInt mVirtualNodeNum;
     /// Offset of block in system matrix
     UInt sysOff;
-    /// Factorization of the subnet's block
-    CPS::LUFactorized luFactorization;
+    /// Block of the subnet in the system matrix
+    SparseMatrix systemMatrix;
+    /// Sparse factorization of the subnet's block
+    std::shared_ptr<DirectLinearSolver> linearSolver;
+    /// Columns of the tear topology matrix with entries in this subnet
+    std::vector<UInt> tearColumns;
+    /// Rows of the tear topology matrix belonging to this subnet, restricted
+    /// to tearColumns
+    Matrix tearTopology;
+    /// Solution of Y * X = C for this subnet's block of Y and C, i.e. the
+    /// only non-zero block of Yinv * C
+    Matrix tearInverse;
+    /// Tear currents of tearColumns
+    Matrix tearCurrents;
+    /// Preallocated right side vector and solution of the subnet
+    Matrix rightVector;
+    Matrix solution;
     /// List of all right side vector contributions
     std::vector<const Matrix *> rightVectorStamps;
     /// Left-side vector of the subnet AFTER complete step
@@ -59,14 +75,13 @@ private:
   typename CPS::SimPowerComp<VarType>::List mTearComponents;
   CPS::SimSignalComp::List mSimSignalComps;
 
+  /// Linear solver implementation used for the subnets
+  DirectLinearSolverImpl mImplementation;
+
   Matrix mRightSideVector;
   Matrix mLeftSideVector;
-  /// Complete matrix in block form
-  Matrix mSystemMatrix;
-  /// Inverse of the complete system matrix (only used for initialization)
-  Matrix mSystemInverse;
   /// Topology of the network removal
-  Matrix mTearTopology;
+  SparseMatrix mTearTopology;
   /// Impedance of the removed network
   CPS::SparseMatrixRow mTearImpedance;
   /// (Factorization of the) impedance matrix for the removed network, including
@@ -91,7 +106,9 @@ private:
 
   void initComponents();
 
+  std::shared_ptr<DirectLinearSolver> createLinearSolver();
   void initMatrices();
+  void initTearBlocks(Subnet &net);
   void applyTearComponentStamp(UInt compIdx);
 
   void log(Real time, Int timeStepCount) override;
@@ -103,9 +120,13 @@ public:
   /// Solutions of the split systems
   const CPS::Attribute<Matrix>::Ptr mOrigLeftSideVector;
 
+  /// The subnets are factorized with `implementation`, which defaults to KLU
+  /// if available and SparseLU otherwise.
   DiakopticsSolver(String name, CPS::SystemTopology system,
                    CPS::IdentifiedObject::List tearComponents, Real timeStep,
-                   CPS::Logger::Level logLevel);
+                   CPS::Logger::Level logLevel,
+                   DirectLinearSolverImpl implementation =
+                       DirectLinearSolverImpl::Undef);
 
   CPS::Task::List getTasks() override;
 
@@ -20,6 +20,18 @@
 #include <dpsim/DirectLinearSolverConfiguration.h>
 
 namespace DPsim {
+
+enum DirectLinearSolverImpl {
+  Undef = 0,
+  KLU,
+  SparseLU,
+  DenseLU,
+  CUDADense,
+  CUDASparse,
+  CUDAMagma,
+  Plugin
+};
+
 class DirectLinearSolver {
 public:
   /// Constructor
@@ -64,6 +76,16 @@ public:
   /// solution function for a right hand side
   virtual Matrix solve(Matrix &rightSideVector) = 0;
 
+  /// solution function writing into a preallocated left side vector,
+  /// the default implementation copies the result of solve()
+  virtual void solve(const Matrix &rightSideVector, Matrix &leftSideVector) {
+    // solve() does not modify the right side vector
+    leftSideVector = solve(const_cast<Matrix &>(rightSideVector));
+  }
+
+  /// estimated memory held by the factorization in bytes, zero if unknown
+  virtual std::size_t memoryUsage() { return 0; }
+
   virtual void
   setConfiguration(DirectLinearSolverConfiguration &configuration) {
     mConfiguration = configuration;
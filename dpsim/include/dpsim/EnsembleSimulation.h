@@ -0,0 +1,137 @@
+/* Copyright 2017-2024 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <functional>
+#include <mutex>
+#include <vector>
+
+#include <dpsim-models/Filesystem.h>
+#include <dpsim/Definitions.h>
+#include <dpsim/MemoryDataLogger.h>
+#include <dpsim/Simulation.h>
+
+namespace DPsim {
+
+/// Runs many variants of the same system concurrently, e.g. for Monte-Carlo
+/// studies and parameter sweeps.
+///
+/// Every member simulates its own topology, which is either a copy of a base
+/// topology or created by a factory. The members differ by parameter changes
+/// applied before the initialization or as events, and by an optional setup
+/// function. They run on a pool of threads, each with a MemoryDataLogger.
+/// Members with the same system matrix share the symbolic KLU factorization
+/// through the KLUFactorizationCache. After run(), the logged values of all
+/// members are available as columns of one matrix.
+class EnsembleSimulation {
+public:
+  /// Sets a Real attribute of a component of a member
+  struct ParameterChange {
+    String component;
+    String attribute;
+    Real value;
+    /// Applied before the initialization if negative, otherwise by an event
+    /// at this simulation time
+    Real time = -1;
+  };
+
+  struct Member {
+    String name;
+    std::vector<ParameterChange> changes;
+  };
+
+  /// Creates the topology of the member with the given index
+  using TopologyFactory = std::function<CPS::SystemTopology(UInt)>;
+  /// Further configuration of a member simulation, e.g. events or solver
+  /// settings, called before it is initialized
+  using SetupFunction =
+      std::function<void(Simulation &, CPS::SystemTopology &, UInt)>;
+
+  /// Members simulate copies of `system` created by SystemTopology::copy()
+  EnsembleSimulation(String name, const CPS::SystemTopology &system,
+                     CPS::Logger::Level logLevel = CPS::Logger::Level::info);
+  /// Members simulate the topologies created by `factory`
+  EnsembleSimulation(String name, TopologyFactory factory,
+                     CPS::Logger::Level logLevel = CPS::Logger::Level::info);
+
+  // #### Settings of all members ####
+  void setTimeStep(Real timeStep) { mTimeStep = timeStep; }
+  void setFinalTime(Real finalTime) { mFinalTime = finalTime; }
+  void setDomain(CPS::Domain domain) { mDomain = domain; }
+  void setSolverType(Solver::Type solverType) { mSolverType = solverType; }
+  void setSetup(SetupFunction setup) { mSetup = setup; }
+  /// Number of members simulated at the same time, zero uses one thread per
+  /// hardware thread
+  void setThreads(UInt threads) { mThreads = threads; }
+  /// Share factorizations between members through the KLU factorization
+  /// cache, which is enabled for the run if required
+  void shareFactorizations(Bool value = true) {
+    mShareFactorizations = value;
+  }
+  /// Logs `attribute` of `component` in all members under `name`
+  void logAttribute(const String &name, const String &component,
+                    const String &attribute);
+
+  void addMember(const Member &member) { mMembers.push_back(member); }
+  const std::vector<Member> &members() const { return mMembers; }
+
+  /// Simulates all members, an exception of a member is stored as its error
+  void run();
+
+  // #### Results ####
+  /// Time of each row followed by the logged values of all members in the
+  /// order of columnNames(). Values of failed members are NaN.
+  const Matrix &results() const { return mResults; }
+  /// "time" followed by "<member>.<column>" for each column of the logged
+  /// attributes, e.g. "<member>.<name>.re" for complex values
+  const std::vector<String> &columnNames() const { return mColumnNames; }
+  /// Error message of each member, empty if it succeeded
+  const std::vector<String> &errors() const { return mErrors; }
+  /// Writes the results to a CSV file
+  void writeCSV(const fs::path &path) const;
+
+protected:
+  struct LoggedAttribute {
+    String name;
+    String component;
+    String attribute;
+  };
+
+  String mName;
+  CPS::Logger::Level mLogLevel;
+  CPS::Logger::Log mLog;
+
+  /// Creates the member topologies, may not be called concurrently
+  TopologyFactory mFactory;
+  /// Protects mFactory and mSetup
+  std::mutex mSetupMutex;
+  SetupFunction mSetup;
+
+  Real mTimeStep = 0.001;
+  Real mFinalTime = 1;
+  CPS::Domain mDomain = CPS::Domain::DP;
+  Solver::Type mSolverType = Solver::Type::MNA;
+  UInt mThreads = 0;
+  Bool mShareFactorizations = true;
+
+  std::vector<LoggedAttribute> mLoggedAttributes;
+  std::vector<Member> mMembers;
+
+  std::vector<MemoryDataLogger::Ptr> mLoggers;
+  std::vector<String> mErrors;
+  Matrix mResults;
+  std::vector<String> mColumnNames;
+
+  /// Sets up and runs the member with the given index
+  void runMember(UInt index);
+  /// Collects the rows of all member loggers into mResults
+  void aggregate();
+};
+
+} // namespace DPsim
@@ -0,0 +1,94 @@
+/* Copyright 2017-2024 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <hdf5.h>
+
+#include <dpsim-models/Attribute.h>
+#include <dpsim-models/Filesystem.h>
+#include <dpsim-models/PtrFactory.h>
+#include <dpsim-models/Task.h>
+#include <dpsim/AttributeExportPlan.h>
+#include <dpsim/DataLoggerInterface.h>
+#include <dpsim/Definitions.h>
+#include <dpsim/Scheduler.h>
+
+namespace DPsim {
+
+/// Data logger writing each logged attribute as a typed column into an
+/// HDF5 file. Rows are buffered in memory and appended in chunks of
+/// chunkSize rows. The columns are datasets in the root group with the
+/// attribute names, the simulation time is stored in the dataset "time".
+/// Failing HDF5 calls throw a CPS::SystemError.
+class HDF5DataLogger : public DataLoggerInterface,
+                       public SharedFactory<HDF5DataLogger> {
+protected:
+  String mName;
+  Bool mEnabled;
+  UInt mDownsampling;
+  fs::path mFilename;
+  /// Number of rows buffered before they are written to the file
+  UInt mChunkSize;
+  /// Deflate compression level between 1 and 9, zero disables compression
+  UInt mCompression;
+
+  hid_t mFile = H5I_INVALID_HID;
+  /// Resolves the logged attributes in the order of mAttributes
+  AttributeExportPlan mExportPlan;
+  /// Datasets of the time followed by the attribute columns
+  std::vector<hid_t> mDatasets;
+  /// Row-major buffer of mChunkSize rows, each holding the time followed by
+  /// the attribute values
+  std::vector<Real> mBuffer;
+  /// Number of rows in the buffer
+  UInt mBufferedRows = 0;
+  /// Number of rows already written to the file
+  hsize_t mWrittenRows = 0;
+
+  /// Creates an extendible dataset for a column
+  hid_t createDataset(const String &name, hid_t type);
+  /// Appends the buffered rows of a column to its dataset
+  void writeColumn(UInt column);
+  /// Writes all buffered rows to the file
+  void flush();
+  /// Closes the datasets and the file, returns a negative value if one of
+  /// them could not be closed
+  herr_t close();
+
+public:
+  typedef std::shared_ptr<HDF5DataLogger> Ptr;
+
+  HDF5DataLogger(String name, Bool enabled = true, UInt downsampling = 1,
+                 UInt chunkSize = 1024, UInt compression = 0);
+  virtual ~HDF5DataLogger();
+
+  virtual void start() override;
+  virtual void stop() override;
+
+  virtual void log(Real time, Int timeStepCount) override;
+
+  virtual CPS::Task::Ptr getTask() override;
+
+  class Step : public CPS::Task {
+  public:
+    Step(HDF5DataLogger &logger)
+        : Task(logger.mName + ".Write"), mLogger(logger) {
+      for (auto attr : logger.mAttributes) {
+        mAttributeDependencies.push_back(attr.second);
+      }
+      mModifiedAttributes.push_back(Scheduler::external);
+    }
+
+    void execute(Real time, Int timeStepCount);
+
+  private:
+    HDF5DataLogger &mLogger;
+  };
+};
+} // namespace DPsim
@@ -10,6 +10,7 @@
 #include <dpsim-models/Attribute.h>
 #include <dpsim-models/Logger.h>
 #include <dpsim-models/Task.h>
+#include <dpsim/AttributeExportPlan.h>
 #include <dpsim/Config.h>
 #include <dpsim/Definitions.h>
 #include <dpsim/Interface.h>
@@ -41,6 +42,31 @@ public:
     PACKET_CLOSE_INTERFACE = 1,
   };
 
+  /// Position of an export in the values gathered by the export plan
+  struct ExportSlot {
+    UInt offset;
+    UInt count; // 1 for Real and Int, 2 for Complex, 0 if the value is cloned
+    Bool integer;
+  };
+
+  /// Values of all exported attributes of one step, see `setBatchedExports`
+  struct AttributeFrame {
+    UInt sequenceId = 0;
+    std::vector<Real> values;
+    // Clones of the exports with a count of zero, indexed by attribute ID
+    std::vector<CPS::AttributeBase::Ptr> clones;
+    const std::vector<ExportSlot> *slots = nullptr;
+
+    /// Number of exported attributes
+    UInt size() const { return static_cast<UInt>(slots->size()); }
+    /// Returns a new attribute holding the value of the export `attributeId`
+    CPS::AttributeBase::Ptr value(UInt attributeId) const;
+    /// Stores the value of the export `attributeId` in `attribute`, which
+    /// is only created if it is empty. Reusing the same attribute for every
+    /// frame avoids allocations.
+    void value(UInt attributeId, CPS::AttributeBase::Ptr &attribute) const;
+  };
+
   InterfaceQueued(std::shared_ptr<InterfaceWorker> intf,
                   const String &name = "", UInt downsampling = 1)
       : Interface(name), mInterfaceWorker(intf), mDownsampling(downsampling) {
@@ -67,6 +93,15 @@ public:
 
   virtual CPS::Task::List getTasks() override;
 
+  /// Pass the exports of each step to the worker as one frame from a pool of
+  /// `poolSize` preallocated frames instead of one packet per attribute.
+  /// Must be called before open(). If all frames are in use, the exports of
+  /// a step are dropped. The number of dropped steps is logged by close().
+  void setBatchedExports(Bool batched, UInt poolSize = 16) {
+    mBatchedExports = batched;
+    mFramePoolSize = poolSize;
+  }
+
   virtual void setLogger(CPS::Logger::Log log) override;
 
   virtual ~InterfaceQueued() {
@@ -85,6 +120,28 @@ protected:
   std::shared_ptr<moodycamel::BlockingReaderWriterQueue<AttributePacket>>
       mQueueInterfaceToDpsim;
 
+  // Reads all Real, Int and Complex exports in one pass, compiled in open()
+  AttributeExportPlan mExportPlan;
+  std::vector<Real> mExportValues;
+  // Position and number of values of each export in mExportValues. Exports with zero values are cloned from the attribute.
+  std::vector<ExportSlot> mExportLayout;
+
+  Bool mBatchedExports = false;
+  UInt mFramePoolSize = 16;
+  UInt mFrameSequence = 0;
+  UInt mDroppedFrames = 0;
+  std::vector<std::unique_ptr<AttributeFrame>> mFrames;
+  // Filled frames on their way to the worker, nullptr closes the interface
+  std::shared_ptr<moodycamel::BlockingReaderWriterQueue<AttributeFrame *>>
+      mFrameQueue;
+  // Frames written by the worker and ready for reuse
+  std::shared_ptr<moodycamel::BlockingReaderWriterQueue<AttributeFrame *>>
+      mFreeFrames;
+
+  void compileExportPlan();
+  void createFramePool();
+  void pushDpsimAttrsAsFrame();
+
 public:
   class WriterThread {
   private:
@@ -102,6 +159,26 @@ public:
     void operator()() const;
   };
 
+  class FrameWriterThread {
+  private:
+    std::shared_ptr<moodycamel::BlockingReaderWriterQueue<AttributeFrame *>>
+        mFrameQueue;
+    std::shared_ptr<moodycamel::BlockingReaderWriterQueue<AttributeFrame *>>
+        mFreeFrames;
+    std::shared_ptr<InterfaceWorker> mInterfaceWorker;
+
+  public:
+    FrameWriterThread(
+        std::shared_ptr<moodycamel::BlockingReaderWriterQueue<AttributeFrame *>>
+            frameQueue,
+        std::shared_ptr<moodycamel::BlockingReaderWriterQueue<AttributeFrame *>>
+            freeFrames,
+        std::shared_ptr<InterfaceWorker> intf)
+        : mFrameQueue(frameQueue), mFreeFrames(freeFrames),
+          mInterfaceWorker(intf){};
+    void operator()() const;
+  };
+
   class ReaderThread {
   private:
     std::shared_ptr<moodycamel::BlockingReaderWriterQueue<AttributePacket>>
@@ -20,6 +20,11 @@ class InterfaceWorker {
 protected:
   bool mOpened;
   UInt mCurrentSequenceInterfaceToDpsim = 1;
+  // Packets passed to `writeValuesToEnv` by the default `writeFrameToEnv`
+  std::vector<InterfaceQueued::AttributePacket> mFramePackets;
+  // Attributes of these packets, created for the first frame and updated in
+  // place for the following ones
+  std::vector<CPS::AttributeBase::Ptr> mFrameAttributes;
 
 public:
   using Ptr = std::shared_ptr<InterfaceWorker>;
@@ -46,6 +51,23 @@ public:
   virtual void writeValuesToEnv(
       std::vector<InterfaceQueued::AttributePacket> &updatedAttrs) = 0;
 
+  /**
+   * Function that will be called on loop in its separate thread if the interface batches its exports.
+   * Should be used to write all values of `frame` to the environment. The frame is reused after this function returns.
+   * The default implementation converts the frame into one packet per attribute and passes them to `writeValuesToEnv`.
+   * The attributes of the packets are reused for every frame.
+   */
+  virtual void writeFrameToEnv(const InterfaceQueued::AttributeFrame &frame) {
+    mFrameAttributes.resize(frame.size());
+    for (UInt i = 0; i < frame.size(); i++) {
+      frame.value(i, mFrameAttributes[i]);
+      mFramePackets.push_back(InterfaceQueued::AttributePacket{
+          mFrameAttributes[i], i, frame.sequenceId,
+          InterfaceQueued::AttributePacketFlags::PACKET_NO_FLAGS});
+    }
+    writeValuesToEnv(mFramePackets);
+  }
+
   /**
    * Open the interface and set up the connection to the environment
    * This is guaranteed to be called before any calls to `readValuesFromEnv` and `writeValuesToEnv`
@@ -23,6 +23,7 @@ extern "C" {
 #include <dpsim/Config.h>
 #include <dpsim/Definitions.h>
 #include <dpsim/DirectLinearSolver.h>
+#include <dpsim/KLUFactorizationCache.h>
 
 namespace DPsim {
 class KLUAdapter : public DirectLinearSolver {
@@ -47,12 +48,33 @@ class KLUAdapter : public DirectLinearSolver {
   /// Count Pivot faults
   int mPivotFaults = 0;
 
+  /// Reciprocal pivot growth estimate of the last factorization with
+  /// pivoting, negative until it is computed by the first refactorization
+  Real mPivotedRcond = -1;
+  /// A refactorization whose estimate drops below this fraction of
+  /// mPivotedRcond is replaced by a factorization with pivoting
+  Real mRefactorizationRcondRatio = 1e-3;
+
   PARTIAL_REFACTORIZATION_METHOD mPartialRefactorizationMethod =
       PARTIAL_REFACTORIZATION_METHOD::FACTORIZATION_PATH;
 
   /// Temporary value to store the number of nonzeros
   Int nnz;
 
+  /// Matrix of the current factorization if the KLUFactorizationCache is
+  /// enabled, the factorization is returned to the cache when it is replaced
+  std::unique_ptr<KLUFactorizationCache::Entry> mCacheEntry;
+  /// False once mNumeric was refactorized with other values than the ones
+  /// stored in mCacheEntry
+  Bool mNumericMatchesCache = false;
+
+  /// Look up factorizations in the KLUFactorizationCache if it is enabled
+  Bool mUseCache = true;
+
+  /// Memory of the KLU objects, needed to move them between klu_commons
+  std::size_t mSymbolicMemory = 0;
+  std::size_t mNumericMemory = 0;
+
 public:
   /// Destructor
   ~KLUAdapter() override;
@@ -82,10 +104,35 @@ public:
   /// solution function for a right hand side
   Matrix solve(Matrix &rightSideVector) override;
 
+  /// solution function for a right hand side without allocating memory
+  void solve(const Matrix &rightSideVector, Matrix &leftSideVector) override;
+
+  /// estimated memory held by the factorization in bytes
+  std::size_t memoryUsage() override;
+
+  /// Bypass the global KLUFactorizationCache, e.g. for matrices whose
+  /// values change with every factorization. Must be set before
+  /// preprocessing().
+  void useFactorizationCache(Bool value) { mUseCache = value; }
+
 protected:
   /// Function to print matrix in MatrixMarket's coo format
   void printMatrixMarket(SparseMatrix &systemMatrix, int counter) const;
 
+  /// Computes the symbolic factorization
+  void analyze(SparseMatrix &systemMatrix);
+  /// Computes the numeric factorization and the refactorization path
+  void factorizeNumeric(SparseMatrix &systemMatrix);
+  /// Returns the factorization to the cache or frees it
+  void releaseFactorization();
+  /// True if factorizations are looked up in the KLUFactorizationCache
+  Bool cacheEnabled() const {
+    return mUseCache && KLUFactorizationCache::global().enabled();
+  }
+  /// Describes the factorization of systemMatrix for a cache lookup
+  std::unique_ptr<KLUFactorizationCache::Entry>
+  cacheRequest(const SparseMatrix &systemMatrix) const;
+
   /// Apply configuration
   void applyConfiguration() override;
 };
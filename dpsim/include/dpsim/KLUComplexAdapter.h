@@ -0,0 +1,98 @@
+/* Copyright 2017-2024 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+extern "C" {
+#include <klu.h>
+}
+
+#include <vector>
+
+#include <dpsim/Config.h>
+#include <dpsim/Definitions.h>
+#include <dpsim/DirectLinearSolver.h>
+
+namespace DPsim {
+
+/// Solves complex systems that are given in the real form of the DP domain,
+/// where the complex entry a + jb of row r and column c of an n x n system is
+/// stored as a at (r, c) and (r + n, c + n), as -b at (r, c + n) and as b at
+/// (r + n, c). The right and left side vectors hold the real parts in the
+/// first and the imaginary parts in the second n rows.
+///
+/// The matrix is factorized as n x n complex matrix with the klu_z_
+/// functions of KLU, which needs about half of the memory and operations of
+/// factorizing the real form. All columns of a right side vector are solved
+/// together. The KLUFactorizationCache is not used.
+class KLUComplexAdapter : public DirectLinearSolver {
+  klu_common mCommon;
+  klu_numeric *mNumeric = nullptr;
+  klu_symbolic *mSymbolic = nullptr;
+
+  /// AMD_ORDERING is defined in SuiteSparse/AMD
+  int mPreordering = AMD_ORDERING;
+
+  /// Complex matrix in compressed row format, the values are stored as
+  /// interleaved real and imaginary parts
+  Int mSize = 0;
+  std::vector<Int> mOuterIndices;
+  std::vector<Int> mInnerIndices;
+  std::vector<Real> mValues;
+  /// Number of nonzeros of the real form when the pattern was converted
+  Eigen::Index mNonZeros = 0;
+  /// Position of each complex value in the real form of the matrix
+  std::vector<std::pair<Int, Int>> mValuePositions;
+  /// Right side vectors in the complex format of KLU, solved in place
+  std::vector<Real> mSolution;
+
+public:
+  ~KLUComplexAdapter() override;
+
+  KLUComplexAdapter();
+
+  KLUComplexAdapter(CPS::Logger::Log log);
+
+  /// True if the matrix is the real form of a complex matrix
+  static Bool isRealForm(const SparseMatrix &systemMatrix);
+
+  /// Converts the pattern and computes the symbolic factorization
+  void preprocessing(SparseMatrix &systemMatrix,
+                     std::vector<std::pair<UInt, UInt>>
+                         &listVariableSystemMatrixEntries) override;
+
+  /// factorization function with partial pivoting
+  void factorize(SparseMatrix &systemMatrix) override;
+
+  /// refactorization without partial pivoting
+  void refactorize(SparseMatrix &systemMatrix) override;
+
+  /// Complex matrices are always refactorized completely
+  void partialRefactorize(SparseMatrix &systemMatrix,
+                          std::vector<std::pair<UInt, UInt>>
+                              &listVariableSystemMatrixEntries) override;
+
+  /// solution function for one or more right hand sides
+  Matrix solve(Matrix &rightSideVector) override;
+
+  /// solution function for one or more right hand sides without allocating
+  /// memory
+  void solve(const Matrix &rightSideVector, Matrix &leftSideVector) override;
+
+  /// estimated memory held by the factorization in bytes
+  std::size_t memoryUsage() override;
+
+protected:
+  /// Collects the pattern of the complex matrix
+  void convertPattern(const SparseMatrix &systemMatrix);
+  /// Copies the values of the real form into the complex matrix
+  void convertValues(const SparseMatrix &systemMatrix);
+
+  void applyConfiguration() override;
+};
+} // namespace DPsim
@@ -0,0 +1,112 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+extern "C" {
+#include <klu.h>
+}
+
+#include <array>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <dpsim/Definitions.h>
+
+namespace DPsim {
+
+/// Keeps the KLU factorizations of finished solvers for later solvers that
+/// factorize the same matrix, e.g. in parameter sweeps with many simulations
+/// of the same grid.
+///
+/// A factorization is always owned by exactly one KLUAdapter or by the
+/// cache. Adapters take a factorization out of the cache when they
+/// factorize a matrix and put it back when they factorize another matrix or
+/// are destroyed, so simulations running in parallel never share KLU
+/// objects. The cache is disabled as long as its capacity is zero.
+class KLUFactorizationCache {
+public:
+  /// Symbolic and numeric factorization of a matrix in compressed format
+  struct Entry {
+    Entry() = default;
+    Entry(const Entry &) = delete;
+    Entry &operator=(const Entry &) = delete;
+    ~Entry();
+
+    /// Copy of the factorized matrix, compared on every lookup
+    std::vector<Int> outerIndices;
+    std::vector<Int> innerIndices;
+    std::vector<Real> values;
+    /// Entries passed to klu_analyze_partial
+    std::vector<Int> varyingRows;
+    std::vector<Int> varyingColumns;
+    /// Preordering, scaling, BTF and partial refactorization method
+    std::array<int, 4> configuration{};
+
+    uint64_t patternHash = 0;
+    uint64_t valueHash = 0;
+
+    /// Owned by the entry while it is stored in the cache
+    klu_symbolic *symbolic = nullptr;
+    /// Null if only the symbolic factorization can be reused
+    klu_numeric *numeric = nullptr;
+    /// Memory of the KLU objects in bytes
+    std::size_t symbolicMemory = 0;
+    std::size_t numericMemory = 0;
+
+    /// Computes both hashes from the stored matrix
+    void updateHashes();
+    Bool samePattern(const Entry &other) const;
+    Bool sameValues(const Entry &other) const;
+  };
+
+  /// Cache shared by all KLUAdapters of the process
+  static KLUFactorizationCache &global();
+
+  /// Number of stored factorizations, zero disables the cache
+  void setCapacity(UInt capacity);
+  UInt capacity() const;
+  Bool enabled() const { return capacity() > 0; }
+
+  /// Removes and returns a factorization with the pattern of `request`,
+  /// preferring one with equal values, or returns nullptr.
+  /// `numericHit` is set if the numeric factorization can be reused.
+  std::unique_ptr<Entry> acquire(const Entry &request, Bool &numericHit);
+  /// Stores a factorization and evicts the least recently stored ones if the
+  /// capacity is exceeded
+  void release(std::unique_ptr<Entry> entry);
+  /// Frees all stored factorizations
+  void clear();
+
+  /// Lookups which reused the numeric factorization
+  uint64_t hits() const;
+  /// Lookups which only reused the symbolic factorization
+  uint64_t symbolicHits() const;
+  uint64_t misses() const;
+  uint64_t evictions() const;
+  /// Fraction of lookups which reused the numeric factorization
+  Real hitRate() const;
+  void resetStatistics();
+
+private:
+  mutable std::mutex mMutex;
+  UInt mCapacity = 0;
+  /// Most recently stored factorization first
+  std::list<std::unique_ptr<Entry>> mEntries;
+
+  uint64_t mHits = 0;
+  uint64_t mSymbolicHits = 0;
+  uint64_t mMisses = 0;
+  uint64_t mEvictions = 0;
+
+  void evict();
+};
+
+} // namespace DPsim
@@ -24,6 +24,7 @@
 #include <dpsim/Config.h>
 #include <dpsim/DataLogger.h>
 #include <dpsim/Solver.h>
+#include <dpsim/TimingStatistics.h>
 
 /* std::size_t is the largest data type. No container can store
  * more than std::size_t elements. Define the number of switches
@@ -83,6 +84,20 @@ protected:
   Matrix mRightSideVector;
   /// List of all right side vector contributions
   std::vector<const Matrix *> mRightVectorStamps;
+  /// Right side vector contribution and the rows it writes to
+  struct RightVectorStampRows {
+    const Matrix *stamp;
+    std::vector<UInt> rows;
+    /// Type and name of the component for logging
+    String name;
+  };
+  /// Contributions that are only summed up at their rows
+  std::vector<RightVectorStampRows> mSparseRightVectorStamps;
+  /// Check that the sparse contributions are zero outside of their rows in
+  /// the next sum of the contributions
+  Bool mCheckSparseRightVector = true;
+  /// Contributions with unknown rows that are added completely
+  std::vector<const Matrix *> mDenseRightVectorStamps;
 
   // #### MNA specific attributes related to harmonics / additional frequencies ####
   /// Source vector of known quantities
@@ -96,6 +111,9 @@ protected:
   CPS::MNAVariableCompInterface::List mVariableComps;
   /// List of variable components if they must be accessed as MNAInterface objects
   CPS::MNAInterface::List mMNAIntfVariableComps;
+  /// Index of the first variable component that reported a parameter change.
+  /// The following components are not asked and have to be restamped as well.
+  UInt mFirstChangedVariableComp = 0;
 
   // #### Attributes related to switching ####
   /// Index of the next switching event
@@ -105,6 +123,17 @@ protected:
   /// Collects the status of switches to select correct system matrix
   void updateSwitchStatus();
 
+  // #### Attributes related to snapshots ####
+  /// True if readSnapshot() was called before the initialization
+  Bool mRestoreSnapshot = false;
+  /// Matrix node indices of all nodes in the snapshot
+  std::vector<std::vector<UInt>> mSnapshotNodeIndices;
+  /// Solution vectors in the snapshot
+  std::vector<Matrix> mSnapshotLeftSideVectors;
+  /// Checks that the nodes were assigned to the same matrix indices as in
+  /// the snapshot
+  void checkSnapshotNodeIndices();
+
   // #### Attributes related to logging ####
   /// Last simulation time step when log was updated
   Int mLastLogTimeStep = 0;
@@ -113,12 +142,16 @@ protected:
   /// Right side vector logger
   std::shared_ptr<DataLogger> mRightVectorLog;
 
+  /// System matrix stamping and compression measurements
+  TimingStatistics mAssemblyTimes;
   /// LU factorization measurements
-  std::vector<Real> mFactorizeTimes;
+  TimingStatistics mFactorizeTimes;
   /// Right-hand side solution measurements
-  std::vector<Real> mSolveTimes;
+  TimingStatistics mSolveTimes;
   /// LU refactorization measurements
-  std::vector<Real> mRecomputationTimes;
+  TimingStatistics mRecomputationTimes;
+  /// Right side vector assembly measurements
+  TimingStatistics mRightVectorTimes;
 
   /// Constructor should not be called by users but by Simulation
   MnaSolver(String name, CPS::Domain domain = CPS::Domain::DP,
@@ -126,14 +159,23 @@ protected:
 
   /// Initialization of individual components
   void initializeComponents();
+  /// Adds the right side vector contribution of a component
+  void addRightVectorStamp(const CPS::MNAInterface::Ptr &comp);
+  /// Moves sparse contributions that are not zero outside of their rows to
+  /// the dense contributions
+  void checkSparseRightVectorStamps();
+  /// Sets the right side vector to the sum of all contributions
+  void sumRightVectorStamps();
   /// Initialization of system matrices and source vector
   virtual void initializeSystem();
   /// Initialization of system matrices and source vector
   void initializeSystemWithParallelFrequencies();
   /// Initialization of system matrices and source vector
-  void initializeSystemWithPrecomputedMatrices();
+  virtual void initializeSystemWithPrecomputedMatrices();
   /// Initialization of system matrices and source vector
   void initializeSystemWithVariableMatrix();
+  /// Stamps all components into the source vector for debugging
+  void stampInitialRightSideVector();
   /// Identify Nodes and SimPowerComps and SimSignalComps
   void identifyTopologyObjects();
   /// Assign simulation node index according to index in the vector.
@@ -179,7 +221,8 @@ protected:
   virtual std::shared_ptr<CPS::Task> createSolveTask() = 0;
   /// Create a solve task for this solver implementation
   virtual std::shared_ptr<CPS::Task> createLogTask() = 0;
-  /// Create a solve task for this solver implementation
+  /// Create a solve task for this solver implementation. Returns nullptr if
+  /// the frequency is solved by the task of another frequency.
   virtual std::shared_ptr<CPS::Task> createSolveTaskHarm(UInt freqIdx) = 0;
 
   // #### Scheduler Task Methods ####
@@ -208,6 +251,12 @@ public:
   /// Calls subroutines to set up everything that is required before simulation
   virtual void initialize() override;
 
+  // #### Snapshot ####
+  /// Writes the matrix node indices and the solution vectors
+  virtual void writeSnapshot(std::ostream &out) override;
+  /// Reads the data written by writeSnapshot
+  virtual void readSnapshot(std::istream &in) override;
+
   // #### Setter and Getter ####
   ///
   virtual void setSystem(const CPS::SystemTopology &system) override;
@@ -216,6 +265,16 @@ public:
   ///
   Matrix &rightSideVector() { return mRightSideVector; }
   ///
+  const TimingStatistics *solveTimes() const override { return &mSolveTimes; }
+  ///
+  const TimingStatistics *factorizeTimes() const override {
+    return &mFactorizeTimes;
+  }
+  ///
+  const TimingStatistics *recomputationTimes() const override {
+    return &mRecomputationTimes;
+  }
+  ///
   virtual CPS::Task::List getTasks() override;
 };
 } // namespace DPsim
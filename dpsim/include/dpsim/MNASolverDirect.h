@@ -9,6 +9,8 @@
 #pragma once
 
 #include <bitset>
+#include <chrono>
+#include <future>
 #include <iostream>
 #include <list>
 #include <memory>
@@ -23,6 +25,7 @@
 #include <dpsim/Solver.h>
 #ifdef WITH_KLU
 #include <dpsim/KLUAdapter.h>
+#include <dpsim/KLUComplexAdapter.h>
 #endif
 #include <dpsim/SparseLUAdapter.h>
 #ifdef WITH_CUDA
@@ -43,17 +46,6 @@
 
 namespace DPsim {
 
-enum DirectLinearSolverImpl {
-  Undef = 0,
-  KLU,
-  SparseLU,
-  DenseLU,
-  CUDADense,
-  CUDASparse,
-  CUDAMagma,
-  Plugin
-};
-
 /// Solver class using Modified Nodal Analysis (MNA).
 template <typename VarType> class MnaSolverDirect : public MnaSolver<VarType> {
 
@@ -67,11 +59,140 @@ protected:
                      std::vector<std::shared_ptr<DirectLinearSolver>>>
       mDirectLinearSolvers;
 
+  // #### Data structures for parallel frequencies ####
+  /// Frequencies whose system matrices are equal in all switch states. They
+  /// share one factorization and are solved together.
+  struct HarmonicGroup {
+    std::vector<UInt> frequencies;
+    /// Right and left side vectors of all frequencies as columns
+    Matrix rightSideVectors;
+    Matrix leftSideVectors;
+  };
+  /// The system matrices and solvers of each switch state are stored in the
+  /// order of the groups
+  std::vector<HarmonicGroup> mHarmonicGroups;
+  /// Index of the group of each frequency
+  std::vector<UInt> mHarmonicGroupOfFrequency;
+
+  // #### Data structures for lazily factorized switch states ####
+  /// Cached switch states ordered from most to least recently used
+  std::list<std::bitset<SWITCH_NUM>> mSwitchStateUsage;
+  /// Position of each cached switch state in the usage list
+  std::unordered_map<std::bitset<SWITCH_NUM>,
+                     std::list<std::bitset<SWITCH_NUM>>::iterator>
+      mSwitchStateUsagePos;
+  /// Dimension of the switched and variable system matrices
+  UInt mSwitchedMatrixSize = 0;
+  /// Compressed pattern of the system matrix with zero values. It contains
+  /// the entries of all switch states and variable elements, so that the
+  /// system matrices are stamped without inserting new entries.
+  SparseMatrix mSystemMatrixPattern;
+  /// System matrix pattern read from a snapshot, replaces the stamping of
+  /// the pattern if it has the same dimension
+  SparseMatrix mSnapshotPattern;
+  /// Number of switch state lookups that found a factorization in the cache
+  UInt mSwitchStateCacheHits = 0;
+  /// Number of switch state lookups that required a new factorization
+  UInt mSwitchStateCacheMisses = 0;
+  /// Number of factorizations removed from the cache
+  UInt mSwitchStateCacheEvictions = 0;
+  /// Estimated memory of each cached switch state in bytes
+  std::unordered_map<std::bitset<SWITCH_NUM>, std::size_t> mSwitchStateMemory;
+  /// Sum of mSwitchStateMemory
+  std::size_t mSwitchStateCacheMemoryUsed = 0;
+
+  // #### Data structures for low-rank switch updates ####
+  /// Entry of the difference between the closed and open stamp of a switch
+  struct SwitchStampDelta {
+    UInt row;
+    UInt col;
+    Real value;
+  };
+  /// Difference between the closed and open stamp of every switch
+  std::vector<std::vector<SwitchStampDelta>> mSwitchStampDeltas;
+  /// Switch state whose system matrix is factorized
+  std::bitset<SWITCH_NUM> mBaseSwitchState;
+  /// Switch state the correction was computed for
+  std::bitset<SWITCH_NUM> mCorrectedSwitchState;
+  /// False if the correction has to be recomputed
+  Bool mSwitchCorrectionValid = false;
+  /// Rows and columns in which the system matrix of the current switch state
+  /// differs from the base matrix
+  std::vector<UInt> mCorrectionIndices;
+  /// Number of indices the correction matrices are allocated for. Entries
+  /// beyond the current indices are padded so that the correction of a new
+  /// switch state does not allocate memory.
+  UInt mCorrectionCapacity = 0;
+  /// Difference to the base matrix at these rows and columns
+  Matrix mCorrectionDelta;
+  /// Solutions of the base system for unit vectors at the indices
+  Matrix mCorrectionBaseSolutions;
+  /// Rows of the base solutions at the indices
+  Matrix mCorrectionSelected;
+  /// Capacitance matrix of the Woodbury identity and its LU factorization
+  Matrix mCorrectionCapacitanceMatrix;
+  Eigen::PartialPivLU<Matrix> mCorrectionCapacitance;
+  /// Work vectors of the correction
+  Matrix mCorrectionValues;
+  Matrix mCorrectionWeights;
+  Matrix mCorrectionUnitVector;
+  Matrix mCorrectionBaseSolution;
+  /// Switch state that is factorized in the background
+  std::bitset<SWITCH_NUM> mRebaseSwitchState;
+  SparseMatrix mRebaseMatrix;
+  std::shared_ptr<DirectLinearSolver> mRebaseSolver;
+  /// Background factorization, declared after the data it accesses so that
+  /// it is finished before the data is destroyed
+  std::future<void> mRebaseFactorization;
+  /// Number of corrections computed for new switch states
+  UInt mSwitchCorrections = 0;
+  /// Number of new base states factorized in the background
+  UInt mSwitchRebases = 0;
+
   // #### Data structures for system recomputation over time ####
   /// System matrix including all static elements
   SparseMatrix mBaseSystemMatrix;
   /// System matrix including stamp of static and variable elements
   SparseMatrix mVariableSystemMatrix;
+
+  /// Stamp of a switch or variable element into the variable system matrix
+  struct VariableStamp {
+    CPS::MNAInterface::Ptr comp;
+    /// Set if the element is a switch
+    CPS::MNASwitchInterface::Ptr sw;
+    /// Index in mVariableComps or -1 if the element is only a switch
+    Int variableIdx = -1;
+    /// Switch position of the last stamp
+    Bool closed = false;
+    /// Indices in mVariableEntries of the values written by the element
+    std::vector<UInt> entries;
+    /// Values of the last stamp at these entries
+    std::vector<Real> values;
+    /// Value index ranges of the rows the element writes to. Nonzeros in
+    /// these ranges outside of the entries are written to values that were
+    /// zero during initialization and require a full restamp.
+    std::vector<std::pair<UInt, UInt>> checkedRows;
+  };
+  /// Value of the variable system matrix written by switches or variable
+  /// elements
+  struct VariableEntry {
+    /// Index in the value array of the compressed matrix
+    UInt valueIdx;
+    /// Index in mVariableStamps and position in its entries
+    std::vector<std::pair<UInt, UInt>> stamps;
+  };
+  /// Stamps of all switches and variable elements
+  std::vector<VariableStamp> mVariableStamps;
+  /// All values written by switches and variable elements
+  std::vector<VariableEntry> mVariableEntries;
+  /// Entries whose value has to be recomputed from the stamps
+  std::vector<UInt> mChangedVariableEntries;
+  std::vector<Bool> mVariableEntryChanged;
+  /// Matrix with the pattern of the variable system matrix into which single
+  /// elements are stamped to obtain their values, zero between the stamps
+  SparseMatrix mVariableStampMatrix;
+  /// False if the stamps have to be initialized by a full restamp
+  Bool mVariableStampsValid = false;
   /// LU factorization of variable system matrix
   std::shared_ptr<DirectLinearSolver> mDirectLinearSolverVariableSystemMatrix;
   /// LU factorization indicator
@@ -98,15 +219,31 @@ protected:
   using MnaSolver<VarType>::mSystemMatrixRecomputation;
   using MnaSolver<VarType>::hasVariableComponentChanged;
   using MnaSolver<VarType>::mNumRecomputations;
+  using MnaSolver<VarType>::mFirstChangedVariableComp;
   using MnaSolver<VarType>::mSyncGen;
   using MnaSolver<VarType>::mFactorizeTimes;
+  using MnaSolver<VarType>::mAssemblyTimes;
   using MnaSolver<VarType>::mSolveTimes;
+  using MnaSolver<VarType>::mRightVectorTimes;
+  using MnaSolver<VarType>::sumRightVectorStamps;
   using MnaSolver<VarType>::mRecomputationTimes;
   using MnaSolver<VarType>::mListVariableSystemMatrixEntries;
+  using MnaSolver<VarType>::mSwitchStateCacheSize;
+  using MnaSolver<VarType>::mSwitchStateCacheMemory;
+  using MnaSolver<VarType>::mLikelySwitchStates;
+  using MnaSolver<VarType>::mSwitchUpdateMaxIndices;
 
   // #### General
   /// Create system matrix
   void createEmptySystemMatrix() override;
+  /// Creates the system matrix pattern and initializes the system matrices
+  void initializeSystem() override;
+  /// Stamps all components, switch positions and variable elements into
+  /// mSystemMatrixPattern and compresses it once
+  void createSystemMatrixPattern();
+  /// Compresses a stamped system matrix and measures the assembly time
+  void finishSystemMatrixAssembly(SparseMatrix &systemMatrix,
+                                  std::chrono::steady_clock::time_point start);
 
   // #### Methods for precomputed switch matrices (optionally with parallel frequencies) ####
   /// Sets all entries in the matrix with the given switch index to zero
@@ -117,6 +254,68 @@ protected:
   void switchedMatrixStamp(
       std::size_t index,
       std::vector<std::shared_ptr<CPS::MNAInterface>> &comp) override;
+  /// Applies the component and switch stamps of one frequency to the matrix
+  /// with the given switch index and frequency index
+  void switchedMatrixStamp(std::size_t swIdx, Int freqIdx,
+                           CPS::MNAInterface::List &components,
+                           CPS::MNASwitchInterface::List &switches) override;
+
+  // #### Methods for parallel frequencies ####
+  /// Groups the frequencies with equal system matrices and factorizes one
+  /// system matrix per group and switch state
+  void initializeHarmonicGroups();
+  /// Returns a solver for the system matrix of a single frequency. With KLU,
+  /// the matrix is factorized in complex form if possible.
+  std::shared_ptr<DirectLinearSolver>
+  createHarmonicSolverImplementation(const SparseMatrix &systemMatrix);
+
+  // #### Methods for lazily factorized switch states ####
+  /// Initializes the switch state cache instead of precomputing all states
+  void initializeSystemWithPrecomputedMatrices() override;
+  /// True if switch states are factorized on first use
+  Bool useSwitchStateCache() const {
+    return mSwitchStateCacheSize > 0 && !mFrequencyParallel &&
+           !mSystemMatrixRecomputation && !useLowRankSwitchUpdates();
+  }
+  /// Returns the solver for the given switch state and factorizes
+  /// the state if it is not cached
+  std::shared_ptr<DirectLinearSolver> &
+  switchedSolver(const std::bitset<SWITCH_NUM> &state);
+  /// Stamps and factorizes the system matrix of a switch state and adds
+  /// it to the cache
+  void cacheSwitchState(const std::bitset<SWITCH_NUM> &state);
+  /// Removes least recently used switch states until the cache limits are met
+  void evictSwitchStates();
+  /// Estimated memory of a cached switch state in bytes
+  std::size_t switchStateMemory(const std::bitset<SWITCH_NUM> &state);
+
+  // #### Methods for low-rank switch updates ####
+  /// True if only one switch state is factorized and the others are solved
+  /// with low-rank corrections
+  Bool useLowRankSwitchUpdates() const {
+    return mSwitchUpdateMaxIndices > 0 && mSwitches.size() > 0 &&
+           !mFrequencyParallel && !mSystemMatrixRecomputation;
+  }
+  /// Factorizes the current switch state and collects the switch stamps
+  void initializeLowRankSwitchUpdates();
+  /// Stamps the system matrix of a switch state
+  void assembleSwitchedMatrix(const std::bitset<SWITCH_NUM> &state,
+                              SparseMatrix &systemMatrix);
+  /// Allocates the correction matrices for the given number of indices
+  void allocateSwitchCorrection(UInt capacity);
+  /// Computes the correction of the base factorization for the current
+  /// switch state
+  void updateSwitchCorrection();
+  /// Starts the factorization of a switch state in the background
+  void startRebase(const std::bitset<SWITCH_NUM> &state);
+  /// Replaces the base state once the background factorization is finished.
+  /// Blocks until it is finished if wait is set.
+  void finishRebase(Bool wait);
+  /// Solves the system of the current switch state
+  void solveSwitchedSystem(const Matrix &rightSideVector,
+                           Matrix &leftSideVector);
+  /// Logging of the low-rank switch update statistics
+  void logLowRankSwitchUpdates();
 
   // #### Methods for system recomputation over time ####
   /// Stamps components into the variable system matrix
@@ -128,27 +327,42 @@ protected:
   std::shared_ptr<CPS::Task> createSolveTaskRecomp() override;
   /// Recomputes systems matrix
   virtual void recomputeSystemMatrix(Real time);
+  /// Collects the values that every switch and variable element writes to
+  void initializeVariableStamps();
+  /// Stamps a single element and stores its values. Returns false if the
+  /// element wrote outside of the system matrix pattern.
+  Bool restampVariableElement(VariableStamp &stamp);
+  /// Restamps switches that changed their position and variable elements
+  /// that changed their parameters, and writes the affected values of the
+  /// variable system matrix in place. Returns false if a full restamp is
+  /// required.
+  Bool restampChangedVariableElements();
 
   // #### Scheduler Task Methods ####
   /// Create a solve task for this solver implementation
   std::shared_ptr<CPS::Task> createSolveTask() override;
   /// Create a solve task for this solver implementation
   std::shared_ptr<CPS::Task> createLogTask() override;
-  /// Create a solve task for this solver implementation
+  /// Create a solve task for the group of the frequency, returns nullptr if
+  /// the frequency is not the first one of its group
   std::shared_ptr<CPS::Task> createSolveTaskHarm(UInt freqIdx) override;
   /// Logging of system matrices and source vector
   void logSystemMatrices() override;
   /// Solves system for single frequency
   void solve(Real time, Int timeStepCount) override;
-  /// Solves system for multiple frequencies
+  /// Solves the systems of all frequencies in the group of the frequency
   void solveWithHarmonics(Real time, Int timeStepCount, Int freqIdx) override;
 
   /// Logging of the right-hand-side solution time
   void logSolveTime();
+  /// Logging of the system matrix assembly time
+  void logAssemblyTime();
   /// Logging of the LU factorization time
   void logFactorizationTime();
   /// Logging of the LU refactorization time
   void logRecomputationTime();
+  /// Logging of the switch state cache statistics
+  void logSwitchStateCache();
 
   /// Returns a pointer to an object of type DirectLinearSolver
   std::shared_ptr<DirectLinearSolver>
@@ -173,6 +387,14 @@ public:
 
   /// log LU decomposition times
   void logLUTimes() override;
+  /// Usage of the switch state cache
+  Solver::SwitchStateCacheStatistics
+  switchStateCacheStatistics() const override;
+
+  /// Writes the system matrix pattern in addition to the MNA data
+  void writeSnapshot(std::ostream &out) override;
+  /// Reads the data written by writeSnapshot
+  void readSnapshot(std::istream &in) override;
 
   /// ### SynGen Interface ###
   int mIter = 0;
@@ -0,0 +1,88 @@
+/* Copyright 2017-2024 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <dpsim-models/Attribute.h>
+#include <dpsim-models/PtrFactory.h>
+#include <dpsim-models/Task.h>
+#include <dpsim/AttributeExportPlan.h>
+#include <dpsim/DataLoggerInterface.h>
+#include <dpsim/Definitions.h>
+#include <dpsim/Scheduler.h>
+
+namespace DPsim {
+
+/// Data logger keeping all rows in one preallocated row-major array instead
+/// of writing a file. Each row holds the simulation time followed by the
+/// attribute values in the order of columnNames(). Rows beyond the capacity
+/// are dropped and counted, so the array is never reallocated while the
+/// simulation runs and views of data() stay valid until the next start().
+class MemoryDataLogger : public DataLoggerInterface,
+                         public SharedFactory<MemoryDataLogger> {
+protected:
+  String mName;
+  UInt mDownsampling;
+  /// Number of rows allocated by start()
+  UInt mCapacity;
+  /// Number of logged rows
+  UInt mRows = 0;
+  UInt mOverruns = 0;
+  std::vector<Real> mData;
+  AttributeExportPlan mExportPlan;
+
+public:
+  typedef std::shared_ptr<MemoryDataLogger> Ptr;
+
+  MemoryDataLogger(String name, UInt rows, UInt downsampling = 1);
+  /// Allocates enough rows for all steps until `finalTime`
+  MemoryDataLogger(String name, Real finalTime, Real timeStep,
+                   UInt downsampling = 1);
+
+  /// Allocates the rows and discards previously logged rows
+  virtual void start() override;
+  virtual void stop() override {}
+
+  virtual void log(Real time, Int timeStepCount) override;
+
+  virtual CPS::Task::Ptr getTask() override;
+
+  /// Discards the logged rows but keeps the memory
+  void clear() {
+    mRows = 0;
+    mOverruns = 0;
+  }
+
+  UInt rows() const { return mRows; }
+  UInt capacity() const { return mCapacity; }
+  UInt columns() const { return mExportPlan.size() + 1; }
+  /// Number of rows dropped because the capacity was exceeded
+  UInt overruns() const { return mOverruns; }
+  /// Names of the columns, starting with "time"
+  std::vector<String> columnNames() const;
+
+  /// Logged rows, valid until the next call of start()
+  const Real *data() const { return mData.data(); }
+
+  class Step : public CPS::Task {
+  public:
+    Step(MemoryDataLogger &logger)
+        : Task(logger.mName + ".Write"), mLogger(logger) {
+      for (auto attr : logger.mAttributes) {
+        mAttributeDependencies.push_back(attr.second);
+      }
+      mModifiedAttributes.push_back(Scheduler::external);
+    }
+
+    void execute(Real time, Int timeStepCount);
+
+  private:
+    MemoryDataLogger &mLogger;
+  };
+};
+} // namespace DPsim
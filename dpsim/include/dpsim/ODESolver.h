@@ -56,6 +56,14 @@ protected:
   /// Reusable error-checking flag
   int mFlag{0};
 
+  /// End time of the last step, where the integrator stopped
+  Real mStopTime{0};
+  /// Forces a reinitialization of the integrator in the next step
+  Bool mReInit{true};
+  /// Integrator statistics at the end of the last step
+  long int mTotalSteps{0};
+  long int mTotalErrorTestFails{0};
+
   // Similar to DAE-Solver
   CPS::ODEInterface::StSpFn mStSpFunction;
   CPS::ODEInterface::JacFn mJacFunction;
@@ -72,6 +80,17 @@ protected:
                N_Vector tmp2, N_Vector tmp3);
   /// ARKode- standard error detection function; in DAE-solver not detection function is used -> for efficiency purposes?
   int check_flag(void *flagvalue, const std::string &funcname, int opt);
+  /// Restarts the integration at time t0 from the current state vector
+  void reInit(Real t0);
+
+public:
+  /// Internal steps of the integrator in the last simulation step
+  const CPS::Attribute<Int>::Ptr mInternalSteps;
+  /// Error test failures of the integrator in the last simulation step
+  const CPS::Attribute<Int>::Ptr mErrorTestFails;
+  /// Number of (re)initializations of the integrator, e.g. because the state
+  /// was changed outside of the solver
+  const CPS::Attribute<Int>::Ptr mReInitCount;
 
 public:
   /// Create solve object with corresponding component and information on the integration type
@@ -98,7 +117,7 @@ public:
     return CPS::Task::List{std::make_shared<SolveTask>(*this)};
   }
 
-  /// Initialize ARKode-solve_environment
+  /// Create the ARKode integrator, which is reused for all steps
   void initialize();
   /// Solve system for the current time
   Real step(Real initial_time);
@@ -13,6 +13,7 @@
 
 #include "dpsim-models/Components.h"
 #include "dpsim-models/SystemTopology.h"
+#include <dpsim/DirectLinearSolver.h>
 #include <dpsim/Scheduler.h>
 #include <dpsim/Solver.h>
 
@@ -48,10 +49,24 @@ protected:
 
   /// Jacobian matrix
   CPS::Matrix mJ;
-  /// Solution vector
-  CPS::Vector mX;
+  /// Sparse Jacobian matrix with pattern derived from admittance matrix
+  SparseMatrix mJSparse;
+  /// Position in the value array of mJSparse for each entry written by
+  /// calculateSparseJacobian, in the order they are written
+  std::vector<UInt> mJSparseValueIndices;
+  /// Position of each node in mPQPVBusIndices, -1 for VD buses
+  std::vector<Int> mPQPVBusPositions;
+  /// Linear solver for the sparse Jacobian, pattern is analyzed only once
+  std::shared_ptr<DirectLinearSolver> mJacobianSolver;
+  /// Implementation of the linear solver for the sparse Jacobian
+  DirectLinearSolverImpl mJacobianSolverImpl = DirectLinearSolverImpl::Undef;
+  /// Assemble sparse Jacobian and reuse its symbolic factorization
+  Bool mSparseJacobian = false;
+  /// Solution vector, a single column matrix so that the linear solver can
+  /// write into it
+  CPS::Matrix mX;
   /// Vector of mismatch values
-  CPS::Vector mF;
+  CPS::Matrix mF;
 
   /// System list
   CPS::SystemTopology mSystem;
@@ -82,7 +97,7 @@ protected:
   /// Maximum number of iterations
   CPS::UInt mMaxIterations = 9;
   /// Actual number of iterations
-  CPS::UInt mIterations;
+  CPS::UInt mIterations = 0;
   /// Base power of per-unit system
   CPS::Real mBaseApparentPower;
   /// Convergence flag
@@ -99,6 +114,10 @@ protected:
   virtual void calculateMismatch() = 0;
   /// Calculate the Jacobian
   virtual void calculateJacobian() = 0;
+  /// Determine the sparsity pattern of the Jacobian and mJSparseValueIndices
+  virtual void determineJacobianPattern() = 0;
+  /// Calculate the values of the sparse Jacobian
+  virtual void calculateSparseJacobian() = 0;
   /// Update solution in each iteration
   virtual void updateSolution() = 0;
   /// Set final solution
@@ -125,6 +144,12 @@ protected:
   CPS::Real B(int i, int j);
   /// Solves the powerflow problem
   Bool solvePowerflow();
+  /// Creates the linear solver for the sparse Jacobian and analyzes its pattern
+  void initializeSparseJacobian();
+  /// Solves mJSparse * mX = mF, reusing the symbolic factorization. The
+  /// first Newton iteration factorizes with pivoting, the following ones
+  /// refactorize with the same pivots.
+  void solveSparseJacobian(Bool refactorize);
   /// Check whether below tolerance
   CPS::Bool checkConvergence();
   /// Logging for integer vectors
@@ -151,6 +176,14 @@ public:
                                    CPS::PowerflowBusType powerFlowBusType);
   /// set solver and component to initialization or simulation behaviour
   void setSolverAndComponentBehaviour(Solver::Behaviour behaviour) override;
+  /// Assemble the Jacobian in sparse format and only refactorize it numerically
+  void doSparseJacobian(Bool value) { mSparseJacobian = value; }
+  /// Sets the linear solver used for the sparse Jacobian
+  void setDirectLinearSolverImplementation(DirectLinearSolverImpl impl) {
+    mJacobianSolverImpl = impl;
+  }
+  /// Number of Newton-Raphson iterations of the last powerflow solution
+  CPS::UInt iterations() const { return mIterations; }
 
   class SolveTask : public CPS::Task {
   public:
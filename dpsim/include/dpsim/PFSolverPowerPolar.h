@@ -35,6 +35,10 @@ protected:
   void generateInitialSolution(Real time, bool keep_last_solution = false);
   /// Calculate the Jacobian
   void calculateJacobian();
+  /// Determine the sparsity pattern of the Jacobian from the admittance matrix
+  void determineJacobianPattern();
+  /// Calculate the values of the sparse Jacobian
+  void calculateSparseJacobian();
   /// Update solution in each iteration
   void updateSolution();
   /// Set final solution
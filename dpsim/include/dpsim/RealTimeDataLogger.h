@@ -15,6 +15,7 @@
 #include <dpsim-models/PtrFactory.h>
 #include <dpsim-models/SimNode.h>
 #include <dpsim-models/Task.h>
+#include <dpsim/AsyncLogBuffer.h>
 #include <dpsim/DataLoggerInterface.h>
 #include <dpsim/Definitions.h>
 #include <dpsim/Scheduler.h>
@@ -32,12 +33,34 @@ protected:
 
   std::vector<std::vector<Real>> mAttributeData;
 
+  /// Rows of the asynchronous buffer, zero keeps all rows in memory
+  UInt mAsyncRows = 0;
+  AsyncLogBuffer::OverflowPolicy mAsyncPolicy =
+      AsyncLogBuffer::OverflowPolicy::Count;
+  std::unique_ptr<AsyncLogBuffer> mAsyncBuffer;
+  std::ofstream mLogFile;
+  AttributeExportPlan mExportPlan;
+
+  void writeHeader(std::ofstream &logFile);
+
 public:
   typedef std::shared_ptr<RealTimeDataLogger> Ptr;
 
   RealTimeDataLogger(std::filesystem::path &filename, Real finalTime,
                      Real timeStep);
   RealTimeDataLogger(std::filesystem::path &filename, size_t rowNumber);
+  virtual ~RealTimeDataLogger();
+
+  /// Stream the rows to the file from a background thread through a ring
+  /// buffer of `rows` rows instead of preallocating memory for the whole
+  /// simulation. The run length is then unbounded. Must be called before
+  /// start().
+  void setAsyncBuffer(UInt rows, AsyncLogBuffer::OverflowPolicy policy =
+                                     AsyncLogBuffer::OverflowPolicy::Count);
+  /// Number of rows lost because the asynchronous buffer was full
+  UInt asyncOverruns() const {
+    return mAsyncBuffer ? mAsyncBuffer->overruns() : 0;
+  }
 
   virtual void start() override;
   virtual void stop() override;
@@ -12,6 +12,8 @@
 
 #include <dpsim-models/Logger.h>
 #include <dpsim/Definitions.h>
+#include <dpsim/TimingStatistics.h>
+#include <dpsim/WaitStrategy.h>
 
 #include <atomic>
 #include <chrono>
@@ -106,10 +108,8 @@ protected:
   CPS::Logger::Log mSLog;
 
 private:
-  // TODO more sophisticated measurement method might be necessary for
-  // longer simulations (risk of high memory requirements and integer
-  // overflow)
-  std::unordered_map<CPS::Task *, std::vector<TaskTime>> mMeasurements;
+  /// Execution time statistics for each task
+  std::unordered_map<CPS::Task *, TimingStatistics> mMeasurements;
 };
 
 /// A barrier is used to synchronize threads. Threads running into the barrier
@@ -121,8 +121,13 @@ public:
   Barrier() = delete;
   /// Limit sets the number of threads that need to reach the barrier
   /// to release it.
-  Barrier(Int limit, Bool useCondition = false)
-      : mLimit(limit), mCount(0), mGeneration(0), mUseCondition(useCondition) {}
+  /// Without condition variable, waiting threads follow the policy of
+  /// `strategy`, or of WaitStrategy::global() if it is nullptr.
+  Barrier(Int limit, Bool useCondition = false,
+          WaitStrategy *strategy = nullptr)
+      : mLimit(limit), mCount(0), mGeneration(0), mWaiters(0),
+        mUseCondition(useCondition),
+        mStrategy(strategy ? strategy : &WaitStrategy::global()) {}
 
   /// Blocks until |limit| calls have been made, at which point all threads
   /// return. Provides synchronization, i.e. all writes from before this call
@@ -150,10 +155,10 @@ public:
       // (This generates the same code on x86.)
       if (mCount.fetch_add(1, std::memory_order_acq_rel) == mLimit - 1) {
         mCount.store(0, std::memory_order_relaxed);
-        mGeneration.fetch_add(1, std::memory_order_release);
+        mGeneration.fetch_add(1, std::memory_order_seq_cst);
+        WaitStrategy::wake(mGeneration, mWaiters);
       } else {
-        while (mGeneration.load(std::memory_order_acquire) == gen)
-          ;
+        mStrategy->wait(mGeneration, gen, mWaiters);
       }
     }
   }
@@ -176,7 +181,8 @@ public:
       // No release here, as this call does not provide any synchronization anyway.
       if (mCount.fetch_add(1, std::memory_order_acquire) == mLimit - 1) {
         mCount.store(0, std::memory_order_relaxed);
-        mGeneration.fetch_add(1, std::memory_order_release);
+        mGeneration.fetch_add(1, std::memory_order_seq_cst);
+        WaitStrategy::wake(mGeneration, mWaiters);
       }
     }
   }
@@ -188,7 +194,10 @@ private:
   std::atomic<Int> mCount;
   /// Allows multiple use of the barrier
   std::atomic<Int> mGeneration;
+  /// Threads parked on mGeneration
+  std::atomic<Int> mWaiters;
   Bool mUseCondition;
+  WaitStrategy *mStrategy;
 
   std::mutex mMutex;
   std::condition_variable mCondition;
@@ -206,16 +215,24 @@ private:
 
 class Counter {
 public:
-  Counter() : mValue(0) {}
+  Counter() : mValue(0), mWaiters(0) {}
 
-  void inc() { mValue.fetch_add(1, std::memory_order_release); }
+  void inc() {
+    mValue.fetch_add(1, std::memory_order_seq_cst);
+    WaitStrategy::wake(mValue, mWaiters);
+  }
 
-  void wait(Int value) {
-    while (mValue.load(std::memory_order_acquire) != value)
-      ;
+  /// Blocks until the counter reaches `value` according to the policy of
+  /// `strategy`
+  void wait(Int value, WaitStrategy &strategy = WaitStrategy::global()) {
+    Int current;
+    while ((current = mValue.load(std::memory_order_acquire)) != value)
+      strategy.wait(mValue, current, mWaiters);
   }
 
 private:
   std::atomic<Int> mValue;
+  /// Threads parked on mValue
+  std::atomic<Int> mWaiters;
 };
 } // namespace DPsim
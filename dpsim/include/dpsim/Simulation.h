@@ -7,6 +7,7 @@
 
 #include <dpsim-models/Attribute.h>
 #include <dpsim-models/Definitions.h>
+#include <dpsim-models/Filesystem.h>
 #include <dpsim-models/Logger.h>
 #include <dpsim-models/SimNode.h>
 #include <dpsim-models/SystemTopology.h>
@@ -16,6 +17,7 @@
 #include <dpsim/Interface.h>
 #include <dpsim/Scheduler.h>
 #include <dpsim/Solver.h>
+#include <dpsim/TimingStatistics.h>
 
 #ifdef WITH_GRAPHVIZ
 #include <dpsim-models/Graph.h>
@@ -52,6 +54,29 @@ public:
   /// By default the initialization is disabled.
   const CPS::Attribute<Bool>::Ptr mSteadyStateInit;
 
+  /// Average (real) time needed for a time step
+  const CPS::Attribute<Real>::Ptr mStepTimeMean;
+  /// Maximum (real) time needed for a time step
+  const CPS::Attribute<Real>::Ptr mStepTimeMax;
+  /// Median (real) time needed for a time step
+  const CPS::Attribute<Real>::Ptr mStepTimeP50;
+  /// 99th percentile of the (real) time needed for a time step
+  const CPS::Attribute<Real>::Ptr mStepTimeP99;
+  /// 99.9th percentile of the (real) time needed for a time step
+  const CPS::Attribute<Real>::Ptr mStepTimeP999;
+  /// Average time of the linear solves of all solvers
+  const CPS::Attribute<Real>::Ptr mSolveTimeMean;
+  /// Maximum time of the linear solves of all solvers
+  const CPS::Attribute<Real>::Ptr mSolveTimeMax;
+  /// Average time of the LU factorizations of all solvers
+  const CPS::Attribute<Real>::Ptr mFactorizeTimeMean;
+  /// Maximum time of the LU factorizations of all solvers
+  const CPS::Attribute<Real>::Ptr mFactorizeTimeMax;
+  /// Average time of the LU refactorizations of all solvers
+  const CPS::Attribute<Real>::Ptr mRecomputeTimeMean;
+  /// Maximum time of the LU refactorizations of all solvers
+  const CPS::Attribute<Real>::Ptr mRecomputeTimeMax;
+
 protected:
   /// Time variable that is incremented at every step
   Real mTime = 0;
@@ -73,9 +98,18 @@ protected:
   /// Simulation log level
   CPS::Logger::Level mLogLevel;
   /// (Real) time needed for the timesteps
-  std::vector<Real> mStepTimes;
+  TimingStatistics mStepTimes;
+  /// Individual step times written by logStepTimes() if enabled by
+  /// setStepTimeSampleLimit(), reserved in start()
+  std::vector<Real> mStepTimeSamples;
+  /// Maximum number of individual step times kept for logStepTimes()
+  UInt mStepTimeSampleLimit = 0;
+  /// Number of time steps that took longer than the time step
+  UInt mStepTimeOverruns = 0;
   /// activate collection of step times
   Bool mLogStepTimes = true;
+  /// Fail if a simulation step allocates heap memory
+  Bool mAllocationCheck = false;
 
   // #### Solver Settings ####
   ///
@@ -94,6 +128,19 @@ protected:
   Bool mInitFromNodesAndTerminals = true;
   /// Enable recomputation of system matrix during simulation
   Bool mSystemMatrixRecomputation = false;
+  /// Sum up only the rows of the right side vector that components write to
+  Bool mSparseRightVector = true;
+  /// Assemble the powerflow Jacobian in sparse format
+  Bool mSparsePowerflowJacobian = false;
+  /// Maximum number of factorized switch states, zero precomputes all states
+  UInt mSwitchStateCacheSize = 0;
+  /// Memory limit in bytes for the factorized switch states
+  std::size_t mSwitchStateCacheMemory = 0;
+  /// Switch states that are factorized during initialization
+  std::vector<std::size_t> mLikelySwitchStates;
+  /// Maximum number of system matrix rows and columns corrected by low-rank
+  /// switch updates, zero disables them
+  UInt mSwitchUpdateMaxIndices = 0;
 
   /// If tearing components exist, the Diakoptics
   /// solver is selected automatically.
@@ -107,6 +154,16 @@ protected:
   ///
   Bool mInitialized = false;
 
+  // #### Snapshot ####
+  /// Snapshot that initialize() resumes from, empty if disabled
+  fs::path mSnapshotPath;
+  /// Attribute values of the snapshot by object key and attribute name
+  std::map<String, CPS::AttributeBase::Map> mSnapshotAttributes;
+  /// Data of the solvers in the snapshot in the order of mSolvers
+  std::vector<String> mSnapshotSolverData;
+  /// Number of time steps executed before the snapshot was saved
+  Int mSnapshotTimeStepCount = 0;
+
   // #### Initialization ####
   /// steady state initialization time limit
   Real mSteadStIniTimeLimit = 10;
@@ -143,6 +200,17 @@ protected:
   /// Prepare schedule for simulation
   void prepSchedule();
 
+  /// Nodes, components and their subcomponents by the keys used in
+  /// snapshots. Subcomponent keys are prefixed with the key of the parent.
+  std::map<String, CPS::IdentifiedObject::Ptr> snapshotObjects();
+  /// Reads the snapshot from mSnapshotPath
+  void readSnapshot();
+  /// Copies the attribute values of the snapshot onto the system. If
+  /// requireAll is set, all objects of the snapshot have to exist.
+  void restoreSnapshotAttributes(Bool requireAll);
+  /// Passes the snapshot data to a solver before its initialization
+  void restoreSolverSnapshot(Solver::Ptr solver);
+
   /// ### SynGen Interface ###
   int mMaxIterations = 10;
 
@@ -213,9 +281,47 @@ public:
   void doSystemMatrixRecomputation(Bool value) {
     mSystemMatrixRecomputation = value;
   }
+  /// Sum up the components' right side vector stamps only at the rows they
+  /// write to instead of adding the full vectors. Only applies to components
+  /// that declare their rows, the others are always added completely.
+  void doSparseRightVector(Bool value) { mSparseRightVector = value; }
+  /// Assemble the powerflow Jacobian directly in sparse format and reuse its
+  /// symbolic factorization over all Newton-Raphson iterations
+  void doSparsePowerflowJacobian(Bool value) {
+    mSparsePowerflowJacobian = value;
+  }
+  /// Factorize the system matrix of a switch state when it is first reached
+  /// and keep at most maxStates factorizations instead of precomputing all
+  /// 2^N switch states. A maxMemory of zero means no memory limit.
+  void setSwitchStateCache(UInt maxStates, std::size_t maxMemory = 0) {
+    mSwitchStateCacheSize = maxStates;
+    mSwitchStateCacheMemory = maxMemory;
+  }
+  /// Switch states that are factorized during initialization if the
+  /// switch state cache is used, bit i is set if switch i is closed
+  void setLikelySwitchStates(const std::vector<std::size_t> &states) {
+    mLikelySwitchStates = states;
+  }
+  /// Factorize only the initial switch state and apply switch changes as
+  /// low-rank corrections during the solve. Once the changed switches touch
+  /// more than maxIndices rows and columns of the system matrix, the current
+  /// switch state is factorized in the background. The rank of the
+  /// correction is at most the number of these indices. Takes precedence
+  /// over the switch state cache.
+  void setLowRankSwitchUpdates(UInt maxIndices) {
+    mSwitchUpdateMaxIndices = maxIndices;
+  }
   /// If logStepTimes is enabled, the time needed for every timesteps is logged
   /// and can be written to a file or the console using logStepTimes()
   void setLogStepTimes(Bool f) { mLogStepTimes = f; }
+  /// Keep at most `limit` individual step times for logStepTimes(). Later
+  /// steps only enter the step time statistics. Disabled by default, then
+  /// logStepTimes() approximates the step times by their histogram.
+  void setStepTimeSampleLimit(UInt limit) { mStepTimeSampleLimit = limit; }
+  /// If enabled, step() throws if events or scheduled tasks allocate heap
+  /// memory on the stepping thread or the scheduler threads. The first step
+  /// is not checked. Requires a build with WITH_ALLOCATION_CHECK.
+  void doAllocationCheck(Bool value);
 
   // #### Initialization ####
   /// activate steady state initialization
@@ -225,6 +331,16 @@ public:
   /// set steady state initialization accuracy limit
   void setSteadStIniAccLimit(Real v) { mSteadStIniAccLimit = v; }
 
+  // #### Snapshots ####
+  /// Writes the attribute values of all nodes and components, the solution
+  /// vectors, matrix node indices and system matrix pattern of the
+  /// simulation to a binary file. Initializes the simulation if required.
+  void saveSnapshot(const fs::path &path);
+  /// Resume from a snapshot of the same system in initialize(). This skips
+  /// the steady-state initialization, so the powerflow can be skipped as
+  /// well. The snapshot must be saved with the same domain and time step.
+  void restoreFromSnapshot(const fs::path &path) { mSnapshotPath = path; }
+
   // #### Simulation Control ####
   /// Create solver instances etc.
   void initialize();
@@ -236,10 +352,19 @@ public:
   Real next();
   /// Run simulation until total time is elapsed.
   void run();
+  /// Run `steps` time steps of a started simulation, at most until the final
+  /// time. Unlike next(), the simulation is not stopped at the end.
+  /// Returns the simulation time.
+  Real runFor(UInt steps);
+  /// Run a started simulation until the simulation time passes `time`, at
+  /// most until the final time. Returns the simulation time.
+  Real runUntil(Real time);
   /// Solve system A * x = z for x and current time
   virtual Real step();
   /// Synchronize simulation with remotes by exchanging intial state over interfaces
   void sync() const;
+  /// Update the step time percentile and solver timing attributes
+  void updateTimingAttributes();
   /// Create the schedule for the independent tasks
   void schedule();
 
@@ -249,7 +374,10 @@ public:
   void addLogger(DataLoggerInterface::Ptr logger) {
     mLoggers.push_back(logger);
   }
-  /// Write step time measurements to log file
+  /// Write the step times to the log file `logName` and their histogram to
+  /// `logName` with "_step_times" replaced by "_step_time_hist" (or "_hist"
+  /// appended). Without setStepTimeSampleLimit(), the step times are taken
+  /// from the histogram in ascending order.
   void logStepTimes(String logName);
   /// Check for overruns
   void checkForOverruns(String logName);
@@ -276,7 +404,9 @@ public:
   Real timeStep() const { return **mTimeStep; }
   DataLogger::List &loggers() { return mLoggers; }
   std::shared_ptr<Scheduler> scheduler() { return mScheduler; }
-  std::vector<Real> &stepTimes() { return mStepTimes; }
+  /// Switch state cache usage summed over all solvers
+  Solver::SwitchStateCacheStatistics switchStateCacheStatistics() const;
+  const TimingStatistics &stepTimes() const { return mStepTimes; }
 
   // #### Set component attributes during simulation ####
   /// CHECK: Can these be deleted? getIdObjAttribute + "**attr =" should suffice
@@ -0,0 +1,95 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <iostream>
+#include <vector>
+
+#include <dpsim-models/Attribute.h>
+#include <dpsim/Definitions.h>
+
+namespace DPsim {
+
+/// Binary encoding of the values stored in simulation snapshots.
+///
+/// Values are written in the native byte order, so snapshots are only meant
+/// to be restored on the same platform. All read functions throw
+/// CPS::SystemError if the stream ends early.
+class Snapshot {
+public:
+  /// Identifies the type of an attribute value
+  enum class ValueType : UInt {
+    Real,
+    Complex,
+    Int,
+    UInt,
+    Bool,
+    Matrix,
+    MatrixComp
+  };
+
+  /// Increase when the layout of the snapshots changes
+  static constexpr UInt Version = 1;
+
+  /// Writes the file identifier and the version
+  static void writeHeader(std::ostream &out);
+  /// Throws if the stream does not start with a header of this version
+  static void readHeader(std::istream &in);
+
+  template <typename T> static void writeValue(std::ostream &out, T value) {
+    out.write(reinterpret_cast<const char *>(&value), sizeof(T));
+  }
+
+  template <typename T> static T readValue(std::istream &in) {
+    T value{};
+    in.read(reinterpret_cast<char *>(&value), sizeof(T));
+    checkStream(in);
+    return value;
+  }
+
+  static void writeString(std::ostream &out, const String &value);
+  static String readString(std::istream &in);
+
+  template <typename T>
+  static void writeMatrix(std::ostream &out, const CPS::MatrixVar<T> &value) {
+    writeValue<UInt>(out, static_cast<UInt>(value.rows()));
+    writeValue<UInt>(out, static_cast<UInt>(value.cols()));
+    out.write(reinterpret_cast<const char *>(value.data()),
+              value.size() * sizeof(T));
+  }
+
+  template <typename T> static CPS::MatrixVar<T> readMatrix(std::istream &in) {
+    UInt rows = readValue<UInt>(in);
+    UInt cols = readValue<UInt>(in);
+    CPS::MatrixVar<T> value(rows, cols);
+    in.read(reinterpret_cast<char *>(value.data()), value.size() * sizeof(T));
+    checkStream(in);
+    return value;
+  }
+
+  /// Writes the pattern of a compressed sparse matrix without its values
+  static void writePattern(std::ostream &out, const SparseMatrix &matrix);
+  /// Reads a pattern written by writePattern, the values are zero
+  static SparseMatrix readPattern(std::istream &in);
+
+  /// Returns false if the value of the attribute cannot be stored
+  static Bool isSupported(CPS::AttributeBase::Ptr attr);
+  /// Writes the type and value of a supported attribute
+  static void writeAttribute(std::ostream &out, CPS::AttributeBase::Ptr attr);
+  /// Returns a new static attribute with a value written by writeAttribute
+  static CPS::AttributeBase::Ptr readAttribute(std::istream &in);
+
+private:
+  static void checkStream(std::istream &in);
+
+  template <typename T> static T &value(CPS::AttributeBase::Ptr attr) {
+    return std::dynamic_pointer_cast<CPS::Attribute<T>>(attr.getPtr())->get();
+  }
+};
+} // namespace DPsim
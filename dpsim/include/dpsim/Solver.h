@@ -18,6 +18,7 @@
 #include <dpsim/Config.h>
 #include <dpsim/Definitions.h>
 #include <dpsim/DirectLinearSolverConfiguration.h>
+#include <dpsim/TimingStatistics.h>
 
 namespace DPsim {
 /// Holds switching time and which system should be activated.
@@ -62,6 +63,19 @@ protected:
   Bool mInitFromNodesAndTerminals = true;
   /// Enable recomputation of system matrix during simulation
   Bool mSystemMatrixRecomputation = false;
+  /// Sum up only the rows of the right side vector that components write to
+  Bool mSparseRightVector = true;
+  /// Maximum number of factorized switch states kept in memory.
+  /// If zero, the system matrices of all switch states are precomputed.
+  UInt mSwitchStateCacheSize = 0;
+  /// Memory limit in bytes for the factorized switch states, zero means no limit
+  std::size_t mSwitchStateCacheMemory = 0;
+  /// Switch states that are factorized already during initialization
+  std::vector<std::size_t> mLikelySwitchStates;
+  /// Maximum number of system matrix rows and columns corrected by the
+  /// low-rank updates of the factorization of a base switch state, zero
+  /// disables low-rank switch updates
+  UInt mSwitchUpdateMaxIndices = 0;
 
   /// Solver behaviour initialization or simulation
   Behaviour mBehaviour = Solver::Behaviour::Simulation;
@@ -90,6 +104,29 @@ public:
   void doSystemMatrixRecomputation(Bool value) {
     mSystemMatrixRecomputation = value;
   }
+  /// Sum up the components' right side vector stamps only at the rows they
+  /// write to instead of adding the full vectors. Only applies to components
+  /// that declare their rows, the others are always added completely.
+  void doSparseRightVector(Bool value) { mSparseRightVector = value; }
+  /// Factorize switch states on first use and keep at most maxStates of them
+  /// (only available in MNA for now)
+  void setSwitchStateCache(UInt maxStates, std::size_t maxMemory = 0) {
+    mSwitchStateCacheSize = maxStates;
+    mSwitchStateCacheMemory = maxMemory;
+  }
+  /// Switch states to factorize during initialization, bit i is set if
+  /// switch i is closed
+  void setLikelySwitchStates(const std::vector<std::size_t> &states) {
+    mLikelySwitchStates = states;
+  }
+  /// Factorize only one switch state and apply switch changes as low-rank
+  /// corrections. If the switch changes touch more than maxIndices rows and
+  /// columns of the system matrix, the current state is factorized in the
+  /// background and becomes the new base state.
+  /// (only available in MNA for now)
+  void setLowRankSwitchUpdates(UInt maxIndices) {
+    mSwitchUpdateMaxIndices = maxIndices;
+  }
 
   void setLogSolveTimes(Bool value) { mLogSolveTimes = value; }
 
@@ -115,6 +152,38 @@ public:
   virtual void logLUTimes() {
     // no default implementation for all types of solvers
   }
+  /// Usage of the cache of factorized switch states
+  struct SwitchStateCacheStatistics {
+    /// Lookups that found a factorization in the cache
+    UInt hits = 0;
+    /// Lookups that required a new factorization
+    UInt misses = 0;
+    /// Factorizations removed from the cache
+    UInt evictions = 0;
+    /// Number of cached switch states
+    UInt states = 0;
+    /// Estimated memory of the cached switch states in bytes
+    std::size_t memory = 0;
+  };
+  /// Switch state cache usage, all zero if the cache is not used
+  virtual SwitchStateCacheStatistics switchStateCacheStatistics() const {
+    return {};
+  }
+  /// Solve time measurements, nullptr if the solver does not collect them
+  virtual const TimingStatistics *solveTimes() const { return nullptr; }
+  /// LU factorization time measurements, nullptr if not applicable
+  virtual const TimingStatistics *factorizeTimes() const { return nullptr; }
+  /// LU refactorization time measurements, nullptr if not applicable
+  virtual const TimingStatistics *recomputationTimes() const {
+    return nullptr;
+  }
+
+  // #### Snapshot ####
+  /// Writes the solver data required to resume the simulation
+  virtual void writeSnapshot(std::ostream &out) {}
+  /// Reads the data written by writeSnapshot. Must be called before
+  /// initialize(), which applies the data.
+  virtual void readSnapshot(std::istream &in) {}
 
   // #### Simulation ####
   /// Get tasks for scheduler
@@ -23,6 +23,16 @@ public:
   void step(Real time, Int timeStepCount);
   virtual void stop();
 
+  /// Sets how threads wait for the start of a step and for the tasks of
+  /// other threads. Must not be called while a step is running.
+  void setWaitPolicy(const WaitPolicy &policy) {
+    mWaitStrategy.setPolicy(policy);
+  }
+  /// Number of times threads parked since the start of the previous step
+  uint64_t lastStepParks() const { return mLastStepParks; }
+  /// Number of times threads parked since the construction
+  uint64_t parks() const { return mWaitStrategy.parks(); }
+
 protected:
   void finishSchedule(const Edges &inEdges);
   void scheduleTask(int thread, CPS::Task::Ptr task);
@@ -34,6 +44,7 @@ private:
   static void threadFunction(ThreadScheduler *sched, Int idx);
 
   String mOutMeasurementFile;
+  WaitStrategy mWaitStrategy;
   Barrier mStartBarrier;
 
   std::vector<std::thread> mThreads;
@@ -46,6 +57,8 @@ private:
   };
   std::vector<ScheduleEntry *> mSchedules;
 
+  uint64_t mStepStartParks = 0;
+  uint64_t mLastStepParks = 0;
   Bool mJoining = false;
   Real mTime = 0;
   Int mTimeStepCount = 0;
@@ -0,0 +1,92 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+#include <dpsim-models/Logger.h>
+#include <dpsim/Definitions.h>
+
+namespace DPsim {
+
+/// Online statistics of time measurements with fixed memory.
+///
+/// Tracks count, mean, variance, minimum and maximum with Welford's algorithm
+/// and sorts the samples into a log-linear histogram with nanosecond
+/// resolution. Percentiles are read from the histogram with a relative error
+/// below 1/64. Samples above ~18 minutes fall into the last bucket.
+///
+/// There must only be one thread calling update(). Other threads may read
+/// the statistics at any time, but a read does not return a consistent
+/// snapshot of all values.
+class TimingStatistics {
+public:
+  /// Sub-buckets per power of two are 2^SubBucketBits
+  static constexpr UInt SubBucketBits = 5;
+  static constexpr UInt SubBucketCount = 1 << SubBucketBits;
+  /// Samples up to 2^MaxBits nanoseconds are resolved
+  static constexpr UInt MaxBits = 40;
+  static constexpr UInt BucketCount =
+      (MaxBits - SubBucketBits + 1) * SubBucketCount;
+
+  TimingStatistics() { reset(); }
+
+  TimingStatistics(const TimingStatistics &) = delete;
+  TimingStatistics &operator=(const TimingStatistics &) = delete;
+
+  /// Removes all samples
+  void reset();
+  /// Adds a sample in seconds
+  void update(Real seconds);
+
+  /// Number of samples
+  uint64_t count() const { return mCount.load(std::memory_order_relaxed); }
+  /// Mean in seconds
+  Real mean() const { return mMean.load(std::memory_order_relaxed); }
+  /// Sample variance in seconds squared
+  Real variance() const;
+  /// Sample standard deviation in seconds
+  Real stdDeviation() const;
+  /// Minimum in seconds, zero without samples
+  Real min() const;
+  /// Maximum in seconds, zero without samples
+  Real max() const;
+  /// Sum of all samples in seconds
+  Real sum() const { return mean() * static_cast<Real>(count()); }
+  /// Value in seconds below which the fraction q of all samples lies
+  Real percentile(Real q) const;
+
+  /// Logs count, mean, standard deviation, extrema and percentiles
+  void logSummary(CPS::Logger::Log log, const String &name) const;
+  /// Logs the lower bound in seconds and count of all non-empty buckets
+  void logHistogram(CPS::Logger::Log log) const;
+  /// Logs one value per sample in ascending order, the middle of the bucket
+  /// it fell into
+  void logSamples(CPS::Logger::Log log) const;
+
+private:
+  /// Bucket index of a sample in nanoseconds
+  static UInt bucketIndex(uint64_t nanoseconds);
+  /// Smallest sample in nanoseconds that falls into the bucket
+  static uint64_t bucketLowerBound(UInt index);
+  /// Number of nanoseconds covered by the bucket
+  static uint64_t bucketWidth(UInt index);
+
+  std::atomic<uint64_t> mCount;
+  std::atomic<Real> mMean;
+  /// Sum of squared differences from the mean
+  std::atomic<Real> mM2;
+  std::atomic<Real> mMin;
+  std::atomic<Real> mMax;
+  std::array<std::atomic<uint64_t>, BucketCount> mBuckets;
+};
+
+} // namespace DPsim
@@ -0,0 +1,84 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+#include <dpsim/Definitions.h>
+
+namespace DPsim {
+
+/// Thresholds of the hybrid wait used by the thread based schedulers.
+///
+/// A waiting thread first busy-waits with a CPU pause hint for
+/// `spinCount` iterations, then calls `std::this_thread::yield()`
+/// `yieldCount` times and finally parks in the kernel until it is woken up.
+/// Spinning gives the lowest wake-up latency, parking frees the core for
+/// other threads while the simulation is idle, e.g. between real-time ticks.
+struct WaitPolicy {
+  /// Busy-wait iterations before yielding
+  UInt spinCount = 4000;
+  /// Yields before parking
+  UInt yieldCount = 16;
+  /// Park after spinning and yielding. Disable this for hard real-time
+  /// simulations on isolated cores, where threads must never sleep.
+  Bool park = true;
+
+  /// Policy that only spins, like the schedulers did before parking was
+  /// introduced
+  static WaitPolicy spinning() { return {0, 0, false}; }
+};
+
+/// Waits for an atomic integer to change according to a `WaitPolicy` and
+/// counts how often threads parked.
+///
+/// Parking uses a futex on Linux. On other platforms, parked threads sleep
+/// for a short time and check the value again.
+class WaitStrategy {
+public:
+  WaitStrategy(const WaitPolicy &policy = WaitPolicy()) : mPolicy(policy) {}
+
+  WaitStrategy(const WaitStrategy &) = delete;
+  WaitStrategy &operator=(const WaitStrategy &) = delete;
+
+  /// Must not be called while threads are waiting
+  void setPolicy(const WaitPolicy &policy) { mPolicy = policy; }
+  const WaitPolicy &policy() const { return mPolicy; }
+
+  /// Blocks until `word` no longer holds `value`. `waiters` counts the threads
+  /// parked on `word`, so that wake() can skip the system call if there are
+  /// none. Loads of `word` are acquire operations.
+  void wait(const std::atomic<Int> &word, Int value,
+            std::atomic<Int> &waiters);
+  /// Wakes all threads parked on `word`. Must be called after every change
+  /// of `word` that waiting threads are interested in.
+  static void wake(std::atomic<Int> &word, const std::atomic<Int> &waiters) {
+    if (waiters.load(std::memory_order_seq_cst) != 0)
+      wakeAll(word);
+  }
+
+  /// Number of times a thread parked since the construction
+  uint64_t parks() const { return mParks.load(std::memory_order_relaxed); }
+
+  /// Hints the CPU that the calling thread is busy-waiting
+  static void pause();
+
+  /// Strategy of barriers and counters without an explicit strategy
+  static WaitStrategy &global();
+
+private:
+  static void park(const std::atomic<Int> &word, Int value);
+  static void wakeAll(std::atomic<Int> &word);
+
+  WaitPolicy mPolicy;
+  std::atomic<uint64_t> mParks{0};
+};
+
+} // namespace DPsim
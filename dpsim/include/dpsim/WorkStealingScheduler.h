@@ -0,0 +1,111 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#pragma once
+
+#include <dpsim/Scheduler.h>
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace DPsim {
+/// Scheduler that maps tasks to threads at run time instead of in
+/// createSchedule().
+///
+/// Every task has a counter of unfinished predecessors. A thread that
+/// finishes a task decrements the counters of its successors and continues
+/// with the most critical task that became ready, the others are pushed to
+/// the thread's work-stealing deque. Idle threads steal from the other
+/// deques. Tasks are prioritized by the length of the longest path to the end
+/// of the step, weighted with the averaged task times from
+/// `inMeasurementFile` if it is given. Threads that find no task wait
+/// according to the WaitPolicy until another task finishes.
+class WorkStealingScheduler : public Scheduler {
+public:
+  WorkStealingScheduler(Int threads = 1, String outMeasurementFile = String(),
+                        String inMeasurementFile = String());
+  virtual ~WorkStealingScheduler();
+
+  void createSchedule(const CPS::Task::List &tasks, const Edges &inEdges,
+                      const Edges &outEdges);
+  void step(Real time, Int timeStepCount);
+  virtual void stop();
+
+  /// Sets how idle threads wait for new tasks. Must not be called while a
+  /// step is running.
+  void setWaitPolicy(const WaitPolicy &policy) {
+    mWaitStrategy.setPolicy(policy);
+  }
+  /// Number of times threads parked since the start of the previous step
+  uint64_t lastStepParks() const { return mLastStepParks; }
+  /// Number of times threads parked since the construction
+  uint64_t parks() const { return mWaitStrategy.parks(); }
+
+private:
+  /// Chase-Lev deque of task indices with a fixed capacity. Only the owner
+  /// thread pushes and pops at the bottom, other threads steal from the top.
+  /// Reset before every step, so the indices never wrap around.
+  class Deque {
+  public:
+    explicit Deque(size_t capacity);
+
+    void reset();
+    void push(UInt task);
+    Bool pop(UInt &task);
+    Bool steal(UInt &task);
+
+  private:
+    std::unique_ptr<std::atomic<UInt>[]> mBuffer;
+    alignas(64) std::atomic<int64_t> mTop;
+    alignas(64) std::atomic<int64_t> mBottom;
+  };
+
+  struct TaskEntry {
+    CPS::Task *task;
+    /// Successor indices ordered by descending priority
+    std::vector<UInt> successors;
+    UInt predecessors;
+    /// Estimated time from the start of this task to the end of the step
+    TaskTime::rep priority;
+  };
+
+  static void threadFunction(WorkStealingScheduler *sched, Int idx);
+  void doStep(Int thread);
+  /// Runs a task and returns the next task for this thread in `next`
+  Bool execute(UInt task, Int thread, UInt &next);
+
+  Int mNumThreads;
+  String mOutMeasurementFile;
+  String mInMeasurementFile;
+  WaitStrategy mWaitStrategy;
+  Barrier mStartBarrier;
+
+  std::vector<std::thread> mThreads;
+  std::vector<TaskEntry> mTasks;
+  /// Tasks without predecessors, ordered by descending priority
+  std::vector<UInt> mInitialTasks;
+  std::vector<std::unique_ptr<Deque>> mDeques;
+  /// Unfinished predecessors of every task in the current step
+  std::unique_ptr<std::atomic<UInt>[]> mPending;
+
+  /// Unfinished tasks in the current step, changes whenever new tasks may
+  /// have become ready
+  alignas(64) std::atomic<Int> mRemaining{0};
+  std::atomic<Int> mRemainingWaiters{0};
+  alignas(64) std::atomic<Int> mActiveThreads{0};
+  std::atomic<Int> mActiveWaiters{0};
+
+  uint64_t mStepStartParks = 0;
+  uint64_t mLastStepParks = 0;
+
+  Bool mJoining = false;
+  Real mTime = 0;
+  Int mTimeStepCount = 0;
+};
+} // namespace DPsim
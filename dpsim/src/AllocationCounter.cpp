@@ -0,0 +1,91 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <atomic>
+#include <cerrno>
+
+#include <dpsim/AllocationCounter.h>
+
+using namespace DPsim;
+
+static std::atomic<bool> sCounting(false);
+static std::atomic<std::size_t> sAllocations(0);
+// The initial-exec model keeps the first access of a thread from allocating
+// the TLS block of the library with malloc, which would recurse.
+static thread_local bool tCountThread
+    __attribute__((tls_model("initial-exec"))) = false;
+
+static inline void countAllocation() {
+  if (tCountThread && sCounting.load(std::memory_order_relaxed))
+    sAllocations.fetch_add(1, std::memory_order_relaxed);
+}
+
+#ifdef WITH_ALLOCATION_CHECK
+// Interpose the allocation functions of glibc. This catches operator new
+// as well as Eigen and SuiteSparse, which call malloc directly.
+extern "C" {
+void *__libc_malloc(std::size_t size);
+void *__libc_calloc(std::size_t num, std::size_t size);
+void *__libc_realloc(void *ptr, std::size_t size);
+void *__libc_memalign(std::size_t alignment, std::size_t size);
+
+void *malloc(std::size_t size) {
+  countAllocation();
+  return __libc_malloc(size);
+}
+
+void *calloc(std::size_t num, std::size_t size) {
+  countAllocation();
+  return __libc_calloc(num, size);
+}
+
+void *realloc(void *ptr, std::size_t size) {
+  countAllocation();
+  return __libc_realloc(ptr, size);
+}
+
+int posix_memalign(void **ptr, std::size_t alignment, std::size_t size) {
+  if (alignment % sizeof(void *) != 0 ||
+      (alignment & (alignment - 1)) != 0 || alignment == 0)
+    return EINVAL;
+  countAllocation();
+  void *mem = __libc_memalign(alignment, size);
+  if (!mem)
+    return ENOMEM;
+  *ptr = mem;
+  return 0;
+}
+
+void *aligned_alloc(std::size_t alignment, std::size_t size) {
+  countAllocation();
+  return __libc_memalign(alignment, size);
+}
+}
+#endif
+
+bool AllocationCounter::isSupported() {
+#ifdef WITH_ALLOCATION_CHECK
+  return true;
+#else
+  return false;
+#endif
+}
+
+void AllocationCounter::countThisThread(bool value) { tCountThread = value; }
+
+bool AllocationCounter::countsThisThread() { return tCountThread; }
+
+void AllocationCounter::start() {
+  sAllocations.store(0, std::memory_order_relaxed);
+  sCounting.store(true, std::memory_order_release);
+}
+
+std::size_t AllocationCounter::stop() {
+  sCounting.store(false, std::memory_order_release);
+  return sAllocations.load(std::memory_order_relaxed);
+}
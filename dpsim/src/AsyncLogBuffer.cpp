@@ -0,0 +1,93 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <stdexcept>
+
+#include <dpsim/AsyncLogBuffer.h>
+
+using namespace DPsim;
+
+AsyncLogBuffer::AsyncLogBuffer(UInt rows, UInt columns, OverflowPolicy policy,
+                               WriteFunction write, FlushFunction flush,
+                               std::chrono::microseconds drainInterval)
+    : mRows(rows), mColumns(columns), mPolicy(policy), mWrite(write),
+      mFlush(flush), mDrainInterval(drainInterval) {
+  if (mRows == 0)
+    throw std::invalid_argument("AsyncLogBuffer: row count must be positive");
+  if (!mWrite)
+    throw std::invalid_argument("AsyncLogBuffer: missing write function");
+
+  mData.resize(static_cast<size_t>(mRows) * mColumns);
+}
+
+AsyncLogBuffer::~AsyncLogBuffer() { stop(); }
+
+void AsyncLogBuffer::start() {
+  if (mRunning.exchange(true))
+    return;
+
+  mThread = std::thread(&AsyncLogBuffer::run, this);
+}
+
+void AsyncLogBuffer::stop() {
+  if (!mRunning.exchange(false))
+    return;
+
+  if (mThread.joinable())
+    mThread.join();
+}
+
+Real *AsyncLogBuffer::acquireRow() {
+  uint64_t head = mHead.load(std::memory_order_relaxed);
+
+  while (head - mTail.load(std::memory_order_acquire) >= mRows) {
+    if (mPolicy != OverflowPolicy::Block || !mRunning.load()) {
+      mOverruns.fetch_add(1, std::memory_order_relaxed);
+      return nullptr;
+    }
+    std::this_thread::yield();
+  }
+
+  return &mData[(head % mRows) * mColumns];
+}
+
+void AsyncLogBuffer::commitRow() {
+  mHead.store(mHead.load(std::memory_order_relaxed) + 1,
+              std::memory_order_release);
+}
+
+bool AsyncLogBuffer::drain() {
+  uint64_t tail = mTail.load(std::memory_order_relaxed);
+  uint64_t head = mHead.load(std::memory_order_acquire);
+
+  if (tail == head)
+    return false;
+
+  for (uint64_t row = tail; row != head; ++row)
+    mWrite(&mData[(row % mRows) * mColumns], mColumns);
+
+  // Release all rows of the batch at once, so the producer only sees
+  // the tail change once per drain cycle
+  mTail.store(head, std::memory_order_release);
+  mWritten.fetch_add(static_cast<UInt>(head - tail), std::memory_order_relaxed);
+
+  if (mFlush)
+    mFlush();
+
+  return true;
+}
+
+void AsyncLogBuffer::run() {
+  while (mRunning.load()) {
+    if (!drain())
+      std::this_thread::sleep_for(mDrainInterval);
+  }
+
+  // Write the rows committed before stop() was called
+  drain();
+}
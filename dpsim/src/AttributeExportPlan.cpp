@@ -0,0 +1,224 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <dpsim/AttributeExportPlan.h>
+
+using namespace DPsim;
+
+namespace {
+
+/// Storage of an attribute whose value can be read without running update
+/// tasks, nullptr otherwise
+template <typename T>
+std::shared_ptr<T> stableStorage(const CPS::AttributeBase::Ptr &attr) {
+  auto typed = std::dynamic_pointer_cast<CPS::Attribute<T>>(attr.getPtr());
+  if (!typed)
+    return nullptr;
+  if (!typed->isStatic()) {
+    auto dynamic =
+        std::dynamic_pointer_cast<CPS::AttributeDynamic<T>>(attr.getPtr());
+    if (!dynamic || dynamic->hasUpdateTasksOnGet())
+      return nullptr;
+  }
+  return typed->asRawPointer();
+}
+
+template <typename T>
+const CPS::AttributeView *viewOf(const CPS::AttributeBase::Ptr &attr) {
+  auto dynamic =
+      std::dynamic_pointer_cast<CPS::AttributeDynamic<T>>(attr.getPtr());
+  if (!dynamic || !dynamic->view().parent.getPtr())
+    return nullptr;
+  return &dynamic->view();
+}
+
+} // namespace
+
+Bool AttributeExportPlan::locate(const CPS::AttributeBase::Ptr &attr,
+                                 Location &location) {
+  const CPS::AttributeView *view = viewOf<Real>(attr);
+  if (!view)
+    view = viewOf<Complex>(attr);
+
+  if (view) {
+    Location parent;
+    if (!locate(view->parent, parent))
+      return false;
+
+    if (view->row >= 0 && *parent.type == typeid(Matrix)) {
+      auto matrix = static_cast<const Matrix *>(parent.object);
+      if (view->row >= matrix->rows() || view->column >= matrix->cols())
+        return false;
+      location = {parent.storage, parent.object,
+                  static_cast<size_t>(view->row + view->column * matrix->rows()),
+                  &typeid(Real)};
+      return true;
+    }
+    if (view->row >= 0 && *parent.type == typeid(MatrixComp)) {
+      auto matrix = static_cast<const MatrixComp *>(parent.object);
+      if (view->row >= matrix->rows() || view->column >= matrix->cols())
+        return false;
+      location = {
+          parent.storage, parent.object,
+          2 * static_cast<size_t>(view->row + view->column * matrix->rows()),
+          &typeid(Complex)};
+      return true;
+    }
+    if (view->part >= 0 && *parent.type == typeid(Complex)) {
+      location = {parent.storage, parent.object,
+                  parent.offset + static_cast<size_t>(view->part),
+                  &typeid(Real)};
+      return true;
+    }
+    return false;
+  }
+
+  if (auto data = stableStorage<Real>(attr)) {
+    location = {Storage::Real, data.get(), 0, &typeid(Real)};
+    mStorage.push_back(data);
+  } else if (auto data = stableStorage<Int>(attr)) {
+    location = {Storage::Int, data.get(), 0, &typeid(Int)};
+    mStorage.push_back(data);
+  } else if (auto data = stableStorage<Complex>(attr)) {
+    location = {Storage::Real, reinterpret_cast<const Real *>(data.get()), 0,
+                &typeid(Complex)};
+    mStorage.push_back(data);
+  } else if (auto data = stableStorage<Matrix>(attr)) {
+    location = {Storage::Matrix, data.get(), 0, &typeid(Matrix)};
+    mStorage.push_back(data);
+  } else if (auto data = stableStorage<MatrixComp>(attr)) {
+    location = {Storage::MatrixComp, data.get(), 0, &typeid(MatrixComp)};
+    mStorage.push_back(data);
+  } else {
+    return false;
+  }
+  return true;
+}
+
+void AttributeExportPlan::append(Storage storage, const void *object,
+                                 size_t offset) {
+  if (!mRuns.empty()) {
+    Run &last = mRuns.back();
+    if (last.storage == storage && last.object == object &&
+        storage != Storage::Int) {
+      if (last.count == 1 && offset > last.offset) {
+        last.stride = offset - last.offset;
+        last.count = 2;
+        return;
+      }
+      if (last.count > 1 && offset == last.offset + last.stride * last.count) {
+        ++last.count;
+        return;
+      }
+    }
+  }
+  mRuns.push_back({storage, object, offset, 1, 1});
+}
+
+UInt AttributeExportPlan::add(CPS::AttributeBase::Ptr attr) {
+  Location location;
+  if (locate(attr, location)) {
+    if (*location.type == typeid(Real)) {
+      append(location.storage, location.object, location.offset);
+      mIntegerValues.push_back(false);
+      return 1;
+    }
+    if (*location.type == typeid(Int)) {
+      append(location.storage, location.object, location.offset);
+      mIntegerValues.push_back(true);
+      return 1;
+    }
+    if (*location.type == typeid(Complex)) {
+      append(location.storage, location.object, location.offset);
+      append(location.storage, location.object, location.offset + 1);
+      mIntegerValues.push_back(false);
+      mIntegerValues.push_back(false);
+      return 2;
+    }
+    return 0;
+  }
+
+  // Read values that are computed by update tasks through the attribute
+  if (auto attrReal =
+          std::dynamic_pointer_cast<CPS::Attribute<Real>>(attr.getPtr())) {
+    mRuns.push_back(
+        {Storage::AttributeReal, nullptr, mRealAttributes.size(), 1, 1});
+    mRealAttributes.push_back(attrReal);
+    mIntegerValues.push_back(false);
+    ++mUnresolved;
+    return 1;
+  }
+  if (auto attrInt =
+          std::dynamic_pointer_cast<CPS::Attribute<Int>>(attr.getPtr())) {
+    mRuns.push_back(
+        {Storage::AttributeInt, nullptr, mIntAttributes.size(), 1, 1});
+    mIntAttributes.push_back(attrInt);
+    mIntegerValues.push_back(true);
+    ++mUnresolved;
+    return 1;
+  }
+  if (auto attrComp =
+          std::dynamic_pointer_cast<CPS::Attribute<Complex>>(attr.getPtr())) {
+    mRuns.push_back(
+        {Storage::AttributeComplex, nullptr, mComplexAttributes.size(), 1, 2});
+    mComplexAttributes.push_back(attrComp);
+    mIntegerValues.push_back(false);
+    mIntegerValues.push_back(false);
+    mUnresolved += 2;
+    return 2;
+  }
+  return 0;
+}
+
+void AttributeExportPlan::clear() {
+  mRuns.clear();
+  mIntegerValues.clear();
+  mUnresolved = 0;
+  mStorage.clear();
+  mRealAttributes.clear();
+  mIntAttributes.clear();
+  mComplexAttributes.clear();
+}
+
+void AttributeExportPlan::gather(Real *values) const {
+  for (const Run &run : mRuns) {
+    const Real *data;
+    switch (run.storage) {
+    case Storage::Real:
+      data = static_cast<const Real *>(run.object);
+      break;
+    case Storage::Matrix:
+      data = static_cast<const Matrix *>(run.object)->data();
+      break;
+    case Storage::MatrixComp:
+      data = reinterpret_cast<const Real *>(
+          static_cast<const MatrixComp *>(run.object)->data());
+      break;
+    case Storage::Int:
+      *values++ = static_cast<Real>(*static_cast<const Int *>(run.object));
+      continue;
+    case Storage::AttributeReal:
+      *values++ = mRealAttributes[run.offset]->get();
+      continue;
+    case Storage::AttributeInt:
+      *values++ = static_cast<Real>(mIntAttributes[run.offset]->get());
+      continue;
+    case Storage::AttributeComplex: {
+      const Complex &value = mComplexAttributes[run.offset]->get();
+      *values++ = value.real();
+      *values++ = value.imag();
+      continue;
+    }
+    }
+
+    data += run.offset;
+    for (UInt k = 0; k < run.count; ++k)
+      values[k] = data[k * run.stride];
+    values += run.count;
+  }
+}
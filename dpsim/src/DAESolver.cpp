@@ -6,6 +6,9 @@
  * file, You can obtain one at https://mozilla.org/MPL/2.0/.
  *********************************************************************************/
 
+#include <algorithm>
+#include <limits>
+
 #include <dpsim-models/SimPowerComp.h>
 #include <dpsim-models/Solver/MNAInterface.h>
 #include <dpsim/DAESolver.h>
@@ -29,12 +32,15 @@ DAESolver::DAESolver(String name, const CPS::SystemTopology &system, Real dt,
   // Set initial values of all required variables and create IDA solver environment
   for (IdentifiedObject::Ptr comp : mSystem.mComponents) {
     auto daeComp = std::dynamic_pointer_cast<DAEInterface>(comp);
-    std::cout << "Added Comp" << std::endl;
-    if (!daeComp)
-      throw CPS::
-          Exception(); // Component does not support the DAE solver interface
+    if (!daeComp) {
+      SPDLOG_LOGGER_ERROR(mSLog,
+                          "Component {} does not support the DAE solver",
+                          comp->name());
+      throw CPS::Exception();
+    }
 
     mComponents.push_back(comp);
+    mDAEComponents.push_back(daeComp.get());
   }
 
   for (auto baseNode : mSystem.mNodes) {
@@ -42,15 +48,13 @@ DAESolver::DAESolver(String name, const CPS::SystemTopology &system, Real dt,
     if (!baseNode->isGround()) {
       auto node = std::dynamic_pointer_cast<CPS::SimNode<Complex>>(baseNode);
       mNodes.push_back(node);
-      std::cout << "Added Node" << std::endl;
     }
   }
 
   mNEQ = mComponents.size() + (2 * mNodes.size());
-  std::cout << std::endl;
-  std::cout << "Number of Eqn. " << mNEQ << std::endl;
+  SPDLOG_LOGGER_INFO(mSLog, "Added {} components and {} nodes, {} equations",
+                     mComponents.size(), mNodes.size(), mNEQ);
 
-  std::cout << "Processing Nodes" << std::endl;
   UInt matrixNodeIndexIdx = 0;
 
   for (UInt idx = 0; idx < mNodes.size(); ++idx) {
@@ -65,7 +69,6 @@ DAESolver::DAESolver(String name, const CPS::SystemTopology &system, Real dt,
     }
   }
 
-  std::cout << "Nodes Setup Done" << std::endl;
   mT0 = t0;
   initialize();
 }
@@ -74,17 +77,13 @@ void DAESolver::initialize() {
   int ret;
   int counter = 0;
   realtype *sval = NULL, *s_dtval = NULL;
-  std::cout << "Init states" << std::endl;
 
   // Allocate state vectors
   state = N_VNew_Serial(mNEQ);
   dstate_dt = N_VNew_Serial(mNEQ);
 
-  std::cout << "State Init done" << std::endl;
-  std::cout << "Pointer Init" << std::endl;
   sval = N_VGetArrayPointer_Serial(state);
   s_dtval = N_VGetArrayPointer_Serial(dstate_dt);
-  std::cout << "Pointer Init done" << std::endl << std::endl;
 
   for (auto node : mNodes) {
     // Initialize nodal voltages of state vector
@@ -92,7 +91,7 @@ void DAESolver::initialize() {
     PhaseType phase = node->phaseType();
     tempVolt = std::real(node->initialSingleVoltage(phase));
 
-    std::cout << "Node Volt " << counter << ": " << tempVolt << std::endl;
+    SPDLOG_LOGGER_DEBUG(mSLog, "Node voltage {}: {}", counter, tempVolt);
     sval[counter++] = tempVolt;
   }
 
@@ -109,65 +108,73 @@ void DAESolver::initialize() {
 
     // Initialize component values of state vector
     sval[counter++] = std::real(daeComp->daeInitialize());
-    std::cout << "Comp Volt " << counter - 1 << ": " << sval[counter - 1]
-              << std::endl;
+    SPDLOG_LOGGER_DEBUG(mSLog, "Component voltage {}: {}", counter - 1,
+                        sval[counter - 1]);
     //		sval[counter++] = component inductance;
-
-    // Register residual functions of components
-
-    mResidualFunctions.push_back(
-        [daeComp](double ttime, const double state[], const double dstate_dt[],
-                  double resid[], std::vector<int> &off) {
-          daeComp->daeResidual(ttime, state, dstate_dt, resid, off);
-        });
   }
 
   for (int j = 0; j < (int)mNodes.size(); j++) {
     // Initialize nodal current equations
     sval[counter++] = 0; //TODO: check for correctness
-    std::cout << "Nodal Equation value " << sval[counter - 1] << std::endl;
   }
 
-  std::cout << std::endl;
-
   // Set initial values for state derivative for now all equal to 0
   for (int i = 0; i < (mNEQ); i++) {
     s_dtval[i] = 0; // TODO: add derivative calculation
-    std::cout << "derivative " << i << ": " << s_dtval[i] << std::endl;
   }
 
-  std::cout << std::endl;
-
-  std::cout << "Init Tolerances" << std::endl;
   rtol = RCONST(1.0e-10);  // Set relative tolerance
   abstol = RCONST(1.0e-4); // Set absolute error
-  std::cout << "Init Tolerances done" << std::endl;
 
   mem = IDACreate();
-  if (mem != NULL)
-    std::cout << "Memory Ok" << std::endl;
-  std::cout << "Define Userdata" << std::endl;
+  if (mem == NULL) {
+    SPDLOG_LOGGER_ERROR(mSLog, "Could not allocate IDA memory");
+    throw CPS::Exception();
+  }
   // This passes the solver instance as the user_data argument to the residual functions
   ret = IDASetUserData(mem, this);
+  if (ret == IDA_SUCCESS)
+    ret = IDAInit(mem, &DAESolver::residualFunctionWrapper, mT0, state,
+                  dstate_dt);
+  if (ret == IDA_SUCCESS)
+    ret = IDASStolerances(mem, rtol, abstol);
+  if (ret != IDA_SUCCESS) {
+    SPDLOG_LOGGER_ERROR(mSLog, "IDA initialization failed: {}", ret);
+    throw CPS::Exception();
+  }
 
-  std::cout << "Call IDAInit" << std::endl;
-
-  ret =
-      IDAInit(mem, &DAESolver::residualFunctionWrapper, mT0, state, dstate_dt);
-
-  std::cout << "Call IDATolerances" << std::endl;
-  ret = IDASStolerances(mem, rtol, abstol);
+  createJacobianPattern();
 
-  std::cout << "Call IDA Solver Stuff" << std::endl;
-  // Allocate and connect Matrix A and solver LS to IDA
+  // Allocate and connect Matrix A and solver LS to IDA. The KLU solver
+  // reuses the symbolic factorization of the first Jacobian for all
+  // following ones, because the pattern does not change.
+#ifdef WITH_SUNDIALS_KLU
+  A = SUNSparseMatrix(mNEQ, mNEQ, mJacobianRows.size(), CSC_MAT);
+  LS = SUNKLU(state, A);
+#else
   A = SUNDenseMatrix(mNEQ, mNEQ);
   LS = SUNDenseLinearSolver(state, A);
+#endif
   ret = IDADlsSetLinearSolver(mem, LS, A);
+  if (ret == IDADLS_SUCCESS)
+    ret = IDADlsSetJacFn(mem, &DAESolver::jacobianFunctionWrapper);
+  if (ret != IDADLS_SUCCESS) {
+    SPDLOG_LOGGER_ERROR(mSLog, "Could not attach linear solver: {}", ret);
+    throw CPS::Exception();
+  }
+
+  if (mAnalyticJacobian)
+    SPDLOG_LOGGER_INFO(mSLog, "Jacobian with {} entries from components",
+                       mJacobianRows.size());
+  else
+    SPDLOG_LOGGER_INFO(mSLog,
+                       "Jacobian with {} entries approximated by {} residual "
+                       "evaluations",
+                       mJacobianRows.size(), mColumnGroups.size());
 
   //TODO: Optional IDA input functions
   //ret = IDASetMaxNumSteps(mem, -1);  //Max. number of timesteps until tout (-1 = unlimited)
   //ret = IDASetMaxConvFails(mem, 100); //Max. number of convergence failures at one step
-  (void)ret;
 }
 
 int DAESolver::residualFunctionWrapper(realtype ttime, N_Vector state,
@@ -180,48 +187,247 @@ int DAESolver::residualFunctionWrapper(realtype ttime, N_Vector state,
 
 int DAESolver::residualFunction(realtype ttime, N_Vector state,
                                 N_Vector dstate_dt, N_Vector resid) {
+  evaluateResidual(ttime, NV_DATA_S(state), NV_DATA_S(dstate_dt),
+                   NV_DATA_S(resid));
+
+  // If successful; positive value if recoverable error, negative if fatal error
+  // TODO: Error handling
+  return 0;
+}
+
+void DAESolver::evaluateResidual(realtype ttime, const double state[],
+                                 const double dstate_dt[], double resid[]) {
   mOffsets[0] = 0; // Reset Offset
   mOffsets[1] = 0; // Reset Offset
-  double *residual = NV_DATA_S(resid);
-  double *tempstate = NV_DATA_S(state);
+  // Components add their currents to the nodal equations
+  std::fill(resid, resid + mNEQ, 0.0);
+
   // Solve for all node Voltages
   for (auto node : mNodes) {
+    resid[mOffsets[0]] = std::real(node->singleVoltage()) - state[mOffsets[0]];
+    mOffsets[0] += 1;
+  }
+
+  // Call the residual functions of all components
+  for (auto comp : mDAEComponents)
+    comp->daeResidual(ttime, state, dstate_dt, resid, mOffsets);
+}
+
+int DAESolver::jacobianFunctionWrapper(realtype ttime, realtype cj,
+                                       N_Vector state, N_Vector dstate_dt,
+                                       N_Vector resid, SUNMatrix jacobian,
+                                       void *user_data, N_Vector tmp1,
+                                       N_Vector tmp2, N_Vector tmp3) {
+  DAESolver *self = reinterpret_cast<DAESolver *>(user_data);
+
+  return self->jacobianFunction(ttime, cj, state, dstate_dt, resid, jacobian,
+                                tmp1, tmp2, tmp3);
+}
 
-    Real tempVolt = 0;
+int DAESolver::jacobianFunction(realtype ttime, realtype cj, N_Vector state,
+                                N_Vector dstate_dt, N_Vector resid,
+                                SUNMatrix jacobian, N_Vector tmp1,
+                                N_Vector tmp2, N_Vector tmp3) {
+  if (mAnalyticJacobian) {
+    collectJacobianEntries(ttime, NV_DATA_S(state), NV_DATA_S(dstate_dt), cj);
+    std::fill(mJacobianValues.begin(), mJacobianValues.end(), 0.0);
+    for (auto &entry : mJacobianEntries) {
+      if (entry.row() < 0 || entry.row() >= mNEQ || entry.col() < 0 ||
+          entry.col() >= mNEQ)
+        continue;
+      sunindextype pos = patternPosition(entry.row(), entry.col());
+      if (pos < 0) {
+        SPDLOG_LOGGER_ERROR(mSLog, "Jacobian entry ({}, {}) not in pattern",
+                            entry.row(), entry.col());
+        return -1;
+      }
+      mJacobianValues[pos] += entry.value();
+    }
+  } else {
+    approximateJacobian(ttime, cj, state, dstate_dt, resid, tmp1, tmp2, tmp3);
+  }
+
+#ifdef WITH_SUNDIALS_KLU
+  // IDA zeros the matrix including its pattern before each evaluation
+  std::copy(mJacobianColumns.begin(), mJacobianColumns.end(),
+            SM_INDEXPTRS_S(jacobian));
+  std::copy(mJacobianRows.begin(), mJacobianRows.end(),
+            SM_INDEXVALS_S(jacobian));
+  std::copy(mJacobianValues.begin(), mJacobianValues.end(),
+            SM_DATA_S(jacobian));
+#else
+  for (Int col = 0; col < mNEQ; ++col) {
+    for (auto pos = mJacobianColumns[col]; pos < mJacobianColumns[col + 1];
+         ++pos)
+      SM_ELEMENT_D(jacobian, mJacobianRows[pos], col) = mJacobianValues[pos];
+  }
+#endif
+  return 0;
+}
 
-    tempVolt += std::real(node->singleVoltage());
+Bool DAESolver::collectJacobianEntries(realtype ttime, const double state[],
+                                       const double dstate_dt[],
+                                       realtype cj) {
+  mOffsets[0] = 0;
+  mOffsets[1] = 0;
+  mJacobianEntries.clear();
 
-    residual[mOffsets[0]] = tempVolt - tempstate[mOffsets[0]];
+  // The node voltage equations only depend on their own variable
+  for (UInt idx = 0; idx < mNodes.size(); ++idx) {
+    mJacobianEntries.emplace_back(mOffsets[0], mOffsets[0], -1.0);
     mOffsets[0] += 1;
   }
 
-  // Call all registered component residual functions
-  for (auto resFn : mResidualFunctions) {
-    resFn(ttime, NV_DATA_S(state), NV_DATA_S(dstate_dt), NV_DATA_S(resid),
-          mOffsets);
+  for (auto comp : mDAEComponents) {
+    if (!comp->daeJacobian(ttime, state, dstate_dt, cj, mJacobianEntries,
+                           mOffsets))
+      return false;
   }
+  return true;
+}
 
-  // If successful; positive value if recoverable error, negative if fatal error
-  // TODO: Error handling
-  return 0;
+void DAESolver::approximateJacobian(realtype ttime, realtype cj,
+                                    N_Vector state, N_Vector dstate_dt,
+                                    N_Vector resid, N_Vector tmp1,
+                                    N_Vector tmp2, N_Vector tmp3) {
+  const realtype *y = NV_DATA_S(state);
+  const realtype *yp = NV_DATA_S(dstate_dt);
+  const realtype *r0 = NV_DATA_S(resid);
+  realtype *yPerturbed = NV_DATA_S(tmp1);
+  realtype *ypPerturbed = NV_DATA_S(tmp2);
+  realtype *r = NV_DATA_S(tmp3);
+
+  // Square root of the unit roundoff, as in the difference quotients of IDA
+  const Real srur = std::sqrt(std::numeric_limits<Real>::epsilon());
+
+  std::copy(y, y + mNEQ, yPerturbed);
+  std::copy(yp, yp + mNEQ, ypPerturbed);
+
+  // The columns of a group do not share rows, so they are perturbed together
+  for (auto &group : mColumnGroups) {
+    for (Int col : group) {
+      Real inc = srur * std::max(std::abs(y[col]), 1.0);
+      yPerturbed[col] += inc;
+      ypPerturbed[col] += cj * inc;
+    }
+
+    evaluateResidual(ttime, yPerturbed, ypPerturbed, r);
+
+    for (Int col : group) {
+      Real inc = yPerturbed[col] - y[col];
+      for (auto pos = mJacobianColumns[col]; pos < mJacobianColumns[col + 1];
+           ++pos) {
+        auto row = mJacobianRows[pos];
+        mJacobianValues[pos] = (r[row] - r0[row]) / inc;
+      }
+      yPerturbed[col] = y[col];
+      ypPerturbed[col] = yp[col];
+    }
+  }
+}
+
+void DAESolver::createJacobianPattern() {
+  const realtype *sval = NV_DATA_S(state);
+  const realtype *s_dtval = NV_DATA_S(dstate_dt);
+
+  // Diagonal entries are always stored to keep the pattern structurally
+  // nonsingular
+  std::vector<std::vector<sunindextype>> columns(mNEQ);
+  for (Int idx = 0; idx < mNEQ; ++idx)
+    columns[idx].push_back(idx);
+
+  mAnalyticJacobian = collectJacobianEntries(mT0, sval, s_dtval, 1.0);
+  if (mAnalyticJacobian) {
+    for (auto &entry : mJacobianEntries) {
+      if (entry.row() >= 0 && entry.row() < mNEQ && entry.col() >= 0 &&
+          entry.col() < mNEQ)
+        columns[entry.col()].push_back(entry.row());
+    }
+  } else {
+    // Each variable and its derivative are perturbed once, the rows whose
+    // residual changes depend on them
+    std::vector<Real> y(sval, sval + mNEQ);
+    std::vector<Real> yp(s_dtval, s_dtval + mNEQ);
+    std::vector<Real> r0(mNEQ), r(mNEQ);
+    evaluateResidual(mT0, y.data(), yp.data(), r0.data());
+    for (Int col = 0; col < mNEQ; ++col) {
+      for (Real *value : {&y[col], &yp[col]}) {
+        Real original = *value;
+        *value += 1e-3 * std::max(std::abs(original), 1.0);
+        evaluateResidual(mT0, y.data(), yp.data(), r.data());
+        *value = original;
+        for (Int row = 0; row < mNEQ; ++row) {
+          if (r[row] != r0[row])
+            columns[col].push_back(row);
+        }
+      }
+    }
+  }
+
+  // Compressed sparse column format with sorted rows
+  mJacobianColumns.assign(1, 0);
+  mJacobianRows.clear();
+  for (auto &rows : columns) {
+    std::sort(rows.begin(), rows.end());
+    rows.erase(std::unique(rows.begin(), rows.end()), rows.end());
+    mJacobianRows.insert(mJacobianRows.end(), rows.begin(), rows.end());
+    mJacobianColumns.push_back(mJacobianRows.size());
+  }
+  mJacobianValues.assign(mJacobianRows.size(), 0);
+
+  // Greedy grouping of the columns for the finite differences
+  mColumnGroups.clear();
+  if (mAnalyticJacobian)
+    return;
+  std::vector<std::vector<bool>> usedRows;
+  for (Int col = 0; col < mNEQ; ++col) {
+    UInt group = 0;
+    for (; group < mColumnGroups.size(); ++group) {
+      Bool conflict = false;
+      for (auto pos = mJacobianColumns[col]; pos < mJacobianColumns[col + 1];
+           ++pos)
+        conflict = conflict || usedRows[group][mJacobianRows[pos]];
+      if (!conflict)
+        break;
+    }
+    if (group == mColumnGroups.size()) {
+      mColumnGroups.emplace_back();
+      usedRows.emplace_back(mNEQ, false);
+    }
+    mColumnGroups[group].push_back(col);
+    for (auto pos = mJacobianColumns[col]; pos < mJacobianColumns[col + 1];
+         ++pos)
+      usedRows[group][mJacobianRows[pos]] = true;
+  }
+}
+
+sunindextype DAESolver::patternPosition(sunindextype row,
+                                        sunindextype column) const {
+  auto begin = mJacobianRows.begin() + mJacobianColumns[column];
+  auto end = mJacobianRows.begin() + mJacobianColumns[column + 1];
+  auto it = std::lower_bound(begin, end, row);
+  if (it == end || *it != row)
+    return -1;
+  return it - mJacobianRows.begin();
 }
 
 Real DAESolver::step(Real time) {
 
   Real NextTime = time + mTimestep;
-  std::cout << "Current Time " << NextTime << std::endl;
+  SPDLOG_LOGGER_DEBUG(mSLog, "Current Time {}", NextTime);
   int ret = IDASolve(mem, NextTime, &tret, state, dstate_dt,
                      IDA_NORMAL); // TODO: find alternative to IDA_NORMAL
 
   if (ret == IDA_SUCCESS) {
     return NextTime;
   } else {
-    std::cout << "Ida Error " << ret << std::endl;
     //throw CPS::Exception();
     void(IDAGetNumSteps(mem, &interalSteps));
     void(IDAGetNumResEvals(mem, &resEval));
-    std::cout << "Interal steps: " << interalSteps << std::endl;
-    std::cout << "Res Eval :" << resEval << std::endl;
+    SPDLOG_LOGGER_ERROR(mSLog,
+                        "IDA error {} at {}, internal steps: {}, residual "
+                        "evaluations: {}",
+                        ret, NextTime, interalSteps, resEval);
     return NextTime;
   }
 }
@@ -40,10 +40,68 @@ void DataLogger::start() {
     // TODO: replace by exception
     std::cerr << "Cannot open log file " << mFilename << std::endl;
     mEnabled = false;
+    return;
   }
+
+  if (mAsyncRows > 0)
+    startAsync();
+  else
+    compileExportPlan();
 }
 
-void DataLogger::stop() { mLogFile.close(); }
+void DataLogger::stop() {
+  if (mAsyncBuffer) {
+    mAsyncBuffer->stop();
+    if (mAsyncPolicy == AsyncLogBuffer::OverflowPolicy::Count &&
+        mAsyncBuffer->overruns() > 0) {
+      auto log = CPS::Logger::get(mName, CPS::Logger::Level::off,
+                                  CPS::Logger::Level::warn);
+      log->warn("Dropped {} of {} rows because the log buffer was full",
+                mAsyncBuffer->overruns(),
+                mAsyncBuffer->overruns() + mAsyncBuffer->written());
+    }
+  }
+  mLogFile.close();
+}
+
+void DataLogger::setAsyncBuffer(UInt rows,
+                                AsyncLogBuffer::OverflowPolicy policy) {
+  mAsyncRows = rows;
+  mAsyncPolicy = policy;
+}
+
+void DataLogger::compileExportPlan() {
+  DataLoggerInterface::compileExportPlan(mExportPlan);
+  mRow.resize(mExportPlan.size() + 1);
+}
+
+void DataLogger::startAsync() {
+  // The columns are fixed from now on, so the header can be written
+  // before the first row
+  mLogFile << std::right << std::setw(14) << "time";
+  for (auto it : mAttributes)
+    mLogFile << ", " << std::right << std::setw(13) << it.first;
+  mLogFile << '\n';
+
+  compileExportPlan();
+  mAsyncBuffer = std::make_unique<AsyncLogBuffer>(
+      mAsyncRows, static_cast<UInt>(mRow.size()), mAsyncPolicy,
+      [this](const Real *row, UInt columns) { writeRow(row, columns); },
+      [this]() { mLogFile.flush(); });
+  mAsyncBuffer->start();
+}
+
+void DataLogger::writeRow(const Real *row, UInt columns) {
+  // Keep the formatting of Attribute::toString()
+  mLogFile << std::scientific << std::right << std::setw(14) << row[0];
+  for (UInt i = 1; i < columns; ++i) {
+    mLogFile << ", " << std::right << std::setw(13)
+             << (mExportPlan.isInteger(i - 1)
+                     ? std::to_string(static_cast<Int>(row[i]))
+                     : std::to_string(row[i]));
+  }
+  mLogFile << '\n';
+}
 
 void DataLogger::setColumnNames(std::vector<String> names) {
   if (mLogFile.tellp() == std::ofstream::pos_type(0)) {
@@ -129,6 +187,16 @@ void DataLogger::log(Real time, Int timeStepCount) {
   if (!mEnabled || !(timeStepCount % mDownsampling == 0))
     return;
 
+  if (mAsyncBuffer) {
+    Real *row = mAsyncBuffer->acquireRow();
+    if (!row)
+      return;
+    row[0] = time;
+    mExportPlan.gather(row + 1);
+    mAsyncBuffer->commitRow();
+    return;
+  }
+
   if (mLogFile.tellp() == std::ofstream::pos_type(0)) {
     mLogFile << std::right << std::setw(14) << "time";
     for (auto it : mAttributes)
@@ -136,10 +204,13 @@ void DataLogger::log(Real time, Int timeStepCount) {
     mLogFile << '\n';
   }
 
-  mLogFile << std::scientific << std::right << std::setw(14) << time;
-  for (auto it : mAttributes)
-    mLogFile << ", " << std::right << std::setw(13) << it.second->toString();
-  mLogFile << '\n';
+  // Attributes may be added until the first row is logged
+  if (mRow.size() != mAttributes.size() + 1)
+    compileExportPlan();
+
+  mRow[0] = time;
+  mExportPlan.gather(mRow.data() + 1);
+  writeRow(mRow.data(), static_cast<UInt>(mRow.size()));
 }
 
 void DataLogger::Step::execute(Real time, Int timeStepCount) {
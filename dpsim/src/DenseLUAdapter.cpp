@@ -39,4 +39,13 @@ void DenseLUAdapter::partialRefactorize(
 Matrix DenseLUAdapter::solve(Matrix &mRightHandSideVector) {
   return LUFactorized.solve(mRightHandSideVector);
 }
+
+void DenseLUAdapter::solve(const Matrix &rightSideVector,
+                           Matrix &leftSideVector) {
+  leftSideVector.noalias() = LUFactorized.solve(rightSideVector);
+}
+
+std::size_t DenseLUAdapter::memoryUsage() {
+  return LUFactorized.matrixLU().size() * sizeof(Real);
+}
 } // namespace DPsim
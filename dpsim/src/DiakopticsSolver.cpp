@@ -13,6 +13,11 @@
 #include <dpsim-models/MathUtils.h>
 #include <dpsim-models/Solver/MNATearInterface.h>
 #include <dpsim/Definitions.h>
+#include <dpsim/DenseLUAdapter.h>
+#include <dpsim/SparseLUAdapter.h>
+#ifdef WITH_KLU
+#include <dpsim/KLUAdapter.h>
+#endif
 
 using namespace CPS;
 using namespace DPsim;
@@ -22,8 +27,9 @@ namespace DPsim {
 template <typename VarType>
 DiakopticsSolver<VarType>::DiakopticsSolver(
     String name, SystemTopology system, IdentifiedObject::List tearComponents,
-    Real timeStep, Logger::Level logLevel)
-    : Solver(name, logLevel),
+    Real timeStep, Logger::Level logLevel,
+    DirectLinearSolverImpl implementation)
+    : Solver(name, logLevel), mImplementation(implementation),
       mMappedTearCurrents(AttributeStatic<Matrix>::make()),
       mOrigLeftSideVector(AttributeStatic<Matrix>::make()) {
   mTimeStep = timeStep;
@@ -214,8 +220,6 @@ template <> void DiakopticsSolver<Complex>::setLogColumns() {
 
 template <typename VarType> void DiakopticsSolver<VarType>::createMatrices() {
   UInt totalSize = mSubnets.back().sysOff + mSubnets.back().sysSize;
-  mSystemMatrix = Matrix::Zero(totalSize, totalSize);
-  mSystemInverse = Matrix::Zero(totalSize, totalSize);
 
   mRightSideVector = Matrix::Zero(totalSize, 1);
   mLeftSideVector = Matrix::Zero(totalSize, 1);
@@ -228,13 +232,15 @@ template <typename VarType> void DiakopticsSolver<VarType>::createMatrices() {
     // copy the solution there
     net.leftVector = AttributeStatic<Matrix>::make();
     net.leftVector->set(Matrix::Zero(net.sysSize, 1));
+    net.rightVector = Matrix::Zero(net.sysSize, 1);
+    net.solution = Matrix::Zero(net.sysSize, 1);
   }
 
   createTearMatrices(totalSize);
 }
 
 template <> void DiakopticsSolver<Real>::createTearMatrices(UInt totalSize) {
-  mTearTopology = Matrix::Zero(totalSize, mTearComponents.size());
+  mTearTopology = SparseMatrix(totalSize, mTearComponents.size());
   mTearImpedance =
       CPS::SparseMatrixRow(mTearComponents.size(), mTearComponents.size());
   mTearCurrents = Matrix::Zero(mTearComponents.size(), 1);
@@ -242,7 +248,7 @@ template <> void DiakopticsSolver<Real>::createTearMatrices(UInt totalSize) {
 }
 
 template <> void DiakopticsSolver<Complex>::createTearMatrices(UInt totalSize) {
-  mTearTopology = Matrix::Zero(totalSize, 2 * mTearComponents.size());
+  mTearTopology = SparseMatrix(totalSize, 2 * mTearComponents.size());
   mTearImpedance = CPS::SparseMatrixRow(2 * mTearComponents.size(),
                                         2 * mTearComponents.size());
   mTearCurrents = Matrix::Zero(2 * mTearComponents.size(), 1);
@@ -273,41 +279,63 @@ template <typename VarType> void DiakopticsSolver<VarType>::initComponents() {
     comp->initialize(mSystem.mSystemOmega, mTimeStep);
 }
 
+template <typename VarType>
+std::shared_ptr<DirectLinearSolver>
+DiakopticsSolver<VarType>::createLinearSolver() {
+  switch (mImplementation) {
+  case DirectLinearSolverImpl::DenseLU:
+    return std::make_shared<DenseLUAdapter>(mSLog);
+  case DirectLinearSolverImpl::SparseLU:
+    return std::make_shared<SparseLUAdapter>(mSLog);
+#ifdef WITH_KLU
+  case DirectLinearSolverImpl::Undef:
+  case DirectLinearSolverImpl::KLU:
+    return std::make_shared<KLUAdapter>(mSLog);
+#else
+  case DirectLinearSolverImpl::Undef:
+    return std::make_shared<SparseLUAdapter>(mSLog);
+#endif
+  default:
+    throw CPS::SystemError(
+        "unsupported linear solver implementation for diakoptics.");
+  }
+}
+
 template <typename VarType> void DiakopticsSolver<VarType>::initMatrices() {
+  std::vector<std::pair<UInt, UInt>> noVariableEntries;
   for (auto &net : mSubnets) {
-    // We can't directly pass the block reference to mnaApplySystemMatrixStamp,
-    // because it expects a concrete Matrix. It can't be changed to accept some common
-    // base class like DenseBase because that would make it a template function (as
-    // Eigen uses CRTP for polymorphism), which is impossible for virtual functions.
-    CPS::SparseMatrixRow partSys =
-        CPS::SparseMatrixRow(net.sysSize, net.sysSize);
+    net.systemMatrix = SparseMatrix(net.sysSize, net.sysSize);
     for (auto comp : net.components) {
-      comp->mnaApplySystemMatrixStamp(partSys);
+      comp->mnaApplySystemMatrixStamp(net.systemMatrix);
     }
-    auto block =
-        mSystemMatrix.block(net.sysOff, net.sysOff, net.sysSize, net.sysSize);
-    block = partSys;
-    SPDLOG_LOGGER_INFO(mSLog, "Block: \n{}", block);
-    net.luFactorization = Eigen::PartialPivLU<Matrix>(partSys);
-    SPDLOG_LOGGER_INFO(mSLog, "Factorization: \n{}",
-                       net.luFactorization.matrixLU());
+    net.systemMatrix.makeCompressed();
+    SPDLOG_LOGGER_INFO(mSLog, "Block: \n{}", net.systemMatrix);
+    net.linearSolver = createLinearSolver();
+    net.linearSolver->preprocessing(net.systemMatrix, noVariableEntries);
+    net.linearSolver->factorize(net.systemMatrix);
   }
-  SPDLOG_LOGGER_INFO(mSLog, "Complete system matrix: \n{}", mSystemMatrix);
 
   // initialize tear topology matrix and impedance matrix of removed network
   for (UInt compIdx = 0; compIdx < mTearComponents.size(); ++compIdx) {
     applyTearComponentStamp(compIdx);
   }
+  mTearTopology.makeCompressed();
   SPDLOG_LOGGER_INFO(mSLog, "Topology matrix: \n{}", mTearTopology);
   SPDLOG_LOGGER_INFO(mSLog, "Removed impedance matrix: \n{}", mTearImpedance);
-  // TODO this can be sped up as well by using the block diagonal form of Yinv
+
+  // Yinv is block diagonal, so C^T * Yinv * C is the sum of the subnets'
+  // contributions, which only touch the tear columns of the subnet
+  Matrix totalTearImpedance = mTearImpedance;
   for (auto &net : mSubnets) {
-    mSystemInverse.block(net.sysOff, net.sysOff, net.sysSize, net.sysSize) =
-        net.luFactorization.inverse();
+    initTearBlocks(net);
+    Matrix contribution = net.tearTopology.transpose() * net.tearInverse;
+    for (UInt i = 0; i < net.tearColumns.size(); ++i) {
+      for (UInt j = 0; j < net.tearColumns.size(); ++j)
+        totalTearImpedance(net.tearColumns[i], net.tearColumns[j]) +=
+            contribution(i, j);
+    }
   }
-  mTotalTearImpedance = Eigen::PartialPivLU<Matrix>(
-      mTearImpedance +
-      mTearTopology.transpose() * mSystemInverse * mTearTopology);
+  mTotalTearImpedance = Eigen::PartialPivLU<Matrix>(totalTearImpedance);
   SPDLOG_LOGGER_INFO(mSLog,
                      "Total removed impedance matrix LU decomposition: \n{}",
                      mTotalTearImpedance.matrixLU());
@@ -323,14 +351,40 @@ template <typename VarType> void DiakopticsSolver<VarType>::initMatrices() {
   }
 }
 
+template <typename VarType>
+void DiakopticsSolver<VarType>::initTearBlocks(Subnet &net) {
+  // Collect the columns of the tear topology with entries in the subnet's rows
+  std::vector<Int> position(mTearTopology.cols(), -1);
+  net.tearColumns.clear();
+  for (UInt row = net.sysOff; row < net.sysOff + net.sysSize; ++row) {
+    for (SparseMatrix::InnerIterator it(mTearTopology, row); it; ++it) {
+      if (position[it.col()] < 0) {
+        position[it.col()] = static_cast<Int>(net.tearColumns.size());
+        net.tearColumns.push_back(static_cast<UInt>(it.col()));
+      }
+    }
+  }
+
+  net.tearTopology = Matrix::Zero(net.sysSize, net.tearColumns.size());
+  for (UInt row = net.sysOff; row < net.sysOff + net.sysSize; ++row) {
+    for (SparseMatrix::InnerIterator it(mTearTopology, row); it; ++it)
+      net.tearTopology(row - net.sysOff, position[it.col()]) = it.value();
+  }
+
+  net.tearInverse = Matrix::Zero(net.sysSize, net.tearColumns.size());
+  if (!net.tearColumns.empty())
+    net.linearSolver->solve(net.tearTopology, net.tearInverse);
+  net.tearCurrents = Matrix::Zero(net.tearColumns.size(), 1);
+}
+
 template <> void DiakopticsSolver<Real>::applyTearComponentStamp(UInt compIdx) {
   auto comp = mTearComponents[compIdx];
-  mTearTopology(mNodeSubnetMap[comp->node(0)]->sysOff +
-                    comp->node(0)->matrixNodeIndex(),
-                compIdx) = 1;
-  mTearTopology(mNodeSubnetMap[comp->node(1)]->sysOff +
-                    comp->node(1)->matrixNodeIndex(),
-                compIdx) = -1;
+  mTearTopology.coeffRef(mNodeSubnetMap[comp->node(0)]->sysOff +
+                             comp->node(0)->matrixNodeIndex(),
+                         compIdx) = 1;
+  mTearTopology.coeffRef(mNodeSubnetMap[comp->node(1)]->sysOff +
+                             comp->node(1)->matrixNodeIndex(),
+                         compIdx) = -1;
 
   auto tearComp = std::dynamic_pointer_cast<MNATearInterface>(comp);
   tearComp->mnaTearApplyMatrixStamp(mTearImpedance);
@@ -343,14 +397,16 @@ void DiakopticsSolver<Complex>::applyTearComponentStamp(UInt compIdx) {
   auto net1 = mNodeSubnetMap[comp->node(0)];
   auto net2 = mNodeSubnetMap[comp->node(1)];
 
-  mTearTopology(net1->sysOff + comp->node(0)->matrixNodeIndex(), compIdx) = 1;
-  mTearTopology(net1->sysOff + net1->mCmplOff +
-                    comp->node(0)->matrixNodeIndex(),
-                mTearComponents.size() + compIdx) = 1;
-  mTearTopology(net2->sysOff + comp->node(1)->matrixNodeIndex(), compIdx) = -1;
-  mTearTopology(net2->sysOff + net2->mCmplOff +
-                    comp->node(1)->matrixNodeIndex(),
-                mTearComponents.size() + compIdx) = -1;
+  mTearTopology.coeffRef(net1->sysOff + comp->node(0)->matrixNodeIndex(),
+                         compIdx) = 1;
+  mTearTopology.coeffRef(net1->sysOff + net1->mCmplOff +
+                             comp->node(0)->matrixNodeIndex(),
+                         mTearComponents.size() + compIdx) = 1;
+  mTearTopology.coeffRef(net2->sysOff + comp->node(1)->matrixNodeIndex(),
+                         compIdx) = -1;
+  mTearTopology.coeffRef(net2->sysOff + net2->mCmplOff +
+                             comp->node(1)->matrixNodeIndex(),
+                         mTearComponents.size() + compIdx) = -1;
 
   auto tearComp = std::dynamic_pointer_cast<MNATearInterface>(comp);
   tearComp->mnaTearApplyMatrixStamp(mTearImpedance);
@@ -389,17 +445,16 @@ template <typename VarType> Task::List DiakopticsSolver<VarType>::getTasks() {
 template <typename VarType>
 void DiakopticsSolver<VarType>::SubnetSolveTask::execute(Real time,
                                                          Int timeStepCount) {
-  auto rBlock =
-      mSolver.mRightSideVector.block(mSubnet.sysOff, 0, mSubnet.sysSize, 1);
-  rBlock.setZero();
-
+  mSubnet.rightVector.setZero();
   for (auto stamp : mSubnet.rightVectorStamps)
-    rBlock += *stamp;
+    mSubnet.rightVector += *stamp;
+  mSolver.mRightSideVector.block(mSubnet.sysOff, 0, mSubnet.sysSize, 1) =
+      mSubnet.rightVector;
 
-  auto lBlock = (**mSolver.mOrigLeftSideVector)
-                    .block(mSubnet.sysOff, 0, mSubnet.sysSize, 1);
   // Solve Y' * v' = I
-  lBlock = mSubnet.luFactorization.solve(rBlock);
+  mSubnet.linearSolver->solve(mSubnet.rightVector, mSubnet.solution);
+  (**mSolver.mOrigLeftSideVector)
+      .block(mSubnet.sysOff, 0, mSubnet.sysSize, 1) = mSubnet.solution;
 }
 
 template <typename VarType>
@@ -411,13 +466,14 @@ void DiakopticsSolver<VarType>::PreSolveTask::execute(Real time,
     tComp->mnaTearApplyVoltageStamp(mSolver.mTearVoltages);
   }
   // -C^T * v'
-  mSolver.mTearVoltages -=
+  mSolver.mTearVoltages.noalias() -=
       mSolver.mTearTopology.transpose() * **mSolver.mOrigLeftSideVector;
   // Solve Z' * i = E - C^T * v'
   mSolver.mTearCurrents =
       mSolver.mTotalTearImpedance.solve(mSolver.mTearVoltages);
   // C * i
-  **mSolver.mMappedTearCurrents = mSolver.mTearTopology * mSolver.mTearCurrents;
+  (**mSolver.mMappedTearCurrents).noalias() =
+      mSolver.mTearTopology * mSolver.mTearCurrents;
   mSolver.mLeftSideVector = **mSolver.mOrigLeftSideVector;
 }
 
@@ -426,11 +482,13 @@ void DiakopticsSolver<VarType>::SolveTask::execute(Real time,
                                                    Int timeStepCount) {
   auto lBlock =
       mSolver.mLeftSideVector.block(mSubnet.sysOff, 0, mSubnet.sysSize, 1);
-  auto rBlock = (**mSolver.mMappedTearCurrents)
-                    .block(mSubnet.sysOff, 0, mSubnet.sysSize, 1);
-  // Solve Y' * x = C * i
+  // x = Y'^-1 * C * i, where only the subnet's tear columns of C are non-zero
+  for (UInt i = 0; i < mSubnet.tearColumns.size(); ++i)
+    mSubnet.tearCurrents(i, 0) =
+        mSolver.mTearCurrents(mSubnet.tearColumns[i], 0);
+  mSubnet.solution.noalias() = mSubnet.tearInverse * mSubnet.tearCurrents;
   // v = v' + x
-  lBlock += mSubnet.luFactorization.solve(rBlock);
+  lBlock += mSubnet.solution;
   **mSubnet.leftVector = lBlock;
 }
 
@@ -438,8 +496,9 @@ template <typename VarType>
 void DiakopticsSolver<VarType>::PostSolveTask::execute(Real time,
                                                        Int timeStepCount) {
   // pass the voltages and current of the solution to the torn components
-  mSolver.mTearVoltages =
-      -mSolver.mTearTopology.transpose() * mSolver.mLeftSideVector;
+  mSolver.mTearVoltages.setZero();
+  mSolver.mTearVoltages.noalias() -=
+      mSolver.mTearTopology.transpose() * mSolver.mLeftSideVector;
   for (UInt compIdx = 0; compIdx < mSolver.mTearComponents.size(); ++compIdx) {
     auto comp = mSolver.mTearComponents[compIdx];
     auto tComp = std::dynamic_pointer_cast<MNATearInterface>(comp);
@@ -0,0 +1,221 @@
+/* Copyright 2017-2024 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <thread>
+
+#include <dpsim/EnsembleSimulation.h>
+#include <dpsim/Event.h>
+
+#ifdef WITH_KLU
+#include <dpsim/KLUFactorizationCache.h>
+#endif
+
+using namespace CPS;
+using namespace DPsim;
+
+EnsembleSimulation::EnsembleSimulation(String name,
+                                       const CPS::SystemTopology &system,
+                                       CPS::Logger::Level logLevel)
+    : EnsembleSimulation(
+          name, [base = system](UInt) mutable { return base.copy(); },
+          logLevel) {}
+
+EnsembleSimulation::EnsembleSimulation(String name, TopologyFactory factory,
+                                       CPS::Logger::Level logLevel)
+    : mName(name), mLogLevel(logLevel), mFactory(factory) {
+  mLog = Logger::get(name, logLevel, std::max(Logger::Level::info, logLevel));
+}
+
+void EnsembleSimulation::logAttribute(const String &name,
+                                      const String &component,
+                                      const String &attribute) {
+  mLoggedAttributes.push_back({name, component, attribute});
+}
+
+void EnsembleSimulation::runMember(UInt index) {
+  const Member &member = mMembers[index];
+  Simulation sim(mName + "_" + member.name, mLogLevel);
+  sim.setTimeStep(mTimeStep);
+  sim.setFinalTime(mFinalTime);
+  sim.setDomain(mDomain);
+  sim.setSolverType(mSolverType);
+
+  CPS::SystemTopology system;
+  {
+    std::lock_guard<std::mutex> lock(mSetupMutex);
+    system = mFactory(index);
+  }
+
+  for (auto &change : member.changes) {
+    auto comp = system.component<IdentifiedObject>(change.component);
+    if (!comp)
+      throw SystemError("Unknown component " + change.component);
+    auto attr = comp->attributeTyped<Real>(change.attribute);
+    if (change.time < 0)
+      attr->set(change.value);
+    else
+      sim.addEvent(AttributeEvent<Real>::make(change.time, attr, change.value));
+  }
+
+  // Attributes are resolved by name in the topology of each member
+  for (auto &logged : mLoggedAttributes) {
+    auto comp = system.component<IdentifiedObject>(logged.component);
+    if (!comp)
+      throw SystemError("Unknown component " + logged.component);
+    mLoggers[index]->logAttribute(logged.name,
+                                  comp->attribute(logged.attribute));
+  }
+  sim.addLogger(mLoggers[index]);
+
+  if (mSetup) {
+    std::lock_guard<std::mutex> lock(mSetupMutex);
+    mSetup(sim, system, index);
+  }
+  sim.setSystem(system);
+  sim.run();
+}
+
+void EnsembleSimulation::run() {
+  UInt threads = mThreads > 0 ? mThreads : std::thread::hardware_concurrency();
+  threads = std::max<UInt>(1, std::min<UInt>(threads, mMembers.size()));
+
+  mLoggers.clear();
+  for (auto &member : mMembers)
+    mLoggers.push_back(MemoryDataLogger::make(mName + "_" + member.name,
+                                              mFinalTime, mTimeStep));
+  mErrors.assign(mMembers.size(), "");
+
+#ifdef WITH_KLU
+  // Members with the same network share the symbolic factorization, which
+  // requires one stored factorization per concurrently running member
+  auto &cache = KLUFactorizationCache::global();
+  UInt previousCapacity = cache.capacity();
+  if (mShareFactorizations && previousCapacity < threads)
+    cache.setCapacity(threads);
+  cache.resetStatistics();
+#endif
+
+  SPDLOG_LOGGER_INFO(mLog, "Running {} members on {} threads", mMembers.size(),
+                     threads);
+  auto start = std::chrono::steady_clock::now();
+
+  std::atomic<UInt> next{0};
+  auto worker = [this, &next]() {
+    for (UInt index = next++; index < mMembers.size(); index = next++) {
+      try {
+        runMember(index);
+      } catch (SystemError &e) {
+        mErrors[index] = e.descr();
+      } catch (std::exception &e) {
+        mErrors[index] = e.what();
+      } catch (...) {
+        mErrors[index] = "Unknown error";
+      }
+    }
+  };
+
+  std::vector<std::thread> pool;
+  for (UInt i = 1; i < threads; i++)
+    pool.emplace_back(worker);
+  worker();
+  for (auto &thread : pool)
+    thread.join();
+
+  std::chrono::duration<double> duration =
+      std::chrono::steady_clock::now() - start;
+  SPDLOG_LOGGER_INFO(mLog, "Finished {} members in {:.3f} s", mMembers.size(),
+                     duration.count());
+
+#ifdef WITH_KLU
+  SPDLOG_LOGGER_INFO(mLog,
+                     "KLU factorizations: {} reused, {} symbolic reused, "
+                     "{} computed",
+                     cache.hits(), cache.symbolicHits(), cache.misses());
+  if (cache.capacity() != previousCapacity)
+    cache.setCapacity(previousCapacity);
+#endif
+
+  for (UInt index = 0; index < mMembers.size(); index++) {
+    if (!mErrors[index].empty())
+      SPDLOG_LOGGER_ERROR(mLog, "Member {} failed: {}", mMembers[index].name,
+                          mErrors[index]);
+  }
+
+  aggregate();
+}
+
+void EnsembleSimulation::aggregate() {
+  // Attributes may span several columns, e.g. the real and imaginary part of
+  // a complex value. All members log the same columns unless they failed.
+  std::vector<String> columns;
+  UInt rows = 0;
+  for (UInt index = 0; index < mMembers.size(); index++) {
+    if (!mErrors[index].empty())
+      continue;
+    if (columns.empty()) {
+      columns = mLoggers[index]->columnNames();
+      columns.erase(columns.begin());
+    }
+    rows = std::max(rows, mLoggers[index]->rows());
+  }
+
+  mColumnNames = {"time"};
+  for (auto &member : mMembers) {
+    for (auto &column : columns)
+      mColumnNames.push_back(member.name + "." + column);
+  }
+
+  mResults = Matrix::Constant(rows, mColumnNames.size(),
+                              std::numeric_limits<Real>::quiet_NaN());
+  for (UInt row = 0; row < rows; row++)
+    mResults(row, 0) = row * mTimeStep;
+
+  for (UInt index = 0; index < mMembers.size(); index++) {
+    if (!mErrors[index].empty())
+      continue;
+
+    auto &logger = mLoggers[index];
+    auto names = logger->columnNames();
+    for (UInt column = 0; column < columns.size(); column++) {
+      auto it = std::find(names.begin() + 1, names.end(), columns[column]);
+      if (it == names.end())
+        continue;
+      UInt source = static_cast<UInt>(it - names.begin());
+      for (UInt row = 0; row < logger->rows(); row++) {
+        mResults(row, 1 + index * columns.size() + column) =
+            logger->data()[row * logger->columns() + source];
+      }
+    }
+    for (UInt row = 0; row < logger->rows(); row++)
+      mResults(row, 0) = logger->data()[row * logger->columns()];
+  }
+  mLoggers.clear();
+}
+
+void EnsembleSimulation::writeCSV(const fs::path &path) const {
+  std::ofstream file(path);
+  if (!file)
+    throw SystemError("Cannot open " + path.string());
+
+  for (std::size_t column = 0; column < mColumnNames.size(); column++)
+    file << (column > 0 ? "," : "") << mColumnNames[column];
+  file << '\n';
+
+  file << std::scientific << std::right << std::setprecision(9);
+  for (Eigen::Index row = 0; row < mResults.rows(); row++) {
+    for (Eigen::Index column = 0; column < mResults.cols(); column++)
+      file << (column > 0 ? "," : "") << mResults(row, column);
+    file << '\n';
+  }
+}
@@ -0,0 +1,202 @@
+/* Copyright 2017-2024 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <dpsim-models/Logger.h>
+#include <dpsim/HDF5DataLogger.h>
+
+using namespace DPsim;
+
+namespace {
+// HDF5 functions return a negative herr_t or hid_t on failure
+template <typename T> T check(T result, const String &what) {
+  if (result < 0)
+    throw CPS::SystemError("HDF5DataLogger: " + what + " failed");
+  return result;
+}
+
+/// Closes an HDF5 identifier when it goes out of scope
+class Identifier {
+public:
+  Identifier(hid_t id, herr_t (*close)(hid_t), const String &what)
+      : mId(check(id, what)), mClose(close) {}
+  Identifier(const Identifier &) = delete;
+  Identifier &operator=(const Identifier &) = delete;
+  ~Identifier() { mClose(mId); }
+
+  operator hid_t() const { return mId; }
+
+private:
+  hid_t mId;
+  herr_t (*mClose)(hid_t);
+};
+} // namespace
+
+HDF5DataLogger::HDF5DataLogger(String name, Bool enabled, UInt downsampling,
+                               UInt chunkSize, UInt compression)
+    : DataLoggerInterface(), mName(name), mEnabled(enabled),
+      mDownsampling(downsampling), mChunkSize(chunkSize > 0 ? chunkSize : 1),
+      mCompression(compression) {
+  if (!mEnabled)
+    return;
+
+  mFilename = CPS::Logger::logDir() + "/" + name + ".h5";
+
+  if (mFilename.has_parent_path() && !fs::exists(mFilename.parent_path()))
+    fs::create_directory(mFilename.parent_path());
+}
+
+HDF5DataLogger::~HDF5DataLogger() {
+  if (mFile == H5I_INVALID_HID)
+    return;
+  // Destructors must not throw, stop() closes the file on errors
+  try {
+    stop();
+  } catch (const CPS::SystemError &) {
+  }
+}
+
+void HDF5DataLogger::start() {
+  if (!mEnabled)
+    return;
+  if (mFile != H5I_INVALID_HID)
+    stop();
+
+  // Resolve the attributes once instead of on every step
+  compileExportPlan(mExportPlan);
+  mBuffer.assign(static_cast<size_t>(mChunkSize) * (mExportPlan.size() + 1),
+                 0);
+  mBufferedRows = 0;
+  mWrittenRows = 0;
+
+  mFile = check(H5Fcreate(mFilename.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT,
+                          H5P_DEFAULT),
+                "Creating file " + mFilename.string());
+
+  try {
+    mDatasets.push_back(createDataset("time", H5T_NATIVE_DOUBLE));
+    UInt index = 0;
+    for (auto &it : mAttributes) {
+      mDatasets.push_back(createDataset(it.first, mExportPlan.isInteger(index)
+                                                      ? H5T_NATIVE_INT
+                                                      : H5T_NATIVE_DOUBLE));
+      ++index;
+    }
+  } catch (...) {
+    close();
+    throw;
+  }
+}
+
+void HDF5DataLogger::stop() {
+  if (mFile == H5I_INVALID_HID)
+    return;
+
+  // The file is closed even if the remaining rows cannot be written
+  try {
+    flush();
+  } catch (...) {
+    close();
+    throw;
+  }
+  check(close(), "Closing file " + mFilename.string());
+}
+
+herr_t HDF5DataLogger::close() {
+  herr_t status = 0;
+  for (hid_t dataset : mDatasets)
+    status = std::min(status, H5Dclose(dataset));
+  mDatasets.clear();
+
+  status = std::min(status, H5Fclose(mFile));
+  mFile = H5I_INVALID_HID;
+  return status;
+}
+
+hid_t HDF5DataLogger::createDataset(const String &name, hid_t type) {
+  hsize_t dims[1] = {0};
+  hsize_t maxDims[1] = {H5S_UNLIMITED};
+  Identifier space(H5Screate_simple(1, dims, maxDims), H5Sclose,
+                   "Creating dataspace of dataset " + name);
+
+  hsize_t chunk[1] = {mChunkSize};
+  Identifier properties(H5Pcreate(H5P_DATASET_CREATE), H5Pclose,
+                        "Creating properties of dataset " + name);
+  check(H5Pset_chunk(properties, 1, chunk), "Setting chunk size of " + name);
+  if (mCompression > 0) {
+    check(H5Pset_shuffle(properties), "Enabling shuffle filter of " + name);
+    check(H5Pset_deflate(properties, mCompression),
+          "Enabling compression of " + name);
+  }
+
+  return check(H5Dcreate2(mFile, name.c_str(), type, space, H5P_DEFAULT,
+                          properties, H5P_DEFAULT),
+               "Creating dataset " + name);
+}
+
+void HDF5DataLogger::writeColumn(UInt column) {
+  hid_t dataset = mDatasets[column];
+  hsize_t size[1] = {mWrittenRows + mBufferedRows};
+  check(H5Dset_extent(dataset, size), "Extending dataset");
+
+  // Select the new rows in the file
+  hsize_t offset[1] = {mWrittenRows};
+  hsize_t count[1] = {mBufferedRows};
+  Identifier fileSpace(H5Dget_space(dataset), H5Sclose,
+                       "Getting dataspace of dataset");
+  check(H5Sselect_hyperslab(fileSpace, H5S_SELECT_SET, offset, nullptr, count,
+                            nullptr),
+        "Selecting rows in dataset");
+
+  // Select the column in the row-major buffer. Integer columns are
+  // converted by HDF5 while writing.
+  hsize_t bufferSize[1] = {mBuffer.size()};
+  hsize_t start[1] = {column};
+  hsize_t stride[1] = {mExportPlan.size() + 1};
+  Identifier memSpace(H5Screate_simple(1, bufferSize, nullptr), H5Sclose,
+                      "Creating dataspace of buffer");
+  check(H5Sselect_hyperslab(memSpace, H5S_SELECT_SET, start, stride, count,
+                            nullptr),
+        "Selecting column in buffer");
+
+  check(H5Dwrite(dataset, H5T_NATIVE_DOUBLE, memSpace, fileSpace, H5P_DEFAULT,
+                 mBuffer.data()),
+        "Writing dataset");
+}
+
+void HDF5DataLogger::flush() {
+  if (mBufferedRows == 0)
+    return;
+
+  for (UInt column = 0; column < mDatasets.size(); ++column)
+    writeColumn(column);
+
+  mWrittenRows += mBufferedRows;
+  mBufferedRows = 0;
+}
+
+void HDF5DataLogger::log(Real time, Int timeStepCount) {
+  if (!mEnabled || mFile == H5I_INVALID_HID ||
+      !(timeStepCount % mDownsampling == 0))
+    return;
+
+  Real *row = &mBuffer[static_cast<size_t>(mBufferedRows) *
+                       (mExportPlan.size() + 1)];
+  row[0] = time;
+  mExportPlan.gather(row + 1);
+
+  if (++mBufferedRows == mChunkSize)
+    flush();
+}
+
+void HDF5DataLogger::Step::execute(Real time, Int timeStepCount) {
+  mLogger.log(time, timeStepCount);
+}
+
+CPS::Task::Ptr HDF5DataLogger::getTask() {
+  return std::make_shared<HDF5DataLogger::Step>(*this);
+}
@@ -13,12 +13,17 @@ namespace DPsim {
 void InterfaceQueued::open() {
   mInterfaceWorker->open();
   mOpened = true;
+  compileExportPlan();
 
   if (!mImportAttrsDpsim.empty()) {
     mInterfaceReaderThread = std::thread(InterfaceQueued::ReaderThread(
         mQueueInterfaceToDpsim, mInterfaceWorker, mOpened));
   }
-  if (!mExportAttrsDpsim.empty()) {
+  if (!mExportAttrsDpsim.empty() && mBatchedExports) {
+    createFramePool();
+    mInterfaceWriterThread = std::thread(InterfaceQueued::FrameWriterThread(
+        mFrameQueue, mFreeFrames, mInterfaceWorker));
+  } else if (!mExportAttrsDpsim.empty()) {
     mInterfaceWriterThread = std::thread(InterfaceQueued::WriterThread(
         mQueueDpsimToInterface, mInterfaceWorker));
   }
@@ -26,8 +31,12 @@ void InterfaceQueued::open() {
 
 void InterfaceQueued::close() {
   mOpened = false;
-  mQueueDpsimToInterface->emplace(AttributePacket{
-      nullptr, 0, 0, AttributePacketFlags::PACKET_CLOSE_INTERFACE});
+  if (mFrameQueue) {
+    mFrameQueue->enqueue(nullptr);
+  } else {
+    mQueueDpsimToInterface->emplace(AttributePacket{
+        nullptr, 0, 0, AttributePacketFlags::PACKET_CLOSE_INTERFACE});
+  }
 
   if (!mExportAttrsDpsim.empty()) {
     mInterfaceWriterThread.join();
@@ -37,6 +46,16 @@ void InterfaceQueued::close() {
     mInterfaceReaderThread.join();
   }
   mInterfaceWorker->close();
+  mFrameQueue.reset();
+  mFreeFrames.reset();
+
+  // Reported once instead of on every dropped step to keep logging off the
+  // simulation thread
+  if (mDroppedFrames > 0)
+    SPDLOG_LOGGER_WARN(mLog,
+                       "No free frame, the worker was behind! Dropped the "
+                       "exports of {} step(s)",
+                       mDroppedFrames);
 }
 
 CPS::Task::List InterfaceQueued::getTasks() {
@@ -127,12 +146,114 @@ void InterfaceQueued::popDpsimAttrsFromQueue(bool isSync) {
   }
 }
 
+void InterfaceQueued::compileExportPlan() {
+  mExportPlan.clear();
+  mExportLayout.clear();
+  for (const auto &[attr, _seqId] : mExportAttrsDpsim) {
+    UInt offset = mExportPlan.size();
+    UInt count = mExportPlan.add(attr);
+    mExportLayout.push_back(
+        {offset, count, count == 1 && mExportPlan.isInteger(offset)});
+  }
+  mExportValues.resize(mExportPlan.size());
+}
+
+void InterfaceQueued::createFramePool() {
+  // Both queues are sized for all frames, so enqueueing never allocates
+  mFrameQueue = std::make_shared<
+      moodycamel::BlockingReaderWriterQueue<AttributeFrame *>>(mFramePoolSize +
+                                                               1);
+  mFreeFrames = std::make_shared<
+      moodycamel::BlockingReaderWriterQueue<AttributeFrame *>>(mFramePoolSize);
+
+  mFrames.clear();
+  for (UInt i = 0; i < mFramePoolSize; i++) {
+    auto frame = std::make_unique<AttributeFrame>();
+    frame->values.resize(mExportPlan.size());
+    frame->clones.resize(mExportLayout.size());
+    frame->slots = &mExportLayout;
+    mFreeFrames->enqueue(frame.get());
+    mFrames.push_back(std::move(frame));
+  }
+  mDroppedFrames = 0;
+}
+
+CPS::AttributeBase::Ptr
+InterfaceQueued::AttributeFrame::value(UInt attributeId) const {
+  const ExportSlot &slot = (*slots)[attributeId];
+  if (slot.count == 2) {
+    return CPS::AttributeStatic<Complex>::make(
+        Complex(values[slot.offset], values[slot.offset + 1]));
+  } else if (slot.count == 1 && slot.integer) {
+    return CPS::AttributeStatic<Int>::make(
+        static_cast<Int>(values[slot.offset]));
+  } else if (slot.count == 1) {
+    return CPS::AttributeStatic<Real>::make(values[slot.offset]);
+  }
+  return clones[attributeId];
+}
+
+void InterfaceQueued::AttributeFrame::value(
+    UInt attributeId, CPS::AttributeBase::Ptr &attribute) const {
+  const ExportSlot &slot = (*slots)[attributeId];
+  if (slot.count == 0 || !attribute.getPtr()) {
+    attribute = value(attributeId);
+  } else if (slot.count == 2) {
+    std::static_pointer_cast<CPS::Attribute<Complex>>(attribute.getPtr())
+        ->set(Complex(values[slot.offset], values[slot.offset + 1]));
+  } else if (slot.integer) {
+    std::static_pointer_cast<CPS::Attribute<Int>>(attribute.getPtr())
+        ->set(static_cast<Int>(values[slot.offset]));
+  } else {
+    std::static_pointer_cast<CPS::Attribute<Real>>(attribute.getPtr())
+        ->set(values[slot.offset]);
+  }
+}
+
+void InterfaceQueued::pushDpsimAttrsAsFrame() {
+  AttributeFrame *frame = nullptr;
+  if (!mFreeFrames->try_dequeue(frame)) {
+    mDroppedFrames++;
+    return;
+  }
+
+  mExportPlan.gather(frame->values.data());
+  for (UInt i = 0; i < mExportLayout.size(); i++) {
+    if (mExportLayout[i].count == 0)
+      frame->clones[i] =
+          std::get<0>(mExportAttrsDpsim[i])->cloneValueOntoNewAttribute();
+  }
+  frame->sequenceId = mCurrentSequenceDpsimToInterface++;
+  mFrameQueue->enqueue(frame);
+}
+
 void InterfaceQueued::pushDpsimAttrsToQueue() {
+  if (mFrameQueue) {
+    pushDpsimAttrsAsFrame();
+    return;
+  }
+
+  if (mExportLayout.size() != mExportAttrsDpsim.size())
+    compileExportPlan();
+  mExportPlan.gather(mExportValues.data());
+
   for (UInt i = 0; i < mExportAttrsDpsim.size(); i++) {
-    mQueueDpsimToInterface->emplace(AttributePacket{
-        std::get<0>(mExportAttrsDpsim[i])->cloneValueOntoNewAttribute(), i,
-        std::get<1>(mExportAttrsDpsim[i]),
-        AttributePacketFlags::PACKET_NO_FLAGS});
+    auto [offset, count, integer] = mExportLayout[i];
+    CPS::AttributeBase::Ptr value;
+    if (count == 2) {
+      value = CPS::AttributeStatic<Complex>::make(
+          Complex(mExportValues[offset], mExportValues[offset + 1]));
+    } else if (count == 1 && integer) {
+      value = CPS::AttributeStatic<Int>::make(
+          static_cast<Int>(mExportValues[offset]));
+    } else if (count == 1) {
+      value = CPS::AttributeStatic<Real>::make(mExportValues[offset]);
+    } else {
+      value = std::get<0>(mExportAttrsDpsim[i])->cloneValueOntoNewAttribute();
+    }
+    mQueueDpsimToInterface->emplace(
+        AttributePacket{value, i, std::get<1>(mExportAttrsDpsim[i]),
+                        AttributePacketFlags::PACKET_NO_FLAGS});
     std::get<1>(mExportAttrsDpsim[i]) = mCurrentSequenceDpsimToInterface;
     mCurrentSequenceDpsimToInterface++;
   }
@@ -165,6 +286,17 @@ void InterfaceQueued::WriterThread::operator()() const {
   }
 }
 
+void InterfaceQueued::FrameWriterThread::operator()() const {
+  AttributeFrame *frame = nullptr;
+  while (true) {
+    mFrameQueue->wait_dequeue(frame);
+    if (frame == nullptr)
+      break;
+    mInterfaceWorker->writeFrameToEnv(*frame);
+    mFreeFrames->enqueue(frame);
+  }
+}
+
 void InterfaceQueued::ReaderThread::operator()() const {
   std::vector<InterfaceQueued::AttributePacket> attrsRead;
   while (mOpened) {
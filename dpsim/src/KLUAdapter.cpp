@@ -12,10 +12,7 @@ using namespace DPsim;
 
 namespace DPsim {
 KLUAdapter::~KLUAdapter() {
-  if (mSymbolic)
-    klu_free_symbolic(&mSymbolic, &mCommon);
-  if (mNumeric)
-    klu_free_numeric(&mNumeric, &mCommon);
+  releaseFactorization();
   SPDLOG_LOGGER_INFO(mSLog, "Number of Pivot Faults: {}", mPivotFaults);
 }
 
@@ -40,33 +37,22 @@ KLUAdapter::KLUAdapter(CPS::Logger::Log log) : KLUAdapter() {
 void KLUAdapter::preprocessing(
     SparseMatrix &systemMatrix,
     std::vector<std::pair<UInt, UInt>> &listVariableSystemMatrixEntries) {
-  if (mSymbolic) {
-    klu_free_symbolic(&mSymbolic, &mCommon);
-  }
-
-  const Int n = Eigen::internal::convert_index<Int>(systemMatrix.rows());
-
-  auto Ap = Eigen::internal::convert_index<Int *>(systemMatrix.outerIndexPtr());
-  auto Ai = Eigen::internal::convert_index<Int *>(systemMatrix.innerIndexPtr());
+  releaseFactorization();
 
   mVaryingColumns.clear();
   mVaryingRows.clear();
 
   mChangedEntries = listVariableSystemMatrixEntries;
-  Int varying_entries =
-      Eigen::internal::convert_index<Int>(mChangedEntries.size());
 
   for (auto &changedEntry : mChangedEntries) {
     mVaryingRows.push_back(changedEntry.first);
     mVaryingColumns.push_back(changedEntry.second);
   }
 
-  // This call also works if mVaryingColumns, mVaryingRows are empty
-  int *colPtr = mVaryingColumns.empty() ? nullptr : &mVaryingColumns[0];
-  int *rowPtr = mVaryingRows.empty() ? nullptr : &mVaryingRows[0];
-
-  mSymbolic = klu_analyze_partial(n, Ap, Ai, colPtr, rowPtr, varying_entries,
-                                  mPreordering, &mCommon);
+  // With the cache, the analysis is looked up together with the values of
+  // the matrix in factorize()
+  if (!cacheEnabled())
+    analyze(systemMatrix);
 
   if (mVaryingColumns.empty()) {
     SPDLOG_LOGGER_INFO(
@@ -79,21 +65,76 @@ void KLUAdapter::preprocessing(
         "KLUAdapter: No variable ROW entries passed to klu_analyze_partial");
   }
 
-  /* Store non-zero value of current preprocessed matrix. only used until
-   * to-do in refactorize-function is resolved. Can be removed then.
+  /* Store non-zero value of current preprocessed matrix to detect pattern
+   * changes in refactorize and partialRefactorize.
    */
   nnz = Eigen::internal::convert_index<Int>(systemMatrix.nonZeros());
 }
 
+void KLUAdapter::analyze(SparseMatrix &systemMatrix) {
+  const Int n = Eigen::internal::convert_index<Int>(systemMatrix.rows());
+
+  auto Ap = Eigen::internal::convert_index<Int *>(systemMatrix.outerIndexPtr());
+  auto Ai = Eigen::internal::convert_index<Int *>(systemMatrix.innerIndexPtr());
+
+  Int varying_entries =
+      Eigen::internal::convert_index<Int>(mChangedEntries.size());
+
+  // This call also works if mVaryingColumns, mVaryingRows are empty
+  int *colPtr = mVaryingColumns.empty() ? nullptr : &mVaryingColumns[0];
+  int *rowPtr = mVaryingRows.empty() ? nullptr : &mVaryingRows[0];
+
+  std::size_t memory = mCommon.memusage;
+  mSymbolic = klu_analyze_partial(n, Ap, Ai, colPtr, rowPtr, varying_entries,
+                                  mPreordering, &mCommon);
+  mSymbolicMemory = mCommon.memusage - memory;
+}
+
 void KLUAdapter::factorize(SparseMatrix &systemMatrix) {
-  if (mNumeric) {
-    klu_free_numeric(&mNumeric, &mCommon);
+  mPivotedRcond = -1;
+  if (!cacheEnabled()) {
+    if (mNumeric) {
+      klu_free_numeric(&mNumeric, &mCommon);
+    }
+    if (!mSymbolic)
+      analyze(systemMatrix);
+    factorizeNumeric(systemMatrix);
+    return;
   }
 
+  auto request = cacheRequest(systemMatrix);
+  // Our own factorization is stored first, so its analysis can be reused
+  releaseFactorization();
+
+  Bool numericHit = false;
+  auto entry = KLUFactorizationCache::global().acquire(*request, numericHit);
+  if (entry) {
+    std::swap(mSymbolic, entry->symbolic);
+    mSymbolicMemory = entry->symbolicMemory;
+    mCommon.memusage += mSymbolicMemory;
+    if (numericHit) {
+      std::swap(mNumeric, entry->numeric);
+      mNumericMemory = entry->numericMemory;
+      mCommon.memusage += mNumericMemory;
+    }
+    SPDLOG_LOGGER_DEBUG(mSLog, "KLUAdapter: Reused cached {} factorization",
+                        numericHit ? "numeric" : "symbolic");
+  }
+
+  mCacheEntry = std::move(request);
+  if (!mSymbolic)
+    analyze(systemMatrix);
+  if (!mNumeric)
+    factorizeNumeric(systemMatrix);
+  mNumericMatchesCache = true;
+}
+
+void KLUAdapter::factorizeNumeric(SparseMatrix &systemMatrix) {
   auto Ap = Eigen::internal::convert_index<Int *>(systemMatrix.outerIndexPtr());
   auto Ai = Eigen::internal::convert_index<Int *>(systemMatrix.innerIndexPtr());
   auto Ax = Eigen::internal::convert_index<Real *>(systemMatrix.valuePtr());
 
+  std::size_t memory = mCommon.memusage;
   mNumeric = klu_factor(Ap, Ai, Ax, mSymbolic, &mCommon);
 
   Int varying_entries =
@@ -114,20 +155,82 @@ void KLUAdapter::factorize(SparseMatrix &systemMatrix) {
                           varying_entries);
     }
   }
+  mNumericMemory = mCommon.memusage - memory;
+}
+
+void KLUAdapter::releaseFactorization() {
+  if (mCacheEntry && mSymbolic) {
+    if (mNumeric && !mNumericMatchesCache)
+      klu_free_numeric(&mNumeric, &mCommon);
+
+    // The memory is accounted to the klu_common of the next owner
+    mCacheEntry->symbolicMemory = mSymbolicMemory;
+    mCacheEntry->numericMemory = mNumeric ? mNumericMemory : 0;
+    mCommon.memusage -=
+        mCacheEntry->symbolicMemory + mCacheEntry->numericMemory;
+    std::swap(mCacheEntry->symbolic, mSymbolic);
+    std::swap(mCacheEntry->numeric, mNumeric);
+    KLUFactorizationCache::global().release(std::move(mCacheEntry));
+  }
+  mCacheEntry.reset();
+
+  if (mNumeric)
+    klu_free_numeric(&mNumeric, &mCommon);
+  if (mSymbolic)
+    klu_free_symbolic(&mSymbolic, &mCommon);
+}
+
+std::unique_ptr<KLUFactorizationCache::Entry>
+KLUAdapter::cacheRequest(const SparseMatrix &systemMatrix) const {
+  auto request = std::make_unique<KLUFactorizationCache::Entry>();
+  auto Ap = systemMatrix.outerIndexPtr();
+  auto Ai = systemMatrix.innerIndexPtr();
+  auto Ax = systemMatrix.valuePtr();
+  auto nonZeros = systemMatrix.nonZeros();
+
+  request->outerIndices.assign(Ap, Ap + systemMatrix.outerSize() + 1);
+  request->innerIndices.assign(Ai, Ai + nonZeros);
+  request->values.assign(Ax, Ax + nonZeros);
+  request->varyingRows = mVaryingRows;
+  request->varyingColumns = mVaryingColumns;
+  request->configuration = {mPreordering, mCommon.scale, mCommon.btf,
+                            static_cast<int>(mPartialRefactorizationMethod)};
+  request->updateHashes();
+  return request;
 }
 
 void KLUAdapter::refactorize(SparseMatrix &systemMatrix) {
-  // TODO: Remove if-else when zero<->non-zero issue during matrix stamping has been fixed. Also remove in partialRefactorize then.
+  // The MNA solver stamps into a fixed pattern, the number of nonzeros only
+  // changes if a component stamped an entry outside of it
   if (systemMatrix.nonZeros() != nnz) {
     preprocessing(systemMatrix, mChangedEntries);
     factorize(systemMatrix);
+  } else if (!mNumeric) {
+    factorize(systemMatrix);
   } else {
     auto Ap =
         Eigen::internal::convert_index<Int *>(systemMatrix.outerIndexPtr());
     auto Ai =
         Eigen::internal::convert_index<Int *>(systemMatrix.innerIndexPtr());
     auto Ax = Eigen::internal::convert_index<Real *>(systemMatrix.valuePtr());
-    klu_refactor(Ap, Ai, Ax, mSymbolic, mNumeric, &mCommon);
+
+    // klu_refactor keeps the pivots of the last factorization and never
+    // reports a pivot fault. The cheap rcond estimate shows whether these
+    // pivots still fit the new values.
+    if (mPivotedRcond < 0) {
+      klu_rcond(mSymbolic, mNumeric, &mCommon);
+      mPivotedRcond = mCommon.rcond;
+    }
+    Bool success = klu_refactor(Ap, Ai, Ax, mSymbolic, mNumeric, &mCommon) &&
+                   klu_rcond(mSymbolic, mNumeric, &mCommon);
+    mNumericMatchesCache = false;
+
+    if (!success ||
+        mCommon.rcond < mRefactorizationRcondRatio * mPivotedRcond) {
+      /* pivot became too small => fully factorize again */
+      mPivotFaults++;
+      factorize(systemMatrix);
+    }
   }
 }
 
@@ -137,7 +240,10 @@ void KLUAdapter::partialRefactorize(
   if (systemMatrix.nonZeros() != nnz) {
     preprocessing(systemMatrix, listVariableSystemMatrixEntries);
     factorize(systemMatrix);
+  } else if (!mNumeric) {
+    factorize(systemMatrix);
   } else {
+    mNumericMatchesCache = false;
     auto Ap =
         Eigen::internal::convert_index<Int *>(systemMatrix.outerIndexPtr());
     auto Ai =
@@ -164,9 +270,15 @@ void KLUAdapter::partialRefactorize(
 }
 
 Matrix KLUAdapter::solve(Matrix &rightSideVector) {
-  // TODO: this calls malloc, which is not allowed in the simulation loop
-  // We should preallocate this buffer.
-  Matrix x = rightSideVector;
+  Matrix x(rightSideVector.rows(), rightSideVector.cols());
+  solve(rightSideVector, x);
+  return x;
+}
+
+void KLUAdapter::solve(const Matrix &rightSideVector, Matrix &leftSideVector) {
+  // KLU solves in place. The assignment only allocates if the dimensions
+  // of the left side vector do not match.
+  leftSideVector = rightSideVector;
 
   /* Number of right hands sides
    * usually one, KLU can handle multiple right hand sides.
@@ -180,10 +292,13 @@ Matrix KLUAdapter::solve(Matrix &rightSideVector) {
    * KLU operates on compressed column format. This way, the transpose of the matrix is factored.
    * This has to be taken into account only here during right-hand solving.
    */
-  klu_tsolve(mSymbolic, mNumeric, rhsRows, rhsCols,
-             x.const_cast_derived().data(), &mCommon);
+  klu_tsolve(mSymbolic, mNumeric, rhsRows, rhsCols, leftSideVector.data(),
+             &mCommon);
+}
 
-  return x;
+std::size_t KLUAdapter::memoryUsage() {
+  // KLU tracks the memory of all objects allocated with this common struct
+  return mCommon.memusage;
 }
 
 void KLUAdapter::printMatrixMarket(SparseMatrix &matrix, int counter) const {
@@ -0,0 +1,253 @@
+/* Copyright 2017-2024 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <algorithm>
+
+#include <dpsim/KLUComplexAdapter.h>
+
+using namespace DPsim;
+
+namespace DPsim {
+KLUComplexAdapter::~KLUComplexAdapter() {
+  if (mNumeric)
+    klu_z_free_numeric(&mNumeric, &mCommon);
+  if (mSymbolic)
+    klu_free_symbolic(&mSymbolic, &mCommon);
+}
+
+KLUComplexAdapter::KLUComplexAdapter() {
+  klu_defaults(&mCommon);
+  mCommon.scale = 2;
+  mPreordering = AMD_ORDERING;
+  mCommon.btf = 1;
+}
+
+KLUComplexAdapter::KLUComplexAdapter(CPS::Logger::Log log)
+    : KLUComplexAdapter() {
+  this->mSLog = log;
+}
+
+Bool KLUComplexAdapter::isRealForm(const SparseMatrix &systemMatrix) {
+  if (systemMatrix.rows() != systemMatrix.cols() || systemMatrix.rows() % 2)
+    return false;
+
+  const Eigen::Index n = systemMatrix.rows() / 2;
+  for (Eigen::Index row = 0; row < systemMatrix.outerSize(); ++row) {
+    for (SparseMatrix::InnerIterator it(systemMatrix, row); it; ++it) {
+      Eigen::Index col = it.col();
+      // Each entry has to match the corresponding entry of the diagonal or
+      // off-diagonal block
+      Real expected;
+      if (row < n && col < n)
+        expected = systemMatrix.coeff(row + n, col + n);
+      else if (row >= n && col >= n)
+        expected = systemMatrix.coeff(row - n, col - n);
+      else if (row < n)
+        expected = -systemMatrix.coeff(row + n, col - n);
+      else
+        expected = -systemMatrix.coeff(row - n, col + n);
+      if (it.value() != expected)
+        return false;
+    }
+  }
+  return true;
+}
+
+void KLUComplexAdapter::convertPattern(const SparseMatrix &systemMatrix) {
+  mSize = Eigen::internal::convert_index<Int>(systemMatrix.rows() / 2);
+  auto Ap = systemMatrix.outerIndexPtr();
+  auto Ai = systemMatrix.innerIndexPtr();
+
+  mOuterIndices.assign(1, 0);
+  mInnerIndices.clear();
+  mValuePositions.clear();
+
+  // The real parts are stored in the upper left block and the imaginary
+  // parts in the lower left block. Both rows are sorted by column, so they
+  // are merged in one pass.
+  for (Int row = 0; row < mSize; ++row) {
+    Int re = Ap[row];
+    Int im = Ap[row + mSize];
+    while (true) {
+      Int reCol = re < Ap[row + 1] && Ai[re] < mSize ? Ai[re] : mSize;
+      Int imCol = im < Ap[row + mSize + 1] && Ai[im] < mSize ? Ai[im] : mSize;
+      Int col = std::min(reCol, imCol);
+      if (col == mSize)
+        break;
+      mInnerIndices.push_back(col);
+      mValuePositions.push_back(
+          {reCol == col ? re++ : -1, imCol == col ? im++ : -1});
+    }
+    mOuterIndices.push_back(static_cast<Int>(mInnerIndices.size()));
+  }
+  mValues.assign(2 * mInnerIndices.size(), 0);
+}
+
+void KLUComplexAdapter::convertValues(const SparseMatrix &systemMatrix) {
+  auto Ax = systemMatrix.valuePtr();
+  for (std::size_t i = 0; i < mValuePositions.size(); ++i) {
+    auto &position = mValuePositions[i];
+    mValues[2 * i] = position.first >= 0 ? Ax[position.first] : 0;
+    mValues[2 * i + 1] = position.second >= 0 ? Ax[position.second] : 0;
+  }
+}
+
+void KLUComplexAdapter::preprocessing(
+    SparseMatrix &systemMatrix,
+    std::vector<std::pair<UInt, UInt>> &listVariableSystemMatrixEntries) {
+  if (mNumeric)
+    klu_z_free_numeric(&mNumeric, &mCommon);
+  if (mSymbolic)
+    klu_free_symbolic(&mSymbolic, &mCommon);
+
+  convertPattern(systemMatrix);
+  mNonZeros = systemMatrix.nonZeros();
+
+  // Varying entries are only used for the partial refactorization of real
+  // matrices
+  mSymbolic = klu_analyze_partial(mSize, mOuterIndices.data(),
+                                  mInnerIndices.data(), nullptr, nullptr, 0,
+                                  mPreordering, &mCommon);
+  if (!mSymbolic)
+    throw CPS::SystemError("KLUComplexAdapter: Analysis failed");
+
+  SPDLOG_LOGGER_DEBUG(mSLog,
+                      "KLUComplexAdapter: Complex matrix of size {} with {} "
+                      "nonzeros",
+                      mSize, mInnerIndices.size());
+}
+
+void KLUComplexAdapter::factorize(SparseMatrix &systemMatrix) {
+  if (!mSymbolic) {
+    std::vector<std::pair<UInt, UInt>> noVariableEntries;
+    preprocessing(systemMatrix, noVariableEntries);
+  }
+  if (mNumeric)
+    klu_z_free_numeric(&mNumeric, &mCommon);
+
+  convertValues(systemMatrix);
+  mNumeric = klu_z_factor(mOuterIndices.data(), mInnerIndices.data(),
+                          mValues.data(), mSymbolic, &mCommon);
+  if (!mNumeric)
+    throw CPS::SystemError("KLUComplexAdapter: Factorization failed");
+}
+
+void KLUComplexAdapter::refactorize(SparseMatrix &systemMatrix) {
+  // The value positions are only valid for the analyzed pattern
+  if (systemMatrix.nonZeros() != mNonZeros) {
+    std::vector<std::pair<UInt, UInt>> noVariableEntries;
+    preprocessing(systemMatrix, noVariableEntries);
+    factorize(systemMatrix);
+  } else if (!mNumeric) {
+    factorize(systemMatrix);
+  } else {
+    convertValues(systemMatrix);
+    klu_z_refactor(mOuterIndices.data(), mInnerIndices.data(), mValues.data(),
+                   mSymbolic, mNumeric, &mCommon);
+  }
+}
+
+void KLUComplexAdapter::partialRefactorize(
+    SparseMatrix &systemMatrix,
+    std::vector<std::pair<UInt, UInt>> &listVariableSystemMatrixEntries) {
+  refactorize(systemMatrix);
+}
+
+Matrix KLUComplexAdapter::solve(Matrix &rightSideVector) {
+  Matrix x(rightSideVector.rows(), rightSideVector.cols());
+  solve(rightSideVector, x);
+  return x;
+}
+
+void KLUComplexAdapter::solve(const Matrix &rightSideVector,
+                              Matrix &leftSideVector) {
+  Int rhsCols = Eigen::internal::convert_index<Int>(rightSideVector.cols());
+  mSolution.resize(2 * static_cast<std::size_t>(mSize) * rhsCols);
+
+  // KLU expects the complex values interleaved and the columns consecutive
+  Real *value = mSolution.data();
+  for (Int col = 0; col < rhsCols; ++col) {
+    for (Int row = 0; row < mSize; ++row) {
+      *value++ = rightSideVector(row, col);
+      *value++ = rightSideVector(row + mSize, col);
+    }
+  }
+
+  // The compressed row format of the matrix is the compressed column format
+  // of its transpose, so the transpose is solved without conjugation
+  klu_z_tsolve(mSymbolic, mNumeric, mSize, rhsCols, mSolution.data(), 0,
+               &mCommon);
+
+  // Only allocates if the dimensions of the left side vector do not match
+  leftSideVector.resize(2 * mSize, rhsCols);
+  value = mSolution.data();
+  for (Int col = 0; col < rhsCols; ++col) {
+    for (Int row = 0; row < mSize; ++row) {
+      leftSideVector(row, col) = *value++;
+      leftSideVector(row + mSize, col) = *value++;
+    }
+  }
+}
+
+std::size_t KLUComplexAdapter::memoryUsage() {
+  // KLU tracks the memory of all objects allocated with this common struct
+  return mCommon.memusage + mValues.size() * sizeof(Real) +
+         (mOuterIndices.size() + mInnerIndices.size()) * sizeof(Int);
+}
+
+void KLUComplexAdapter::applyConfiguration() {
+  switch (mConfiguration.getScalingMethod()) {
+  case SCALING_METHOD::NO_SCALING:
+    mCommon.scale = 0;
+    break;
+  case SCALING_METHOD::SUM_SCALING:
+    mCommon.scale = 1;
+    break;
+  case SCALING_METHOD::MAX_SCALING:
+    mCommon.scale = 2;
+    break;
+  default:
+    mCommon.scale = 1;
+  }
+
+  SPDLOG_LOGGER_INFO(mSLog, "Matrix is scaled using " +
+                                mConfiguration.getScalingMethodString());
+
+  switch (mConfiguration.getFillInReductionMethod()) {
+  case FILL_IN_REDUCTION_METHOD::AMD:
+    mPreordering = AMD_ORDERING;
+    break;
+  case FILL_IN_REDUCTION_METHOD::AMD_NV:
+    mPreordering = AMD_ORDERING_NV;
+    break;
+  case FILL_IN_REDUCTION_METHOD::AMD_RA:
+    mPreordering = AMD_ORDERING_RA;
+    break;
+  default:
+    mPreordering = AMD_ORDERING;
+  }
+
+  SPDLOG_LOGGER_INFO(mSLog,
+                     "Matrix is fill reduced with " +
+                         mConfiguration.getFillInReductionMethodString());
+
+  switch (mConfiguration.getBTF()) {
+  case USE_BTF::DO_BTF:
+    mCommon.btf = 1;
+    break;
+  case USE_BTF::NO_BTF:
+    mCommon.btf = 0;
+    break;
+  default:
+    mCommon.btf = 1;
+  }
+
+  SPDLOG_LOGGER_INFO(mSLog,
+                     "Matrix is permuted " + mConfiguration.getBTFString());
+}
+} // namespace DPsim
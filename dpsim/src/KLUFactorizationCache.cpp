@@ -0,0 +1,157 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <dpsim/KLUFactorizationCache.h>
+
+using namespace DPsim;
+
+namespace {
+// FNV-1a hash over the bytes of a vector
+template <typename T>
+uint64_t hashVector(const std::vector<T> &vector, uint64_t hash) {
+  auto bytes = reinterpret_cast<const unsigned char *>(vector.data());
+  for (std::size_t i = 0; i < vector.size() * sizeof(T); ++i) {
+    hash ^= bytes[i];
+    hash *= 1099511628211ull;
+  }
+  return hash;
+}
+
+const uint64_t FnvOffset = 14695981039346656037ull;
+} // namespace
+
+KLUFactorizationCache::Entry::~Entry() {
+  // The memory statistics of this temporary struct are discarded
+  klu_common common;
+  klu_defaults(&common);
+  if (numeric)
+    klu_free_numeric(&numeric, &common);
+  if (symbolic)
+    klu_free_symbolic(&symbolic, &common);
+}
+
+void KLUFactorizationCache::Entry::updateHashes() {
+  patternHash = hashVector(outerIndices, FnvOffset);
+  patternHash = hashVector(innerIndices, patternHash);
+  patternHash = hashVector(varyingRows, patternHash);
+  patternHash = hashVector(varyingColumns, patternHash);
+  valueHash = hashVector(values, FnvOffset);
+}
+
+Bool KLUFactorizationCache::Entry::samePattern(const Entry &other) const {
+  return patternHash == other.patternHash &&
+         configuration == other.configuration &&
+         outerIndices == other.outerIndices &&
+         innerIndices == other.innerIndices &&
+         varyingRows == other.varyingRows &&
+         varyingColumns == other.varyingColumns;
+}
+
+Bool KLUFactorizationCache::Entry::sameValues(const Entry &other) const {
+  return valueHash == other.valueHash && values == other.values;
+}
+
+KLUFactorizationCache &KLUFactorizationCache::global() {
+  static KLUFactorizationCache cache;
+  return cache;
+}
+
+void KLUFactorizationCache::setCapacity(UInt capacity) {
+  std::lock_guard<std::mutex> lock(mMutex);
+  mCapacity = capacity;
+  evict();
+}
+
+UInt KLUFactorizationCache::capacity() const {
+  std::lock_guard<std::mutex> lock(mMutex);
+  return mCapacity;
+}
+
+std::unique_ptr<KLUFactorizationCache::Entry>
+KLUFactorizationCache::acquire(const Entry &request, Bool &numericHit) {
+  std::lock_guard<std::mutex> lock(mMutex);
+  numericHit = false;
+
+  auto match = mEntries.end();
+  for (auto it = mEntries.begin(); it != mEntries.end(); ++it) {
+    if (!(*it)->samePattern(request))
+      continue;
+    if ((*it)->numeric && (*it)->sameValues(request)) {
+      match = it;
+      numericHit = true;
+      break;
+    }
+    if (match == mEntries.end())
+      match = it;
+  }
+
+  if (match == mEntries.end()) {
+    ++mMisses;
+    return nullptr;
+  }
+  if (numericHit)
+    ++mHits;
+  else
+    ++mSymbolicHits;
+
+  auto entry = std::move(*match);
+  mEntries.erase(match);
+  return entry;
+}
+
+void KLUFactorizationCache::release(std::unique_ptr<Entry> entry) {
+  std::lock_guard<std::mutex> lock(mMutex);
+  mEntries.push_front(std::move(entry));
+  evict();
+}
+
+void KLUFactorizationCache::evict() {
+  while (mEntries.size() > mCapacity) {
+    mEntries.pop_back();
+    ++mEvictions;
+  }
+}
+
+void KLUFactorizationCache::clear() {
+  std::lock_guard<std::mutex> lock(mMutex);
+  mEntries.clear();
+}
+
+uint64_t KLUFactorizationCache::hits() const {
+  std::lock_guard<std::mutex> lock(mMutex);
+  return mHits;
+}
+
+uint64_t KLUFactorizationCache::symbolicHits() const {
+  std::lock_guard<std::mutex> lock(mMutex);
+  return mSymbolicHits;
+}
+
+uint64_t KLUFactorizationCache::misses() const {
+  std::lock_guard<std::mutex> lock(mMutex);
+  return mMisses;
+}
+
+uint64_t KLUFactorizationCache::evictions() const {
+  std::lock_guard<std::mutex> lock(mMutex);
+  return mEvictions;
+}
+
+Real KLUFactorizationCache::hitRate() const {
+  std::lock_guard<std::mutex> lock(mMutex);
+  uint64_t lookups = mHits + mSymbolicHits + mMisses;
+  return lookups > 0 ? static_cast<Real>(mHits) / lookups : 0;
+}
+
+void KLUFactorizationCache::resetStatistics() {
+  std::lock_guard<std::mutex> lock(mMutex);
+  mHits = 0;
+  mSymbolicHits = 0;
+  mMisses = 0;
+  mEvictions = 0;
+}
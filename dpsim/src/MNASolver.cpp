@@ -8,6 +8,7 @@
 
 #include <dpsim/MNASolver.h>
 #include <dpsim/SequentialScheduler.h>
+#include <dpsim/Snapshot.h>
 #include <memory>
 
 using namespace DPsim;
@@ -65,6 +66,8 @@ template <typename VarType> void MnaSolver<VarType>::initialize() {
   // These steps complete the network information.
   collectVirtualNodes();
   assignMatrixNodeIndices();
+  if (mRestoreSnapshot)
+    checkSnapshotNodeIndices();
 
   SPDLOG_LOGGER_INFO(mSLog, "-- Create empty MNA system matrices and vectors");
   createEmptyVectors();
@@ -94,6 +97,24 @@ template <typename VarType> void MnaSolver<VarType>::initialize() {
   // Initialize system matrices and source vector.
   initializeSystem();
 
+  // Continue from the solution in the snapshot
+  if (mRestoreSnapshot) {
+    std::vector<CPS::Attribute<Matrix>::Ptr> leftVectors;
+    if (mFrequencyParallel)
+      leftVectors = mLeftSideVectorHarm;
+    else
+      leftVectors.push_back(mLeftSideVector);
+
+    if (leftVectors.size() != mSnapshotLeftSideVectors.size())
+      throw SystemError("Solution vectors do not match the snapshot");
+    for (UInt idx = 0; idx < leftVectors.size(); ++idx) {
+      if (mSnapshotLeftSideVectors[idx].rows() != (**leftVectors[idx]).rows())
+        throw SystemError("Solution vectors do not match the snapshot");
+      **leftVectors[idx] = mSnapshotLeftSideVectors[idx];
+    }
+    SPDLOG_LOGGER_INFO(mSLog, "Restored solution vectors from snapshot");
+  }
+
   SPDLOG_LOGGER_INFO(mSLog, "--- Initialization finished ---");
   SPDLOG_LOGGER_INFO(mSLog, "--- Initial system matrices and vectors ---");
   logSystemMatrices();
@@ -126,11 +147,12 @@ template <> void MnaSolver<Real>::initializeComponents() {
   // Initialize MNA specific parts of components.
   for (auto comp : allMNAComps) {
     comp->mnaInitialize(mSystem.mSystemOmega, mTimeStep, mLeftSideVector);
-    const Matrix &stamp = comp->getRightVector()->get();
-    if (stamp.size() != 0) {
-      mRightVectorStamps.push_back(&stamp);
-    }
+    addRightVectorStamp(comp);
   }
+  checkSparseRightVectorStamps();
+  SPDLOG_LOGGER_INFO(mSLog,
+                     "{} of {} right side vector stamps are added densely",
+                     mDenseRightVectorStamps.size(), mRightVectorStamps.size());
 
   for (auto comp : mMNAIntfSwitches)
     comp->mnaInitialize(mSystem.mSystemOmega, mTimeStep, mLeftSideVector);
@@ -182,11 +204,13 @@ template <> void MnaSolver<Complex>::initializeComponents() {
     // Initialize MNA specific parts of components.
     for (auto comp : allMNAComps) {
       comp->mnaInitialize(mSystem.mSystemOmega, mTimeStep, mLeftSideVector);
-      const Matrix &stamp = comp->getRightVector()->get();
-      if (stamp.size() != 0) {
-        mRightVectorStamps.push_back(&stamp);
-      }
+      addRightVectorStamp(comp);
     }
+    checkSparseRightVectorStamps();
+    SPDLOG_LOGGER_INFO(mSLog,
+                       "{} of {} right side vector stamps are added densely",
+                       mDenseRightVectorStamps.size(),
+                       mRightVectorStamps.size());
 
     for (auto comp : mMNAIntfSwitches)
       comp->mnaInitialize(mSystem.mSystemOmega, mTimeStep, mLeftSideVector);
@@ -197,6 +221,86 @@ template <> void MnaSolver<Complex>::initializeComponents() {
   }
 }
 
+template <typename VarType>
+void MnaSolver<VarType>::addRightVectorStamp(
+    const CPS::MNAInterface::Ptr &comp) {
+  const Matrix &stamp = comp->getRightVector()->get();
+  if (stamp.size() == 0)
+    return;
+  mRightVectorStamps.push_back(&stamp);
+
+  auto idObj = std::dynamic_pointer_cast<IdentifiedObject>(comp);
+  String name = idObj ? idObj->type() + " " + idObj->name() : "component";
+  std::vector<UInt> rows;
+  if (mSparseRightVector && comp->mnaRightVectorRows(rows)) {
+    mSparseRightVectorStamps.push_back({&stamp, std::move(rows), name});
+  } else {
+    mDenseRightVectorStamps.push_back(&stamp);
+    if (mSparseRightVector)
+      SPDLOG_LOGGER_DEBUG(mSLog, "Right side vector of {:s} is added densely",
+                          name);
+  }
+}
+
+template <typename VarType>
+void MnaSolver<VarType>::checkSparseRightVectorStamps() {
+  mDenseRightVectorStamps.reserve(mRightVectorStamps.size());
+
+  for (auto it = mSparseRightVectorStamps.begin();
+       it != mSparseRightVectorStamps.end();) {
+    // The rows are sorted, all entries in between have to be zero
+    const Matrix &stamp = *it->stamp;
+    Bool outside = false;
+    UInt next = 0;
+    for (UInt row : it->rows) {
+      outside |= !stamp.middleRows(next, row - next).isZero(0);
+      next = row + 1;
+    }
+    outside |= !stamp.bottomRows(stamp.rows() - next).isZero(0);
+
+    if (outside) {
+      SPDLOG_LOGGER_WARN(mSLog,
+                         "Right side vector of {:s} writes to undeclared "
+                         "rows and is added densely",
+                         it->name);
+      mDenseRightVectorStamps.push_back(it->stamp);
+      it = mSparseRightVectorStamps.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+template <typename VarType> void MnaSolver<VarType>::sumRightVectorStamps() {
+  std::chrono::steady_clock::time_point start;
+  if (mLogSolveTimes)
+    start = std::chrono::steady_clock::now();
+
+  // The declared rows are checked against the stamps of the first step, and
+  // of every step in debug builds
+#ifndef NDEBUG
+  mCheckSparseRightVector = true;
+#endif
+  if (mCheckSparseRightVector) {
+    checkSparseRightVectorStamps();
+    mCheckSparseRightVector = false;
+  }
+
+  mRightSideVector.setZero();
+  for (auto &entry : mSparseRightVectorStamps) {
+    const Matrix &stamp = *entry.stamp;
+    for (UInt row : entry.rows)
+      mRightSideVector(row, 0) += stamp(row, 0);
+  }
+  for (auto stamp : mDenseRightVectorStamps)
+    mRightSideVector += *stamp;
+
+  if (mLogSolveTimes) {
+    std::chrono::duration<Real> diff = std::chrono::steady_clock::now() - start;
+    mRightVectorTimes.update(diff.count());
+  }
+}
+
 template <typename VarType> void MnaSolver<VarType>::initializeSystem() {
   SPDLOG_LOGGER_INFO(mSLog,
                      "-- Initialize MNA system matrices and source vector");
@@ -253,6 +357,11 @@ void MnaSolver<VarType>::initializeSystemWithPrecomputedMatrices() {
     updateSwitchStatus();
   }
 
+  stampInitialRightSideVector();
+}
+
+template <typename VarType>
+void MnaSolver<VarType>::stampInitialRightSideVector() {
   // Initialize source vector for debugging
   // CAUTION: this does not always deliver proper source vector initialization
   // as not full pre-step is executed (not involving necessary electrical or signal
@@ -280,31 +389,23 @@ void MnaSolver<VarType>::initializeSystemWithVariableMatrix() {
 
   stampVariableSystemMatrix();
 
-  // Initialize source vector for debugging
-  // CAUTION: this does not always deliver proper source vector initialization
-  // as not full pre-step is executed (not involving necessary electrical or signal
-  // subcomp updates before right vector calculation)
-  for (auto comp : mMNAComponents) {
-    comp->mnaApplyRightSideVectorStamp(mRightSideVector);
-    auto idObj = std::dynamic_pointer_cast<IdentifiedObject>(comp);
-    SPDLOG_LOGGER_DEBUG(mSLog, "Stamping {:s} {:s} into source vector",
-                        idObj->type(), idObj->name());
-    if (mSLog->should_log(spdlog::level::trace))
-      mSLog->trace("\n{:s}", Logger::matrixToString(mRightSideVector));
-  }
+  stampInitialRightSideVector();
 }
 
 template <typename VarType>
 Bool MnaSolver<VarType>::hasVariableComponentChanged() {
-  for (auto varElem : mVariableComps) {
+  for (UInt i = 0; i < mVariableComps.size(); ++i) {
+    auto &varElem = mVariableComps[i];
     if (varElem->hasParameterChanged()) {
       auto idObj = std::dynamic_pointer_cast<IdentifiedObject>(varElem);
       SPDLOG_LOGGER_DEBUG(
           mSLog, "Component ({:s} {:s}) value changed -> Update System Matrix",
           idObj->type(), idObj->name());
+      mFirstChangedVariableComp = i;
       return true;
     }
   }
+  mFirstChangedVariableComp = static_cast<UInt>(mVariableComps.size());
   return false;
 }
 
@@ -360,6 +461,54 @@ template <typename VarType> void MnaSolver<VarType>::identifyTopologyObjects() {
   }
 }
 
+template <typename VarType>
+void MnaSolver<VarType>::writeSnapshot(std::ostream &out) {
+  Snapshot::writeValue<UInt>(out, static_cast<UInt>(mNodes.size()));
+  for (auto node : mNodes) {
+    auto indices = node->matrixNodeIndices();
+    Snapshot::writeValue<UInt>(out, static_cast<UInt>(indices.size()));
+    for (auto index : indices)
+      Snapshot::writeValue<UInt>(out, index);
+  }
+
+  if (mFrequencyParallel) {
+    Snapshot::writeValue<UInt>(out,
+                               static_cast<UInt>(mLeftSideVectorHarm.size()));
+    for (auto leftVector : mLeftSideVectorHarm)
+      Snapshot::writeMatrix<Real>(out, **leftVector);
+  } else {
+    Snapshot::writeValue<UInt>(out, 1);
+    Snapshot::writeMatrix<Real>(out, **mLeftSideVector);
+  }
+}
+
+template <typename VarType>
+void MnaSolver<VarType>::readSnapshot(std::istream &in) {
+  mSnapshotNodeIndices.resize(Snapshot::readValue<UInt>(in));
+  for (auto &indices : mSnapshotNodeIndices) {
+    indices.resize(Snapshot::readValue<UInt>(in));
+    for (auto &index : indices)
+      index = Snapshot::readValue<UInt>(in);
+  }
+
+  mSnapshotLeftSideVectors.resize(Snapshot::readValue<UInt>(in));
+  for (auto &leftVector : mSnapshotLeftSideVectors)
+    leftVector = Snapshot::readMatrix<Real>(in);
+
+  mRestoreSnapshot = true;
+}
+
+template <typename VarType>
+void MnaSolver<VarType>::checkSnapshotNodeIndices() {
+  if (mSnapshotNodeIndices.size() != mNodes.size())
+    throw SystemError("Number of nodes does not match the snapshot");
+  for (UInt idx = 0; idx < mNodes.size(); ++idx) {
+    if (mNodes[idx]->matrixNodeIndices() != mSnapshotNodeIndices[idx])
+      throw SystemError("Matrix node indices of node " + mNodes[idx]->name() +
+                        " do not match the snapshot");
+  }
+}
+
 template <typename VarType> void MnaSolver<VarType>::assignMatrixNodeIndices() {
   UInt matrixNodeIndexIdx = 0;
   for (UInt idx = 0; idx < mNodes.size(); ++idx) {
@@ -609,8 +758,10 @@ template <typename VarType> Task::List MnaSolver<VarType>::getTasks() {
     }
   }
   if (mFrequencyParallel) {
-    for (UInt i = 0; i < mSystem.mFrequencies.size(); ++i)
-      l.push_back(createSolveTaskHarm(i));
+    for (UInt i = 0; i < mSystem.mFrequencies.size(); ++i) {
+      if (auto task = createSolveTaskHarm(i))
+        l.push_back(task);
+    }
   } else if (mSystemMatrixRecomputation) {
     for (auto comp : this->mMNAIntfVariableComps) {
       for (auto task : comp->mnaTasks())
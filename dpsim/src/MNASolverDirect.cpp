@@ -6,14 +6,31 @@
  * file, You can obtain one at https://mozilla.org/MPL/2.0/.
  *********************************************************************************/
 
+#include <algorithm>
+
 #include <dpsim/MNASolverDirect.h>
 #include <dpsim/SequentialScheduler.h>
+#include <dpsim/Snapshot.h>
 
 using namespace DPsim;
 using namespace CPS;
 
 namespace DPsim {
 
+namespace {
+// True if both compressed matrices have the same pattern and values
+Bool equalMatrices(const SparseMatrix &a, const SparseMatrix &b) {
+  if (a.rows() != b.rows() || a.cols() != b.cols() ||
+      a.nonZeros() != b.nonZeros())
+    return false;
+  return std::equal(a.outerIndexPtr(), a.outerIndexPtr() + a.outerSize() + 1,
+                    b.outerIndexPtr()) &&
+         std::equal(a.innerIndexPtr(), a.innerIndexPtr() + a.nonZeros(),
+                    b.innerIndexPtr()) &&
+         std::equal(a.valuePtr(), a.valuePtr() + a.nonZeros(), b.valuePtr());
+}
+} // namespace
+
 template <typename VarType>
 MnaSolverDirect<VarType>::MnaSolverDirect(String name, CPS::Domain domain,
                                           CPS::Logger::Level logLevel)
@@ -21,9 +38,86 @@ MnaSolverDirect<VarType>::MnaSolverDirect(String name, CPS::Domain domain,
   mImplementationInUse = DirectLinearSolverImpl::KLU;
 }
 
+template <typename VarType> void MnaSolverDirect<VarType>::initializeSystem() {
+  if (!mFrequencyParallel)
+    createSystemMatrixPattern();
+  if (mFrequencyParallel) {
+    // A previous initialization only kept one matrix per frequency group
+    for (auto &it : mSwitchedMatrices) {
+      auto size = it.second[0].rows();
+      it.second.resize(mRightSideVectorHarm.size(), SparseMatrix(size, size));
+    }
+  }
+  MnaSolver<VarType>::initializeSystem();
+  if (mFrequencyParallel)
+    initializeHarmonicGroups();
+}
+
+template <typename VarType>
+void MnaSolverDirect<VarType>::createSystemMatrixPattern() {
+  auto start = std::chrono::steady_clock::now();
+
+  // Entries that are missing in a restored pattern are inserted when the
+  // matrices are stamped
+  if (mSnapshotPattern.rows() == mSwitchedMatrixSize &&
+      mSnapshotPattern.cols() == mSwitchedMatrixSize) {
+    mSystemMatrixPattern = mSnapshotPattern;
+    SPDLOG_LOGGER_INFO(mSLog, "Restored system matrix pattern with {} entries",
+                       mSystemMatrixPattern.nonZeros());
+    return;
+  }
+
+  // Reserve entries for every row, so that inserting an entry does not move
+  // the entries of all following rows
+  mSystemMatrixPattern = SparseMatrix(mSwitchedMatrixSize, mSwitchedMatrixSize);
+  mSystemMatrixPattern.reserve(
+      Eigen::VectorXi::Constant(mSwitchedMatrixSize, 8));
+
+  for (auto comp : mMNAComponents)
+    comp->mnaApplySystemMatrixStamp(mSystemMatrixPattern);
+  for (auto sw : mSwitches) {
+    sw->mnaApplySwitchSystemMatrixStamp(false, mSystemMatrixPattern, 0);
+    sw->mnaApplySwitchSystemMatrixStamp(true, mSystemMatrixPattern, 0);
+  }
+  // Variable elements are only stamped with system matrix recomputation
+  if (mSystemMatrixRecomputation) {
+    for (auto comp : mMNAIntfVariableComps)
+      comp->mnaApplySystemMatrixStamp(mSystemMatrixPattern);
+  }
+
+  mSystemMatrixPattern.makeCompressed();
+  mSystemMatrixPattern.coeffs().setZero();
+
+  std::chrono::duration<Real> diff = std::chrono::steady_clock::now() - start;
+  SPDLOG_LOGGER_INFO(mSLog,
+                     "Created system matrix pattern with {} entries in {} s",
+                     mSystemMatrixPattern.nonZeros(), diff.count());
+}
+
+template <typename VarType>
+void MnaSolverDirect<VarType>::writeSnapshot(std::ostream &out) {
+  MnaSolver<VarType>::writeSnapshot(out);
+  Snapshot::writePattern(out, mSystemMatrixPattern);
+}
+
+template <typename VarType>
+void MnaSolverDirect<VarType>::readSnapshot(std::istream &in) {
+  MnaSolver<VarType>::readSnapshot(in);
+  mSnapshotPattern = Snapshot::readPattern(in);
+}
+
+template <typename VarType>
+void MnaSolverDirect<VarType>::finishSystemMatrixAssembly(
+    SparseMatrix &systemMatrix, std::chrono::steady_clock::time_point start) {
+  // Only required if a component stamped an entry outside of the pattern
+  systemMatrix.makeCompressed();
+  std::chrono::duration<Real> diff = std::chrono::steady_clock::now() - start;
+  mAssemblyTimes.update(diff.count());
+}
+
 template <typename VarType>
 void MnaSolverDirect<VarType>::switchedMatrixEmpty(std::size_t index) {
-  mSwitchedMatrices[std::bitset<SWITCH_NUM>(index)][0].setZero();
+  mSwitchedMatrices[std::bitset<SWITCH_NUM>(index)][0] = mSystemMatrixPattern;
 }
 
 template <typename VarType>
@@ -37,11 +131,13 @@ void MnaSolverDirect<VarType>::switchedMatrixStamp(
     std::size_t index, std::vector<std::shared_ptr<CPS::MNAInterface>> &comp) {
   auto bit = std::bitset<SWITCH_NUM>(index);
   auto &sys = mSwitchedMatrices[bit][0];
+  auto assemblyStart = std::chrono::steady_clock::now();
   for (auto component : comp) {
     component->mnaApplySystemMatrixStamp(sys);
   }
   for (UInt i = 0; i < mSwitches.size(); ++i)
     mSwitches[i]->mnaApplySwitchSystemMatrixStamp(bit[i], sys, 0);
+  finishSystemMatrixAssembly(sys, assemblyStart);
 
   // Compute LU-factorization for system matrix
   mDirectLinearSolvers[bit][0]->preprocessing(sys,
@@ -50,7 +146,420 @@ void MnaSolverDirect<VarType>::switchedMatrixStamp(
   mDirectLinearSolvers[bit][0]->factorize(sys);
   auto end = std::chrono::steady_clock::now();
   std::chrono::duration<Real> diff = end - start;
-  mFactorizeTimes.push_back(diff.count());
+  mFactorizeTimes.update(diff.count());
+}
+
+template <typename VarType>
+void MnaSolverDirect<VarType>::switchedMatrixStamp(
+    std::size_t swIdx, Int freqIdx, CPS::MNAInterface::List &components,
+    CPS::MNASwitchInterface::List &switches) {
+  auto bit = std::bitset<SWITCH_NUM>(swIdx);
+  auto &sys = mSwitchedMatrices[bit][freqIdx];
+  auto assemblyStart = std::chrono::steady_clock::now();
+  for (auto component : components)
+    component->mnaApplySystemMatrixStampHarm(sys, freqIdx);
+  for (UInt i = 0; i < switches.size(); ++i)
+    switches[i]->mnaApplySwitchSystemMatrixStamp(bit[i], sys, freqIdx);
+  // The matrices are factorized once the frequencies are grouped
+  finishSystemMatrixAssembly(sys, assemblyStart);
+}
+
+template <typename VarType>
+void MnaSolverDirect<VarType>::initializeHarmonicGroups() {
+  UInt numFreqs = static_cast<UInt>(mRightSideVectorHarm.size());
+  mHarmonicGroups.clear();
+  mHarmonicGroupOfFrequency.assign(numFreqs, 0);
+
+  // Frequencies can only share a factorization if their matrices are equal
+  // in every switch state
+  for (UInt freq = 0; freq < numFreqs; ++freq) {
+    UInt groupIdx = 0;
+    for (; groupIdx < mHarmonicGroups.size(); ++groupIdx) {
+      UInt first = mHarmonicGroups[groupIdx].frequencies[0];
+      Bool equal = true;
+      for (auto &it : mSwitchedMatrices)
+        equal = equal && equalMatrices(it.second[first], it.second[freq]);
+      if (equal)
+        break;
+    }
+    if (groupIdx == mHarmonicGroups.size())
+      mHarmonicGroups.emplace_back();
+    mHarmonicGroups[groupIdx].frequencies.push_back(freq);
+    mHarmonicGroupOfFrequency[freq] = groupIdx;
+  }
+
+  for (auto &group : mHarmonicGroups) {
+    UInt rows = static_cast<UInt>(mRightSideVectorHarm[0].rows());
+    UInt cols = static_cast<UInt>(group.frequencies.size());
+    group.rightSideVectors = Matrix::Zero(rows, cols);
+    group.leftSideVectors = Matrix::Zero(rows, cols);
+  }
+
+  // Only the matrix of the first frequency of each group is kept
+  std::size_t memory = 0;
+  for (auto &it : mSwitchedMatrices) {
+    std::vector<SparseMatrix> matrices;
+    auto &solvers = mDirectLinearSolvers[it.first];
+    solvers.clear();
+    for (auto &group : mHarmonicGroups) {
+      matrices.push_back(std::move(it.second[group.frequencies[0]]));
+      auto &sys = matrices.back();
+      auto solver = createHarmonicSolverImplementation(sys);
+      solver->preprocessing(sys, mListVariableSystemMatrixEntries);
+      auto start = std::chrono::steady_clock::now();
+      solver->factorize(sys);
+      std::chrono::duration<Real> diff =
+          std::chrono::steady_clock::now() - start;
+      mFactorizeTimes.update(diff.count());
+      memory += solver->memoryUsage();
+      solvers.push_back(solver);
+    }
+    it.second = std::move(matrices);
+  }
+
+  SPDLOG_LOGGER_INFO(mSLog,
+                     "Solving {} frequencies with {} factorizations per "
+                     "switch state, {} bytes",
+                     numFreqs, mHarmonicGroups.size(), memory);
+}
+
+template <typename VarType>
+std::shared_ptr<DirectLinearSolver>
+MnaSolverDirect<VarType>::createHarmonicSolverImplementation(
+    const SparseMatrix &systemMatrix) {
+#ifdef WITH_KLU
+  if (mImplementationInUse == DirectLinearSolverImpl::KLU &&
+      KLUComplexAdapter::isRealForm(systemMatrix))
+    return std::make_shared<KLUComplexAdapter>(mSLog);
+#endif
+  return createDirectSolverImplementation(mSLog);
+}
+
+template <typename VarType>
+void MnaSolverDirect<VarType>::initializeSystemWithPrecomputedMatrices() {
+  if (useLowRankSwitchUpdates()) {
+    initializeLowRankSwitchUpdates();
+    return;
+  }
+  if (!useSwitchStateCache()) {
+    MnaSolver<VarType>::initializeSystemWithPrecomputedMatrices();
+    return;
+  }
+
+  SPDLOG_LOGGER_INFO(mSLog,
+                     "Factorizing switch states on demand, keeping at most {} "
+                     "states in memory",
+                     mSwitchStateCacheSize);
+
+  // Warm up the cache with the states declared by the user
+  for (auto state : mLikelySwitchStates) {
+    if (mSwitches.size() < SWITCH_NUM && (state >> mSwitches.size()) != 0) {
+      SPDLOG_LOGGER_WARN(mSLog, "Ignoring likely switch state {} for {} switches",
+                         state, mSwitches.size());
+      continue;
+    }
+    auto bit = std::bitset<SWITCH_NUM>(state);
+    if (mSwitchStateUsagePos.find(bit) == mSwitchStateUsagePos.end())
+      cacheSwitchState(bit);
+  }
+
+  if (mSwitches.size() > 0)
+    MnaSolver<VarType>::updateSwitchStatus();
+  switchedSolver(mCurrentSwitchStatus);
+
+  this->stampInitialRightSideVector();
+}
+
+template <typename VarType>
+std::shared_ptr<DirectLinearSolver> &
+MnaSolverDirect<VarType>::switchedSolver(
+    const std::bitset<SWITCH_NUM> &state) {
+  if (!useSwitchStateCache())
+    return mDirectLinearSolvers[state][0];
+
+  auto pos = mSwitchStateUsagePos.find(state);
+  if (pos != mSwitchStateUsagePos.end()) {
+    ++mSwitchStateCacheHits;
+    // Move the state to the front of the usage list
+    mSwitchStateUsage.splice(mSwitchStateUsage.begin(), mSwitchStateUsage,
+                             pos->second);
+  } else {
+    ++mSwitchStateCacheMisses;
+    cacheSwitchState(state);
+  }
+  return mDirectLinearSolvers[state][0];
+}
+
+template <typename VarType>
+void MnaSolverDirect<VarType>::cacheSwitchState(
+    const std::bitset<SWITCH_NUM> &state) {
+  SPDLOG_LOGGER_DEBUG(mSLog, "Factorizing system matrix for switch state {:s}",
+                      state.to_string());
+
+  mSwitchedMatrices[state].push_back(mSystemMatrixPattern);
+  mDirectLinearSolvers[state].push_back(
+      createDirectSolverImplementation(mSLog));
+  mSwitchStateUsage.push_front(state);
+  mSwitchStateUsagePos[state] = mSwitchStateUsage.begin();
+
+  switchedMatrixStamp(state.to_ullong(), mMNAComponents);
+  std::size_t memory = switchStateMemory(state);
+  mSwitchStateMemory[state] = memory;
+  mSwitchStateCacheMemoryUsed += memory;
+  evictSwitchStates();
+}
+
+template <typename VarType>
+void MnaSolverDirect<VarType>::evictSwitchStates() {
+  // The most recently used state is never evicted
+  while (mSwitchStateUsage.size() > 1 &&
+         (mSwitchStateUsage.size() > mSwitchStateCacheSize ||
+          (mSwitchStateCacheMemory > 0 &&
+           mSwitchStateCacheMemoryUsed > mSwitchStateCacheMemory))) {
+    auto state = mSwitchStateUsage.back();
+    SPDLOG_LOGGER_DEBUG(mSLog, "Evicting switch state {:s}",
+                        state.to_string());
+    mSwitchStateUsage.pop_back();
+    mSwitchStateUsagePos.erase(state);
+    mSwitchStateCacheMemoryUsed -= mSwitchStateMemory[state];
+    mSwitchStateMemory.erase(state);
+    mSwitchedMatrices.erase(state);
+    mDirectLinearSolvers.erase(state);
+    ++mSwitchStateCacheEvictions;
+  }
+}
+
+template <typename VarType>
+std::size_t MnaSolverDirect<VarType>::switchStateMemory(
+    const std::bitset<SWITCH_NUM> &state) {
+  return mSwitchedMatrices[state][0].nonZeros() *
+             (sizeof(Real) + sizeof(SparseMatrix::StorageIndex)) +
+         mDirectLinearSolvers[state][0]->memoryUsage();
+}
+
+template <typename VarType>
+void MnaSolverDirect<VarType>::initializeLowRankSwitchUpdates() {
+  SPDLOG_LOGGER_INFO(mSLog,
+                     "Applying switch changes as low-rank updates of up to {} "
+                     "rows and columns",
+                     mSwitchUpdateMaxIndices);
+
+  // Initialization can run several times, e.g. after the steady state
+  // initialization
+  finishRebase(true);
+  mSwitchedMatrices.clear();
+  mDirectLinearSolvers.clear();
+
+  MnaSolver<VarType>::updateSwitchStatus();
+  mBaseSwitchState = mCurrentSwitchStatus;
+  mSwitchedMatrices[mBaseSwitchState].push_back(mSystemMatrixPattern);
+  mDirectLinearSolvers[mBaseSwitchState].push_back(
+      createDirectSolverImplementation(mSLog));
+  switchedMatrixStamp(mBaseSwitchState.to_ullong(), mMNAComponents);
+
+  // The difference between both positions of a switch is constant
+  SparseMatrix closed = mSystemMatrixPattern;
+  SparseMatrix open = mSystemMatrixPattern;
+  mSwitchStampDeltas.assign(mSwitches.size(), {});
+  std::vector<UInt> indices;
+  for (UInt i = 0; i < mSwitches.size(); ++i) {
+    closed.coeffs().setZero();
+    open.coeffs().setZero();
+    mSwitches[i]->mnaApplySwitchSystemMatrixStamp(true, closed, 0);
+    mSwitches[i]->mnaApplySwitchSystemMatrixStamp(false, open, 0);
+    SparseMatrix delta = closed - open;
+    for (Int row = 0; row < delta.outerSize(); ++row) {
+      for (SparseMatrix::InnerIterator it(delta, row); it; ++it) {
+        if (it.value() == 0)
+          continue;
+        mSwitchStampDeltas[i].push_back({static_cast<UInt>(it.row()),
+                                         static_cast<UInt>(it.col()),
+                                         it.value()});
+        indices.push_back(static_cast<UInt>(it.row()));
+        indices.push_back(static_cast<UInt>(it.col()));
+      }
+    }
+  }
+  mSwitchCorrectionValid = false;
+
+  // Corrections up to the configured size are computed without allocating
+  // memory. Larger ones only occur while a new base state is factorized.
+  std::sort(indices.begin(), indices.end());
+  UInt maxIndices = static_cast<UInt>(
+      std::unique(indices.begin(), indices.end()) - indices.begin());
+  mCorrectionIndices.clear();
+  mCorrectionIndices.reserve(maxIndices);
+  allocateSwitchCorrection(std::min(maxIndices, mSwitchUpdateMaxIndices));
+
+  this->stampInitialRightSideVector();
+}
+
+template <typename VarType>
+void MnaSolverDirect<VarType>::assembleSwitchedMatrix(
+    const std::bitset<SWITCH_NUM> &state, SparseMatrix &systemMatrix) {
+  auto start = std::chrono::steady_clock::now();
+  systemMatrix = mSystemMatrixPattern;
+  for (auto comp : mMNAComponents)
+    comp->mnaApplySystemMatrixStamp(systemMatrix);
+  for (UInt i = 0; i < mSwitches.size(); ++i)
+    mSwitches[i]->mnaApplySwitchSystemMatrixStamp(state[i], systemMatrix, 0);
+  finishSystemMatrixAssembly(systemMatrix, start);
+}
+
+template <typename VarType>
+void MnaSolverDirect<VarType>::allocateSwitchCorrection(UInt capacity) {
+  mCorrectionCapacity = capacity;
+  mCorrectionDelta = Matrix::Zero(capacity, capacity);
+  mCorrectionBaseSolutions = Matrix::Zero(mSwitchedMatrixSize, capacity);
+  mCorrectionSelected = Matrix::Zero(capacity, capacity);
+  mCorrectionCapacitanceMatrix = Matrix::Identity(capacity, capacity);
+  mCorrectionCapacitance = Eigen::PartialPivLU<Matrix>(capacity);
+  mCorrectionValues = Matrix::Zero(capacity, 1);
+  mCorrectionWeights = Matrix::Zero(capacity, 1);
+  mCorrectionUnitVector = Matrix::Zero(mSwitchedMatrixSize, 1);
+  mCorrectionBaseSolution = Matrix::Zero(mSwitchedMatrixSize, 1);
+}
+
+template <typename VarType>
+void MnaSolverDirect<VarType>::updateSwitchCorrection() {
+  mCorrectedSwitchState = mCurrentSwitchStatus;
+  mSwitchCorrectionValid = true;
+  ++mSwitchCorrections;
+
+  auto changed = mCurrentSwitchStatus ^ mBaseSwitchState;
+  mCorrectionIndices.clear();
+  for (UInt i = 0; i < mSwitches.size(); ++i) {
+    if (!changed[i])
+      continue;
+    for (auto &delta : mSwitchStampDeltas[i]) {
+      mCorrectionIndices.push_back(delta.row);
+      mCorrectionIndices.push_back(delta.col);
+    }
+  }
+  std::sort(mCorrectionIndices.begin(), mCorrectionIndices.end());
+  mCorrectionIndices.erase(
+      std::unique(mCorrectionIndices.begin(), mCorrectionIndices.end()),
+      mCorrectionIndices.end());
+  UInt size = static_cast<UInt>(mCorrectionIndices.size());
+  if (size == 0)
+    return;
+
+  // The corrections become expensive with a growing number of changed
+  // switches, so a new base state is factorized in the background
+  if (size > mSwitchUpdateMaxIndices)
+    startRebase(mCurrentSwitchStatus);
+  if (size > mCorrectionCapacity)
+    allocateSwitchCorrection(size);
+
+  auto position = [this](UInt index) {
+    return std::lower_bound(mCorrectionIndices.begin(),
+                            mCorrectionIndices.end(), index) -
+           mCorrectionIndices.begin();
+  };
+  mCorrectionDelta.setZero();
+  for (UInt i = 0; i < mSwitches.size(); ++i) {
+    if (!changed[i])
+      continue;
+    // Add the difference if the switch was closed, subtract it if it opened
+    Real sign = mCurrentSwitchStatus[i] ? 1. : -1.;
+    for (auto &delta : mSwitchStampDeltas[i])
+      mCorrectionDelta(position(delta.row), position(delta.col)) +=
+          sign * delta.value;
+  }
+
+  // Woodbury identity with U = P, C = delta and V = P^T, where P selects the
+  // changed rows and columns and Z = A^-1 P:
+  // (A + P delta P^T)^-1 = A^-1 - Z (I + delta P^T Z)^-1 delta P^T A^-1
+  // The padded entries of delta and Z are zero, which leaves the padded part
+  // of the capacitance matrix at identity.
+  mCorrectionBaseSolutions.setZero();
+  for (UInt j = 0; j < size; ++j) {
+    mCorrectionUnitVector(mCorrectionIndices[j], 0) = 1;
+    mDirectLinearSolvers[mBaseSwitchState][0]->solve(mCorrectionUnitVector,
+                                                     mCorrectionBaseSolution);
+    mCorrectionUnitVector(mCorrectionIndices[j], 0) = 0;
+    mCorrectionBaseSolutions.col(j) = mCorrectionBaseSolution;
+  }
+
+  for (UInt i = 0; i < size; ++i)
+    mCorrectionSelected.row(i) =
+        mCorrectionBaseSolutions.row(mCorrectionIndices[i]);
+  mCorrectionCapacitanceMatrix.setIdentity();
+  mCorrectionCapacitanceMatrix.noalias() +=
+      mCorrectionDelta * mCorrectionSelected;
+  mCorrectionCapacitance.compute(mCorrectionCapacitanceMatrix);
+  mCorrectionValues.setZero();
+
+  SPDLOG_LOGGER_DEBUG(mSLog,
+                      "Correction of {} rows and columns for switch state "
+                      "{:s}",
+                      size, mCurrentSwitchStatus.to_string());
+}
+
+template <typename VarType>
+void MnaSolverDirect<VarType>::startRebase(
+    const std::bitset<SWITCH_NUM> &state) {
+  // Only one factorization runs at a time, the next state change starts
+  // another one if it is still required
+  if (mRebaseFactorization.valid())
+    return;
+
+  // Components are stamped in this thread, only the factorization runs in
+  // the background
+  mRebaseSwitchState = state;
+  assembleSwitchedMatrix(state, mRebaseMatrix);
+  mRebaseSolver = createDirectSolverImplementation(mSLog);
+  mRebaseFactorization = std::async(std::launch::async, [this]() {
+    std::vector<std::pair<UInt, UInt>> noVariableEntries;
+    mRebaseSolver->preprocessing(mRebaseMatrix, noVariableEntries);
+    mRebaseSolver->factorize(mRebaseMatrix);
+  });
+}
+
+template <typename VarType>
+void MnaSolverDirect<VarType>::finishRebase(Bool wait) {
+  if (!mRebaseFactorization.valid())
+    return;
+  if (!wait && mRebaseFactorization.wait_for(std::chrono::seconds(0)) !=
+                   std::future_status::ready)
+    return;
+  // Rethrows exceptions of the factorization
+  mRebaseFactorization.get();
+
+  mSwitchedMatrices.erase(mBaseSwitchState);
+  mDirectLinearSolvers.erase(mBaseSwitchState);
+  mBaseSwitchState = mRebaseSwitchState;
+  mSwitchedMatrices[mBaseSwitchState] = {std::move(mRebaseMatrix)};
+  mDirectLinearSolvers[mBaseSwitchState] = {std::move(mRebaseSolver)};
+  mRebaseMatrix = SparseMatrix();
+  mSwitchCorrectionValid = false;
+  ++mSwitchRebases;
+}
+
+template <typename VarType>
+void MnaSolverDirect<VarType>::solveSwitchedSystem(
+    const Matrix &rightSideVector, Matrix &leftSideVector) {
+  if (!useLowRankSwitchUpdates()) {
+    switchedSolver(mCurrentSwitchStatus)->solve(rightSideVector,
+                                                leftSideVector);
+    return;
+  }
+
+  finishRebase(false);
+  if (!mSwitchCorrectionValid || mCorrectedSwitchState != mCurrentSwitchStatus)
+    updateSwitchCorrection();
+
+  mDirectLinearSolvers[mBaseSwitchState][0]->solve(rightSideVector,
+                                                   leftSideVector);
+  if (mCorrectionIndices.empty())
+    return;
+
+  // The padded entries of the work vectors stay zero
+  for (UInt i = 0; i < mCorrectionIndices.size(); ++i)
+    mCorrectionValues(i, 0) = leftSideVector(mCorrectionIndices[i], 0);
+  mCorrectionWeights.noalias() = mCorrectionDelta * mCorrectionValues;
+  mCorrectionValues = mCorrectionCapacitance.solve(mCorrectionWeights);
+  leftSideVector.noalias() -= mCorrectionBaseSolutions * mCorrectionValues;
 }
 
 template <typename VarType>
@@ -67,13 +576,16 @@ void MnaSolverDirect<VarType>::stampVariableSystemMatrix() {
                      "\nNumber of MNA components: {}",
                      mVariableComps.size(), mMNAComponents.size());
 
-  // Build base matrix with only static elements
-  mBaseSystemMatrix.setZero();
+  // Build base matrix with only static elements. It already contains the
+  // entries of the switches and variable elements, so that they are stamped
+  // without changing the pattern.
+  auto start = std::chrono::steady_clock::now();
+  mBaseSystemMatrix = mSystemMatrixPattern;
   for (auto statElem : mMNAComponents)
     statElem->mnaApplySystemMatrixStamp(mBaseSystemMatrix);
+  finishSystemMatrixAssembly(mBaseSystemMatrix, start);
   SPDLOG_LOGGER_INFO(mSLog, "Base matrix with only static elements: {}",
-                     Logger::matrixToString(mBaseSystemMatrix));
-  mSLog->flush();
+                     Logger::sparseMatrixToString(mBaseSystemMatrix));
 
   // Continue from base matrix
   mVariableSystemMatrix = mBaseSystemMatrix;
@@ -87,33 +599,29 @@ void MnaSolverDirect<VarType>::stampVariableSystemMatrix() {
   SPDLOG_LOGGER_INFO(mSLog, "Stamping variable elements");
   for (auto varElem : mMNAIntfVariableComps)
     varElem->mnaApplySystemMatrixStamp(mVariableSystemMatrix);
+  mVariableSystemMatrix.makeCompressed();
+  initializeVariableStamps();
 
   SPDLOG_LOGGER_INFO(mSLog, "Initial system matrix with variable elements {}",
-                     Logger::matrixToString(mVariableSystemMatrix));
-  /* TODO: find replacement for flush() */
-  mSLog->flush();
+                     Logger::sparseMatrixToString(mVariableSystemMatrix));
 
   // Calculate factorization of current matrix
   mDirectLinearSolverVariableSystemMatrix->preprocessing(
       mVariableSystemMatrix, mListVariableSystemMatrixEntries);
 
-  auto start = std::chrono::steady_clock::now();
+  start = std::chrono::steady_clock::now();
   mDirectLinearSolverVariableSystemMatrix->factorize(mVariableSystemMatrix);
   auto end = std::chrono::steady_clock::now();
   std::chrono::duration<Real> diff = end - start;
-  mFactorizeTimes.push_back(diff.count());
+  mFactorizeTimes.update(diff.count());
 }
 
 template <typename VarType>
 void MnaSolverDirect<VarType>::solveWithSystemMatrixRecomputation(
     Real time, Int timeStepCount) {
-  // Reset source vector
-  mRightSideVector.setZero();
-
   // Add together the right side vector (computed by the components'
   // pre-step tasks)
-  for (auto stamp : mRightVectorStamps)
-    mRightSideVector += *stamp;
+  sumRightVectorStamps();
 
   // Get switch and variable comp status and update system matrix and lu factorization accordingly
   if (hasVariableComponentChanged())
@@ -121,11 +629,11 @@ void MnaSolverDirect<VarType>::solveWithSystemMatrixRecomputation(
 
   // Calculate new solution vector
   auto start = std::chrono::steady_clock::now();
-  **mLeftSideVector =
-      mDirectLinearSolverVariableSystemMatrix->solve(mRightSideVector);
+  mDirectLinearSolverVariableSystemMatrix->solve(mRightSideVector,
+                                                 **mLeftSideVector);
   auto end = std::chrono::steady_clock::now();
   std::chrono::duration<Real> diff = end - start;
-  mSolveTimes.push_back(diff.count());
+  mSolveTimes.update(diff.count());
 
   // TODO split into separate task? (dependent on x, updating all v attributes)
   for (UInt nodeIdx = 0; nodeIdx < mNumNetNodes; ++nodeIdx)
@@ -136,16 +644,27 @@ void MnaSolverDirect<VarType>::solveWithSystemMatrixRecomputation(
 
 template <typename VarType>
 void MnaSolverDirect<VarType>::recomputeSystemMatrix(Real time) {
-  // Start from base matrix
-  mVariableSystemMatrix = mBaseSystemMatrix;
-
-  // Now stamp switches into matrix
-  for (auto sw : mMNAIntfSwitches)
-    sw->mnaApplySystemMatrixStamp(mVariableSystemMatrix);
-
-  // Now stamp variable elements into matrix
-  for (auto comp : mMNAIntfVariableComps)
-    comp->mnaApplySystemMatrixStamp(mVariableSystemMatrix);
+  auto assemblyStart = std::chrono::steady_clock::now();
+
+  if (!mVariableStampsValid || !restampChangedVariableElements()) {
+    // Start from base matrix. Both matrices share the same pattern unless a
+    // component stamped an entry outside of it, then only the values differ.
+    if (mVariableSystemMatrix.nonZeros() == mBaseSystemMatrix.nonZeros())
+      mVariableSystemMatrix.coeffs() = mBaseSystemMatrix.coeffs();
+    else
+      mVariableSystemMatrix = mBaseSystemMatrix;
+
+    // Now stamp switches into matrix
+    for (auto sw : mMNAIntfSwitches)
+      sw->mnaApplySystemMatrixStamp(mVariableSystemMatrix);
+
+    // Now stamp variable elements into matrix
+    for (auto comp : mMNAIntfVariableComps)
+      comp->mnaApplySystemMatrixStamp(mVariableSystemMatrix);
+    mVariableSystemMatrix.makeCompressed();
+    initializeVariableStamps();
+  }
+  finishSystemMatrixAssembly(mVariableSystemMatrix, assemblyStart);
 
   // Refactorization of matrix assuming that structure remained
   // constant by omitting analyzePattern
@@ -154,24 +673,209 @@ void MnaSolverDirect<VarType>::recomputeSystemMatrix(Real time) {
       mVariableSystemMatrix, mListVariableSystemMatrixEntries);
   auto end = std::chrono::steady_clock::now();
   std::chrono::duration<Real> diff = end - start;
-  mRecomputationTimes.push_back(diff.count());
+  mRecomputationTimes.update(diff.count());
   ++mNumRecomputations;
 }
 
+template <typename VarType>
+void MnaSolverDirect<VarType>::initializeVariableStamps() {
+  mVariableStamps.clear();
+  mVariableEntries.clear();
+  mChangedVariableEntries.clear();
+  mVariableStampsValid = false;
+
+  // Values can only be written in place if the variable elements did not add
+  // entries to the pattern of the base matrix
+  if (mVariableSystemMatrix.nonZeros() != mBaseSystemMatrix.nonZeros())
+    return;
+
+  // Switches that are also variable elements are stamped once
+  std::unordered_map<CPS::MNAInterface *, UInt> stampIndices;
+  for (auto comp : mMNAIntfSwitches) {
+    VariableStamp stamp;
+    stamp.comp = comp;
+    stamp.sw = std::dynamic_pointer_cast<CPS::MNASwitchInterface>(comp);
+    stampIndices[comp.get()] = static_cast<UInt>(mVariableStamps.size());
+    mVariableStamps.push_back(std::move(stamp));
+  }
+  for (UInt i = 0; i < mVariableComps.size(); ++i) {
+    auto comp = std::dynamic_pointer_cast<CPS::MNAInterface>(mVariableComps[i]);
+    if (!comp)
+      continue;
+    auto it = stampIndices.find(comp.get());
+    if (it != stampIndices.end()) {
+      mVariableStamps[it->second].variableIdx = static_cast<Int>(i);
+    } else {
+      VariableStamp stamp;
+      stamp.comp = comp;
+      stamp.variableIdx = static_cast<Int>(i);
+      mVariableStamps.push_back(std::move(stamp));
+    }
+  }
+
+  mVariableStampMatrix = mBaseSystemMatrix;
+  const Int *outer = mVariableStampMatrix.outerIndexPtr();
+  const Int *inner = mVariableStampMatrix.innerIndexPtr();
+  auto valueIndex = [outer, inner](UInt row, UInt col) -> Int {
+    const Int *begin = inner + outer[row];
+    const Int *end = inner + outer[row + 1];
+    const Int *it = std::lower_bound(begin, end, static_cast<Int>(col));
+    return (it != end && *it == static_cast<Int>(col))
+               ? static_cast<Int>(it - inner)
+               : -1;
+  };
+
+  // The values an element writes to are the nonzeros after stamping both
+  // switch positions and the current state, together with the entries the
+  // element declares as variable
+  std::unordered_map<UInt, UInt> entryIndices;
+  for (UInt s = 0; s < mVariableStamps.size(); ++s) {
+    auto &stamp = mVariableStamps[s];
+    mVariableStampMatrix.coeffs().setZero();
+    if (stamp.sw) {
+      stamp.sw->mnaApplySwitchSystemMatrixStamp(false, mVariableStampMatrix, 0);
+      stamp.sw->mnaApplySwitchSystemMatrixStamp(true, mVariableStampMatrix, 0);
+    }
+    stamp.comp->mnaApplySystemMatrixStamp(mVariableStampMatrix);
+    if (!mVariableStampMatrix.isCompressed())
+      return;
+
+    std::vector<UInt> values;
+    const Real *stampValues = mVariableStampMatrix.valuePtr();
+    for (Int k = 0; k < mVariableStampMatrix.nonZeros(); ++k) {
+      if (stampValues[k] != 0)
+        values.push_back(static_cast<UInt>(k));
+    }
+    if (stamp.variableIdx >= 0) {
+      for (auto &entry :
+           mVariableComps[stamp.variableIdx]->mVariableSystemMatrixEntries) {
+        Int k = valueIndex(entry.first, entry.second);
+        if (k >= 0)
+          values.push_back(static_cast<UInt>(k));
+      }
+    }
+    std::sort(values.begin(), values.end());
+    values.erase(std::unique(values.begin(), values.end()), values.end());
+
+    // Without values, the rows of the element are unknown and the whole
+    // matrix is checked
+    if (values.empty())
+      stamp.checkedRows.emplace_back(
+          0, static_cast<UInt>(mVariableStampMatrix.nonZeros()));
+    for (UInt valueIdx : values) {
+      const Int *row = std::upper_bound(
+          outer, outer + mVariableStampMatrix.outerSize(),
+          static_cast<Int>(valueIdx));
+      std::pair<UInt, UInt> range(static_cast<UInt>(row[-1]),
+                                  static_cast<UInt>(row[0]));
+      if (stamp.checkedRows.empty() || stamp.checkedRows.back() != range)
+        stamp.checkedRows.push_back(range);
+    }
+
+    for (UInt valueIdx : values) {
+      auto res = entryIndices.emplace(
+          valueIdx, static_cast<UInt>(mVariableEntries.size()));
+      if (res.second)
+        mVariableEntries.push_back({valueIdx, {}});
+      mVariableEntries[res.first->second].stamps.emplace_back(
+          s, static_cast<UInt>(stamp.entries.size()));
+      stamp.entries.push_back(res.first->second);
+    }
+    stamp.values.assign(stamp.entries.size(), 0);
+  }
+
+  mVariableEntryChanged.assign(mVariableEntries.size(), false);
+  mVariableStampMatrix.coeffs().setZero();
+  for (auto &stamp : mVariableStamps) {
+    if (!restampVariableElement(stamp))
+      return;
+  }
+  // The variable system matrix already contains these values
+  for (UInt entry : mChangedVariableEntries)
+    mVariableEntryChanged[entry] = false;
+  mChangedVariableEntries.clear();
+
+  mVariableStampsValid = true;
+  SPDLOG_LOGGER_DEBUG(mSLog, "{} switches and variable elements write to {} "
+                      "values of the system matrix",
+                      mVariableStamps.size(), mVariableEntries.size());
+}
+
+template <typename VarType>
+Bool MnaSolverDirect<VarType>::restampVariableElement(VariableStamp &stamp) {
+  stamp.comp->mnaApplySystemMatrixStamp(mVariableStampMatrix);
+  if (!mVariableStampMatrix.isCompressed())
+    return false;
+
+  // Take the values out of the stamp matrix, so that only values written
+  // outside of the entries remain
+  Real *values = mVariableStampMatrix.valuePtr();
+  for (UInt i = 0; i < stamp.entries.size(); ++i) {
+    UInt entry = stamp.entries[i];
+    UInt valueIdx = mVariableEntries[entry].valueIdx;
+    stamp.values[i] = values[valueIdx];
+    values[valueIdx] = 0;
+    if (!mVariableEntryChanged[entry]) {
+      mVariableEntryChanged[entry] = true;
+      mChangedVariableEntries.push_back(entry);
+    }
+  }
+  for (auto &row : stamp.checkedRows) {
+    for (UInt k = row.first; k < row.second; ++k) {
+      if (values[k] != 0) {
+        SPDLOG_LOGGER_DEBUG(mSLog, "Variable element wrote to a value that "
+                                   "was zero during initialization");
+        return false;
+      }
+    }
+  }
+  if (stamp.sw)
+    stamp.closed = stamp.sw->mnaIsClosed();
+  return true;
+}
+
+template <typename VarType>
+Bool MnaSolverDirect<VarType>::restampChangedVariableElements() {
+  for (auto &stamp : mVariableStamps) {
+    Bool changed =
+        (stamp.variableIdx >= 0 && static_cast<UInt>(stamp.variableIdx) >=
+                                       mFirstChangedVariableComp) ||
+        (stamp.sw && stamp.sw->mnaIsClosed() != stamp.closed);
+    if (changed && !restampVariableElement(stamp))
+      return false;
+  }
+
+  // Write the sum of the base value and all stamps to the changed values
+  const Real *base = mBaseSystemMatrix.valuePtr();
+  Real *values = mVariableSystemMatrix.valuePtr();
+  for (UInt entryIdx : mChangedVariableEntries) {
+    auto &entry = mVariableEntries[entryIdx];
+    Real value = base[entry.valueIdx];
+    for (auto &stamp : entry.stamps)
+      value += mVariableStamps[stamp.first].values[stamp.second];
+    values[entry.valueIdx] = value;
+    mVariableEntryChanged[entryIdx] = false;
+  }
+  mChangedVariableEntries.clear();
+  return true;
+}
+
 template <> void MnaSolverDirect<Real>::createEmptySystemMatrix() {
   if (mSwitches.size() > SWITCH_NUM)
     throw SystemError("Too many Switches.");
 
+  mSwitchedMatrixSize = mNumMatrixNodeIndices;
   if (mSystemMatrixRecomputation) {
-    mBaseSystemMatrix =
-        SparseMatrix(mNumMatrixNodeIndices, mNumMatrixNodeIndices);
+    mBaseSystemMatrix = SparseMatrix(mSwitchedMatrixSize, mSwitchedMatrixSize);
     mVariableSystemMatrix =
-        SparseMatrix(mNumMatrixNodeIndices, mNumMatrixNodeIndices);
-  } else {
+        SparseMatrix(mSwitchedMatrixSize, mSwitchedMatrixSize);
+  } else if (!useSwitchStateCache() && !useLowRankSwitchUpdates()) {
+    // With the cache or low-rank updates, matrices are created when a switch
+    // state is factorized
     for (std::size_t i = 0; i < (1ULL << mSwitches.size()); i++) {
       auto bit = std::bitset<SWITCH_NUM>(i);
       mSwitchedMatrices[bit].push_back(
-          SparseMatrix(mNumMatrixNodeIndices, mNumMatrixNodeIndices));
+          SparseMatrix(mSwitchedMatrixSize, mSwitchedMatrixSize));
       mDirectLinearSolvers[bit].push_back(
           createDirectSolverImplementation(mSLog));
     }
@@ -183,25 +887,29 @@ template <> void MnaSolverDirect<Complex>::createEmptySystemMatrix() {
     throw SystemError("Too many Switches.");
 
   if (mFrequencyParallel) {
+    // The solvers are created by initializeHarmonicGroups
     for (UInt i = 0; i < std::pow(2, mSwitches.size()); ++i) {
       for (Int freq = 0; freq < mSystem.mFrequencies.size(); ++freq) {
         auto bit = std::bitset<SWITCH_NUM>(i);
         mSwitchedMatrices[bit].push_back(SparseMatrix(
             2 * (mNumMatrixNodeIndices), 2 * (mNumMatrixNodeIndices)));
-        mDirectLinearSolvers[bit].push_back(
-            createDirectSolverImplementation(mSLog));
       }
     }
   } else if (mSystemMatrixRecomputation) {
-    mBaseSystemMatrix =
-        SparseMatrix(2 * (mNumMatrixNodeIndices), 2 * (mNumMatrixNodeIndices));
+    mSwitchedMatrixSize = 2 * (mNumMatrixNodeIndices);
+    mBaseSystemMatrix = SparseMatrix(mSwitchedMatrixSize, mSwitchedMatrixSize);
     mVariableSystemMatrix =
-        SparseMatrix(2 * (mNumMatrixNodeIndices), 2 * (mNumMatrixNodeIndices));
+        SparseMatrix(mSwitchedMatrixSize, mSwitchedMatrixSize);
   } else {
+    mSwitchedMatrixSize = 2 * (mNumTotalMatrixNodeIndices);
+    // With the cache or low-rank updates, matrices are created when a switch
+    // state is factorized
+    if (useSwitchStateCache() || useLowRankSwitchUpdates())
+      return;
     for (std::size_t i = 0; i < (1ULL << mSwitches.size()); i++) {
       auto bit = std::bitset<SWITCH_NUM>(i);
-      mSwitchedMatrices[bit].push_back(SparseMatrix(
-          2 * (mNumTotalMatrixNodeIndices), 2 * (mNumTotalMatrixNodeIndices)));
+      mSwitchedMatrices[bit].push_back(
+          SparseMatrix(mSwitchedMatrixSize, mSwitchedMatrixSize));
       mDirectLinearSolvers[bit].push_back(
           createDirectSolverImplementation(mSLog));
     }
@@ -221,6 +929,10 @@ std::shared_ptr<CPS::Task> MnaSolverDirect<VarType>::createSolveTaskRecomp() {
 template <typename VarType>
 std::shared_ptr<CPS::Task>
 MnaSolverDirect<VarType>::createSolveTaskHarm(UInt freqIdx) {
+  // One task solves all frequencies of a group
+  auto &group = mHarmonicGroups[mHarmonicGroupOfFrequency[freqIdx]];
+  if (group.frequencies[0] != freqIdx)
+    return nullptr;
   return std::make_shared<MnaSolverDirect<VarType>::SolveTaskHarm>(*this,
                                                                    freqIdx);
 }
@@ -232,12 +944,8 @@ std::shared_ptr<CPS::Task> MnaSolverDirect<VarType>::createLogTask() {
 
 template <typename VarType>
 void MnaSolverDirect<VarType>::solve(Real time, Int timeStepCount) {
-  // Reset source vector
-  mRightSideVector.setZero();
-
   // Add together the right side vector (computed by the components' pre-step tasks)
-  for (auto stamp : mRightVectorStamps)
-    mRightSideVector += *stamp;
+  sumRightVectorStamps();
 
   if (!mIsInInitialization)
     MnaSolver<VarType>::updateSwitchStatus();
@@ -247,13 +955,12 @@ void MnaSolverDirect<VarType>::solve(Real time, Int timeStepCount) {
     if (Solver::mLogSolveTimes)
       start = std::chrono::steady_clock::now();
 
-    **mLeftSideVector =
-        mDirectLinearSolvers[mCurrentSwitchStatus][0]->solve(mRightSideVector);
+    solveSwitchedSystem(mRightSideVector, **mLeftSideVector);
 
     if (Solver::mLogSolveTimes) {
       auto end = std::chrono::steady_clock::now();
       std::chrono::duration<Real> diff = end - start;
-      mSolveTimes.push_back(diff.count());
+      mSolveTimes.update(diff.count());
     }
   }
 
@@ -279,9 +986,6 @@ void MnaSolverDirect<VarType>::solve(Real time, Int timeStepCount) {
       if (numCompsRequireIter > 0) {
         mIter++;
 
-        // Reset source vector
-        mRightSideVector.setZero();
-
         if (!mIsInInitialization)
           MnaSolver<VarType>::updateSwitchStatus();
 
@@ -289,17 +993,14 @@ void MnaSolverDirect<VarType>::solve(Real time, Int timeStepCount) {
           syncGen->correctorStep();
 
         // Add together the right side vector (computed by the components' pre-step tasks)
-        for (auto stamp : mRightVectorStamps)
-          mRightSideVector += *stamp;
+        sumRightVectorStamps();
 
         if (mSwitchedMatrices.size() > 0) {
           auto start = std::chrono::steady_clock::now();
-          **mLeftSideVector =
-              mDirectLinearSolvers[mCurrentSwitchStatus][0]->solve(
-                  mRightSideVector);
+          solveSwitchedSystem(mRightSideVector, **mLeftSideVector);
           auto end = std::chrono::steady_clock::now();
           std::chrono::duration<Real> diff = end - start;
-          mSolveTimes.push_back(diff.count());
+          mSolveTimes.update(diff.count());
         }
 
         // CHECK: Is this really required? Or can operations actually become part of
@@ -320,23 +1021,42 @@ void MnaSolverDirect<VarType>::solve(Real time, Int timeStepCount) {
 template <typename VarType>
 void MnaSolverDirect<VarType>::solveWithHarmonics(Real time, Int timeStepCount,
                                                   Int freqIdx) {
-  mRightSideVectorHarm[freqIdx].setZero();
+  UInt groupIdx = mHarmonicGroupOfFrequency[freqIdx];
+  auto &group = mHarmonicGroups[groupIdx];
+  auto &solver = mDirectLinearSolvers[mCurrentSwitchStatus][groupIdx];
 
   // Sum of right side vectors (computed by the components' pre-step tasks)
-  for (auto stamp : mRightVectorStamps)
-    mRightSideVectorHarm[freqIdx] += stamp->col(freqIdx);
+  for (auto freq : group.frequencies) {
+    mRightSideVectorHarm[freq].setZero();
+    for (auto stamp : mRightVectorStamps)
+      mRightSideVectorHarm[freq] += stamp->col(freq);
+  }
 
-  **mLeftSideVectorHarm[freqIdx] =
-      mDirectLinearSolvers[mCurrentSwitchStatus][freqIdx]->solve(
-          mRightSideVectorHarm[freqIdx]);
+  if (group.frequencies.size() == 1) {
+    solver->solve(mRightSideVectorHarm[freqIdx],
+                  **mLeftSideVectorHarm[freqIdx]);
+    return;
+  }
+
+  // All frequencies of the group are solved with one multi-column solve
+  for (UInt col = 0; col < group.frequencies.size(); ++col)
+    group.rightSideVectors.col(col) =
+        mRightSideVectorHarm[group.frequencies[col]];
+  solver->solve(group.rightSideVectors, group.leftSideVectors);
+  for (UInt col = 0; col < group.frequencies.size(); ++col)
+    **mLeftSideVectorHarm[group.frequencies[col]] =
+        group.leftSideVectors.col(col);
 }
 
 template <typename VarType> void MnaSolverDirect<VarType>::logSystemMatrices() {
   if (mFrequencyParallel) {
-    for (UInt i = 0; i < mSwitchedMatrices[std::bitset<SWITCH_NUM>(0)].size();
-         ++i) {
-      SPDLOG_LOGGER_INFO(mSLog, "System matrix for frequency: {:d} \n{:s}", i,
-                         Logger::matrixToString(
+    for (UInt i = 0; i < mHarmonicGroups.size(); ++i) {
+      SPDLOG_LOGGER_INFO(mSLog,
+                         "System matrix for {:d} frequencies starting at "
+                         "frequency: {:d} \n{:s}",
+                         mHarmonicGroups[i].frequencies.size(),
+                         mHarmonicGroups[i].frequencies[0],
+                         Logger::sparseMatrixToString(
                              mSwitchedMatrices[std::bitset<SWITCH_NUM>(0)][i]));
     }
 
@@ -348,15 +1068,16 @@ template <typename VarType> void MnaSolverDirect<VarType>::logSystemMatrices() {
   } else if (mSystemMatrixRecomputation) {
     SPDLOG_LOGGER_INFO(mSLog, "Summarizing matrices: ");
     SPDLOG_LOGGER_INFO(mSLog, "Base matrix with only static elements: {}",
-                       Logger::matrixToString(mBaseSystemMatrix));
+                       Logger::sparseMatrixToString(mBaseSystemMatrix));
     SPDLOG_LOGGER_INFO(mSLog, "Initial system matrix with variable elements {}",
-                       Logger::matrixToString(mVariableSystemMatrix));
+                       Logger::sparseMatrixToString(mVariableSystemMatrix));
     SPDLOG_LOGGER_INFO(mSLog, "Right side vector: {}",
                        Logger::matrixToString(mRightSideVector));
   } else {
     if (mSwitches.size() < 1) {
       SPDLOG_LOGGER_INFO(mSLog, "System matrix: \n{}",
-                         mSwitchedMatrices[std::bitset<SWITCH_NUM>(0)][0]);
+                         Logger::sparseMatrixToString(
+                             mSwitchedMatrices[std::bitset<SWITCH_NUM>(0)][0]));
     } else {
       SPDLOG_LOGGER_INFO(mSLog, "Initial switch status: {:s}",
                          mCurrentSwitchStatus.to_string());
@@ -364,7 +1085,7 @@ template <typename VarType> void MnaSolverDirect<VarType>::logSystemMatrices() {
       for (auto sys : mSwitchedMatrices) {
         SPDLOG_LOGGER_INFO(mSLog, "Switching System matrix {:s} \n{:s}",
                            sys.first.to_string(),
-                           Logger::matrixToString(sys.second[0]));
+                           Logger::sparseMatrixToString(sys.second[0]));
       }
     }
     SPDLOG_LOGGER_INFO(mSLog, "Right side vector: \n{}", mRightSideVector);
@@ -372,53 +1093,69 @@ template <typename VarType> void MnaSolverDirect<VarType>::logSystemMatrices() {
 }
 
 template <typename VarType> void MnaSolverDirect<VarType>::logLUTimes() {
+  logAssemblyTime();
   logFactorizationTime();
   logRecomputationTime();
   logSolveTime();
+  if (useSwitchStateCache())
+    logSwitchStateCache();
+  if (useLowRankSwitchUpdates())
+    logLowRankSwitchUpdates();
+}
+
+template <typename VarType>
+void MnaSolverDirect<VarType>::logSwitchStateCache() {
+  SPDLOG_LOGGER_INFO(mSLog, "Switch state cache hits: {:d}",
+                     mSwitchStateCacheHits);
+  SPDLOG_LOGGER_INFO(mSLog, "Switch state cache misses: {:d}",
+                     mSwitchStateCacheMisses);
+  SPDLOG_LOGGER_INFO(mSLog, "Switch state cache evictions: {:d}",
+                     mSwitchStateCacheEvictions);
+  SPDLOG_LOGGER_INFO(mSLog, "Cached switch states: {:d}, {:d} bytes",
+                     mSwitchStateUsage.size(), mSwitchStateCacheMemoryUsed);
+}
+
+template <typename VarType>
+Solver::SwitchStateCacheStatistics
+MnaSolverDirect<VarType>::switchStateCacheStatistics() const {
+  Solver::SwitchStateCacheStatistics statistics;
+  statistics.hits = mSwitchStateCacheHits;
+  statistics.misses = mSwitchStateCacheMisses;
+  statistics.evictions = mSwitchStateCacheEvictions;
+  statistics.states = static_cast<UInt>(mSwitchStateUsage.size());
+  statistics.memory = mSwitchStateCacheMemoryUsed;
+  return statistics;
+}
+
+template <typename VarType>
+void MnaSolverDirect<VarType>::logLowRankSwitchUpdates() {
+  SPDLOG_LOGGER_INFO(mSLog, "Low-rank switch corrections: {:d}",
+                     mSwitchCorrections);
+  SPDLOG_LOGGER_INFO(mSLog, "Switch base state refactorizations: {:d}",
+                     mSwitchRebases);
 }
 
 template <typename VarType> void MnaSolverDirect<VarType>::logSolveTime() {
-  Real solveSum = 0.0;
-  Real solveMax = 0.0;
-  for (auto meas : mSolveTimes) {
-    solveSum += meas;
-    if (meas > solveMax)
-      solveMax = meas;
-  }
-  SPDLOG_LOGGER_INFO(mSLog, "Cumulative solve times: {:.12f}", solveSum);
-  SPDLOG_LOGGER_INFO(mSLog, "Average solve time: {:.12f}",
-                     solveSum / static_cast<double>(mSolveTimes.size()));
-  SPDLOG_LOGGER_INFO(mSLog, "Maximum solve time: {:.12f}", solveMax);
-  SPDLOG_LOGGER_INFO(mSLog, "Number of solves: {:d}", mSolveTimes.size());
+  mSolveTimes.logSummary(mSLog, "solve");
+  // Not measured when the frequencies are solved in parallel
+  if (mRightVectorTimes.count() != 0)
+    mRightVectorTimes.logSummary(mSLog, "right side vector assembly");
+}
+
+template <typename VarType> void MnaSolverDirect<VarType>::logAssemblyTime() {
+  mAssemblyTimes.logSummary(mSLog, "system matrix assembly");
 }
 
 template <typename VarType>
 void MnaSolverDirect<VarType>::logFactorizationTime() {
-  for (auto meas : mFactorizeTimes) {
-    SPDLOG_LOGGER_INFO(mSLog, "LU factorization time: {:.12f}", meas);
-  }
+  mFactorizeTimes.logSummary(mSLog, "LU factorization");
 }
 
 template <typename VarType>
 void MnaSolverDirect<VarType>::logRecomputationTime() {
-  Real recompSum = 0.0;
-  Real recompMax = 0.0;
-  for (auto meas : mRecomputationTimes) {
-    recompSum += meas;
-    if (meas > recompMax)
-      recompMax = meas;
-  }
   // Sometimes, refactorization is not used
-  if (mRecomputationTimes.size() != 0) {
-    SPDLOG_LOGGER_INFO(mSLog, "Cumulative refactorization times: {:.12f}",
-                       recompSum);
-    SPDLOG_LOGGER_INFO(mSLog, "Average refactorization time: {:.12f}",
-                       recompSum / ((double)mRecomputationTimes.size()));
-    SPDLOG_LOGGER_INFO(mSLog, "Maximum refactorization time: {:.12f}",
-                       recompMax);
-    SPDLOG_LOGGER_INFO(mSLog, "Number of refactorizations: {:d}",
-                       mRecomputationTimes.size());
-  }
+  if (mRecomputationTimes.count() != 0)
+    mRecomputationTimes.logSummary(mSLog, "refactorization");
 }
 
 template <typename VarType>
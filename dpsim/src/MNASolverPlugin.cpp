@@ -40,8 +40,13 @@ extern "C" void pluginLogger(const char *str) {
 
 template <typename VarType>
 void MnaSolverPlugin<VarType>::recomputeSystemMatrix(Real time) {
-  // Start from base matrix
-  this->mVariableSystemMatrix = this->mBaseSystemMatrix;
+  // Start from base matrix, which has the same pattern
+  auto assemblyStart = std::chrono::steady_clock::now();
+  if (this->mVariableSystemMatrix.nonZeros() ==
+      this->mBaseSystemMatrix.nonZeros())
+    this->mVariableSystemMatrix.coeffs() = this->mBaseSystemMatrix.coeffs();
+  else
+    this->mVariableSystemMatrix = this->mBaseSystemMatrix;
 
   // Now stamp switches into matrix
   for (auto sw : this->mMNAIntfSwitches)
@@ -50,6 +55,7 @@ void MnaSolverPlugin<VarType>::recomputeSystemMatrix(Real time) {
   // Now stamp variable elements into matrix
   for (auto comp : this->mMNAIntfVariableComps)
     comp->mnaApplySystemMatrixStamp(this->mVariableSystemMatrix);
+  this->finishSystemMatrixAssembly(this->mVariableSystemMatrix, assemblyStart);
 
   int size = this->mRightSideVector.rows();
   int nnz = this->mVariableSystemMatrix.nonZeros();
@@ -147,13 +153,9 @@ template <typename VarType> Task::List MnaSolverPlugin<VarType>::getTasks() {
 
 template <typename VarType>
 void MnaSolverPlugin<VarType>::solve(Real time, Int timeStepCount) {
-  // Reset source vector
-  this->mRightSideVector.setZero();
-
   // Add together the right side vector (computed by the components'
   // pre-step tasks)
-  for (const auto &stamp : this->mRightVectorStamps)
-    this->mRightSideVector += *stamp;
+  this->sumRightVectorStamps();
 
   if (!this->mIsInInitialization)
     this->updateSwitchStatus();
@@ -0,0 +1,58 @@
+/* Copyright 2017-2024 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <dpsim/MemoryDataLogger.h>
+
+using namespace DPsim;
+
+MemoryDataLogger::MemoryDataLogger(String name, UInt rows, UInt downsampling)
+    : mName(name), mDownsampling(downsampling > 0 ? downsampling : 1),
+      mCapacity(rows) {}
+
+MemoryDataLogger::MemoryDataLogger(String name, Real finalTime, Real timeStep,
+                                   UInt downsampling)
+    : mName(name), mDownsampling(downsampling > 0 ? downsampling : 1),
+      // One additional row for the initial values at t=0
+      mCapacity(static_cast<UInt>(finalTime / timeStep + 0.5) / mDownsampling +
+                1) {}
+
+void MemoryDataLogger::start() {
+  compileExportPlan(mExportPlan);
+  mData.assign(static_cast<size_t>(mCapacity) * columns(), 0);
+  clear();
+}
+
+void MemoryDataLogger::log(Real time, Int timeStepCount) {
+  if (timeStepCount % mDownsampling != 0)
+    return;
+
+  if (mRows >= mCapacity) {
+    ++mOverruns;
+    return;
+  }
+
+  Real *row = mData.data() + static_cast<size_t>(mRows) * columns();
+  row[0] = time;
+  mExportPlan.gather(row + 1);
+  ++mRows;
+}
+
+std::vector<String> MemoryDataLogger::columnNames() const {
+  std::vector<String> names{"time"};
+  for (auto &it : mAttributes)
+    names.push_back(it.first);
+  return names;
+}
+
+void MemoryDataLogger::Step::execute(Real time, Int timeStepCount) {
+  mLogger.log(time, timeStepCount);
+}
+
+CPS::Task::Ptr MemoryDataLogger::getTask() {
+  return std::make_shared<MemoryDataLogger::Step>(*this);
+}
@@ -14,7 +14,10 @@ using namespace DPsim;
 ODESolver::ODESolver(String name, const CPS::ODEInterface::Ptr &comp,
                      bool implicit_integration, Real timestep)
     : Solver(name, CPS::Logger::Level::info), mComponent(comp),
-      mImplicitIntegration(implicit_integration), mTimestep(timestep) {
+      mImplicitIntegration(implicit_integration), mTimestep(timestep),
+      mInternalSteps(CPS::AttributeStatic<Int>::make(0)),
+      mErrorTestFails(CPS::AttributeStatic<Int>::make(0)),
+      mReInitCount(CPS::AttributeStatic<Int>::make(0)) {
   mProbDim = mComponent->mOdePreState->get().rows();
   initialize();
 }
@@ -37,61 +40,23 @@ void ODESolver::initialize() {
                          double tmp1[], double tmp2[], double tmp3[]) {
     dummy->odeJacobian(t, y, fy, J, tmp1, tmp2, tmp3);
   };
-}
-
-int ODESolver::StateSpaceWrapper(realtype t, N_Vector y, N_Vector ydot,
-                                 void *user_data) {
-  ODESolver *self = reinterpret_cast<ODESolver *>(user_data);
-  return self->StateSpace(t, y, ydot);
-}
-
-int ODESolver::StateSpace(realtype t, N_Vector y, N_Vector ydot) {
-  mStSpFunction(t, NV_DATA_S(y), NV_DATA_S(ydot));
-  return 0;
-}
-
-int ODESolver::JacobianWrapper(realtype t, N_Vector y, N_Vector fy, SUNMatrix J,
-                               void *user_data, N_Vector tmp1, N_Vector tmp2,
-                               N_Vector tmp3) {
-  ODESolver *self = reinterpret_cast<ODESolver *>(user_data);
-  return self->Jacobian(t, y, fy, J, tmp1, tmp2, tmp3);
-}
-
-int ODESolver::Jacobian(realtype t, N_Vector y, N_Vector fy, SUNMatrix J,
-                        N_Vector tmp1, N_Vector tmp2, N_Vector tmp3) {
-  mJacFunction(t, NV_DATA_S(y), NV_DATA_S(fy), SM_DATA_D(J), NV_DATA_S(tmp1),
-               NV_DATA_S(tmp2), NV_DATA_S(tmp3));
-  return 0;
-}
 
-Real ODESolver::step(Real initial_time) {
-  // Not absolutely necessary; realtype by default double (same as Real)
-  realtype T0 = (realtype)initial_time;
-  realtype Tf = (realtype)initial_time + mTimestep;
-
-  /// Number of integration steps
-  long int nst;
-  /// Number of error test fails
-  long int netf;
-
-  mComponent->mOdePostState->set(mComponent->mOdePreState->get());
-
-  // Better allocate the arkode memory here to prevent numerical problems
   mArkode_mem = ARKodeCreate();
   if (check_flag(mArkode_mem, "ARKodeCreate", 0))
-    mFlag = 1;
+    throw CPS::Exception();
 
   mFlag = ARKodeSetUserData(mArkode_mem, this);
   if (check_flag(&mFlag, "ARKodeSetUserData", 1))
-    mFlag = 1;
+    throw CPS::Exception();
 
   /* Call ARKodeInit to initialize the integrator memory and specify the
    * right-hand side function in y'=f(t,y), the inital time T0, and
    * the initial dependent variable vector y(fluxes+mech. vars).
+   * The actual initial state and time are set by the first step.
    */
   if (mImplicitIntegration) {
-    mFlag = ARKodeInit(mArkode_mem, NULL, &ODESolver::StateSpaceWrapper,
-                       initial_time, mStates);
+    mFlag = ARKodeInit(mArkode_mem, NULL, &ODESolver::StateSpaceWrapper, 0,
+                       mStates);
     if (check_flag(&mFlag, "ARKodeInit", 1))
       throw CPS::Exception();
 
@@ -115,25 +80,105 @@ Real ODESolver::step(Real initial_time) {
     if (check_flag(&mFlag, "ARKDlsSetJacFn", 1))
       throw CPS::Exception();
   } else {
-    mFlag = ARKodeInit(mArkode_mem, &ODESolver::StateSpaceWrapper, NULL,
-                       initial_time, mStates);
+    mFlag = ARKodeInit(mArkode_mem, &ODESolver::StateSpaceWrapper, NULL, 0,
+                       mStates);
     if (check_flag(&mFlag, "ARKodeInit", 1))
       throw CPS::Exception();
   }
 
   mFlag = ARKodeSStolerances(mArkode_mem, reltol, abstol);
   if (check_flag(&mFlag, "ARKodeSStolerances", 1))
-    mFlag = 1;
+    throw CPS::Exception();
+
+  mReInit = true;
+}
+
+void ODESolver::reInit(Real t0) {
+  // Keeps the tolerances and the attached linear solver
+  if (mImplicitIntegration)
+    mFlag = ARKodeReInit(mArkode_mem, NULL, &ODESolver::StateSpaceWrapper, t0,
+                         mStates);
+  else
+    mFlag = ARKodeReInit(mArkode_mem, &ODESolver::StateSpaceWrapper, NULL, t0,
+                         mStates);
+  if (check_flag(&mFlag, "ARKodeReInit", 1))
+    throw CPS::Exception();
+
+  mTotalSteps = 0;
+  mTotalErrorTestFails = 0;
+  mReInit = false;
+  ++**mReInitCount;
+}
+
+int ODESolver::StateSpaceWrapper(realtype t, N_Vector y, N_Vector ydot,
+                                 void *user_data) {
+  ODESolver *self = reinterpret_cast<ODESolver *>(user_data);
+  return self->StateSpace(t, y, ydot);
+}
+
+int ODESolver::StateSpace(realtype t, N_Vector y, N_Vector ydot) {
+  mStSpFunction(t, NV_DATA_S(y), NV_DATA_S(ydot));
+  return 0;
+}
+
+int ODESolver::JacobianWrapper(realtype t, N_Vector y, N_Vector fy, SUNMatrix J,
+                               void *user_data, N_Vector tmp1, N_Vector tmp2,
+                               N_Vector tmp3) {
+  ODESolver *self = reinterpret_cast<ODESolver *>(user_data);
+  return self->Jacobian(t, y, fy, J, tmp1, tmp2, tmp3);
+}
+
+int ODESolver::Jacobian(realtype t, N_Vector y, N_Vector fy, SUNMatrix J,
+                        N_Vector tmp1, N_Vector tmp2, N_Vector tmp3) {
+  mJacFunction(t, NV_DATA_S(y), NV_DATA_S(fy), SM_DATA_D(J), NV_DATA_S(tmp1),
+               NV_DATA_S(tmp2), NV_DATA_S(tmp3));
+  return 0;
+}
+
+Real ODESolver::step(Real initial_time) {
+  // Not absolutely necessary; realtype by default double (same as Real)
+  realtype T0 = (realtype)initial_time;
+  realtype Tf = (realtype)initial_time + mTimestep;
+
+  auto &preState = **mComponent->mOdePreState;
+  auto &postState = **mComponent->mOdePostState;
+
+  // The integrator continues with its step size and Jacobian history as long
+  // as the component passes on the state where the last step ended
+  if (std::abs(T0 - mStopTime) > 1e-9 * mTimestep || preState != postState)
+    mReInit = true;
+
+  mComponent->mOdePostState->set(preState);
+  if (postState.data() != NV_DATA_S(mStates)) {
+    N_VSetArrayPointer(postState.data(), mStates);
+    mReInit = true;
+  }
+
+  if (mReInit)
+    reInit(T0);
+
+  // Stop exactly at the end of the step, so the internal state of the
+  // integrator matches the state passed back to the component
+  mFlag = ARKodeSetStopTime(mArkode_mem, Tf);
+  if (check_flag(&mFlag, "ARKodeSetStopTime", 1))
+    throw CPS::Exception();
 
   // Main integrator loop
   realtype t = T0;
   while (Tf - t > 1.0e-15) {
     mFlag = ARKode(mArkode_mem, Tf, mStates, &t, ARK_NORMAL);
-    if (check_flag(&mFlag, "ARKode", 1))
+    if (check_flag(&mFlag, "ARKode", 1)) {
+      mReInit = true;
       break;
+    }
   }
+  mStopTime = Tf;
 
   // Get some statistics to check for numerical problems (instability, blow-up etc)
+  /// Number of integration steps
+  long int nst;
+  /// Number of error test fails
+  long int netf;
   mFlag = ARKodeGetNumSteps(mArkode_mem, &nst);
   if (check_flag(&mFlag, "ARKodeGetNumSteps", 1))
     return 1;
@@ -141,12 +186,11 @@ Real ODESolver::step(Real initial_time) {
   if (check_flag(&mFlag, "ARKodeGetNumErrTestFails", 1))
     return 1;
 
-  ARKodeFree(&mArkode_mem);
-  SUNLinSolFree(LS);
-  SUNMatDestroy(A);
+  **mInternalSteps = static_cast<Int>(nst - mTotalSteps);
+  **mErrorTestFails = static_cast<Int>(netf - mTotalErrorTestFails);
+  mTotalSteps = nst;
+  mTotalErrorTestFails = netf;
 
-  // Print statistics:
-  //std::cout << "Number Computing Steps: "<< nst << " Number Error-Test-Fails: " << netf << std::endl;
   return Tf;
 }
 
@@ -193,4 +237,13 @@ int ODESolver::check_flag(void *flagvalue, const std::string &funcname,
   return 0;
 }
 
-ODESolver::~ODESolver() { N_VDestroy(mStates); }
+ODESolver::~ODESolver() {
+  SPDLOG_LOGGER_INFO(mSLog, "Integrator restarts: {}", **mReInitCount);
+  if (mArkode_mem)
+    ARKodeFree(&mArkode_mem);
+  if (LS)
+    SUNLinSolFree(LS);
+  if (A)
+    SUNMatDestroy(A);
+  N_VDestroy(mStates);
+}
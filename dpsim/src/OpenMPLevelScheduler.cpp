@@ -6,6 +6,7 @@
  * file, You can obtain one at https://mozilla.org/MPL/2.0/.
  *********************************************************************************/
 
+#include <dpsim/AllocationCounter.h>
 #include <dpsim/OpenMPLevelScheduler.h>
 #include <omp.h>
 
@@ -42,8 +43,10 @@ void OpenMPLevelScheduler::step(Real time, Int timeStepCount) {
   if (!mOutMeasurementFile.empty()) {
 #pragma omp parallel shared(time, timeStepCount) private(level, i, start, end) \
     num_threads(mNumThreads)
-    for (level = 0; level < static_cast<long>(mLevels.size()); level++) {
-      {
+    {
+      // Restores the setting of the calling thread after the region
+      AllocationCounter::ThreadScope countAllocations(true);
+      for (level = 0; level < static_cast<long>(mLevels.size()); level++) {
 #pragma omp for schedule(static)
         for (i = 0; i < static_cast<long>(mLevels[level].size()); i++) {
           start = std::chrono::steady_clock::now();
@@ -56,8 +59,10 @@ void OpenMPLevelScheduler::step(Real time, Int timeStepCount) {
   } else {
 #pragma omp parallel shared(time, timeStepCount) private(level, i)             \
     num_threads(mNumThreads)
-    for (level = 0; level < static_cast<long>(mLevels.size()); level++) {
-      {
+    {
+      // Restores the setting of the calling thread after the region
+      AllocationCounter::ThreadScope countAllocations(true);
+      for (level = 0; level < static_cast<long>(mLevels.size()); level++) {
 #pragma omp for schedule(static)
         for (i = 0; i < static_cast<long>(mLevels[level].size()); i++) {
           mLevels[level][i]->execute(time, timeStepCount);
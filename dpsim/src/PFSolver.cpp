@@ -6,8 +6,13 @@
  * file, You can obtain one at https://mozilla.org/MPL/2.0/.
  *********************************************************************************/
 
+#include <dpsim/DenseLUAdapter.h>
 #include <dpsim/PFSolver.h>
 #include <dpsim/SequentialScheduler.h>
+#include <dpsim/SparseLUAdapter.h>
+#ifdef WITH_KLU
+#include <dpsim/KLUAdapter.h>
+#endif
 #include <iostream>
 
 using namespace DPsim;
@@ -60,9 +65,63 @@ void PFSolver::initialize() {
   determineNodeBaseVoltages();
   composeAdmittanceMatrix();
 
-  mJ.setZero(mNumUnknowns, mNumUnknowns);
-  mX.setZero(mNumUnknowns);
-  mF.setZero(mNumUnknowns);
+  mX.setZero(mNumUnknowns, 1);
+  mF.setZero(mNumUnknowns, 1);
+
+  if (mSparseJacobian)
+    initializeSparseJacobian();
+  else
+    mJ.setZero(mNumUnknowns, mNumUnknowns);
+}
+
+void PFSolver::initializeSparseJacobian() {
+  if (mJacobianSolverImpl == DirectLinearSolverImpl::Undef) {
+#ifdef WITH_KLU
+    mJacobianSolverImpl = DirectLinearSolverImpl::KLU;
+#else
+    mJacobianSolverImpl = DirectLinearSolverImpl::SparseLU;
+#endif
+  }
+
+  switch (mJacobianSolverImpl) {
+  case DirectLinearSolverImpl::DenseLU:
+    mJacobianSolver = std::make_shared<DenseLUAdapter>(mSLog);
+    break;
+  case DirectLinearSolverImpl::SparseLU:
+    mJacobianSolver = std::make_shared<SparseLUAdapter>(mSLog);
+    break;
+#ifdef WITH_KLU
+  case DirectLinearSolverImpl::KLU: {
+    // Jacobian values differ in every iteration, so cached factorizations
+    // would never be reused
+    auto klu = std::make_shared<KLUAdapter>(mSLog);
+    klu->useFactorizationCache(false);
+    mJacobianSolver = klu;
+    break;
+  }
+#endif
+  default:
+    throw CPS::SystemError("unsupported linear solver implementation.");
+  }
+
+  // The sparsity pattern only depends on the admittance matrix and the bus
+  // types, so the symbolic analysis is done once for all iterations
+  determineJacobianPattern();
+  std::vector<std::pair<UInt, UInt>> noVariableEntries;
+  mJacobianSolver->preprocessing(mJSparse, noVariableEntries);
+
+  SPDLOG_LOGGER_INFO(mSLog,
+                     "Sparse Jacobian with {} unknowns and {} non-zeros",
+                     mNumUnknowns, mJSparse.nonZeros());
+}
+
+void PFSolver::solveSparseJacobian(Bool refactorize) {
+  // Numerical factorization only, the pattern was analyzed in initialize()
+  if (refactorize)
+    mJacobianSolver->refactorize(mJSparse);
+  else
+    mJacobianSolver->factorize(mJSparse);
+  mJacobianSolver->solve(mF, mX);
 }
 
 void PFSolver::assignMatrixNodeIndices() {
@@ -450,13 +509,18 @@ Bool PFSolver::solvePowerflow() {
   mIterations = 0;
   for (unsigned i = 1; i < mMaxIterations && !isConverged; ++i) {
 
-    calculateJacobian();
-    auto sparseJ = mJ.sparseView();
+    if (mSparseJacobian) {
+      calculateSparseJacobian();
+      solveSparseJacobian(i > 1);
+    } else {
+      calculateJacobian();
+      auto sparseJ = mJ.sparseView();
 
-    // Solve system mJ*mX = mF
-    Eigen::SparseLU<SparseMatrix> lu(sparseJ);
+      // Solve system mJ*mX = mF
+      Eigen::SparseLU<SparseMatrix> lu(sparseJ);
 
-    mX = lu.solve(mF); /* code */
+      mX = lu.solve(mF); /* code */
+    }
 
     // Calculate new solution based on mX increments obtained from equation system
     updateSolution();
@@ -465,7 +529,6 @@ Bool PFSolver::solvePowerflow() {
     calculateMismatch();
 
     SPDLOG_LOGGER_DEBUG(mSLog, "Mismatch vector at iteration {}: \n {}", i, mF);
-    mSLog->flush();
 
     // Check convergence
     isConverged = checkConvergence();
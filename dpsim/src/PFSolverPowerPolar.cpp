@@ -308,6 +308,102 @@ void PFSolverPowerPolar::calculateJacobian() {
   }
 }
 
+void PFSolverPowerPolar::determineJacobianPattern() {
+  UInt npqpv = mNumPQBuses + mNumPVBuses;
+
+  mPQPVBusPositions.assign(mSystem.mNodes.size(), -1);
+  for (UInt a = 0; a < npqpv; ++a)
+    mPQPVBusPositions[mPQPVBusIndices[a]] = a;
+
+  // Record the entries in the same order as calculateSparseJacobian writes them
+  std::vector<Eigen::Triplet<Real>> entries;
+  for (UInt a = 0; a < npqpv; ++a) {
+    UInt k = mPQPVBusIndices[a];
+    for (SparseMatrixCompRow::InnerIterator it(mY, k); it; ++it) {
+      Int b = mPQPVBusPositions[it.col()];
+      if ((UInt)it.col() == k || b < 0)
+        continue;
+      // J1 and J2
+      entries.emplace_back(a, b, 0.);
+      if (b < (Int)mNumPQBuses)
+        entries.emplace_back(a, b + npqpv, 0.);
+      // J3 and J4
+      if (a < mNumPQBuses) {
+        entries.emplace_back(a + npqpv, b, 0.);
+        if (b < (Int)mNumPQBuses)
+          entries.emplace_back(a + npqpv, b + npqpv, 0.);
+      }
+    }
+    entries.emplace_back(a, a, 0.);
+    if (a < mNumPQBuses) {
+      entries.emplace_back(a, a + npqpv, 0.);
+      entries.emplace_back(a + npqpv, a, 0.);
+      entries.emplace_back(a + npqpv, a + npqpv, 0.);
+    }
+  }
+
+  mJSparse = SparseMatrix(mNumUnknowns, mNumUnknowns);
+  mJSparse.setFromTriplets(entries.begin(), entries.end());
+  mJSparse.makeCompressed();
+
+  // Map each entry to its position in the compressed value array
+  mJSparseValueIndices.clear();
+  mJSparseValueIndices.reserve(entries.size());
+  for (auto &entry : entries) {
+    auto begin = mJSparse.innerIndexPtr() + mJSparse.outerIndexPtr()[entry.row()];
+    auto end =
+        mJSparse.innerIndexPtr() + mJSparse.outerIndexPtr()[entry.row() + 1];
+    auto pos = std::lower_bound(begin, end, entry.col());
+    mJSparseValueIndices.push_back(pos - mJSparse.innerIndexPtr());
+  }
+}
+
+void PFSolverPowerPolar::calculateSparseJacobian() {
+  UInt npqpv = mNumPQBuses + mNumPVBuses;
+  Real *values = mJSparse.valuePtr();
+  auto index = mJSparseValueIndices.begin();
+
+  for (UInt a = 0; a < npqpv; ++a) {
+    UInt k = mPQPVBusIndices[a];
+    Real Vk = sol_V.coeff(k);
+    Real Pk = 0., Qk = 0.;
+
+    // P(k) and Q(k) are accumulated from the same terms as the off-diagonals
+    for (SparseMatrixCompRow::InnerIterator it(mY, k); it; ++it) {
+      UInt j = it.col();
+      Real Gkj = it.value().real();
+      Real Bkj = it.value().imag();
+      Real dkj = sol_D.coeff(k) - sol_D.coeff(j);
+      Real VkVj = Vk * sol_V.coeff(j);
+      Real t1 = VkVj * (Gkj * sin(dkj) - Bkj * cos(dkj));
+      Real t2 = VkVj * (Gkj * cos(dkj) + Bkj * sin(dkj));
+      Pk += t2;
+      Qk += t1;
+
+      Int b = mPQPVBusPositions[j];
+      if (j == k || b < 0)
+        continue;
+      values[*index++] = t1;
+      if (b < (Int)mNumPQBuses)
+        values[*index++] = t2;
+      if (a < mNumPQBuses) {
+        values[*index++] = -t2;
+        if (b < (Int)mNumPQBuses)
+          values[*index++] = t1;
+      }
+    }
+
+    Real Gkk = G(k, k) * Vk * Vk;
+    Real Bkk = B(k, k) * Vk * Vk;
+    values[*index++] = -Qk - Bkk;
+    if (a < mNumPQBuses) {
+      values[*index++] = Pk + Gkk;
+      values[*index++] = Pk - Gkk;
+      values[*index++] = Qk - Bkk;
+    }
+  }
+}
+
 void PFSolverPowerPolar::updateSolution() {
   UInt npqpv = mNumPQBuses + mNumPVBuses;
   UInt k;
@@ -412,18 +508,23 @@ void PFSolverPowerPolar::calculateNodalInjection() {
 
 Real PFSolverPowerPolar::P(UInt k) {
   Real val = 0.0;
-  for (UInt j = 0; j < mSystem.mNodes.size(); ++j) {
-    val += sol_V.coeff(j) * (G(k, j) * cos(sol_D.coeff(k) - sol_D.coeff(j)) +
-                             B(k, j) * sin(sol_D.coeff(k) - sol_D.coeff(j)));
+  // Only the non-zero admittances of row k contribute
+  for (SparseMatrixCompRow::InnerIterator it(mY, k); it; ++it) {
+    UInt j = it.col();
+    val += sol_V.coeff(j) *
+           (it.value().real() * cos(sol_D.coeff(k) - sol_D.coeff(j)) +
+            it.value().imag() * sin(sol_D.coeff(k) - sol_D.coeff(j)));
   }
   return sol_V.coeff(k) * val;
 }
 
 Real PFSolverPowerPolar::Q(UInt k) {
   Real val = 0.0;
-  for (UInt j = 0; j < mSystem.mNodes.size(); ++j) {
-    val += sol_V.coeff(j) * (G(k, j) * sin(sol_D.coeff(k) - sol_D.coeff(j)) -
-                             B(k, j) * cos(sol_D.coeff(k) - sol_D.coeff(j)));
+  for (SparseMatrixCompRow::InnerIterator it(mY, k); it; ++it) {
+    UInt j = it.col();
+    val += sol_V.coeff(j) *
+           (it.value().real() * sin(sol_D.coeff(k) - sol_D.coeff(j)) -
+            it.value().imag() * cos(sol_D.coeff(k) - sol_D.coeff(j)));
   }
   return sol_V.coeff(k) * val;
 }
@@ -435,8 +536,8 @@ void PFSolverPowerPolar::calculatePAndQAtSlackBus() {
 
     // calculate power flowing out of the node into the admittance matrix (i.e. S_inj)
     CPS::Complex I(0.0, 0.0);
-    for (UInt j = 0; j < mSystem.mNodes.size(); ++j)
-      I += mY.coeff(node_idx, j) * sol_Vcx(j);
+    for (SparseMatrixCompRow::InnerIterator it(mY, node_idx); it; ++it)
+      I += it.value() * sol_Vcx(it.col());
     CPS::Complex S = sol_Vcx(node_idx) * conj(I);
 
     // add load power to obtain generator power (S_gen = S_inj + S_load)
@@ -482,8 +583,8 @@ void PFSolverPowerPolar::calculateQAtPVBuses() {
 
     // calculate power flowing out of the node into the admittance matrix (i.e. S_inj)
     CPS::Complex I(0.0, 0.0);
-    for (UInt j = 0; j < mSystem.mNodes.size(); ++j)
-      I += mY.coeff(node_idx, j) * sol_Vcx(j);
+    for (SparseMatrixCompRow::InnerIterator it(mY, node_idx); it; ++it)
+      I += it.value() * sol_Vcx(it.col());
     Complex S = sol_Vcx(node_idx) * conj(I);
 
     // add load power to obtain generator power (S_gen = S_inj + S_load)
@@ -519,8 +620,8 @@ void PFSolverPowerPolar::calculatePAndQInjectionPQBuses() {
 
     // calculate power flowing out of the node into the admittance matrix (i.e. S_inj)
     CPS::Complex I(0.0, 0.0);
-    for (UInt j = 0; j < mSystem.mNodes.size(); ++j)
-      I += mY.coeff(node_idx, j) * sol_Vcx(j);
+    for (SparseMatrixCompRow::InnerIterator it(mY, node_idx); it; ++it)
+      I += it.value() * sol_Vcx(it.col());
     CPS::Complex S = sol_Vcx(node_idx) * conj(I);
 
     // Subtracting shunt power to obtain power injection flowing from this node to the other nodes (i.e. S_inj_to_other)
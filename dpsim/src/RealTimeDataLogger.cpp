@@ -24,7 +24,58 @@ RealTimeDataLogger::RealTimeDataLogger(std::filesystem::path &filename,
       mRowNumber((finalTime / timeStep + 0.5)), mCurrentRow(0),
       mCurrentAttribute(0), mAttributeData() {}
 
+RealTimeDataLogger::~RealTimeDataLogger() {
+  // The writer thread uses the log file
+  if (mAsyncBuffer)
+    mAsyncBuffer->stop();
+}
+
+void RealTimeDataLogger::setAsyncBuffer(UInt rows,
+                                        AsyncLogBuffer::OverflowPolicy policy) {
+  mAsyncRows = rows;
+  mAsyncPolicy = policy;
+}
+
+void RealTimeDataLogger::writeHeader(std::ofstream &logFile) {
+  logFile << std::right << std::setw(14) << "time";
+  for (auto it : mAttributes)
+    logFile << ", " << std::right << std::setw(13) << it.first;
+  logFile << '\n';
+}
+
 void RealTimeDataLogger::start() {
+  if (mAsyncRows > 0) {
+    mLogFile =
+        std::ofstream(mFilename, std::ios_base::out | std::ios_base::trunc);
+    if (!mLogFile.is_open()) {
+      throw std::runtime_error("Cannot open log file " + mFilename.string());
+    }
+    writeHeader(mLogFile);
+
+    compileExportPlan(mExportPlan);
+    UInt column = mExportPlan.size() + 1;
+
+    auto log = CPS::Logger::get("RealTimeDataLogger", CPS::Logger::Level::off,
+                                CPS::Logger::Level::info);
+    log->info("Streaming real-time data log through a buffer of {} rows for "
+              "{} attributes ({} MB)",
+              mAsyncRows, mAttributes.size(),
+              static_cast<double>(mAsyncRows) * column * sizeof(Real) /
+                  (1024 * 1024));
+
+    mAsyncBuffer = std::make_unique<AsyncLogBuffer>(
+        mAsyncRows, column, mAsyncPolicy,
+        [this](const Real *row, UInt columns) {
+          mLogFile << std::scientific << std::right << std::setw(14) << row[0];
+          for (UInt i = 1; i < columns; ++i)
+            mLogFile << ", " << std::right << std::setw(13) << row[i];
+          mLogFile << '\n';
+        },
+        [this]() { mLogFile.flush(); });
+    mAsyncBuffer->start();
+    return;
+  }
+
   double mb_size =
       static_cast<double>(mRowNumber) * (mAttributes.size() + 1) * sizeof(Real);
   auto log = CPS::Logger::get("RealTimeDataLogger", CPS::Logger::Level::off,
@@ -32,6 +83,7 @@ void RealTimeDataLogger::start() {
   log->info("Preallocating memory for real-time data logger: {} rows for {} "
             "attributes ({} MB)",
             mRowNumber, mAttributes.size(), mb_size / (1024 * 1024));
+  compileExportPlan(mExportPlan);
   // We are doing real time so preallocate everything
   mAttributeData.resize(mRowNumber);
   for (auto &it : mAttributeData) {
@@ -41,27 +93,49 @@ void RealTimeDataLogger::start() {
 }
 
 void RealTimeDataLogger::stop() {
-  auto mLogFile =
+  if (mAsyncBuffer) {
+    mAsyncBuffer->stop();
+    if (mAsyncPolicy == AsyncLogBuffer::OverflowPolicy::Count &&
+        mAsyncBuffer->overruns() > 0) {
+      auto log = CPS::Logger::get("RealTimeDataLogger",
+                                  CPS::Logger::Level::off,
+                                  CPS::Logger::Level::info);
+      log->warn("Dropped {} of {} rows because the log buffer was full",
+                mAsyncBuffer->overruns(),
+                mAsyncBuffer->overruns() + mAsyncBuffer->written());
+    }
+    mLogFile.close();
+    return;
+  }
+
+  auto logFile =
       std::ofstream(mFilename, std::ios_base::out | std::ios_base::trunc);
-  if (!mLogFile.is_open()) {
+  if (!logFile.is_open()) {
     throw std::runtime_error("Cannot open log file " + mFilename.string());
   }
 
-  mLogFile << std::right << std::setw(14) << "time";
-  for (auto it : mAttributes)
-    mLogFile << ", " << std::right << std::setw(13) << it.first;
-  mLogFile << '\n';
+  writeHeader(logFile);
 
   for (auto row : mAttributeData) {
-    mLogFile << std::scientific << std::right << std::setw(14) << row[0];
+    logFile << std::scientific << std::right << std::setw(14) << row[0];
     for (size_t i = 1; i < row.size(); ++i)
-      mLogFile << ", " << std::right << std::setw(13) << row[i];
-    mLogFile << '\n';
+      logFile << ", " << std::right << std::setw(13) << row[i];
+    logFile << '\n';
   }
-  mLogFile.close();
+  logFile.close();
 }
 
 void RealTimeDataLogger::log(Real time, Int timeStepCount) {
+  if (mAsyncBuffer) {
+    Real *row = mAsyncBuffer->acquireRow();
+    if (!row)
+      return;
+    row[0] = time;
+    mExportPlan.gather(row + 1);
+    mAsyncBuffer->commitRow();
+    return;
+  }
+
   mCurrentRow = timeStepCount;
   if (timeStepCount < 0 || static_cast<size_t>(timeStepCount) >= mRowNumber) {
     throw std::runtime_error(
@@ -74,19 +148,7 @@ void RealTimeDataLogger::log(Real time, Int timeStepCount) {
         "RealTimeDataLogger: Attribute data size mismatch");
   }
   mAttributeData[mCurrentRow][0] = time;
-  mCurrentAttribute = 1;
-
-  for (auto it : mAttributes) {
-    if (it.second->getType() == typeid(Real)) {
-      mAttributeData[mCurrentRow][mCurrentAttribute++] =
-          **std::dynamic_pointer_cast<std::shared_ptr<CPS::Attribute<Real>>>(
-              it.second.getPtr());
-    } else if (it.second->getType() == typeid(Int)) {
-      mAttributeData[mCurrentRow][mCurrentAttribute++] =
-          **std::dynamic_pointer_cast<std::shared_ptr<CPS::Attribute<Int>>>(
-              it.second.getPtr());
-    }
-  }
+  mExportPlan.gather(mAttributeData[mCurrentRow].data() + 1);
 }
 
 void RealTimeDataLogger::Step::execute(Real time, Int timeStepCount) {
@@ -2,15 +2,20 @@
 
 #include <algorithm>
 #include <chrono>
+#include <cmath>
+#include <fstream>
 #include <iomanip>
+#include <sstream>
 #include <typeindex>
 
 #include <dpsim-models/Utils.h>
+#include <dpsim/AllocationCounter.h>
 #include <dpsim/DiakopticsSolver.h>
 #include <dpsim/MNASolverFactory.h>
 #include <dpsim/PFSolverPowerPolar.h>
 #include <dpsim/SequentialScheduler.h>
 #include <dpsim/Simulation.h>
+#include <dpsim/Snapshot.h>
 #include <dpsim/Utils.h>
 
 #include <spdlog/sinks/stdout_color_sinks.h>
@@ -34,6 +39,17 @@ Simulation::Simulation(String name, Logger::Level logLevel)
       mTimeStep(AttributeStatic<Real>::make(0.001)),
       mSplitSubnets(AttributeStatic<Bool>::make(true)),
       mSteadyStateInit(AttributeStatic<Bool>::make(false)),
+      mStepTimeMean(AttributeStatic<Real>::make(0)),
+      mStepTimeMax(AttributeStatic<Real>::make(0)),
+      mStepTimeP50(AttributeStatic<Real>::make(0)),
+      mStepTimeP99(AttributeStatic<Real>::make(0)),
+      mStepTimeP999(AttributeStatic<Real>::make(0)),
+      mSolveTimeMean(AttributeStatic<Real>::make(0)),
+      mSolveTimeMax(AttributeStatic<Real>::make(0)),
+      mFactorizeTimeMean(AttributeStatic<Real>::make(0)),
+      mFactorizeTimeMax(AttributeStatic<Real>::make(0)),
+      mRecomputeTimeMean(AttributeStatic<Real>::make(0)),
+      mRecomputeTimeMax(AttributeStatic<Real>::make(0)),
       mLogLevel(logLevel) {
   create();
 }
@@ -45,6 +61,17 @@ Simulation::Simulation(String name, CommandLineArgs &args)
       mTimeStep(AttributeStatic<Real>::make(args.timeStep)),
       mSplitSubnets(AttributeStatic<Bool>::make(true)),
       mSteadyStateInit(AttributeStatic<Bool>::make(false)),
+      mStepTimeMean(AttributeStatic<Real>::make(0)),
+      mStepTimeMax(AttributeStatic<Real>::make(0)),
+      mStepTimeP50(AttributeStatic<Real>::make(0)),
+      mStepTimeP99(AttributeStatic<Real>::make(0)),
+      mStepTimeP999(AttributeStatic<Real>::make(0)),
+      mSolveTimeMean(AttributeStatic<Real>::make(0)),
+      mSolveTimeMax(AttributeStatic<Real>::make(0)),
+      mFactorizeTimeMean(AttributeStatic<Real>::make(0)),
+      mFactorizeTimeMax(AttributeStatic<Real>::make(0)),
+      mRecomputeTimeMean(AttributeStatic<Real>::make(0)),
+      mRecomputeTimeMax(AttributeStatic<Real>::make(0)),
       mLogLevel(args.logLevel), mDomain(args.solver.domain),
       mSolverType(args.solver.type), mDirectImpl(args.directImpl) {
   create();
@@ -66,6 +93,13 @@ void Simulation::initialize() {
 
   mSolvers.clear();
 
+  // The initial node voltages are restored before the components are
+  // initialized from them
+  if (!mSnapshotPath.empty()) {
+    readSnapshot();
+    restoreSnapshotAttributes(false);
+  }
+
   switch (mDomain) {
   case Domain::SP:
     // Treat SP as DP
@@ -80,6 +114,17 @@ void Simulation::initialize() {
   mTime = 0;
   mTimeStepCount = 0;
 
+  if (!mSnapshotPath.empty()) {
+    // Overwrite the states computed by the component initialization
+    restoreSnapshotAttributes(true);
+    mTimeStepCount = mSnapshotTimeStepCount;
+    mTime = mTimeStepCount * **mTimeStep;
+    mSnapshotAttributes.clear();
+    mSnapshotSolverData.clear();
+    SPDLOG_LOGGER_INFO(mLog, "Resumed from snapshot {} at time step {}",
+                       mSnapshotPath.string(), mTimeStepCount);
+  }
+
   schedule();
 
   mInitialized = true;
@@ -97,14 +142,19 @@ template <typename VarType> void Simulation::createSolvers() {
     mSolvers.push_back(solver);
     break;
 #endif /* WITH_SUNDIALS */
-  case Solver::Type::NRP:
-    solver = std::make_shared<PFSolverPowerPolar>(**mName, mSystem, **mTimeStep,
-                                                  mLogLevel);
+  case Solver::Type::NRP: {
+    auto pfSolver = std::make_shared<PFSolverPowerPolar>(
+        **mName, mSystem, **mTimeStep, mLogLevel);
+    pfSolver->doSparseJacobian(mSparsePowerflowJacobian);
+    pfSolver->setDirectLinearSolverImplementation(mDirectImpl);
+    solver = pfSolver;
     solver->doInitFromNodesAndTerminals(mInitFromNodesAndTerminals);
     solver->setSolverAndComponentBehaviour(mSolverBehaviour);
+    restoreSolverSnapshot(solver);
     solver->initialize();
     mSolvers.push_back(solver);
     break;
+  }
   default:
     throw UnsupportedSolverException();
   }
@@ -146,7 +196,8 @@ template <typename VarType> void Simulation::createMNASolver() {
     if (mTearComponents.size() > 0) {
       // Tear components available, use diakoptics
       solver = std::make_shared<DiakopticsSolver<VarType>>(
-          **mName, subnets[net], mTearComponents, **mTimeStep, mLogLevel);
+          **mName, subnets[net], mTearComponents, **mTimeStep, mLogLevel,
+          mDirectImpl);
     } else {
       // Default case with lu decomposition from mna factory
       solver = MnaSolverFactory::factory<VarType>(**mName + copySuffix, mDomain,
@@ -154,7 +205,8 @@ template <typename VarType> void Simulation::createMNASolver() {
                                                   mSolverPluginName);
       solver->setTimeStep(**mTimeStep);
       solver->setLogSolveTimes(mLogStepTimes);
-      solver->doSteadyStateInit(**mSteadyStateInit);
+      // The steady state is part of the snapshot
+      solver->doSteadyStateInit(**mSteadyStateInit && mSnapshotPath.empty());
       solver->doFrequencyParallelization(mFreqParallel);
       solver->setSteadStIniTimeLimit(mSteadStIniTimeLimit);
       solver->setSteadStIniAccLimit(mSteadStIniAccLimit);
@@ -162,8 +214,14 @@ template <typename VarType> void Simulation::createMNASolver() {
       solver->setSolverAndComponentBehaviour(mSolverBehaviour);
       solver->doInitFromNodesAndTerminals(mInitFromNodesAndTerminals);
       solver->doSystemMatrixRecomputation(mSystemMatrixRecomputation);
+      solver->doSparseRightVector(mSparseRightVector);
+      solver->setSwitchStateCache(mSwitchStateCacheSize,
+                                  mSwitchStateCacheMemory);
+      solver->setLikelySwitchStates(mLikelySwitchStates);
+      solver->setLowRankSwitchUpdates(mSwitchUpdateMaxIndices);
       solver->setDirectLinearSolverConfiguration(
           mDirectLinearSolverConfiguration);
+      restoreSolverSnapshot(solver);
       solver->initialize();
       solver->setMaxNumberOfIterations(mMaxIterations);
     }
@@ -171,6 +229,138 @@ template <typename VarType> void Simulation::createMNASolver() {
   }
 }
 
+std::map<String, IdentifiedObject::Ptr> Simulation::snapshotObjects() {
+  std::map<String, IdentifiedObject::Ptr> objects;
+  for (auto node : mSystem.mNodes)
+    objects["node/" + node->uid()] = node;
+
+  std::vector<std::pair<String, IdentifiedObject::Ptr>> comps;
+  for (auto comp : mSystem.mComponents)
+    comps.push_back({"comp/" + comp->uid(), comp});
+  while (!comps.empty()) {
+    auto comp = comps.back();
+    comps.pop_back();
+    objects[comp.first] = comp.second;
+
+    if (auto powerComp =
+            std::dynamic_pointer_cast<SimPowerComp<Real>>(comp.second)) {
+      for (auto subComp : powerComp->subComponents())
+        comps.push_back({comp.first + "/" + subComp->uid(), subComp});
+    } else if (auto powerComp =
+                   std::dynamic_pointer_cast<SimPowerComp<Complex>>(
+                       comp.second)) {
+      for (auto subComp : powerComp->subComponents())
+        comps.push_back({comp.first + "/" + subComp->uid(), subComp});
+    }
+  }
+  return objects;
+}
+
+void Simulation::saveSnapshot(const fs::path &path) {
+  if (!mInitialized)
+    initialize();
+
+  std::ofstream out(path.string(), std::ios::binary);
+  if (!out)
+    throw SystemError("Cannot open snapshot " + path.string());
+
+  Snapshot::writeHeader(out);
+  Snapshot::writeValue(out, mDomain);
+  Snapshot::writeValue<Real>(out, **mTimeStep);
+  Snapshot::writeValue<Int>(out, mTimeStepCount);
+
+  // Dynamic attributes are computed from static ones and are not stored
+  auto objects = snapshotObjects();
+  Snapshot::writeValue<UInt>(out, static_cast<UInt>(objects.size()));
+  for (auto &obj : objects) {
+    AttributeBase::Map attrs;
+    for (auto &attr : obj.second->attributes()) {
+      if (attr.second->isStatic() && Snapshot::isSupported(attr.second))
+        attrs.insert(attr);
+    }
+
+    Snapshot::writeString(out, obj.first);
+    Snapshot::writeValue<UInt>(out, static_cast<UInt>(attrs.size()));
+    for (auto &attr : attrs) {
+      Snapshot::writeString(out, attr.first);
+      Snapshot::writeAttribute(out, attr.second);
+    }
+  }
+
+  Snapshot::writeValue<UInt>(out, static_cast<UInt>(mSolvers.size()));
+  for (auto solver : mSolvers) {
+    std::ostringstream data;
+    solver->writeSnapshot(data);
+    Snapshot::writeString(out, data.str());
+  }
+
+  out.close();
+  if (!out)
+    throw SystemError("Failed to write snapshot " + path.string());
+  SPDLOG_LOGGER_INFO(mLog, "Saved snapshot {} at time step {}", path.string(),
+                     mTimeStepCount);
+}
+
+void Simulation::readSnapshot() {
+  std::ifstream in(mSnapshotPath.string(), std::ios::binary);
+  if (!in)
+    throw SystemError("Cannot open snapshot " + mSnapshotPath.string());
+
+  Snapshot::readHeader(in);
+  if (Snapshot::readValue<Domain>(in) != mDomain ||
+      Snapshot::readValue<Real>(in) != **mTimeStep)
+    throw SystemError("Snapshot was saved with a different domain or "
+                      "time step");
+  mSnapshotTimeStepCount = Snapshot::readValue<Int>(in);
+
+  mSnapshotAttributes.clear();
+  UInt numObjects = Snapshot::readValue<UInt>(in);
+  for (UInt obj = 0; obj < numObjects; ++obj) {
+    auto &attrs = mSnapshotAttributes[Snapshot::readString(in)];
+    UInt numAttrs = Snapshot::readValue<UInt>(in);
+    for (UInt attr = 0; attr < numAttrs; ++attr) {
+      String name = Snapshot::readString(in);
+      attrs[name] = Snapshot::readAttribute(in);
+    }
+  }
+
+  mSnapshotSolverData.resize(Snapshot::readValue<UInt>(in));
+  for (auto &data : mSnapshotSolverData)
+    data = Snapshot::readString(in);
+}
+
+void Simulation::restoreSnapshotAttributes(Bool requireAll) {
+  // Subcomponents may only be created by the component initialization
+  auto objects = snapshotObjects();
+  for (auto &obj : mSnapshotAttributes) {
+    auto search = objects.find(obj.first);
+    if (search == objects.end()) {
+      if (requireAll)
+        throw SystemError("Object " + obj.first +
+                          " of the snapshot does not exist");
+      continue;
+    }
+
+    for (auto &attr : obj.second) {
+      if (!search->second->attribute(attr.first)->copyValue(attr.second))
+        throw SystemError("Type of attribute " + attr.first + " of " +
+                          obj.first + " does not match the snapshot");
+    }
+  }
+}
+
+void Simulation::restoreSolverSnapshot(Solver::Ptr solver) {
+  if (mSnapshotPath.empty())
+    return;
+
+  // Solvers are created in the same order as when the snapshot was saved
+  UInt idx = static_cast<UInt>(mSolvers.size());
+  if (idx >= mSnapshotSolverData.size())
+    throw SystemError("Number of solvers does not match the snapshot");
+  std::istringstream data(mSnapshotSolverData[idx]);
+  solver->readSnapshot(data);
+}
+
 void Simulation::sync() const {
   SPDLOG_LOGGER_INFO(mLog, "Start synchronization with remotes on interfaces");
 
@@ -328,6 +518,17 @@ void Simulation::start() {
     mTime += **mTimeStep;
   }
 
+  mStepTimeSamples.clear();
+  mStepTimeSamples.shrink_to_fit();
+  if (mLogStepTimes && mStepTimeSampleLimit > 0) {
+    // Clamped before the conversion, the number of steps of long runs may
+    // exceed the range of UInt
+    Real steps = std::ceil(**mFinalTime / **mTimeStep) + 1;
+    Real limit = static_cast<Real>(mStepTimeSampleLimit);
+    mStepTimeSamples.reserve(
+        static_cast<std::size_t>(steps >= 0 && steps < limit ? steps : limit));
+  }
+
   mSimulationStartTimePoint = std::chrono::steady_clock::now();
 }
 
@@ -338,6 +539,9 @@ void Simulation::stop() {
       mSimulationEndTimePoint - mSimulationStartTimePoint;
   SPDLOG_LOGGER_INFO(mLog, "Simulation calculation time: {:.6f}",
                      mSimulationCalculationTime.count());
+  if (mLogStepTimes)
+    mStepTimes.logSummary(mLog, "step");
+  updateTimingAttributes();
 
   mScheduler->stop();
 
@@ -370,26 +574,119 @@ void Simulation::run() {
   stop();
 }
 
+Real Simulation::runFor(UInt steps) {
+  for (UInt i = 0; i < steps && mTime < **mFinalTime + DOUBLE_EPSILON; ++i)
+    step();
+
+  updateTimingAttributes();
+  return mTime;
+}
+
+Real Simulation::runUntil(Real time) {
+  Real endTime = std::min(time, **mFinalTime);
+  while (mTime < endTime + DOUBLE_EPSILON)
+    step();
+
+  updateTimingAttributes();
+  return mTime;
+}
+
 Real Simulation::step() {
   std::chrono::steady_clock::time_point start;
   if (mLogStepTimes) {
     start = std::chrono::steady_clock::now();
   }
 
+  // The first step may still allocate, e.g. for lazily created buffers
+  Bool checkAllocations = mAllocationCheck && mTimeStepCount > 0;
+  // Only counts this thread for the duration of the step
+  AllocationCounter::ThreadScope countAllocations(checkAllocations);
+  if (checkAllocations)
+    AllocationCounter::start();
+
   mEvents.handleEvents(mTime);
   mScheduler->step(mTime, mTimeStepCount);
 
+  if (checkAllocations) {
+    auto allocations = AllocationCounter::stop();
+    if (allocations > 0)
+      throw SystemError("Simulation step " + std::to_string(mTimeStepCount) +
+                        " performed " + std::to_string(allocations) +
+                        " heap allocations");
+  }
+
   mTime += **mTimeStep;
   ++mTimeStepCount;
 
   if (mLogStepTimes) {
     auto end = std::chrono::steady_clock::now();
     std::chrono::duration<double> diff = end - start;
-    mStepTimes.push_back(diff.count());
+    mStepTimes.update(diff.count());
+    // Only fills the capacity reserved in start(), so it never allocates
+    if (mStepTimeSamples.size() < mStepTimeSamples.capacity())
+      mStepTimeSamples.push_back(diff.count());
+    if (diff.count() > **mTimeStep)
+      ++mStepTimeOverruns;
+    **mStepTimeMean = mStepTimes.mean();
+    **mStepTimeMax = mStepTimes.max();
   }
+  // Reading the percentiles scans the histograms, so the remaining timing
+  // attributes are only refreshed every thousand steps
+  if (mTimeStepCount % 1000 == 0)
+    updateTimingAttributes();
   return mTime;
 }
 
+Solver::SwitchStateCacheStatistics
+Simulation::switchStateCacheStatistics() const {
+  Solver::SwitchStateCacheStatistics total;
+  for (auto &solver : mSolvers) {
+    auto statistics = solver->switchStateCacheStatistics();
+    total.hits += statistics.hits;
+    total.misses += statistics.misses;
+    total.evictions += statistics.evictions;
+    total.states += statistics.states;
+    total.memory += statistics.memory;
+  }
+  return total;
+}
+
+void Simulation::updateTimingAttributes() {
+  if (mLogStepTimes) {
+    **mStepTimeP50 = mStepTimes.percentile(0.5);
+    **mStepTimeP99 = mStepTimes.percentile(0.99);
+    **mStepTimeP999 = mStepTimes.percentile(0.999);
+  }
+
+  // Combine the measurements of all solvers, e.g. of split subnets
+  auto combine = [this](const TimingStatistics *(Solver::*times)() const,
+                        Real &mean, Real &max) {
+    Real sum = 0;
+    uint64_t count = 0;
+    max = 0;
+    for (auto solver : mSolvers) {
+      auto stats = (solver.get()->*times)();
+      if (!stats || stats->count() == 0)
+        continue;
+      sum += stats->sum();
+      count += stats->count();
+      max = std::max(max, stats->max());
+    }
+    mean = count > 0 ? sum / static_cast<Real>(count) : 0;
+  };
+  combine(&Solver::solveTimes, **mSolveTimeMean, **mSolveTimeMax);
+  combine(&Solver::factorizeTimes, **mFactorizeTimeMean, **mFactorizeTimeMax);
+  combine(&Solver::recomputationTimes, **mRecomputeTimeMean,
+          **mRecomputeTimeMax);
+}
+
+void Simulation::doAllocationCheck(Bool value) {
+  if (value && !AllocationCounter::isSupported())
+    SPDLOG_LOGGER_WARN(mLog, "DPsim was built without WITH_ALLOCATION_CHECK. "
+                             "Allocations are not counted.");
+  mAllocationCheck = value;
+}
+
 void Simulation::logStepTimes(String logName) {
   auto stepTimeLog = Logger::get(logName, Logger::Level::info);
   if (!mLogStepTimes) {
@@ -398,29 +695,41 @@ void Simulation::logStepTimes(String logName) {
   }
   Logger::setLogPattern(stepTimeLog, "%v");
   stepTimeLog->info("step_time");
-
-  Real stepTimeSum = 0;
-  for (auto meas : mStepTimes) {
-    stepTimeSum += meas;
-    stepTimeLog->info("{:.9f}", meas);
+  if (mStepTimeSampleLimit == 0) {
+    mStepTimes.logSamples(stepTimeLog);
+  } else {
+    for (auto meas : mStepTimeSamples)
+      stepTimeLog->info("{:.9f}", meas);
+    if (mStepTimeSamples.size() < mStepTimes.count())
+      SPDLOG_LOGGER_WARN(mLog,
+                         "Only the first {} of {} step times are written to "
+                         "{}, see setStepTimeSampleLimit().",
+                         mStepTimeSamples.size(), mStepTimes.count(), logName);
   }
-  SPDLOG_LOGGER_INFO(mLog, "Average step time: {:.9f}",
-                     stepTimeSum / mStepTimes.size());
+
+  const String samplesSuffix = "_step_times";
+  String histName = logName;
+  if (histName.size() >= samplesSuffix.size() &&
+      histName.compare(histName.size() - samplesSuffix.size(),
+                       samplesSuffix.size(), samplesSuffix) == 0)
+    histName.replace(histName.size() - samplesSuffix.size(),
+                     samplesSuffix.size(), "_step_time_hist");
+  else
+    histName += "_hist";
+  auto histLog = Logger::get(histName, Logger::Level::info);
+  Logger::setLogPattern(histLog, "%v");
+  mStepTimes.logHistogram(histLog);
+  mStepTimes.logSummary(mLog, "step");
 }
 
 void Simulation::checkForOverruns(String logName) {
   auto stepTimeLog = Logger::get(logName, Logger::Level::info);
   Logger::setLogPattern(stepTimeLog, "%v");
   stepTimeLog->info("overruns");
+  stepTimeLog->info("{}", mStepTimeOverruns);
 
-  int overruns = 0;
-  for (auto meas : mStepTimes) {
-    if (meas > **mTimeStep) {
-      overruns++;
-      SPDLOG_LOGGER_INFO(mLog, "overrun detected {}: {:.9f}", overruns, meas);
-    }
-  }
-  SPDLOG_LOGGER_INFO(mLog, "Detected {} overruns.", overruns);
+  SPDLOG_LOGGER_INFO(mLog, "Detected {} overruns, maximum step time: {:.9f}",
+                     mStepTimeOverruns, mStepTimes.max());
 }
 
 void Simulation::logLUTimes() {
@@ -0,0 +1,140 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <algorithm>
+
+#include <dpsim/Snapshot.h>
+
+using namespace CPS;
+using namespace DPsim;
+
+namespace {
+const char Magic[8] = {'D', 'P', 'S', 'I', 'M', 'S', 'N', 'P'};
+}
+
+void Snapshot::checkStream(std::istream &in) {
+  if (!in)
+    throw SystemError("Unexpected end of snapshot");
+}
+
+void Snapshot::writeHeader(std::ostream &out) {
+  out.write(Magic, sizeof(Magic));
+  writeValue<UInt>(out, Version);
+}
+
+void Snapshot::readHeader(std::istream &in) {
+  char magic[sizeof(Magic)];
+  in.read(magic, sizeof(magic));
+  checkStream(in);
+  if (!std::equal(magic, magic + sizeof(magic), Magic))
+    throw SystemError("File is not a snapshot");
+  if (readValue<UInt>(in) != Version)
+    throw SystemError("Unsupported snapshot version");
+}
+
+void Snapshot::writeString(std::ostream &out, const String &value) {
+  writeValue<UInt>(out, static_cast<UInt>(value.size()));
+  out.write(value.data(), value.size());
+}
+
+String Snapshot::readString(std::istream &in) {
+  String value(readValue<UInt>(in), '\0');
+  in.read(&value[0], value.size());
+  checkStream(in);
+  return value;
+}
+
+void Snapshot::writePattern(std::ostream &out,
+                            const DPsim::SparseMatrix &matrix) {
+  writeValue<UInt>(out, static_cast<UInt>(matrix.rows()));
+  writeValue<UInt>(out, static_cast<UInt>(matrix.cols()));
+  writeValue<UInt>(out, static_cast<UInt>(matrix.nonZeros()));
+  for (Int outer = 0; outer <= matrix.outerSize(); ++outer)
+    writeValue<Int>(out, matrix.outerIndexPtr()[outer]);
+  for (Int entry = 0; entry < matrix.nonZeros(); ++entry)
+    writeValue<Int>(out, matrix.innerIndexPtr()[entry]);
+}
+
+DPsim::SparseMatrix Snapshot::readPattern(std::istream &in) {
+  UInt rows = readValue<UInt>(in);
+  UInt cols = readValue<UInt>(in);
+  Int nonZeros = static_cast<Int>(readValue<UInt>(in));
+
+  DPsim::SparseMatrix matrix(rows, cols);
+  matrix.resizeNonZeros(nonZeros);
+  for (Int outer = 0; outer <= matrix.outerSize(); ++outer) {
+    Int index = readValue<Int>(in);
+    Int previous = outer > 0 ? matrix.outerIndexPtr()[outer - 1] : 0;
+    if (index < previous || index > nonZeros)
+      throw SystemError("Invalid matrix pattern in snapshot");
+    matrix.outerIndexPtr()[outer] = index;
+  }
+  for (Int entry = 0; entry < nonZeros; ++entry) {
+    Int index = readValue<Int>(in);
+    if (index < 0 || index >= matrix.innerSize())
+      throw SystemError("Invalid matrix pattern in snapshot");
+    matrix.innerIndexPtr()[entry] = index;
+    matrix.valuePtr()[entry] = 0;
+  }
+  return matrix;
+}
+
+Bool Snapshot::isSupported(AttributeBase::Ptr attr) {
+  auto &type = attr->getType();
+  return type == typeid(Real) || type == typeid(Complex) ||
+         type == typeid(Int) || type == typeid(UInt) || type == typeid(Bool) ||
+         type == typeid(Matrix) || type == typeid(MatrixComp);
+}
+
+void Snapshot::writeAttribute(std::ostream &out, AttributeBase::Ptr attr) {
+  auto &type = attr->getType();
+  if (type == typeid(Real)) {
+    writeValue(out, ValueType::Real);
+    writeValue(out, value<Real>(attr));
+  } else if (type == typeid(Complex)) {
+    writeValue(out, ValueType::Complex);
+    writeValue(out, value<Complex>(attr));
+  } else if (type == typeid(Int)) {
+    writeValue(out, ValueType::Int);
+    writeValue(out, value<Int>(attr));
+  } else if (type == typeid(UInt)) {
+    writeValue(out, ValueType::UInt);
+    writeValue(out, value<UInt>(attr));
+  } else if (type == typeid(Bool)) {
+    writeValue(out, ValueType::Bool);
+    writeValue(out, value<Bool>(attr));
+  } else if (type == typeid(Matrix)) {
+    writeValue(out, ValueType::Matrix);
+    writeMatrix<Real>(out, value<Matrix>(attr));
+  } else if (type == typeid(MatrixComp)) {
+    writeValue(out, ValueType::MatrixComp);
+    writeMatrix<Complex>(out, value<MatrixComp>(attr));
+  } else {
+    throw TypeException();
+  }
+}
+
+AttributeBase::Ptr Snapshot::readAttribute(std::istream &in) {
+  switch (readValue<ValueType>(in)) {
+  case ValueType::Real:
+    return AttributeStatic<Real>::make(readValue<Real>(in));
+  case ValueType::Complex:
+    return AttributeStatic<Complex>::make(readValue<Complex>(in));
+  case ValueType::Int:
+    return AttributeStatic<Int>::make(readValue<Int>(in));
+  case ValueType::UInt:
+    return AttributeStatic<UInt>::make(readValue<UInt>(in));
+  case ValueType::Bool:
+    return AttributeStatic<Bool>::make(readValue<Bool>(in));
+  case ValueType::Matrix:
+    return AttributeStatic<Matrix>::make(readMatrix<Real>(in));
+  case ValueType::MatrixComp:
+    return AttributeStatic<MatrixComp>::make(readMatrix<Complex>(in));
+  }
+  throw SystemError("Invalid attribute type in snapshot");
+}
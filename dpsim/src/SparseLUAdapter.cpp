@@ -38,4 +38,14 @@ void SparseLUAdapter::partialRefactorize(
 Matrix SparseLUAdapter::solve(Matrix &mRightHandSideVector) {
   return LUFactorizedSparse.solve(mRightHandSideVector);
 }
+
+void SparseLUAdapter::solve(const Matrix &rightSideVector,
+                            Matrix &leftSideVector) {
+  leftSideVector = LUFactorizedSparse.solve(rightSideVector);
+}
+
+std::size_t SparseLUAdapter::memoryUsage() {
+  return (LUFactorizedSparse.nnzL() + LUFactorizedSparse.nnzU()) *
+         (sizeof(Real) + sizeof(int));
+}
 } // namespace DPsim
@@ -6,6 +6,7 @@
  * file, You can obtain one at https://mozilla.org/MPL/2.0/.
  *********************************************************************************/
 
+#include <dpsim/AllocationCounter.h>
 #include <dpsim/ThreadScheduler.h>
 
 #include <iostream>
@@ -16,7 +17,7 @@ using namespace DPsim;
 ThreadScheduler::ThreadScheduler(Int threads, String outMeasurementFile,
                                  Bool useConditionVariable)
     : mNumThreads(threads), mOutMeasurementFile(outMeasurementFile),
-      mStartBarrier(threads, useConditionVariable) {
+      mStartBarrier(threads, useConditionVariable, &mWaitStrategy) {
   if (threads < 1)
     throw SchedulingException();
   mTempSchedules.resize(threads);
@@ -67,6 +68,11 @@ void ThreadScheduler::finishSchedule(const Edges &inEdges) {
 void ThreadScheduler::step(Real time, Int timeStepCount) {
   mTime = time;
   mTimeStepCount = timeStepCount;
+
+  uint64_t parks = mWaitStrategy.parks();
+  mLastStepParks = parks - mStepStartParks;
+  mStepStartParks = parks;
+
   mStartBarrier.wait();
   doStep(0);
   // since we don't have a final BarrierTask, wait for all threads to finish
@@ -74,7 +80,7 @@ void ThreadScheduler::step(Real time, Int timeStepCount) {
   for (int thread = 1; thread < mNumThreads; thread++) {
     if (mTempSchedules[thread].size() != 0)
       mSchedules[thread][mTempSchedules[thread].size() - 1].endCounter.wait(
-          mTimeStepCount + 1);
+          mTimeStepCount + 1, mWaitStrategy);
   }
 }
 
@@ -89,9 +95,11 @@ void ThreadScheduler::stop() {
   if (!mOutMeasurementFile.empty()) {
     writeMeasurements(mOutMeasurementFile);
   }
+  SPDLOG_LOGGER_INFO(mSLog, "Threads parked {} times", mWaitStrategy.parks());
 }
 
 void ThreadScheduler::threadFunction(ThreadScheduler *sched, Int idx) {
+  AllocationCounter::countThisThread(true);
   while (true) {
     sched->mStartBarrier.wait();
     if (sched->mJoining)
@@ -106,7 +114,7 @@ void ThreadScheduler::doStep(Int thread) {
     for (size_t i = 0; i != mTempSchedules[thread].size(); i++) {
       ScheduleEntry *entry = &mSchedules[thread][i];
       for (Counter *counter : entry->reqCounters)
-        counter->wait(mTimeStepCount + 1);
+        counter->wait(mTimeStepCount + 1, mWaitStrategy);
       entry->task->execute(mTime, mTimeStepCount);
       entry->endCounter.inc();
     }
@@ -114,7 +122,7 @@ void ThreadScheduler::doStep(Int thread) {
     for (size_t i = 0; i != mTempSchedules[thread].size(); i++) {
       ScheduleEntry *entry = &mSchedules[thread][i];
       for (Counter *counter : entry->reqCounters)
-        counter->wait(mTimeStepCount + 1);
+        counter->wait(mTimeStepCount + 1, mWaitStrategy);
       auto start = std::chrono::steady_clock::now();
       entry->task->execute(mTime, mTimeStepCount);
       auto end = std::chrono::steady_clock::now();
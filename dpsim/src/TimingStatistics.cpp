@@ -0,0 +1,157 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <dpsim/TimingStatistics.h>
+
+using namespace DPsim;
+
+void TimingStatistics::reset() {
+  mCount.store(0, std::memory_order_relaxed);
+  mMean.store(0, std::memory_order_relaxed);
+  mM2.store(0, std::memory_order_relaxed);
+  mMin.store(std::numeric_limits<Real>::max(), std::memory_order_relaxed);
+  mMax.store(0, std::memory_order_relaxed);
+  for (auto &bucket : mBuckets)
+    bucket.store(0, std::memory_order_relaxed);
+}
+
+void TimingStatistics::update(Real seconds) {
+  // Only one thread writes, so plain loads and stores are sufficient
+  uint64_t n = mCount.load(std::memory_order_relaxed) + 1;
+  Real mean = mMean.load(std::memory_order_relaxed);
+  Real delta = seconds - mean;
+  mean += delta / static_cast<Real>(n);
+  mMean.store(mean, std::memory_order_relaxed);
+  mM2.store(mM2.load(std::memory_order_relaxed) + delta * (seconds - mean),
+            std::memory_order_relaxed);
+
+  if (seconds < mMin.load(std::memory_order_relaxed))
+    mMin.store(seconds, std::memory_order_relaxed);
+  if (seconds > mMax.load(std::memory_order_relaxed))
+    mMax.store(seconds, std::memory_order_relaxed);
+
+  uint64_t nanoseconds =
+      seconds > 0 ? static_cast<uint64_t>(std::llround(seconds * 1e9)) : 0;
+  auto &bucket = mBuckets[bucketIndex(nanoseconds)];
+  bucket.store(bucket.load(std::memory_order_relaxed) + 1,
+               std::memory_order_relaxed);
+
+  mCount.store(n, std::memory_order_release);
+}
+
+Real TimingStatistics::variance() const {
+  uint64_t n = count();
+  if (n < 2)
+    return 0;
+  return mM2.load(std::memory_order_relaxed) / static_cast<Real>(n - 1);
+}
+
+Real TimingStatistics::stdDeviation() const { return std::sqrt(variance()); }
+
+Real TimingStatistics::min() const {
+  return count() > 0 ? mMin.load(std::memory_order_relaxed) : 0;
+}
+
+Real TimingStatistics::max() const {
+  return count() > 0 ? mMax.load(std::memory_order_relaxed) : 0;
+}
+
+Real TimingStatistics::percentile(Real q) const {
+  uint64_t n = count();
+  if (n == 0)
+    return 0;
+
+  q = std::clamp(q, 0.0, 1.0);
+  uint64_t rank = std::max<uint64_t>(
+      1, static_cast<uint64_t>(std::ceil(q * static_cast<Real>(n))));
+
+  uint64_t cumulative = 0;
+  for (UInt i = 0; i < BucketCount; ++i) {
+    cumulative += mBuckets[i].load(std::memory_order_relaxed);
+    if (cumulative >= rank) {
+      // Report the middle of the bucket, but never leave the observed range
+      Real value =
+          (bucketLowerBound(i) + 0.5 * (bucketWidth(i) - 1)) * 1e-9;
+      return std::clamp(value, min(), max());
+    }
+  }
+  return max();
+}
+
+void TimingStatistics::logSummary(CPS::Logger::Log log,
+                                  const String &name) const {
+  SPDLOG_LOGGER_INFO(log, "Number of {:s}: {:d}", name, count());
+  if (count() == 0)
+    return;
+  SPDLOG_LOGGER_INFO(log, "Cumulative {:s} time: {:.12f}", name, sum());
+  SPDLOG_LOGGER_INFO(log, "Average {:s} time: {:.12f}", name, mean());
+  SPDLOG_LOGGER_INFO(log, "Standard deviation of {:s} time: {:.12f}", name,
+                     stdDeviation());
+  SPDLOG_LOGGER_INFO(log, "Minimum {:s} time: {:.12f}", name, min());
+  SPDLOG_LOGGER_INFO(log, "Maximum {:s} time: {:.12f}", name, max());
+  SPDLOG_LOGGER_INFO(log, "{:s} time p50 / p99 / p99.9: {:.9f} / {:.9f} / {:.9f}",
+                     name, percentile(0.5), percentile(0.99),
+                     percentile(0.999));
+}
+
+void TimingStatistics::logHistogram(CPS::Logger::Log log) const {
+  log->info("lower_bound,count");
+  for (UInt i = 0; i < BucketCount; ++i) {
+    auto bucketCount = mBuckets[i].load(std::memory_order_relaxed);
+    if (bucketCount > 0)
+      log->info("{:.9f},{:d}", bucketLowerBound(i) * 1e-9, bucketCount);
+  }
+}
+
+void TimingStatistics::logSamples(CPS::Logger::Log log) const {
+  for (UInt i = 0; i < BucketCount; ++i) {
+    auto bucketCount = mBuckets[i].load(std::memory_order_relaxed);
+    if (bucketCount == 0)
+      continue;
+    Real value = std::clamp(
+        (bucketLowerBound(i) + 0.5 * (bucketWidth(i) - 1)) * 1e-9, min(),
+        max());
+    for (uint64_t n = 0; n < bucketCount; ++n)
+      log->info("{:.9f}", value);
+  }
+}
+
+UInt TimingStatistics::bucketIndex(uint64_t nanoseconds) {
+  if (nanoseconds < 2 * SubBucketCount)
+    return static_cast<UInt>(nanoseconds);
+
+  // Position of the most significant bit
+  UInt msb = 63;
+  while (!(nanoseconds >> msb))
+    --msb;
+  if (msb >= MaxBits)
+    return BucketCount - 1;
+
+  // Keep SubBucketBits + 1 significant bits
+  UInt shift = msb - SubBucketBits;
+  return (shift + 1) * SubBucketCount +
+         static_cast<UInt>(nanoseconds >> shift) - SubBucketCount;
+}
+
+uint64_t TimingStatistics::bucketLowerBound(UInt index) {
+  if (index < 2 * SubBucketCount)
+    return index;
+  UInt shift = index / SubBucketCount - 1;
+  return static_cast<uint64_t>(index % SubBucketCount + SubBucketCount)
+         << shift;
+}
+
+uint64_t TimingStatistics::bucketWidth(UInt index) {
+  if (index < 2 * SubBucketCount)
+    return 1;
+  return uint64_t(1) << (index / SubBucketCount - 1);
+}
@@ -0,0 +1,93 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <chrono>
+#include <climits>
+#include <thread>
+
+#include <dpsim/WaitStrategy.h>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64)
+#include <immintrin.h>
+#endif
+
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+using namespace DPsim;
+
+static_assert(sizeof(std::atomic<Int>) == sizeof(int) &&
+                  std::atomic<Int>::is_always_lock_free,
+              "futex requires a lock-free 32 bit atomic");
+
+void WaitStrategy::pause() {
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64)
+  _mm_pause();
+#elif defined(__aarch64__)
+  asm volatile("yield");
+#endif
+}
+
+WaitStrategy &WaitStrategy::global() {
+  static WaitStrategy strategy;
+  return strategy;
+}
+
+void WaitStrategy::wait(const std::atomic<Int> &word, Int value,
+                        std::atomic<Int> &waiters) {
+  for (UInt i = 0; i < mPolicy.spinCount; ++i) {
+    if (word.load(std::memory_order_acquire) != value)
+      return;
+    pause();
+  }
+
+  for (UInt i = 0; i < mPolicy.yieldCount; ++i) {
+    if (word.load(std::memory_order_acquire) != value)
+      return;
+    std::this_thread::yield();
+  }
+
+  if (!mPolicy.park) {
+    while (word.load(std::memory_order_acquire) == value)
+      pause();
+    return;
+  }
+
+  while (word.load(std::memory_order_acquire) == value) {
+    // Announce the waiter before checking the value again. Together with the
+    // sequentially consistent update and waiter check in the waking thread,
+    // either this thread sees the new value or the waker sees the waiter.
+    waiters.fetch_add(1, std::memory_order_seq_cst);
+    if (word.load(std::memory_order_seq_cst) == value) {
+      mParks.fetch_add(1, std::memory_order_relaxed);
+      park(word, value);
+    }
+    waiters.fetch_sub(1, std::memory_order_relaxed);
+  }
+}
+
+void WaitStrategy::park(const std::atomic<Int> &word, Int value) {
+#ifdef __linux__
+  // Returns immediately if the value already changed, spurious wake-ups are
+  // handled by the caller
+  syscall(SYS_futex, reinterpret_cast<const int *>(&word), FUTEX_WAIT_PRIVATE,
+          value, nullptr, nullptr, 0);
+#else
+  std::this_thread::sleep_for(std::chrono::microseconds(50));
+#endif
+}
+
+void WaitStrategy::wakeAll(std::atomic<Int> &word) {
+#ifdef __linux__
+  syscall(SYS_futex, reinterpret_cast<int *>(&word), FUTEX_WAKE_PRIVATE,
+          INT_MAX, nullptr, nullptr, 0);
+#endif
+}
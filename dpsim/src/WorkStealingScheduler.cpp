@@ -0,0 +1,269 @@
+/* Copyright 2017-2021 Institute for Automation of Complex Power Systems,
+ *                     EONERC, RWTH Aachen University
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at https://mozilla.org/MPL/2.0/.
+ *********************************************************************************/
+
+#include <dpsim/AllocationCounter.h>
+#include <dpsim/WorkStealingScheduler.h>
+
+#include <algorithm>
+
+using namespace CPS;
+using namespace DPsim;
+
+WorkStealingScheduler::Deque::Deque(size_t capacity)
+    : mBuffer(new std::atomic<UInt>[capacity]), mTop(0), mBottom(0) {}
+
+void WorkStealingScheduler::Deque::reset() {
+  mTop.store(0, std::memory_order_relaxed);
+  mBottom.store(0, std::memory_order_relaxed);
+}
+
+void WorkStealingScheduler::Deque::push(UInt task) {
+  int64_t bottom = mBottom.load(std::memory_order_relaxed);
+  mBuffer[bottom].store(task, std::memory_order_relaxed);
+  mBottom.store(bottom + 1, std::memory_order_release);
+}
+
+Bool WorkStealingScheduler::Deque::pop(UInt &task) {
+  int64_t bottom = mBottom.load(std::memory_order_relaxed) - 1;
+  mBottom.store(bottom, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  int64_t top = mTop.load(std::memory_order_relaxed);
+
+  if (top > bottom) {
+    mBottom.store(bottom + 1, std::memory_order_relaxed);
+    return false;
+  }
+
+  task = mBuffer[bottom].load(std::memory_order_relaxed);
+  if (top == bottom) {
+    // Last entry, race against thieves
+    Bool won = mTop.compare_exchange_strong(top, top + 1,
+                                            std::memory_order_seq_cst,
+                                            std::memory_order_relaxed);
+    mBottom.store(bottom + 1, std::memory_order_relaxed);
+    return won;
+  }
+  return true;
+}
+
+Bool WorkStealingScheduler::Deque::steal(UInt &task) {
+  int64_t top = mTop.load(std::memory_order_acquire);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  int64_t bottom = mBottom.load(std::memory_order_acquire);
+
+  if (top >= bottom)
+    return false;
+
+  task = mBuffer[top].load(std::memory_order_relaxed);
+  return mTop.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst,
+                                      std::memory_order_relaxed);
+}
+
+WorkStealingScheduler::WorkStealingScheduler(Int threads,
+                                             String outMeasurementFile,
+                                             String inMeasurementFile)
+    : mNumThreads(threads), mOutMeasurementFile(outMeasurementFile),
+      mInMeasurementFile(inMeasurementFile),
+      mStartBarrier(threads, false, &mWaitStrategy) {
+  if (threads < 1)
+    throw SchedulingException();
+}
+
+WorkStealingScheduler::~WorkStealingScheduler() {
+  if (!mThreads.empty() && !mJoining) {
+    mJoining = true;
+    mStartBarrier.wait();
+    for (auto &thread : mThreads)
+      thread.join();
+  }
+}
+
+void WorkStealingScheduler::createSchedule(const Task::List &tasks,
+                                           const Edges &inEdges,
+                                           const Edges &outEdges) {
+  Task::List ordered;
+  Scheduler::topologicalSort(tasks, inEdges, outEdges, ordered);
+  Scheduler::initMeasurements(ordered);
+
+  std::unordered_map<String, TaskTime::rep> measurements;
+  if (!mInMeasurementFile.empty())
+    readMeasurements(mInMeasurementFile, measurements);
+
+  std::unordered_map<Task::Ptr, UInt> indices;
+  for (UInt i = 0; i < ordered.size(); i++)
+    indices[ordered[i]] = i;
+
+  mTasks.clear();
+  mTasks.resize(ordered.size());
+  for (UInt i = 0; i < ordered.size(); i++) {
+    auto &task = ordered[i];
+    mTasks[i].task = task.get();
+    mTasks[i].predecessors = 0;
+    if (inEdges.find(task) != inEdges.end()) {
+      for (auto &before : inEdges.at(task)) {
+        if (indices.count(before))
+          mTasks[i].predecessors++;
+      }
+    }
+    if (outEdges.find(task) != outEdges.end()) {
+      for (auto &after : outEdges.at(task)) {
+        auto it = indices.find(after);
+        if (it != indices.end())
+          mTasks[i].successors.push_back(it->second);
+      }
+    }
+  }
+
+  // Longest path to the end of the step, computed in reverse topological order
+  for (UInt i = static_cast<UInt>(ordered.size()); i-- > 0;) {
+    TaskTime::rep weight = 1;
+    if (!mInMeasurementFile.empty()) {
+      auto it = measurements.find(ordered[i]->toString());
+      if (it == measurements.end())
+        throw SchedulingException();
+      weight = std::max<TaskTime::rep>(it->second, 1);
+    }
+    TaskTime::rep longest = 0;
+    for (UInt after : mTasks[i].successors)
+      longest = std::max(longest, mTasks[after].priority);
+    mTasks[i].priority = weight + longest;
+  }
+
+  auto byPriority = [this](UInt a, UInt b) {
+    return mTasks[a].priority > mTasks[b].priority;
+  };
+  mInitialTasks.clear();
+  for (UInt i = 0; i < mTasks.size(); i++) {
+    std::sort(mTasks[i].successors.begin(), mTasks[i].successors.end(),
+              byPriority);
+    if (mTasks[i].predecessors == 0)
+      mInitialTasks.push_back(i);
+  }
+  std::sort(mInitialTasks.begin(), mInitialTasks.end(), byPriority);
+
+  mPending.reset(new std::atomic<UInt>[mTasks.size()]);
+  mDeques.clear();
+  for (Int thread = 0; thread < mNumThreads; thread++)
+    mDeques.push_back(
+        std::make_unique<Deque>(std::max<size_t>(mTasks.size(), 1)));
+
+  for (Int thread = 1; thread < mNumThreads; thread++)
+    mThreads.emplace_back(threadFunction, this, thread);
+}
+
+void WorkStealingScheduler::step(Real time, Int timeStepCount) {
+  mTime = time;
+  mTimeStepCount = timeStepCount;
+
+  uint64_t parks = mWaitStrategy.parks();
+  mLastStepParks = parks - mStepStartParks;
+  mStepStartParks = parks;
+
+  for (UInt i = 0; i < mTasks.size(); i++)
+    mPending[i].store(mTasks[i].predecessors, std::memory_order_relaxed);
+  for (auto &deque : mDeques)
+    deque->reset();
+
+  // Deal the initial tasks to the threads so that every thread starts with
+  // one of the most critical tasks. Pushing in reverse order lets each
+  // owner pop its most critical task first.
+  for (size_t i = mInitialTasks.size(); i-- > 0;)
+    mDeques[i % mNumThreads]->push(mInitialTasks[i]);
+
+  mRemaining.store(static_cast<Int>(mTasks.size()), std::memory_order_relaxed);
+  mActiveThreads.store(mNumThreads - 1, std::memory_order_relaxed);
+
+  mStartBarrier.wait();
+  doStep(0);
+
+  // The deques are reset in the next step, so wait until no other thread
+  // accesses them anymore
+  Int active;
+  while ((active = mActiveThreads.load(std::memory_order_acquire)) != 0)
+    mWaitStrategy.wait(mActiveThreads, active, mActiveWaiters);
+}
+
+void WorkStealingScheduler::stop() {
+  if (!mThreads.empty() && !mJoining) {
+    mJoining = true;
+    mStartBarrier.wait();
+    for (auto &thread : mThreads)
+      thread.join();
+  }
+  if (!mOutMeasurementFile.empty()) {
+    writeMeasurements(mOutMeasurementFile);
+  }
+  SPDLOG_LOGGER_INFO(mSLog, "Threads parked {} times", mWaitStrategy.parks());
+}
+
+void WorkStealingScheduler::threadFunction(WorkStealingScheduler *sched,
+                                           Int idx) {
+  AllocationCounter::countThisThread(true);
+  while (true) {
+    sched->mStartBarrier.wait();
+    if (sched->mJoining)
+      return;
+
+    sched->doStep(idx);
+    sched->mActiveThreads.fetch_sub(1, std::memory_order_seq_cst);
+    WaitStrategy::wake(sched->mActiveThreads, sched->mActiveWaiters);
+  }
+}
+
+Bool WorkStealingScheduler::execute(UInt task, Int thread, UInt &next) {
+  TaskEntry &entry = mTasks[task];
+
+  if (mOutMeasurementFile.empty()) {
+    entry.task->execute(mTime, mTimeStepCount);
+  } else {
+    auto start = std::chrono::steady_clock::now();
+    entry.task->execute(mTime, mTimeStepCount);
+    auto end = std::chrono::steady_clock::now();
+    updateMeasurement(entry.task, end - start);
+  }
+
+  // Continue with the most critical successor that became ready and leave
+  // the others to this thread's deque, where idle threads can steal them.
+  // Going through the successors by ascending priority pushes the most
+  // critical of the remaining ones last, so the owner pops it first.
+  Bool hasNext = false;
+  for (auto it = entry.successors.rbegin(); it != entry.successors.rend();
+       ++it) {
+    if (mPending[*it].fetch_sub(1, std::memory_order_acq_rel) != 1)
+      continue;
+    if (hasNext)
+      mDeques[thread]->push(next);
+    next = *it;
+    hasNext = true;
+  }
+
+  mRemaining.fetch_sub(1, std::memory_order_seq_cst);
+  WaitStrategy::wake(mRemaining, mRemainingWaiters);
+  return hasNext;
+}
+
+void WorkStealingScheduler::doStep(Int thread) {
+  UInt task;
+  Deque &own = *mDeques[thread];
+
+  Int remaining;
+  while ((remaining = mRemaining.load(std::memory_order_acquire)) != 0) {
+    Bool found = own.pop(task);
+    for (Int i = 1; !found && i < mNumThreads; i++)
+      found = mDeques[(thread + i) % mNumThreads]->steal(task);
+    if (!found) {
+      // Tasks are pushed before mRemaining is decremented, so there is new
+      // work or the step is done once mRemaining changed
+      mWaitStrategy.wait(mRemaining, remaining, mRemainingWaiters);
+      continue;
+    }
+
+    while (execute(task, thread, task))
+      ;
+  }
+}
@@ -6,6 +6,8 @@
  * file, You can obtain one at https://mozilla.org/MPL/2.0/.
  *********************************************************************************/
 
+#include <pybind11/numpy.h>
+
 #include <DPsim.h>
 #include <dpsim-models/CSVReader.h>
 #include <dpsim-models/IdentifiedObject.h>
@@ -19,6 +21,26 @@ PYBIND11_DECLARE_HOLDER_TYPE(T, CPS::AttributePointer<T>);
 namespace py = pybind11;
 using namespace pybind11::literals;
 
+// Describes the storage of a matrix attribute for the buffer protocol, so
+// that numpy arrays can use it without copying. Writing to such an array
+// changes the attribute. Resizing the matrix invalidates the array.
+template <typename T>
+py::buffer_info matrixBuffer(CPS::Attribute<CPS::MatrixVar<T>> &attr) {
+  auto &matrix = attr.get();
+  return py::buffer_info(
+      matrix.data(), sizeof(T), py::format_descriptor<T>::format(), 2,
+      {static_cast<py::ssize_t>(matrix.rows()),
+       static_cast<py::ssize_t>(matrix.cols())},
+      {static_cast<py::ssize_t>(sizeof(T)),
+       static_cast<py::ssize_t>(sizeof(T) * matrix.rows())});
+}
+
+// Numpy view of a matrix attribute which keeps the attribute alive
+template <typename T> py::array matrixView(py::object self) {
+  auto &attr = self.cast<CPS::Attribute<CPS::MatrixVar<T>> &>();
+  return py::array(matrixBuffer(attr), self);
+}
+
 void addAttributes(py::module_ m) {
 
   py::class_<CPS::AttributeBase, CPS::AttributePointer<CPS::AttributeBase>>(
@@ -77,9 +99,11 @@ void addAttributes(py::module_ m) {
 
   py::class_<CPS::Attribute<CPS::Matrix>,
              CPS::AttributePointer<CPS::Attribute<CPS::Matrix>>,
-             CPS::AttributeBase>(m, "AttributeMatrix")
+             CPS::AttributeBase>(m, "AttributeMatrix", py::buffer_protocol())
       .def("get", &CPS::Attribute<CPS::Matrix>::get)
       .def("set", &CPS::Attribute<CPS::Matrix>::set)
+      .def_buffer(&matrixBuffer<CPS::Real>)
+      .def("numpy", &matrixView<CPS::Real>)
       .def("derive_coeff",
            &CPS::Attribute<CPS::Matrix>::deriveCoeff<CPS::Real>);
 
@@ -93,9 +117,12 @@ void addAttributes(py::module_ m) {
 
   py::class_<CPS::Attribute<CPS::MatrixComp>,
              CPS::AttributePointer<CPS::Attribute<CPS::MatrixComp>>,
-             CPS::AttributeBase>(m, "AttributeMatrixComp")
+             CPS::AttributeBase>(m, "AttributeMatrixComp",
+                                 py::buffer_protocol())
       .def("get", &CPS::Attribute<CPS::MatrixComp>::get)
       .def("set", &CPS::Attribute<CPS::MatrixComp>::set)
+      .def_buffer(&matrixBuffer<CPS::Complex>)
+      .def("numpy", &matrixView<CPS::Complex>)
       .def("derive_coeff",
            &CPS::Attribute<CPS::MatrixComp>::deriveCoeff<CPS::Complex>);
 
@@ -12,6 +12,7 @@
 #include <pybind11/eigen.h>
 #include <pybind11/functional.h>
 #include <pybind11/iostream.h>
+#include <pybind11/numpy.h>
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
 
@@ -172,6 +173,44 @@ PYBIND11_MODULE(dpsimpy, m) {
                getPartialRefactorizationMethod)
       .def("get_btf", &DPsim::DirectLinearSolverConfiguration::getBTF);
 
+  py::class_<DPsim::TimingStatistics>(m, "TimingStatistics")
+      .def("count", &DPsim::TimingStatistics::count)
+      .def("mean", &DPsim::TimingStatistics::mean)
+      .def("variance", &DPsim::TimingStatistics::variance)
+      .def("std_deviation", &DPsim::TimingStatistics::stdDeviation)
+      .def("min", &DPsim::TimingStatistics::min)
+      .def("max", &DPsim::TimingStatistics::max)
+      .def("percentile", &DPsim::TimingStatistics::percentile, "q"_a);
+
+#ifdef WITH_KLU
+  // Static methods operating on the cache shared by all KLU solvers
+  using KLUCache = DPsim::KLUFactorizationCache;
+  py::class_<KLUCache, std::unique_ptr<KLUCache, py::nodelete>>(
+      m, "KLUFactorizationCache")
+      .def_static(
+          "set_capacity",
+          [](CPS::UInt capacity) { KLUCache::global().setCapacity(capacity); },
+          "capacity"_a)
+      .def_static("capacity", []() { return KLUCache::global().capacity(); })
+      .def_static("clear", []() { KLUCache::global().clear(); })
+      .def_static("hits", []() { return KLUCache::global().hits(); })
+      .def_static("symbolic_hits",
+                  []() { return KLUCache::global().symbolicHits(); })
+      .def_static("misses", []() { return KLUCache::global().misses(); })
+      .def_static("evictions", []() { return KLUCache::global().evictions(); })
+      .def_static("hit_rate", []() { return KLUCache::global().hitRate(); })
+      .def_static("reset_statistics",
+                  []() { KLUCache::global().resetStatistics(); });
+#endif
+
+  using SwitchStateCacheStatistics = DPsim::Solver::SwitchStateCacheStatistics;
+  py::class_<SwitchStateCacheStatistics>(m, "SwitchStateCacheStatistics")
+      .def_readonly("hits", &SwitchStateCacheStatistics::hits)
+      .def_readonly("misses", &SwitchStateCacheStatistics::misses)
+      .def_readonly("evictions", &SwitchStateCacheStatistics::evictions)
+      .def_readonly("states", &SwitchStateCacheStatistics::states)
+      .def_readonly("memory", &SwitchStateCacheStatistics::memory);
+
   py::class_<DPsim::Simulation>(m, "Simulation")
       .def(py::init<std::string, CPS::Logger::Level>(), "name"_a,
            "loglevel"_a = CPS::Logger::Level::off)
@@ -180,11 +219,16 @@ PYBIND11_MODULE(dpsimpy, m) {
       .def("set_final_time", &DPsim::Simulation::setFinalTime)
       .def("add_logger", &DPsim::Simulation::addLogger)
       .def("set_system", &DPsim::Simulation::setSystem)
-      .def("run", &DPsim::Simulation::run)
+      .def("run", &DPsim::Simulation::run,
+           py::call_guard<py::gil_scoped_release>())
       .def("set_solver", &DPsim::Simulation::setSolverType)
       .def("set_domain", &DPsim::Simulation::setDomain)
       .def("start", &DPsim::Simulation::start)
       .def("next", &DPsim::Simulation::next)
+      .def("run_for", &DPsim::Simulation::runFor, "steps"_a,
+           py::call_guard<py::gil_scoped_release>())
+      .def("run_until", &DPsim::Simulation::runUntil, "time"_a,
+           py::call_guard<py::gil_scoped_release>())
       .def("stop", &DPsim::Simulation::stop)
       .def("get_idobj_attr", &DPsim::Simulation::getIdObjAttribute, "comp"_a,
            "attr"_a)
@@ -197,6 +241,20 @@ PYBIND11_MODULE(dpsimpy, m) {
            &DPsim::Simulation::doInitFromNodesAndTerminals)
       .def("do_system_matrix_recomputation",
            &DPsim::Simulation::doSystemMatrixRecomputation)
+      .def("do_sparse_right_vector", &DPsim::Simulation::doSparseRightVector)
+      .def("do_allocation_check", &DPsim::Simulation::doAllocationCheck)
+      .def("set_step_time_sample_limit",
+           &DPsim::Simulation::setStepTimeSampleLimit, "limit"_a)
+      .def("do_sparse_powerflow_jacobian",
+           &DPsim::Simulation::doSparsePowerflowJacobian)
+      .def("set_switch_state_cache", &DPsim::Simulation::setSwitchStateCache,
+           "max_states"_a, "max_memory"_a = 0)
+      .def("set_likely_switch_states",
+           &DPsim::Simulation::setLikelySwitchStates, "states"_a)
+      .def("switch_state_cache_statistics",
+           &DPsim::Simulation::switchStateCacheStatistics)
+      .def("set_low_rank_switch_updates",
+           &DPsim::Simulation::setLowRankSwitchUpdates, "max_indices"_a)
       .def("do_steady_state_init", &DPsim::Simulation::doSteadyStateInit)
       .def("do_frequency_parallelization",
            &DPsim::Simulation::doFrequencyParallelization)
@@ -209,7 +267,64 @@ PYBIND11_MODULE(dpsimpy, m) {
            &DPsim::Simulation::setDirectLinearSolverImplementation)
       .def("set_direct_linear_solver_configuration",
            &DPsim::Simulation::setDirectLinearSolverConfiguration)
-      .def("log_lu_times", &DPsim::Simulation::logLUTimes);
+      .def("log_lu_times", &DPsim::Simulation::logLUTimes)
+      .def(
+          "save_snapshot",
+          [](DPsim::Simulation &sim, const std::string &path) {
+            sim.saveSnapshot(path);
+          },
+          "path"_a)
+      .def(
+          "restore_from_snapshot",
+          [](DPsim::Simulation &sim, const std::string &path) {
+            sim.restoreFromSnapshot(path);
+          },
+          "path"_a)
+      .def("step_times", &DPsim::Simulation::stepTimes,
+           py::return_value_policy::reference_internal)
+      .def_property_readonly("step_time_mean",
+                             [](DPsim::Simulation &sim) {
+                               return sim.mStepTimeMean;
+                             })
+      .def_property_readonly("step_time_max",
+                             [](DPsim::Simulation &sim) {
+                               return sim.mStepTimeMax;
+                             })
+      .def_property_readonly("step_time_p50",
+                             [](DPsim::Simulation &sim) {
+                               return sim.mStepTimeP50;
+                             })
+      .def_property_readonly("step_time_p99",
+                             [](DPsim::Simulation &sim) {
+                               return sim.mStepTimeP99;
+                             })
+      .def_property_readonly("step_time_p999",
+                             [](DPsim::Simulation &sim) {
+                               return sim.mStepTimeP999;
+                             })
+      .def_property_readonly("solve_time_mean",
+                             [](DPsim::Simulation &sim) {
+                               return sim.mSolveTimeMean;
+                             })
+      .def_property_readonly("solve_time_max",
+                             [](DPsim::Simulation &sim) {
+                               return sim.mSolveTimeMax;
+                             })
+      .def_property_readonly("factorize_time_mean",
+                             [](DPsim::Simulation &sim) {
+                               return sim.mFactorizeTimeMean;
+                             })
+      .def_property_readonly("factorize_time_max",
+                             [](DPsim::Simulation &sim) {
+                               return sim.mFactorizeTimeMax;
+                             })
+      .def_property_readonly("recompute_time_mean",
+                             [](DPsim::Simulation &sim) {
+                               return sim.mRecomputeTimeMean;
+                             })
+      .def_property_readonly("recompute_time_max", [](DPsim::Simulation &sim) {
+        return sim.mRecomputeTimeMax;
+      });
 
   py::class_<DPsim::RealTimeSimulation, DPsim::Simulation>(m,
                                                            "RealTimeSimulation")
@@ -222,7 +337,8 @@ PYBIND11_MODULE(dpsimpy, m) {
       .def("set_system", &DPsim::RealTimeSimulation::setSystem)
       .def("run",
            static_cast<void (DPsim::RealTimeSimulation::*)(CPS::Int startIn)>(
-               &DPsim::RealTimeSimulation::run))
+               &DPsim::RealTimeSimulation::run),
+           py::call_guard<py::gil_scoped_release>())
       .def("set_solver", &DPsim::RealTimeSimulation::setSolverType)
       .def("set_domain", &DPsim::RealTimeSimulation::setDomain);
 
@@ -250,6 +366,7 @@ PYBIND11_MODULE(dpsimpy, m) {
       .def("component",
            &DPsim::SystemTopology::component<CPS::TopologicalPowerComp>)
       .def("add_tear_component", &DPsim::SystemTopology::addTearComponent)
+      .def("copy", &DPsim::SystemTopology::copy)
 #ifdef WITH_GRAPHVIZ
       .def("_repr_svg_", &DPsim::SystemTopology::render)
       .def("render_to_file", &DPsim::SystemTopology::renderToFile)
@@ -291,11 +408,20 @@ PYBIND11_MODULE(dpsimpy, m) {
              logger.logAttribute(names, comp.attribute(attr));
            });
 
+  py::enum_<DPsim::AsyncLogBuffer::OverflowPolicy>(m, "LogOverflowPolicy")
+      .value("drop", DPsim::AsyncLogBuffer::OverflowPolicy::Drop)
+      .value("block", DPsim::AsyncLogBuffer::OverflowPolicy::Block)
+      .value("count", DPsim::AsyncLogBuffer::OverflowPolicy::Count);
+
   py::class_<DPsim::DataLogger, DPsim::DataLoggerInterface,
              std::shared_ptr<DPsim::DataLogger>>(m, "Logger")
       .def(py::init<std::string>())
       .def_static("set_log_dir", &CPS::Logger::setLogDir)
       .def_static("get_log_dir", &CPS::Logger::logDir)
+      .def("set_async_buffer", &DPsim::DataLogger::setAsyncBuffer, "rows"_a,
+           "policy"_a = DPsim::AsyncLogBuffer::OverflowPolicy::Count)
+      .def_property_readonly("async_overruns",
+                             &DPsim::DataLogger::asyncOverruns)
       .def("log_attribute",
            py::overload_cast<const CPS::String &, CPS::AttributeBase::Ptr,
                              CPS::UInt, CPS::UInt>(
@@ -323,6 +449,119 @@ PYBIND11_MODULE(dpsimpy, m) {
              logger.logAttribute(names, comp.attribute(attr));
            });
 
+  py::class_<DPsim::MemoryDataLogger, DPsim::DataLoggerInterface,
+             std::shared_ptr<DPsim::MemoryDataLogger>>(m, "MemoryLogger")
+      .def(py::init<std::string, CPS::UInt, CPS::UInt>(), "name"_a, "rows"_a,
+           "downsampling"_a = 1)
+      .def(py::init<std::string, CPS::Real, CPS::Real, CPS::UInt>(), "name"_a,
+           "final_time"_a, "time_step"_a, "downsampling"_a = 1)
+      .def("clear", &DPsim::MemoryDataLogger::clear)
+      .def_property_readonly("rows", &DPsim::MemoryDataLogger::rows)
+      .def_property_readonly("capacity", &DPsim::MemoryDataLogger::capacity)
+      .def_property_readonly("overruns", &DPsim::MemoryDataLogger::overruns)
+      .def_property_readonly("column_names",
+                             &DPsim::MemoryDataLogger::columnNames)
+      // Read-only view of the logged rows without copying, which keeps the
+      // logger alive. It is invalidated by the next start of the logger.
+      .def(
+          "data",
+          [](py::object self) {
+            auto &logger = self.cast<DPsim::MemoryDataLogger &>();
+            py::array_t<CPS::Real> array(
+                {static_cast<py::ssize_t>(logger.rows()),
+                 static_cast<py::ssize_t>(logger.columns())},
+                logger.data(), self);
+            array.attr("setflags")("write"_a = false);
+            return array;
+          })
+      .def(
+          "column",
+          [](py::object self, const CPS::String &name) {
+            auto &logger = self.cast<DPsim::MemoryDataLogger &>();
+            auto names = logger.columnNames();
+            auto it = std::find(names.begin(), names.end(), name);
+            if (it == names.end())
+              throw py::key_error(name);
+            py::array_t<CPS::Real> array(
+                {static_cast<py::ssize_t>(logger.rows())},
+                {static_cast<py::ssize_t>(logger.columns() *
+                                          sizeof(CPS::Real))},
+                logger.data() + (it - names.begin()), self);
+            array.attr("setflags")("write"_a = false);
+            return array;
+          },
+          "name"_a);
+
+  py::class_<DPsim::EnsembleSimulation::ParameterChange>(m, "ParameterChange")
+      .def(py::init([](const CPS::String &component,
+                       const CPS::String &attribute, CPS::Real value,
+                       CPS::Real time) {
+             return DPsim::EnsembleSimulation::ParameterChange{
+                 component, attribute, value, time};
+           }),
+           "component"_a, "attribute"_a, "value"_a, "time"_a = -1)
+      .def_readwrite("component",
+                     &DPsim::EnsembleSimulation::ParameterChange::component)
+      .def_readwrite("attribute",
+                     &DPsim::EnsembleSimulation::ParameterChange::attribute)
+      .def_readwrite("value",
+                     &DPsim::EnsembleSimulation::ParameterChange::value)
+      .def_readwrite("time", &DPsim::EnsembleSimulation::ParameterChange::time);
+
+  py::class_<DPsim::EnsembleSimulation::Member>(m, "EnsembleMember")
+      .def(py::init([](const CPS::String &name,
+                       const std::vector<
+                           DPsim::EnsembleSimulation::ParameterChange>
+                           &changes) {
+             return DPsim::EnsembleSimulation::Member{name, changes};
+           }),
+           "name"_a,
+           "changes"_a =
+               std::vector<DPsim::EnsembleSimulation::ParameterChange>())
+      .def_readwrite("name", &DPsim::EnsembleSimulation::Member::name)
+      .def_readwrite("changes", &DPsim::EnsembleSimulation::Member::changes);
+
+  // Factories and setup functions written in Python hold the GIL while they
+  // are called, the members are simulated without it
+  py::class_<DPsim::EnsembleSimulation>(m, "EnsembleSimulation")
+      .def(py::init<std::string, const CPS::SystemTopology &,
+                    CPS::Logger::Level>(),
+           "name"_a, "system"_a, "loglevel"_a = CPS::Logger::Level::info)
+      .def(py::init<std::string, DPsim::EnsembleSimulation::TopologyFactory,
+                    CPS::Logger::Level>(),
+           "name"_a, "factory"_a, "loglevel"_a = CPS::Logger::Level::info)
+      .def("set_time_step", &DPsim::EnsembleSimulation::setTimeStep)
+      .def("set_final_time", &DPsim::EnsembleSimulation::setFinalTime)
+      .def("set_domain", &DPsim::EnsembleSimulation::setDomain)
+      .def("set_solver", &DPsim::EnsembleSimulation::setSolverType)
+      .def("set_setup", &DPsim::EnsembleSimulation::setSetup)
+      .def("set_threads", &DPsim::EnsembleSimulation::setThreads)
+      .def("share_factorizations",
+           &DPsim::EnsembleSimulation::shareFactorizations, "value"_a = true)
+      .def("log_attribute", &DPsim::EnsembleSimulation::logAttribute, "name"_a,
+           "component"_a, "attribute"_a)
+      .def("add_member", &DPsim::EnsembleSimulation::addMember)
+      .def_property_readonly("members", &DPsim::EnsembleSimulation::members)
+      .def("run", &DPsim::EnsembleSimulation::run,
+           py::call_guard<py::gil_scoped_release>())
+      .def("results", &DPsim::EnsembleSimulation::results,
+           py::return_value_policy::reference_internal)
+      .def_property_readonly("column_names",
+                             &DPsim::EnsembleSimulation::columnNames)
+      .def_property_readonly("errors", &DPsim::EnsembleSimulation::errors)
+      .def("write_csv", [](const DPsim::EnsembleSimulation &ensemble,
+                           const std::string &path) {
+        ensemble.writeCSV(path);
+      });
+
+#ifdef WITH_HDF5
+  py::class_<DPsim::HDF5DataLogger, DPsim::DataLoggerInterface,
+             std::shared_ptr<DPsim::HDF5DataLogger>>(m, "HDF5Logger")
+      .def(py::init<std::string, bool, CPS::UInt, CPS::UInt, CPS::UInt>(),
+           "name"_a, "enabled"_a = true, "downsampling"_a = 1,
+           "chunk_size"_a = 1024, "compression"_a = 0);
+#endif
+
   py::class_<CPS::IdentifiedObject, std::shared_ptr<CPS::IdentifiedObject>>(
       m, "IdentifiedObject")
       .def("name", &CPS::IdentifiedObject::name)
@@ -342,7 +581,15 @@ PYBIND11_MODULE(dpsimpy, m) {
       .def("loadCIM", (CPS::SystemTopology(CPS::CIM::Reader::*)(
                           CPS::Real, const std::list<CPS::String> &,
                           CPS::Domain, CPS::PhaseType, CPS::GeneratorType)) &
-                          CPS::CIM::Reader::loadCIM);
+                          CPS::CIM::Reader::loadCIM)
+      .def("use_parallel_mapping", &CPS::CIM::Reader::useParallelMapping,
+           "value"_a = true)
+      .def(
+          "use_snapshot_cache",
+          [](CPS::CIM::Reader &reader, const std::string &directory) {
+            reader.useSnapshotCache(directory);
+          },
+          "directory"_a);
 #endif
 
   py::class_<CPS::CSVReader>(m, "CSVReader")
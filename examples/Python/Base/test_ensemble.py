@@ -0,0 +1,106 @@
+import dpsimpy
+import numpy as np
+import pytest
+
+TIME_STEP = 0.001
+FINAL_TIME = 0.05
+
+
+def build_system(resistance=5):
+    # Voltage source feeding a resistor and an inductor in series
+    gnd = dpsimpy.dp.SimNode.gnd
+    n1 = dpsimpy.dp.SimNode("n1")
+    n2 = dpsimpy.dp.SimNode("n2")
+
+    vs = dpsimpy.dp.ph1.VoltageSource("vs")
+    vs.set_parameters(V_ref=complex(10, 0))
+    r1 = dpsimpy.dp.ph1.Resistor("r_1")
+    r1.set_parameters(resistance)
+    l1 = dpsimpy.dp.ph1.Inductor("l_1")
+    l1.set_parameters(0.02)
+    vs.connect([gnd, n1])
+    r1.connect([n1, n2])
+    l1.connect([n2, gnd])
+
+    return dpsimpy.SystemTopology(50, [n1, n2], [vs, r1, l1]), l1
+
+
+def reference_current(resistance):
+    system, l1 = build_system(resistance)
+    logger = dpsimpy.MemoryLogger("test_ensemble_reference", FINAL_TIME, TIME_STEP)
+    logger.log_attribute("i", l1.attr("i_intf"))
+
+    sim = dpsimpy.Simulation("test_ensemble_reference", dpsimpy.LogLevel.off)
+    sim.set_system(system)
+    sim.set_domain(dpsimpy.Domain.DP)
+    sim.set_time_step(TIME_STEP)
+    sim.set_final_time(FINAL_TIME)
+    sim.add_logger(logger)
+    sim.run()
+    return logger.column("i.re") + 1j * logger.column("i.im")
+
+
+def run_ensemble(share_factorizations):
+    system, _ = build_system()
+    ensemble = dpsimpy.EnsembleSimulation("test_ensemble", system, dpsimpy.LogLevel.off)
+    ensemble.set_time_step(TIME_STEP)
+    ensemble.set_final_time(FINAL_TIME)
+    ensemble.set_domain(dpsimpy.Domain.DP)
+    ensemble.set_threads(2)
+    ensemble.share_factorizations(share_factorizations)
+    ensemble.log_attribute("i", "l_1", "i_intf")
+
+    ensemble.add_member(dpsimpy.EnsembleMember("r5"))
+    ensemble.add_member(
+        dpsimpy.EnsembleMember("r10", [dpsimpy.ParameterChange("r_1", "R", 10)])
+    )
+    ensemble.add_member(
+        dpsimpy.EnsembleMember("unknown", [dpsimpy.ParameterChange("r_2", "R", 10)])
+    )
+    ensemble.add_member(dpsimpy.EnsembleMember("r5_copy"))
+    ensemble.run()
+    return ensemble
+
+
+def member_current(ensemble, member):
+    results = ensemble.results()
+    names = ensemble.column_names
+    return (
+        results[:, names.index(member + ".i.re")]
+        + 1j * results[:, names.index(member + ".i.im")]
+    )
+
+
+@pytest.mark.parametrize("share_factorizations", [False, True])
+def test_ensemble_results(share_factorizations):
+    ensemble = run_ensemble(share_factorizations)
+
+    assert ensemble.errors == ["", "", "Unknown component r_2", ""]
+
+    names = ensemble.column_names
+    assert names[0] == "time"
+    assert sorted(names[1:]) == sorted(
+        member + column
+        for member in ["r5", "r10", "unknown", "r5_copy"]
+        for column in [".i.re", ".i.im"]
+    )
+
+    results = ensemble.results()
+    rows = round(FINAL_TIME / TIME_STEP) + 1
+    assert results.shape == (rows, len(names))
+    assert results[:, 0] == pytest.approx(np.arange(rows) * TIME_STEP)
+
+    # The failed member has no values
+    unknown = member_current(ensemble, "unknown")
+    assert np.isnan(unknown).all()
+
+    r5 = member_current(ensemble, "r5")
+    assert r5 == pytest.approx(reference_current(5), rel=1e-9)
+    assert member_current(ensemble, "r5_copy") == pytest.approx(r5, rel=1e-9)
+    r10 = member_current(ensemble, "r10")
+    assert r10 == pytest.approx(reference_current(10), rel=1e-9)
+
+
+if __name__ == "__main__":
+    test_ensemble_results(False)
+    test_ensemble_results(True)
@@ -0,0 +1,109 @@
+import dpsimpy
+import numpy as np
+import pytest
+
+TIME_STEP = 0.001
+FINAL_TIME = 0.05
+
+
+def build_simulation(name):
+    # Voltage source feeding a resistor and an inductor in series
+    gnd = dpsimpy.dp.SimNode.gnd
+    n1 = dpsimpy.dp.SimNode("n1")
+    n2 = dpsimpy.dp.SimNode("n2")
+
+    vs = dpsimpy.dp.ph1.VoltageSource("vs")
+    vs.set_parameters(V_ref=complex(10, 0))
+    r1 = dpsimpy.dp.ph1.Resistor("r_1")
+    r1.set_parameters(5)
+    l1 = dpsimpy.dp.ph1.Inductor("l_1")
+    l1.set_parameters(0.02)
+    vs.connect([gnd, n1])
+    r1.connect([n1, n2])
+    l1.connect([n2, gnd])
+
+    system = dpsimpy.SystemTopology(50, [n1, n2], [vs, r1, l1])
+
+    sim = dpsimpy.Simulation(name, dpsimpy.LogLevel.off)
+    sim.set_system(system)
+    sim.set_domain(dpsimpy.Domain.DP)
+    sim.set_time_step(TIME_STEP)
+    sim.set_final_time(FINAL_TIME)
+    return sim, n2
+
+
+def reference_voltages():
+    sim, node = build_simulation("test_run_for_reference")
+    sim.start()
+    voltages = [node.single_voltage()]
+    for _ in range(round(FINAL_TIME / TIME_STEP)):
+        sim.next()
+        voltages.append(node.single_voltage())
+    sim.stop()
+    return voltages
+
+
+def test_run_for_and_run_until():
+    sim, node = build_simulation("test_run_for")
+    logger = dpsimpy.MemoryLogger("test_run_for", FINAL_TIME, TIME_STEP)
+    logger.log_attribute("v2", node.attr("v"))
+    sim.add_logger(logger)
+    sim.start()
+    # One row holds the initial values
+    assert logger.capacity == 51
+
+    # The first step is computed at one time step
+    assert sim.run_for(10) == pytest.approx(11 * TIME_STEP)
+    assert logger.rows == 11
+
+    # Runs up to and including the step at the given time
+    assert sim.run_until(0.03) == pytest.approx(0.031)
+    assert logger.rows == 31
+
+    # Stops at the final time
+    assert sim.run_until(1) == pytest.approx(FINAL_TIME + TIME_STEP)
+    assert sim.run_for(10) == pytest.approx(FINAL_TIME + TIME_STEP)
+    sim.stop()
+    assert logger.rows == logger.capacity
+    assert logger.overruns == 0
+
+    data = logger.data()
+    assert sorted(logger.column_names) == ["time", "v2.im", "v2.re"]
+    assert data.shape == (logger.rows, 3)
+    assert not data.flags.writeable
+
+    time = logger.column("time")
+    assert np.array_equal(time, data[:, 0])
+    assert time == pytest.approx(np.arange(logger.rows) * TIME_STEP)
+
+    voltages = logger.column("v2.re") + 1j * logger.column("v2.im")
+    assert voltages == pytest.approx(reference_voltages(), rel=1e-12)
+
+    with pytest.raises(KeyError):
+        logger.column("v3")
+
+
+def test_memory_logger_view_outlives_logger():
+    sim, node = build_simulation("test_run_for_view")
+    logger = dpsimpy.MemoryLogger("test_run_for_view", 20, downsampling=2)
+    logger.log_attribute("v2", node.attr("v"))
+    sim.add_logger(logger)
+    sim.start()
+    sim.run_for(9)
+    sim.stop()
+
+    # Every second step is logged after the initial values, starting with
+    # the first step
+    time = logger.column("time")
+    expected = np.array([0, 1, 3, 5, 7, 9]) * TIME_STEP
+    assert time == pytest.approx(expected)
+
+    # The views keep the logger alive
+    del logger
+    del sim
+    assert time == pytest.approx(expected)
+
+
+if __name__ == "__main__":
+    test_run_for_and_run_until()
+    test_memory_logger_view_outlives_logger()
@@ -0,0 +1,133 @@
+import dpsimpy
+import pytest
+
+# Switch positions to go through, bit i is set if switch i is closed
+SWITCH_STATES = [0b001, 0b011, 0b111, 0b010, 0b001, 0b100, 0b011, 0b000, 0b110]
+
+
+def build_system():
+    # Voltage source feeding three loads that are connected by switches
+    gnd = dpsimpy.dp.SimNode.gnd
+    n1 = dpsimpy.dp.SimNode("n1")
+    n2 = dpsimpy.dp.SimNode("n2")
+
+    vs = dpsimpy.dp.ph1.VoltageSource("vs")
+    vs.set_parameters(V_ref=complex(10, 0))
+    r_line = dpsimpy.dp.ph1.Resistor("r_line")
+    r_line.set_parameters(1)
+    vs.connect([gnd, n1])
+    r_line.connect([n1, n2])
+
+    nodes = [n1, n2]
+    components = [vs, r_line]
+    switches = []
+    for i, resistance in enumerate([2, 5, 10]):
+        n_load = dpsimpy.dp.SimNode("n_load" + str(i))
+        sw = dpsimpy.dp.ph1.Switch("sw" + str(i))
+        sw.set_parameters(1e6, 1e-3)
+        sw.open()
+        load = dpsimpy.dp.ph1.Resistor("r_load" + str(i))
+        load.set_parameters(resistance)
+        sw.connect([n2, n_load])
+        load.connect([n_load, gnd])
+        nodes.append(n_load)
+        components += [sw, load]
+        switches.append(sw)
+
+    return dpsimpy.SystemTopology(50, nodes, components), switches, n2
+
+
+def simulate(name, configure):
+    system, switches, node = build_system()
+
+    sim = dpsimpy.Simulation(name, dpsimpy.LogLevel.off)
+    sim.set_system(system)
+    sim.set_domain(dpsimpy.Domain.DP)
+    sim.set_time_step(0.001)
+    sim.set_final_time(1)
+    configure(sim)
+    sim.start()
+
+    voltages = []
+    for state in SWITCH_STATES:
+        for i, sw in enumerate(switches):
+            if state & (1 << i):
+                sw.close()
+            else:
+                sw.open()
+        sim.run_for(5)
+        voltages.append(node.single_voltage())
+    sim.stop()
+    return voltages, sim.switch_state_cache_statistics()
+
+
+def precomputed():
+    voltages, statistics = simulate("test_switch_precomputed", lambda sim: None)
+    # All switch states are factorized in advance without the cache
+    assert statistics.hits == 0
+    assert statistics.misses == 0
+    return voltages
+
+
+def test_switch_state_cache():
+    expected = precomputed()
+    # Two cached states for eight switch states evict the least recently
+    # used factorization on most switchings
+    voltages, statistics = simulate(
+        "test_switch_cache", lambda sim: sim.set_switch_state_cache(2)
+    )
+    assert voltages == pytest.approx(expected, rel=1e-9)
+    assert statistics.hits > 0
+    assert statistics.misses > 2
+    assert statistics.states == 2
+    assert statistics.evictions == statistics.misses - statistics.states
+    assert statistics.memory > 0
+
+
+def test_switch_state_cache_memory_limit():
+    expected = precomputed()
+    # A limit of one byte only keeps the most recently used state
+    voltages, statistics = simulate(
+        "test_switch_cache_memory",
+        lambda sim: sim.set_switch_state_cache(8, max_memory=1),
+    )
+    assert voltages == pytest.approx(expected, rel=1e-9)
+    assert statistics.hits > 0
+    assert statistics.states == 1
+    assert statistics.evictions == statistics.misses - 1
+
+
+def test_likely_switch_states():
+    expected = precomputed()
+
+    def configure(sim):
+        sim.set_switch_state_cache(3)
+        sim.set_likely_switch_states([0b011, 0b111])
+
+    voltages, statistics = simulate("test_switch_likely", configure)
+    assert voltages == pytest.approx(expected, rel=1e-9)
+    assert statistics.hits > 0
+    assert statistics.states == 3
+
+
+@pytest.mark.parametrize("max_indices", [2, 8])
+def test_low_rank_switch_updates(max_indices):
+    expected = precomputed()
+    # Every switch touches the real and imaginary parts of n2 and of its load
+    # node. Two indices factorize a new base state in the background on every
+    # switching, eight indices correct all states of the three switches.
+    voltages, _ = simulate(
+        "test_switch_low_rank_" + str(max_indices),
+        lambda sim: sim.set_low_rank_switch_updates(max_indices),
+    )
+    # The corrections are computed from the base factorization, which loses
+    # some accuracy for the large ratio of open and closed resistance
+    assert voltages == pytest.approx(expected, rel=1e-6)
+
+
+if __name__ == "__main__":
+    test_switch_state_cache()
+    test_switch_state_cache_memory_limit()
+    test_likely_switch_states()
+    test_low_rank_switch_updates(2)
+    test_low_rank_switch_updates(8)
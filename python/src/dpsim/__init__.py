@@ -1,3 +1,4 @@
+from . import hdf5
 from . import matpower
 from .matpower import Reader
 
@@ -6,4 +7,4 @@ try:
 except ImportError:  # pragma: no cover
     print("Error: Could not find dpsim C++ module.")
 
-__all__ = ["matpower"]
+__all__ = ["hdf5", "matpower"]
@@ -0,0 +1,18 @@
+import numpy as np
+import pandas as pd
+
+
+def read_log(filename, columns=None):
+    """Read a log written by dpsimpy.HDF5Logger into a pandas DataFrame.
+
+    Every dataset is read once into a numpy array which is handed to pandas
+    without copying. The DataFrame is indexed by the simulation time.
+    """
+    import h5py
+
+    with h5py.File(filename, "r") as f:
+        names = columns if columns is not None else [n for n in f.keys() if n != "time"]
+        time = f["time"][()]
+        data = {name: np.asarray(f[name][()]) for name in names}
+
+    return pd.DataFrame(data, index=pd.Index(time, name="time"), copy=False)
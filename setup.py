@@ -63,7 +63,7 @@ setup(
     package_dir={"dpsim": "python/src/dpsim"},
     python_requires=">=3.8",
     setup_requires=["pytest-runner", "wheel"],
-    tests_require=["pytest", "pyyaml", "nbformat", "nbconvert"],
+    tests_require=["pytest", "pyyaml", "nbformat", "nbconvert", "numpy", "h5py"],
     ext_modules=[CMakeExtension("dpsimpy")],
     cmdclass={"build_ext": CMakeBuild},
     zip_safe=False,